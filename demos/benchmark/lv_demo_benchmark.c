@@ -36,11 +36,27 @@
 #define IMG_NUM         LV_MAX((LV_HOR_RES * LV_VER_RES) / 5 / IMG_WIDH / IMG_HEIGHT, 1)
 #define IMG_ZOOM_MIN    128
 #define IMG_ZOOM_MAX    (256 + 64)
+#define IMG_ZOOM_OUT_MIN 32
 #define TXT "hello world\nit is a multi line text to test\nthe performance of text rendering"
+#define TXT_MIXED "hello world 你好世界\nit is a 多行 text to test 中文\nthe 性能 of 文本 rendering"
+#define TXT_UPDATE_NUM  64
+#define TABLE_ROW_NUM   1000
+#define FONT_LOAD_REPEAT    10
+#define TRANSP_CLEAR_REFR_CNT   500
+#define TRANSP_CLEAR_AREA_SIZE  LV_MAX(LV_DPI_DEF / 2, 16)
+#define ROTATION_REFR_CNT   20
+#define TXT_DENSE "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua."
+#define TXT_KERNED "AVATAR WAVE: \"Yo, Ty!\" To Tamara, LT. VAY Away. Wavy Tower. P.A. F.Y. Vote Yay. T-Type AWAY."
+#define TXT_RTL "לורם איפסום 2023 דולור (LVGL) סיט אמט. " \
+                "هذا نص طويل لاختبار الأداء v9.0 من اليمين إلى اليسار."
 #define LINE_WIDTH  LV_MAX(LV_DPI_DEF / 50, 2)
 #define LINE_POINT_NUM  16
 #define LINE_POINT_DIFF_MIN (LV_DPI_DEF / 10)
 #define LINE_POINT_DIFF_MAX LV_MAX(LV_HOR_RES / (LINE_POINT_NUM + 2), LINE_POINT_DIFF_MIN * 2)
+#define LINE_SHORT_NUM  250
+#define LINE_SHORT_LEN  LV_MAX(LV_DPI_DEF / 8, 8)
+#define POLYGON_POINT_NUM_FEW   16
+#define POLYGON_POINT_NUM_MANY  256
 #define ARC_WIDTH_THIN LV_MAX(LV_DPI_DEF / 50, 2)
 #define ARC_WIDTH_THICK LV_MAX(LV_DPI_DEF / 10, 5)
 
@@ -55,6 +71,7 @@
 typedef struct {
     const char * name;
     void (*create_cb)(void);
+    void (*update_cb)(void);    /*Called before each refresh. Its time is measured too.*/
     uint32_t time_sum_normal;
     uint32_t time_sum_opa;
     uint32_t refr_cnt_normal;
@@ -74,6 +91,7 @@ static bool scene_with_opa = true;
 static uint32_t last_flush_cb_call;
 static uint32_t render_start_time;
 static void (*flush_cb_ori)(lv_disp_t *, const lv_area_t *, lv_color_t *);
+static void (*init_buf_ori)(lv_draw_ctx_t *);
 static uint32_t disp_ori_timer_period;
 static uint32_t anim_ori_timer_period;
 
@@ -104,12 +122,34 @@ static void next_scene_timer_cb(lv_timer_t * timer);
 static void single_scene_finsih_timer_cb(lv_timer_t * timer);
 static void dummy_flush_cb(lv_disp_t * drv, const lv_area_t * area, lv_color_t * colors);
 static void generate_report(void);
+static void font_load_measure(const char * path, bool lazy, uint32_t cache_size);
+static uint32_t transp_clear_measure(lv_disp_t * disp, lv_obj_t * obj, bool full_band);
+static void transp_flush_cb(lv_disp_t * disp, const lv_area_t * area, lv_color_t * color_p);
+static void transp_init_buf_full_band(lv_draw_ctx_t * draw_ctx);
+static void rotation_flush_cb(lv_disp_t * disp, const lv_area_t * area, lv_color_t * color_p);
 
 static void rect_create(lv_style_t * style);
+static void clip_corner_create(lv_style_t * style);
 static void img_create(lv_style_t * style, const void * src, bool rotate, bool zoom, bool aa);
-static void txt_create(lv_style_t * style);
+static void img_zoom_out_create(lv_style_t * style, const void * src);
+static void txt_create(lv_style_t * style, const char * txt);
+static lv_obj_t * txt_dense_create(lv_style_t * style, const char * txt);
+static void txt_dense_update(void);
+static lv_font_t * kern_pair_font_create(const lv_font_t * font_ref);
+static void kern_pair_font_delete_event_cb(lv_event_t * e);
+static void txt_update_create(lv_style_t * style);
+static void txt_update(void);
+#if LV_USE_TABLE
+    static void table_create(lv_style_t * style);
+    static void table_update(void);
+#endif
 static void line_create(lv_style_t * style);
+static void line_short_create(lv_style_t * style);
+static void polygon_create(uint32_t point_num);
 static void arc_create(lv_style_t * style);
+static void layer_create(lv_style_t * style, bool rotate);
+static void layer_argb_create(lv_style_t * style);
+static void static_card_create(bool cache);
 static void fall_anim(lv_obj_t * obj);
 static void rnd_reset(void);
 static int32_t rnd_next(int32_t min, int32_t max);
@@ -129,6 +169,14 @@ static void rectangle_rounded_cb(void)
     rect_create(&style_common);
 }
 
+static void rectangle_clip_corner_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_radius(&style_common, RADIUS);
+    lv_style_set_bg_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    clip_corner_create(&style_common);
+}
+
 static void rectangle_circle_cb(void)
 {
     lv_style_reset(&style_common);
@@ -422,12 +470,30 @@ static void img_argb_zoom_aa_cb(void)
 #endif
 }
 
+static void img_rgb_zoom_out_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_img_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    img_zoom_out_create(&style_common, &img_benchmark_cogwheel_rgb);
+}
+
+static void img_argb_zoom_out_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_img_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+#if LV_DEMO_BENCHMARK_RGB565A8 && LV_COLOR_DEPTH == 16
+    img_zoom_out_create(&style_common, &img_benchmark_cogwheel_rgb565a8);
+#else
+    img_zoom_out_create(&style_common, &img_benchmark_cogwheel_argb);
+#endif
+}
+
 static void txt_small_cb(void)
 {
     lv_style_reset(&style_common);
     lv_style_set_text_font(&style_common, lv_theme_get_font_small(NULL));
     lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
-    txt_create(&style_common);
+    txt_create(&style_common, TXT);
 
 }
 
@@ -436,7 +502,7 @@ static void txt_medium_cb(void)
     lv_style_reset(&style_common);
     lv_style_set_text_font(&style_common, lv_theme_get_font_normal(NULL));
     lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
-    txt_create(&style_common);
+    txt_create(&style_common, TXT);
 
 }
 
@@ -445,17 +511,59 @@ static void txt_large_cb(void)
     lv_style_reset(&style_common);
     lv_style_set_text_font(&style_common, lv_theme_get_font_large(NULL));
     lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
-    txt_create(&style_common);
+    txt_create(&style_common, TXT);
+
+}
+
+static void txt_dense_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_text_font(&style_common, lv_theme_get_font_small(NULL));
+    lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    txt_dense_create(&style_common, TXT_DENSE);
+}
+
+static void txt_kerned_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_text_font(&style_common, lv_theme_get_font_small(NULL));
+    lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    txt_dense_create(&style_common, TXT_KERNED);
+}
+
+static void txt_kerned_pairs_cb(void)
+{
+    /*The same font but its kerning is stored as pairs*/
+    const lv_font_t * font = lv_theme_get_font_small(NULL);
+    lv_font_t * pair_font = kern_pair_font_create(font);
+
+    lv_style_reset(&style_common);
+    lv_style_set_text_font(&style_common, pair_font ? pair_font : font);
+    lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    lv_obj_t * label = txt_dense_create(&style_common, TXT_KERNED);
 
+    /*Free the font with the label*/
+    if(pair_font) lv_obj_add_event(label, kern_pair_font_delete_event_cb, LV_EVENT_DELETE, pair_font);
 }
 
+#if LV_USE_BIDI && LV_FONT_DEJAVU_16_PERSIAN_HEBREW
+static void txt_rtl_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_text_font(&style_common, &lv_font_dejavu_16_persian_hebrew);
+    lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    lv_style_set_base_dir(&style_common, LV_BASE_DIR_RTL);
+    txt_dense_create(&style_common, TXT_RTL);
+}
+#endif
+
 #if LV_USE_FONT_COMPRESSED
 static void txt_small_compr_cb(void)
 {
     lv_style_reset(&style_common);
     lv_style_set_text_font(&style_common, &lv_font_benchmark_montserrat_12_compr_az);
     lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
-    txt_create(&style_common);
+    txt_create(&style_common, TXT);
 }
 
 static void txt_medium_compr_cb(void)
@@ -463,7 +571,7 @@ static void txt_medium_compr_cb(void)
     lv_style_reset(&style_common);
     lv_style_set_text_font(&style_common, &lv_font_benchmark_montserrat_16_compr_az);
     lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
-    txt_create(&style_common);
+    txt_create(&style_common, TXT);
 }
 
 static void txt_large_compr_cb(void)
@@ -471,7 +579,45 @@ static void txt_large_compr_cb(void)
     lv_style_reset(&style_common);
     lv_style_set_text_font(&style_common, &lv_font_benchmark_montserrat_28_compr_az);
     lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
-    txt_create(&style_common);
+    txt_create(&style_common, TXT);
+}
+#endif
+
+#if LV_FONT_UNSCII_16
+static void txt_1bpp_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_text_font(&style_common, &lv_font_unscii_16);
+    lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    txt_create(&style_common, TXT);
+}
+#endif
+
+#if LV_FONT_SIMSUN_16_CJK
+static void txt_mixed_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_text_font(&style_common, &lv_font_simsun_16_cjk);
+    lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    txt_create(&style_common, TXT_MIXED);
+}
+#endif
+
+static void txt_update_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_text_font(&style_common, lv_theme_get_font_normal(NULL));
+    lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    txt_update_create(&style_common);
+}
+
+#if LV_USE_TABLE
+static void table_measure_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_text_font(&style_common, lv_theme_get_font_small(NULL));
+    lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    table_create(&style_common);
 }
 #endif
 
@@ -483,6 +629,24 @@ static void line_cb(void)
     line_create(&style_common);
 }
 
+static void line_short_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_line_width(&style_common, LINE_WIDTH);
+    lv_style_set_line_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    line_short_create(&style_common);
+}
+
+static void polygon_cb(void)
+{
+    polygon_create(POLYGON_POINT_NUM_FEW);
+}
+
+static void polygon_many_points_cb(void)
+{
+    polygon_create(POLYGON_POINT_NUM_MANY);
+}
+
 static void arc_think_cb(void)
 {
 
@@ -501,6 +665,42 @@ static void arc_thick_cb(void)
 
 }
 
+static void layer_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_radius(&style_common, RADIUS);
+    lv_style_set_bg_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    lv_style_set_opa(&style_common, LV_OPA_70);
+    layer_create(&style_common, false);
+}
+
+static void layer_rotate_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_radius(&style_common, RADIUS);
+    lv_style_set_bg_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    lv_style_set_opa(&style_common, LV_OPA_70);
+    layer_create(&style_common, true);
+}
+
+static void layer_argb_cb(void)
+{
+    lv_style_reset(&style_common);
+    lv_style_set_radius(&style_common, RADIUS);
+    lv_style_set_bg_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    lv_style_set_opa(&style_common, LV_OPA_70);
+    layer_argb_create(&style_common);
+}
+
+static void static_card_cb(void)
+{
+    static_card_create(false);
+}
+
+static void static_card_cached_cb(void)
+{
+    static_card_create(true);
+}
 
 static void sub_rectangle_cb(void)
 {
@@ -571,7 +771,7 @@ static void sub_text_cb(void)
     lv_style_set_text_font(&style_common, lv_theme_get_font_normal(NULL));
     lv_style_set_text_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
     lv_style_set_blend_mode(&style_common, LV_BLEND_MODE_SUBTRACTIVE);
-    txt_create(&style_common);
+    txt_create(&style_common, TXT);
 }
 
 
@@ -583,6 +783,7 @@ static void sub_text_cb(void)
 static scene_dsc_t scenes[] = {
     {.name = "Rectangle",                    .weight = 30, .create_cb = rectangle_cb},
     {.name = "Rectangle rounded",            .weight = 20, .create_cb = rectangle_rounded_cb},
+    {.name = "Rectangle clip corner",        .weight = 10, .create_cb = rectangle_clip_corner_cb},
     {.name = "Circle",                       .weight = 10, .create_cb = rectangle_circle_cb},
     {.name = "Border",                       .weight = 20, .create_cb = border_cb},
     {.name = "Border rounded",               .weight = 30, .create_cb = border_rounded_cb},
@@ -617,10 +818,18 @@ static scene_dsc_t scenes[] = {
     {.name = "Image RGB zoom anti aliased",  .weight = 3, .create_cb = img_rgb_zoom_aa_cb},
     {.name = "Image ARGB zoom",              .weight = 5, .create_cb = img_argb_zoom_cb},
     {.name = "Image ARGB zoom anti aliased", .weight = 5, .create_cb = img_argb_zoom_aa_cb},
+    {.name = "Image RGB zoom out",           .weight = 3, .create_cb = img_rgb_zoom_out_cb},
+    {.name = "Image ARGB zoom out",          .weight = 3, .create_cb = img_argb_zoom_out_cb},
 
     {.name = "Text small",                   .weight = 20, .create_cb = txt_small_cb},
     {.name = "Text medium",                  .weight = 30, .create_cb = txt_medium_cb},
     {.name = "Text large",                   .weight = 20, .create_cb = txt_large_cb},
+    {.name = "Text dense",                   .weight = 10, .create_cb = txt_dense_cb, .update_cb = txt_dense_update},
+#if LV_USE_BIDI && LV_FONT_DEJAVU_16_PERSIAN_HEBREW
+    {.name = "Text right-to-left",           .weight = 5, .create_cb = txt_rtl_cb, .update_cb = txt_dense_update},
+#endif
+    {.name = "Text kerned",                  .weight = 5, .create_cb = txt_kerned_cb, .update_cb = txt_dense_update},
+    {.name = "Text kerned pairs",            .weight = 3, .create_cb = txt_kerned_pairs_cb, .update_cb = txt_dense_update},
 
 #if LV_USE_FONT_COMPRESSED
     {.name = "Text small compressed",        .weight = 3, .create_cb = txt_small_compr_cb},
@@ -628,11 +837,36 @@ static scene_dsc_t scenes[] = {
     {.name = "Text large compressed",        .weight = 10, .create_cb = txt_large_compr_cb},
 #endif
 
+#if LV_FONT_UNSCII_16
+    {.name = "Text 1bpp",                    .weight = 3, .create_cb = txt_1bpp_cb},
+#endif
+
+#if LV_FONT_SIMSUN_16_CJK
+    {.name = "Text mixed script",            .weight = 5, .create_cb = txt_mixed_cb},
+#endif
+
+    {.name = "Text update",                  .weight = 10, .create_cb = txt_update_cb, .update_cb = txt_update},
+
+#if LV_USE_TABLE
+    {.name = "Table measure",                .weight = 5, .create_cb = table_measure_cb, .update_cb = table_update},
+#endif
+
     {.name = "Line",                         .weight = 10, .create_cb = line_cb},
+    {.name = "Line short",                   .weight = 5, .create_cb = line_short_cb},
+
+    {.name = "Polygon",                      .weight = 5, .create_cb = polygon_cb},
+    {.name = "Polygon many points",          .weight = 5, .create_cb = polygon_many_points_cb},
 
     {.name = "Arc think",                    .weight = 10, .create_cb = arc_think_cb},
     {.name = "Arc thick",                    .weight = 10, .create_cb = arc_thick_cb},
 
+    {.name = "Layer",                        .weight = 10, .create_cb = layer_cb},
+    {.name = "Layer rotate",                 .weight = 5, .create_cb = layer_rotate_cb},
+    {.name = "Layer ARGB",                   .weight = 5, .create_cb = layer_argb_cb},
+
+    {.name = "Static card",                  .weight = 5, .create_cb = static_card_cb},
+    {.name = "Static card cached",           .weight = 5, .create_cb = static_card_cached_cb},
+
     {.name = "Substr. rectangle",            .weight = 10, .create_cb = sub_rectangle_cb},
     {.name = "Substr. border",               .weight = 10, .create_cb = sub_border_cb},
     {.name = "Substr. shadow",               .weight = 10, .create_cb = sub_shadow_cb},
@@ -743,6 +977,106 @@ void lv_demo_benchmark_run_scene(lv_demo_benchmark_mode_t _mode, uint16_t scene_
     }
 }
 
+void lv_demo_benchmark_font_load(const char * path, uint32_t cache_size)
+{
+    font_load_measure(path, false, 0);
+    font_load_measure(path, true, cache_size);
+}
+
+void lv_demo_benchmark_transp_clear(lv_coord_t hor_res, lv_coord_t ver_res, lv_disp_render_mode_t render_mode)
+{
+    uint32_t buf_size = hor_res * ver_res * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+    if(render_mode == LV_DISP_RENDER_MODE_PARTIAL) buf_size /= 10;
+    void * buf = lv_malloc(buf_size);
+    if(buf == NULL) {
+        LV_LOG_WARN("Couldn't allocate the draw buffer");
+        return;
+    }
+
+    lv_disp_t * disp = lv_disp_create(hor_res, ver_res);
+    lv_disp_set_draw_buffers(disp, buf, NULL, buf_size, render_mode);
+    lv_disp_set_flush_cb(disp, transp_flush_cb);
+    lv_disp_set_color_format(disp, LV_COLOR_FORMAT_NATIVE_ALPHA);
+
+    lv_obj_t * scr = lv_disp_get_scr_act(disp);
+    lv_obj_remove_style_all(scr);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_TRANSP, 0);
+    lv_refr_now(disp);
+
+    /*Refresh small areas of the transparent screen*/
+    uint32_t transp_full_band = transp_clear_measure(disp, scr, true);
+    uint32_t transp_new = transp_clear_measure(disp, scr, false);
+
+    /*Refresh small areas of an opaque panel covering the screen*/
+    lv_obj_t * panel = lv_obj_create(scr);
+    lv_obj_remove_style_all(panel);
+    lv_obj_set_size(panel, lv_pct(100), lv_pct(100));
+    lv_obj_set_style_bg_opa(panel, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(panel, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_refr_now(disp);
+
+    uint32_t cover_full_band = transp_clear_measure(disp, panel, true);
+    uint32_t cover_new = transp_clear_measure(disp, panel, false);
+
+    lv_disp_remove(disp);
+    lv_free(buf);
+
+    LV_LOG("Transparent %dx%d display, %" LV_PRIu32 " refreshes of %dx%d areas\n"
+           "  transparent screen: full band clear: %" LV_PRIu32 " ms, clip area clear: %" LV_PRIu32 " ms\n"
+           "  covered screen: full band clear: %" LV_PRIu32 " ms, clip area clear: %" LV_PRIu32 " ms\n",
+           (int)hor_res, (int)ver_res, (uint32_t)TRANSP_CLEAR_REFR_CNT,
+           (int)TRANSP_CLEAR_AREA_SIZE, (int)TRANSP_CLEAR_AREA_SIZE,
+           transp_full_band, transp_new, cover_full_band, cover_new);
+}
+
+void lv_demo_benchmark_rotation(lv_coord_t hor_res, lv_coord_t ver_res)
+{
+    /*Render the whole screen in one band so that the whole buffer is rotated at once*/
+    uint32_t buf_size = hor_res * ver_res * sizeof(lv_color_t);
+    void * buf = lv_malloc(buf_size);
+    if(buf == NULL) {
+        LV_LOG_WARN("Couldn't allocate the draw buffer");
+        return;
+    }
+
+    lv_disp_t * disp = lv_disp_create(hor_res, ver_res);
+    lv_disp_set_draw_buffers(disp, buf, NULL, buf_size, LV_DISP_RENDER_MODE_PARTIAL);
+    lv_disp_set_flush_cb(disp, rotation_flush_cb);
+
+    /*Keep the rendering simple to see mainly the time of the rotation*/
+    lv_obj_t * scr = lv_disp_get_scr_act(disp);
+    lv_obj_remove_style_all(scr);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(scr, lv_palette_main(LV_PALETTE_BLUE), 0);
+
+    static const lv_disp_rotation_t rotations[] = {LV_DISP_ROTATION_0, LV_DISP_ROTATION_90,
+                                                   LV_DISP_ROTATION_180, LV_DISP_ROTATION_270
+                                                  };
+    uint32_t time_0 = 0;
+    uint32_t i;
+    for(i = 0; i < dimof(rotations); i++) {
+        lv_disp_set_rotation(disp, rotations[i], true);
+        lv_refr_now(disp);
+
+        uint32_t t = lv_tick_get();
+        uint32_t j;
+        for(j = 0; j < ROTATION_REFR_CNT; j++) {
+            lv_obj_invalidate(scr);
+            lv_refr_now(disp);
+        }
+        uint32_t time = lv_tick_elaps(t);
+        if(rotations[i] == LV_DISP_ROTATION_0) time_0 = time;
+
+        /*The rendering is the same in each case so the difference is the time of the rotation*/
+        LV_LOG("Rotating %dx%d %d bpp screen by %d degrees: refresh: %" LV_PRIu32 " ms, rotation: %" LV_PRIu32 " ms\n",
+               (int)hor_res, (int)ver_res, LV_COLOR_DEPTH, (int)i * 90,
+               time / ROTATION_REFR_CNT, (time > time_0 ? time - time_0 : 0) / ROTATION_REFR_CNT);
+    }
+
+    lv_disp_remove(disp);
+    lv_free(buf);
+}
+
 
 /**********************
  *   STATIC FUNCTIONS
@@ -793,7 +1127,13 @@ static void benchmark_event_cb(lv_event_t * e)
 {
     lv_event_code_t code = lv_event_get_code(e);
 
-    if(code == LV_EVENT_RENDER_START) {
+    bool update = scene_act >= 0 && scenes[scene_act].update_cb != NULL;
+
+    if(code == LV_EVENT_REFR_START && update) {
+        render_start_time = lv_tick_get();
+        scenes[scene_act].update_cb();
+    }
+    else if(code == LV_EVENT_RENDER_START && !update) {
         render_start_time = lv_tick_get();
     }
 }
@@ -1169,6 +1509,28 @@ static void rect_create(lv_style_t * style)
     }
 }
 
+/*Rounded rectangles on a parent which clips them to its rounded corners,
+ *so they are drawn with more masks*/
+static void clip_corner_create(lv_style_t * style)
+{
+    lv_obj_t * cont = lv_obj_create(scene_bg);
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, lv_pct(100), lv_pct(100));
+    lv_obj_set_style_radius(cont, LV_RADIUS_CIRCLE, 0);
+    lv_obj_set_style_clip_corner(cont, true, 0);
+    lv_obj_clear_flag(cont, LV_OBJ_FLAG_SCROLLABLE);
+
+    uint32_t i;
+    for(i = 0; i < OBJ_NUM; i++) {
+        lv_obj_t * obj = lv_obj_create(cont);
+        lv_obj_remove_style_all(obj);
+        lv_obj_add_style(obj, style, 0);
+        lv_obj_set_style_bg_color(obj, lv_color_hex(rnd_next(0, 0xFFFFF0)), 0);
+        lv_obj_set_size(obj, rnd_next(OBJ_SIZE_MIN, OBJ_SIZE_MAX), rnd_next(OBJ_SIZE_MIN, OBJ_SIZE_MAX));
+
+        fall_anim(obj);
+    }
+}
 
 static void img_create(lv_style_t * style, const void * src, bool rotate, bool zoom, bool aa)
 {
@@ -1188,8 +1550,39 @@ static void img_create(lv_style_t * style, const void * src, bool rotate, bool z
     }
 }
 
+static void zoom_anim_cb(void * var, int32_t v)
+{
+    lv_img_set_zoom(var, v);
+}
+
+/*Images shrinking from 100% to IMG_ZOOM_OUT_MIN and back*/
+static void img_zoom_out_create(lv_style_t * style, const void * src)
+{
+    uint32_t i;
+    for(i = 0; i < (uint32_t)IMG_NUM; i++) {
+        lv_obj_t * obj = lv_img_create(scene_bg);
+        lv_obj_remove_style_all(obj);
+        lv_obj_add_style(obj, style, 0);
+        lv_img_set_src(obj, src);
+        lv_img_set_antialias(obj, true);
+
+        fall_anim(obj);
+
+        uint32_t t = rnd_next(ANIM_TIME_MIN, ANIM_TIME_MAX);
+
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, obj);
+        lv_anim_set_exec_cb(&a, zoom_anim_cb);
+        lv_anim_set_values(&a, LV_ZOOM_NONE, IMG_ZOOM_OUT_MIN);
+        lv_anim_set_time(&a, t);
+        lv_anim_set_playback_time(&a, t);
+        lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+        lv_anim_start(&a);
+    }
+}
 
-static void txt_create(lv_style_t * style)
+static void txt_create(lv_style_t * style, const char * txt)
 {
     uint32_t i;
     for(i = 0; i < OBJ_NUM; i++) {
@@ -1198,12 +1591,189 @@ static void txt_create(lv_style_t * style)
         lv_obj_add_style(obj, style, 0);
         lv_obj_set_style_text_color(obj, lv_color_hex(rnd_next(0, 0xFFFFF0)), 0);
 
-        lv_label_set_text(obj, TXT);
+        lv_label_set_text(obj, txt);
 
         fall_anim(obj);
     }
 }
 
+/*A scene full of small text like a document or a log. `txt_dense_update` redraws it in each refresh.*/
+static lv_obj_t * txt_dense_create(lv_style_t * style, const char * txt)
+{
+    lv_obj_t * obj = lv_label_create(scene_bg);
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, style, 0);
+    lv_obj_set_width(obj, lv_pct(100));
+    lv_obj_set_style_text_color(obj, lv_color_hex(rnd_next(0, 0xFFFFF0)), 0);
+
+    /*Repeat the text until it fills the scene*/
+    lv_label_set_text(obj, txt);
+    lv_obj_update_layout(obj);
+    while(lv_obj_get_height(obj) < lv_obj_get_height(scene_bg)) {
+        lv_label_ins_text(obj, LV_LABEL_POS_LAST, " ");
+        lv_label_ins_text(obj, LV_LABEL_POS_LAST, txt);
+        lv_obj_update_layout(obj);
+    }
+
+    return obj;
+}
+
+static void txt_dense_update(void)
+{
+    lv_obj_invalidate(scene_bg);
+}
+
+/*A font whose kerning is stored as pairs. The fields are allocated together with the font.*/
+typedef struct {
+    lv_font_t font;
+    lv_font_fmt_txt_dsc_t dsc;
+    lv_font_fmt_txt_kern_pair_t kern_pairs;
+    lv_font_fmt_txt_glyph_cache_t cache;
+} kern_pair_font_t;
+
+/*Create a copy of a font with class based kerning where the kerning is stored as pairs.
+ *The built-in fonts use class based kerning, but fonts converted with other settings or
+ *loaded from files can have pair based kerning. Return NULL if the font can't be converted.*/
+static lv_font_t * kern_pair_font_create(const lv_font_t * font_ref)
+{
+    if(font_ref->get_glyph_dsc != lv_font_get_glyph_dsc_fmt_txt) return NULL;
+    const lv_font_fmt_txt_dsc_t * dsc_ref = font_ref->dsc;
+    if(dsc_ref->kern_classes == 0 || dsc_ref->kern_dsc == NULL) return NULL;
+    const lv_font_fmt_txt_kern_classes_t * kern_classes = dsc_ref->kern_dsc;
+
+    /*Only 8 bit glyph IDs are handled here*/
+    uint32_t glyph_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < dsc_ref->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &dsc_ref->cmaps[i];
+        uint32_t n = cmap->unicode_list ? cmap->list_length : cmap->range_length;
+        glyph_cnt = LV_MAX(glyph_cnt, cmap->glyph_id_start + n);
+    }
+    if(glyph_cnt > 256) return NULL;
+
+    /*Count the pairs first to allocate them with the font*/
+    uint32_t pair_cnt = 0;
+    uint32_t l;
+    uint32_t r;
+    for(l = 1; l < glyph_cnt; l++) {
+        uint8_t lc = kern_classes->left_class_mapping[l];
+        if(lc == 0) continue;
+        for(r = 1; r < glyph_cnt; r++) {
+            uint8_t rc = kern_classes->right_class_mapping[r];
+            if(rc == 0) continue;
+            if(kern_classes->class_pair_values[(lc - 1) * kern_classes->right_class_cnt + (rc - 1)] != 0) pair_cnt++;
+        }
+    }
+
+    kern_pair_font_t * pf = lv_malloc(sizeof(kern_pair_font_t) + pair_cnt * 3);
+    if(pf == NULL) return NULL;
+    lv_memzero(pf, sizeof(kern_pair_font_t));
+    uint8_t * glyph_ids = (uint8_t *)(pf + 1);
+    int8_t * values = (int8_t *)(glyph_ids + pair_cnt * 2);
+
+    /*The pairs are sorted by the left and then the right glyph ID*/
+    uint32_t p = 0;
+    for(l = 1; l < glyph_cnt; l++) {
+        uint8_t lc = kern_classes->left_class_mapping[l];
+        if(lc == 0) continue;
+        for(r = 1; r < glyph_cnt; r++) {
+            uint8_t rc = kern_classes->right_class_mapping[r];
+            if(rc == 0) continue;
+            int8_t v = kern_classes->class_pair_values[(lc - 1) * kern_classes->right_class_cnt + (rc - 1)];
+            if(v == 0) continue;
+            glyph_ids[p * 2] = l;
+            glyph_ids[p * 2 + 1] = r;
+            values[p] = v;
+            p++;
+        }
+    }
+
+    pf->kern_pairs.glyph_ids = glyph_ids;
+    pf->kern_pairs.values = values;
+    pf->kern_pairs.pair_cnt = pair_cnt;
+    pf->kern_pairs.glyph_ids_size = 0;
+
+    pf->dsc = *dsc_ref;
+    pf->dsc.kern_dsc = &pf->kern_pairs;
+    pf->dsc.kern_classes = 0;
+    pf->dsc.cache = &pf->cache;
+    pf->font = *font_ref;
+    pf->font.dsc = &pf->dsc;
+
+    return &pf->font;
+}
+
+static void kern_pair_font_delete_event_cb(lv_event_t * e)
+{
+    lv_font_t * font = lv_event_get_user_data(e);
+#if LV_FONT_FMT_TXT_GLYPH_ID_LUT
+    lv_font_free_glyph_id_lut_fmt_txt(font);
+#endif
+    /*`font` is the first field of `kern_pair_font_t`*/
+    lv_free(font);
+}
+
+/*A grid of small labels like a dashboard. `txt_update` sets their values.*/
+static void txt_update_create(lv_style_t * style)
+{
+    lv_obj_t * cont = lv_obj_create(scene_bg);
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_flex_align(cont, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
+
+    uint32_t i;
+    for(i = 0; i < TXT_UPDATE_NUM; i++) {
+        lv_obj_t * obj = lv_label_create(cont);
+        lv_obj_remove_style_all(obj);
+        lv_obj_add_style(obj, style, 0);
+        lv_obj_set_style_text_color(obj, lv_color_hex(rnd_next(0, 0xFFFFF0)), 0);
+    }
+
+    txt_update();
+}
+
+static void txt_update(void)
+{
+    lv_obj_t * cont = lv_obj_get_child(scene_bg, 0);
+    if(cont == NULL) return;
+
+    uint32_t i;
+    for(i = 0; i < TXT_UPDATE_NUM; i++) {
+        int32_t v = rnd_next(0, 99999);
+        lv_label_set_text_fmt(lv_obj_get_child(cont, i), "%" LV_PRId32 ".%02" LV_PRId32 " V\n0x%04" LV_PRIX32,
+                              v / 100, v % 100, (uint32_t)v & 0xFFFF);
+    }
+}
+
+#if LV_USE_TABLE
+/*A long table whose rows are measured again before each refresh. Only a few of them are visible.*/
+static void table_create(lv_style_t * style)
+{
+    static const char * status[] = {"OK", "Idle", "Running", "OK", "Warning", "OK", "Error\nCheck the sensor"};
+
+    lv_obj_t * table = lv_table_create(scene_bg);
+    lv_obj_add_style(table, style, LV_PART_ITEMS);
+    lv_obj_set_size(table, lv_pct(100), lv_pct(100));
+    lv_obj_update_layout(table);
+    lv_table_set_col_width(table, 0, lv_obj_get_content_width(table));
+    lv_table_set_row_cnt(table, TABLE_ROW_NUM);
+
+    uint32_t i;
+    for(i = 0; i < TABLE_ROW_NUM; i++) {
+        lv_table_set_cell_value(table, i, 0, status[i % (sizeof(status) / sizeof(status[0]))]);
+    }
+}
+
+static void table_update(void)
+{
+    lv_obj_t * table = lv_obj_get_child(scene_bg, 0);
+    if(table == NULL) return;
+
+    /*Measure the height of all the rows again, like after a style or font change*/
+    lv_obj_refresh_style(table, LV_PART_ANY, LV_STYLE_PROP_ANY);
+}
+#endif
 
 static void line_create(lv_style_t * style)
 {
@@ -1233,6 +1803,107 @@ static void line_create(lv_style_t * style)
 }
 
 
+static void line_short_draw_event_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+
+    lv_draw_line_dsc_t draw_dsc;
+    lv_draw_line_dsc_init(&draw_dsc);
+    lv_obj_init_draw_line_dsc(obj, LV_PART_MAIN, &draw_dsc);
+
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    lv_coord_t w = LV_MAX(lv_area_get_width(&coords) - 2 * LINE_SHORT_LEN, 1);
+    lv_coord_t h = LV_MAX(lv_area_get_height(&coords) - 2 * LINE_SHORT_LEN, 1);
+
+    /*Generate the same lines in every refresh from the object specific seed*/
+    uint32_t seed = (uint32_t)((uintptr_t)lv_event_get_user_data(e));
+    uint32_t i;
+    for(i = 0; i < LINE_SHORT_NUM; i++) {
+        seed = seed * 1103515245 + 12345;
+        lv_point_t p1;
+        p1.x = coords.x1 + LINE_SHORT_LEN + (seed >> 8) % w;
+        p1.y = coords.y1 + LINE_SHORT_LEN + (seed >> 20) % h;
+        lv_point_t p2;
+        p2.x = p1.x + (lv_coord_t)((seed >> 4) % (2 * LINE_SHORT_LEN)) - LINE_SHORT_LEN;
+        p2.y = p1.y + (lv_coord_t)((seed >> 12) % (2 * LINE_SHORT_LEN)) - LINE_SHORT_LEN;
+        lv_draw_line(draw_ctx, &draw_dsc, &p1, &p2);
+    }
+}
+
+/*Many short lines in random directions, e.g. like the markers of a scatter chart*/
+static void line_short_create(lv_style_t * style)
+{
+    uint32_t i;
+    for(i = 0; i < OBJ_NUM; i++) {
+        lv_obj_t * obj = lv_obj_create(scene_bg);
+        lv_obj_remove_style_all(obj);
+        lv_obj_add_style(obj, style, 0);
+        lv_obj_set_style_line_color(obj, lv_color_hex(rnd_next(0, 0xFFFFF0)), 0);
+        lv_obj_set_size(obj, rnd_next(OBJ_SIZE_MAX / 2, OBJ_SIZE_MAX), rnd_next(OBJ_SIZE_MAX / 2, OBJ_SIZE_MAX));
+        lv_obj_add_event(obj, line_short_draw_event_cb, LV_EVENT_DRAW_MAIN, (void *)((uintptr_t)rnd_next(1, 0xFFFF)));
+
+        fall_anim(obj);
+    }
+}
+
+static void polygon_draw_event_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+    const lv_point_t * points = lv_obj_get_user_data(obj);
+    uint32_t point_num = (uint32_t)((uintptr_t)lv_event_get_user_data(e));
+
+    /*The points are relative to the object*/
+    static lv_point_t points_abs[POLYGON_POINT_NUM_MANY + 2];
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    uint32_t i;
+    for(i = 0; i < point_num; i++) {
+        points_abs[i].x = points[i].x + coords.x1;
+        points_abs[i].y = points[i].y + coords.y1;
+    }
+
+    lv_draw_rect_dsc_t draw_dsc;
+    lv_draw_rect_dsc_init(&draw_dsc);
+    draw_dsc.bg_color = lv_obj_get_style_bg_color(obj, LV_PART_MAIN);
+    draw_dsc.bg_opa = scene_with_opa ? LV_OPA_50 : LV_OPA_COVER;
+    lv_draw_polygon(draw_ctx, &draw_dsc, points_abs, point_num);
+}
+
+/*Polygons like the area of a chart with `point_num` random values*/
+static void polygon_create(uint32_t point_num)
+{
+    static lv_point_t points[OBJ_NUM][POLYGON_POINT_NUM_MANY + 2];
+
+    uint32_t i;
+    for(i = 0; i < OBJ_NUM; i++) {
+        lv_coord_t w = rnd_next(OBJ_SIZE_MAX / 2, OBJ_SIZE_MAX);
+        lv_coord_t h = rnd_next(OBJ_SIZE_MIN * 2, OBJ_SIZE_MAX);
+
+        /*The values are between the bottom corners*/
+        points[i][0].x = 0;
+        points[i][0].y = h - 1;
+        uint32_t j;
+        for(j = 0; j < point_num; j++) {
+            points[i][j + 1].x = (j * (w - 1)) / (point_num - 1);
+            points[i][j + 1].y = rnd_next(0, h - 1);
+        }
+        points[i][point_num + 1].x = w - 1;
+        points[i][point_num + 1].y = h - 1;
+
+        lv_obj_t * obj = lv_obj_create(scene_bg);
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_style_bg_color(obj, lv_color_hex(rnd_next(0, 0xFFFFF0)), 0);
+        lv_obj_set_size(obj, w, h);
+        lv_obj_set_user_data(obj, points[i]);
+        lv_obj_add_event(obj, polygon_draw_event_cb, LV_EVENT_DRAW_MAIN, (void *)((uintptr_t)point_num + 2));
+
+        fall_anim(obj);
+    }
+}
+
 static void arc_anim_end_angle_cb(void * var, int32_t v)
 {
     lv_arc_set_end_angle(var, v);
@@ -1266,6 +1937,96 @@ static void arc_create(lv_style_t * style)
     }
 }
 
+/*Semi-transparent objects with children, so all of them are rendered into a layer first*/
+static void layer_create(lv_style_t * style, bool rotate)
+{
+    uint32_t i;
+    for(i = 0; i < OBJ_NUM; i++) {
+        lv_obj_t * obj = lv_obj_create(scene_bg);
+        lv_obj_remove_style_all(obj);
+        lv_obj_add_style(obj, style, 0);
+        lv_obj_set_style_bg_color(obj, lv_color_hex(rnd_next(0, 0xFFFFF0)), 0);
+        lv_obj_set_size(obj, rnd_next(OBJ_SIZE_MAX / 4, OBJ_SIZE_MAX / 2), rnd_next(OBJ_SIZE_MAX / 4, OBJ_SIZE_MAX / 2));
+
+        lv_obj_t * child = lv_obj_create(obj);
+        lv_obj_remove_style_all(child);
+        lv_obj_set_style_bg_opa(child, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(child, lv_color_hex(rnd_next(0, 0xFFFFF0)), 0);
+        lv_obj_set_style_border_width(child, BORDER_WIDTH, 0);
+        lv_obj_set_style_border_color(child, lv_color_hex(rnd_next(0, 0xFFFFF0)), 0);
+        lv_obj_set_size(child, lv_pct(50), lv_pct(50));
+        lv_obj_center(child);
+
+        if(rotate) {
+            lv_obj_update_layout(obj);
+            lv_obj_set_style_transform_pivot_x(obj, lv_obj_get_width(obj) / 2, 0);
+            lv_obj_set_style_transform_pivot_y(obj, lv_obj_get_height(obj) / 2, 0);
+            lv_obj_set_style_transform_angle(obj, rnd_next(0, 3599), 0);
+        }
+
+        fall_anim(obj);
+    }
+}
+
+/*Semi-transparent objects with a semi-transparent child layer holding an ARGB image and a text.
+ *The image and the letters are blended onto the ARGB child layer, which is blended onto the ARGB parent layer.*/
+static void layer_argb_create(lv_style_t * style)
+{
+    uint32_t i;
+    for(i = 0; i < OBJ_NUM; i++) {
+        lv_obj_t * obj = lv_obj_create(scene_bg);
+        lv_obj_remove_style_all(obj);
+        lv_obj_add_style(obj, style, 0);
+        lv_obj_set_style_bg_color(obj, lv_color_hex(rnd_next(0, 0xFFFFF0)), 0);
+        lv_obj_set_size(obj, rnd_next(OBJ_SIZE_MAX / 4, OBJ_SIZE_MAX / 2), rnd_next(OBJ_SIZE_MAX / 4, OBJ_SIZE_MAX / 2));
+
+        lv_obj_t * child = lv_obj_create(obj);
+        lv_obj_remove_style_all(child);
+        lv_obj_set_style_opa(child, LV_OPA_80, 0);
+        lv_obj_set_style_radius(child, RADIUS, 0);
+        lv_obj_set_style_border_width(child, BORDER_WIDTH, 0);
+        lv_obj_set_style_border_color(child, lv_color_hex(rnd_next(0, 0xFFFFF0)), 0);
+        lv_obj_set_size(child, lv_pct(80), lv_pct(80));
+        lv_obj_center(child);
+
+        lv_obj_t * img = lv_img_create(child);
+#if LV_DEMO_BENCHMARK_RGB565A8 && LV_COLOR_DEPTH == 16
+        lv_img_set_src(img, &img_benchmark_cogwheel_rgb565a8);
+#else
+        lv_img_set_src(img, &img_benchmark_cogwheel_argb);
+#endif
+        lv_obj_center(img);
+
+        lv_obj_t * label = lv_label_create(child);
+        lv_label_set_text(label, "ARGB layer");
+        lv_obj_align(label, LV_ALIGN_BOTTOM_MID, 0, 0);
+
+        fall_anim(obj);
+    }
+}
+
+/*A static card with many labels and some rectangles moving on it.
+ *With `cache == true` the card is rendered only once into a cached layer
+ *(needs `LV_OBJ_LAYER_CACHE_SIZE > 0`)*/
+static void static_card_create(bool cache)
+{
+    lv_obj_t * card = lv_obj_create(scene_bg);
+    lv_obj_set_size(card, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(card, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_clear_flag(card, LV_OBJ_FLAG_SCROLLABLE);
+    if(cache) lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_LAYER);
+
+    uint32_t i;
+    for(i = 0; i < 40; i++) {
+        lv_obj_t * label = lv_label_create(card);
+        lv_label_set_text_fmt(label, LV_SYMBOL_SETTINGS " Setting %"LV_PRIu32, i);
+    }
+
+    lv_style_reset(&style_common);
+    lv_style_set_bg_opa(&style_common, scene_with_opa ? LV_OPA_50 : LV_OPA_COVER);
+    lv_style_set_radius(&style_common, RADIUS);
+    rect_create(&style_common);
+}
 
 static void fall_anim_y_cb(void * var, int32_t v)
 {
@@ -1293,6 +2054,109 @@ static void fall_anim(lv_obj_t * obj)
 
 }
 
+/*Load a font and draw a screen of text with it. Log the time and the used memory.*/
+static void font_load_measure(const char * path, bool lazy, uint32_t cache_size)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    uint32_t used_start = mon.total_size - mon.free_size;
+
+    /*Load it a few times to get a measurable time*/
+    lv_font_t * font = NULL;
+    uint32_t t = lv_tick_get();
+    uint32_t i;
+    for(i = 0; i < FONT_LOAD_REPEAT; i++) {
+        if(font) lv_font_free(font);
+        font = lazy ? lv_font_load_lazy(path, cache_size) : lv_font_load(path);
+        if(font == NULL) {
+            LV_LOG_WARN("Couldn't load %s", path);
+            return;
+        }
+    }
+    uint32_t load_time = lv_tick_elaps(t);
+
+    lv_mem_monitor(&mon);
+    uint32_t used_loaded = mon.total_size - mon.free_size - used_start;
+
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, lv_pct(100));
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_label_set_text(label, TXT_DENSE);
+    lv_obj_update_layout(label);
+    while(lv_obj_get_height(label) < lv_obj_get_height(lv_scr_act())) {
+        lv_label_ins_text(label, LV_LABEL_POS_LAST, " " TXT_DENSE);
+        lv_obj_update_layout(label);
+    }
+
+    t = lv_tick_get();
+    lv_refr_now(NULL);
+    uint32_t render_time = lv_tick_elaps(t);
+
+    lv_mem_monitor(&mon);
+    uint32_t used_rendered = mon.total_size - mon.free_size - used_start;
+
+    lv_obj_del(label);
+    lv_font_free(font);
+
+    LV_LOG("%s loading of \"%s\": %" LV_PRIu32 " ms, render: %" LV_PRIu32 " ms, "
+           "RAM after loading: %" LV_PRIu32 " bytes, after rendering: %" LV_PRIu32 " bytes\n",
+           lazy ? "Lazy" : "Eager", path, load_time / FONT_LOAD_REPEAT, render_time, used_loaded, used_rendered);
+}
+
+static uint32_t transp_clear_measure(lv_disp_t * disp, lv_obj_t * obj, bool full_band)
+{
+    lv_draw_ctx_t * draw_ctx = disp->draw_ctx;
+    void (*buffer_clear_ori)(lv_draw_ctx_t *) = draw_ctx->buffer_clear;
+    init_buf_ori = draw_ctx->init_buf;
+
+    /*Emulate the earlier behavior: clear the whole band in every refresh, even if it's covered*/
+    if(full_band) {
+        draw_ctx->init_buf = transp_init_buf_full_band;
+        draw_ctx->buffer_clear = NULL;
+    }
+
+    lv_coord_t max_x = lv_disp_get_hor_res(disp) - TRANSP_CLEAR_AREA_SIZE;
+    lv_coord_t max_y = lv_disp_get_ver_res(disp) - TRANSP_CLEAR_AREA_SIZE;
+    rnd_reset();
+    uint32_t t = lv_tick_get();
+    uint32_t i;
+    for(i = 0; i < TRANSP_CLEAR_REFR_CNT; i++) {
+        lv_area_t a;
+        a.x1 = rnd_next(0, LV_MAX(max_x, 0));
+        a.y1 = rnd_next(0, LV_MAX(max_y, 0));
+        a.x2 = a.x1 + TRANSP_CLEAR_AREA_SIZE - 1;
+        a.y2 = a.y1 + TRANSP_CLEAR_AREA_SIZE - 1;
+        lv_obj_invalidate_area(obj, &a);
+        lv_refr_now(disp);
+    }
+    uint32_t time = lv_tick_elaps(t);
+
+    draw_ctx->init_buf = init_buf_ori;
+    draw_ctx->buffer_clear = buffer_clear_ori;
+
+    return time;
+}
+
+static void transp_flush_cb(lv_disp_t * disp, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(disp);
+}
+
+static void transp_init_buf_full_band(lv_draw_ctx_t * draw_ctx)
+{
+    if(init_buf_ori) init_buf_ori(draw_ctx);
+    lv_memzero(draw_ctx->buf, lv_area_get_size(draw_ctx->buf_area) * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE);
+}
+
+static void rotation_flush_cb(lv_disp_t * disp, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(color_p);
+    lv_disp_flush_ready(disp);
+}
+
 static void rnd_reset(void)
 {
     rnd_act = 0;
@@ -46,6 +46,33 @@ typedef enum {
 void lv_demo_benchmark(lv_demo_benchmark_mode_t mode);
 void lv_demo_benchmark_run_scene(lv_demo_benchmark_mode_t mode, uint16_t scene_no);
 
+/**
+ * Load a binary font with `lv_font_load()` and `lv_font_load_lazy()` and draw a screen of text with it.
+ * The load and render times and the memory used after loading and after rendering are logged.
+ * @param path          path of the font file
+ * @param cache_size    glyph cache size of the lazily loaded font in bytes
+ */
+void lv_demo_benchmark_font_load(const char * path, uint32_t cache_size);
+
+/**
+ * Create a display with `LV_COLOR_FORMAT_NATIVE_ALPHA` and refresh small areas of it.
+ * The time of clearing the whole band in each refresh and clearing only the clip area are logged,
+ * once on a transparent screen and once on a screen covered by an opaque object.
+ * @param hor_res       horizontal resolution of the display
+ * @param ver_res       vertical resolution of the display
+ * @param render_mode   `LV_DISP_RENDER_MODE_PARTIAL` or `LV_DISP_RENDER_MODE_FULL`
+ */
+void lv_demo_benchmark_transp_clear(lv_coord_t hor_res, lv_coord_t ver_res, lv_disp_render_mode_t render_mode);
+
+/**
+ * Create a display with a full screen sized draw buffer and software rotation,
+ * and refresh the whole screen with 0, 90, 180 and 270 degrees rotation.
+ * The refresh time and the time of the rotation (compared to 0 degrees) are logged.
+ * @param hor_res       physical horizontal resolution of the display
+ * @param ver_res       physical vertical resolution of the display
+ */
+void lv_demo_benchmark_rotation(lv_coord_t hor_res, lv_coord_t ver_res);
+
 /**********************
  *      MACROS
  **********************/
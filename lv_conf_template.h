@@ -108,6 +108,17 @@
  *Required to draw shadow, rounded corners, circles, arc, skew lines, or any other masks*/
 #define LV_USE_DRAW_MASKS 1
 
+/*Keep the buffers of the destroyed layers (for `style_opa < 255`, transformations, etc)
+ *to reuse them for the next layers instead of allocating new ones.
+ *The software renderer takes the mask buffers of the letters from here too.
+ *It's the default budget of each display, see `lv_draw_layer_buf_pool_set_size()`. 0: to disable keeping buffers*/
+#define LV_DRAW_LAYER_BUF_POOL_SIZE 0     /*[bytes]*/
+
+/*Memory budget in bytes for the objects with `LV_OBJ_FLAG_CACHE_LAYER`.
+ *Such objects are rendered with their children into a layer only once,
+ *and it's blended again until something changes in them. 0: to disable caching*/
+#define LV_OBJ_LAYER_CACHE_SIZE 0
+
 #define LV_USE_DRAW_SW  1
 #if LV_USE_DRAW_SW
 
@@ -126,6 +137,11 @@
     /*Used if `LV_DRAW_SW_LAYER_SIMPLE_BUF_SIZE` couldn't be allocated.*/
     #define LV_DRAW_SW_LAYER_SIMPLE_FALLBACK_BUF_SIZE (3 * 1024)    /*[bytes]*/
 
+    /*Store the colors multiplied by the alpha in layers, ARGB draw buffers and decoded PNG images.
+     *Blending onto such buffers needs no division per pixel and premultiplied images can be blended directly.
+     *The buffers are converted back to straight alpha when flushed or transformed.*/
+    #define LV_DRAW_SW_PREMULTIPLIED_ALPHA 0
+
     /*Allow buffering some shadow calculation.
     *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
     *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
@@ -137,6 +153,12 @@
     * 0: to disable caching */
     #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
 
+    /*Allow buffering the coverage of some rings to draw arcs with the same radius and width faster.
+    * The rings are kept between the refreshes and the least used one is replaced by a new ring.
+    * A few hundred bytes are used per ring, e.g. ~1.5 kB for 50 px radius
+    * 0: to disable caching */
+    #define LV_DRAW_SW_ARC_CACHE_SIZE 4
+
     /*Default gradient buffer size.
      *When LVGL calculates the gradient "maps" it can save them into a cache to avoid calculating them again.
      *LV_DRAW_SW_GRADIENT_CACHE_DEF_SIZE sets the size of this cache in bytes.
@@ -146,7 +168,8 @@
 
     /*Allow dithering the gradients (to achieve visual smooth color gradients on limited color depth display)
      *LV_DRAW_SW_GRADIENT_DITHER implies allocating one or two more lines of the object's rendering surface
-     *The increase in memory consumption is (32 bits * object width) plus 24 bits * object width if using error diffusion */
+     *The increase in memory consumption is (32 bits * object width) plus 24 bits * object width if using error diffusion.
+     *The 8 rows of the ordered dithering pattern of horizontal gradients are also cached (8 * object width pixels)*/
     #define LV_DRAW_SW_GRADIENT_DITHER 0
     #if LV_DRAW_SW_GRADIENT_DITHER
         /*Add support for error diffusion dithering.
@@ -161,6 +184,19 @@
         /*Set the pixel order of the display. Physical order of RGB channels. Doesn't matter with "normal" fonts.*/
         #define LV_DRAW_SW_FONT_SUBPX_BGR 0  /*0: RGB; 1:BGR order*/
     #endif
+
+    /*Convert the 1, 2 and 4 bpp glyphs to opacity a byte at a time with lookup tables instead of pixel by pixel.
+     *Needs 3.5 kB RAM for the tables. They are created on first use.*/
+    #define LV_DRAW_SW_GLYPH_LUT 0
+
+    /*Cache the glyphs of the `lv_font_fmt_txt` fonts (built-in, converted and loaded fonts) converted to 8 bpp.
+     *It saves the conversion and the decompression of the compressed fonts when the same letters are drawn again.
+     *Size of the cache in bytes. 0: disable*/
+    #define LV_DRAW_SW_GLYPH_CACHE_SIZE 0
+
+    /*Use the vector extensions of GCC and Clang in some hot loops (e.g. image transformation).
+     *The same code is compiled to SSE2, NEON, etc. depending on the target. Requires GCC or Clang.*/
+    #define LV_USE_DRAW_SW_SIMD 0
 #endif
 
 /*Use SDL renderer API*/
@@ -300,7 +336,8 @@
 #define LV_USE_REFR_DEBUG 0
 
 /*Maximum buffer size to allocate for rotation.
- *Only used if software rotation is enabled in the display driver.*/
+ *Only used if software rotation is enabled in the display driver.
+ *The rotated areas are flushed in chunks of this size so a larger buffer means less flushes.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
 
 /*Garbage Collector settings
@@ -317,6 +354,15 @@
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE 0
 
+/*Memory budget in bytes to cache the result of image rotation and zooming.
+ *A static rotated or zoomed image needs to be transformed only once this way.
+ *0: to disable caching*/
+#define LV_IMG_TRANSFORM_CACHE_SIZE 0
+
+/*1: Draw the images zoomed out below 50% from downscaled copies (mipmaps).
+ *It's faster and less aliased. The mipmaps are stored in the transformed image cache,
+ *so LV_IMG_TRANSFORM_CACHE_SIZE needs to be > 0*/
+#define LV_USE_IMG_MIPMAP 0
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
@@ -420,6 +466,20 @@
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
 
+/*Map the letters to glyphs with lookup tables built on the first use of a font
+ *instead of searching in the character maps. Uses 512 bytes + ~12 bytes/glyph RAM per used font.
+ *Loaded fonts build the tables when they are created and free them in `lv_font_free()`.
+ *The tables of the other fonts are kept until `lv_deinit()`.*/
+#define LV_FONT_FMT_TXT_GLYPH_ID_LUT 0
+
+/*Cache the kerning values of this many glyph pairs (power of 2) per font to avoid
+ *searching in the kerning pairs again and again. Not used by class based kerning. 0: disable*/
+#define LV_FONT_FMT_TXT_KERN_CACHE_SIZE 0
+
+/*Convert the pair based kerning of the fonts loaded by `lv_font_load()` to class based kerning
+ *if the class matrix is not larger than this many bytes. The lookup is faster but might use more RAM. 0: disable*/
+#define LV_FONT_LOADER_KERN_CLASSES_MAX_SIZE 0
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
 
@@ -453,6 +513,14 @@
 /*The control character to use for signalling text recoloring.*/
 #define LV_TXT_COLOR_CMD "#"
 
+/*Number of text sizes to cache. Widgets measure the same texts again and again (e.g. table cells, labels).
+ *Needs ~40 bytes + LV_TXT_SIZE_CACHE_TXT_LEN of RAM per entry. 0: disable*/
+#define LV_TXT_SIZE_CACHE_CNT 0
+#if LV_TXT_SIZE_CACHE_CNT
+    /*Longest text (in bytes) to cache. The texts are stored to compare them when looked up.*/
+    #define LV_TXT_SIZE_CACHE_TXT_LEN 32
+#endif
+
 /*Support bidirectional texts. Allows mixing Left-to-Right and Right-to-Left texts.
  *The direction will be processed according to the Unicode Bidirectional Algorithm:
  *https://www.w3.org/International/articles/inline-bidi-markup/uba-basics*/
@@ -519,6 +587,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+    #define LV_LABEL_BIDI_CACHE 1     /*Store the bidi processed lines to not process them on every redraw (with LV_USE_BIDI)*/
 #endif
 
 #define LV_USE_LED        1
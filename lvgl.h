@@ -40,6 +40,7 @@ extern "C" {
 
 #include "src/font/lv_font.h"
 #include "src/font/lv_font_loader.h"
+#include "src/font/lv_font_atlas.h"
 #include "src/font/lv_font_fmt_txt.h"
 
 #include "src/widgets/animimg/lv_animimg.h"
@@ -86,6 +86,7 @@ lv_disp_t * lv_disp_create(lv_coord_t hor_res, lv_coord_t ver_res)
     disp->antialiasing     = LV_COLOR_DEPTH > 8 ? 1 : 0;
     disp->dpi              = LV_DPI_DEF;
     disp->color_chroma_key = LV_COLOR_CHROMA_KEY;
+    _lv_draw_layer_buf_pool_init(&disp->layer_buf_pool);
 
 #if LV_USE_GPU_STM32_DMA2D
     lv_disp_set_draw_ctx(disp, lv_draw_stm32_dma2d_ctx_init, lv_draw_stm32_dma2d_ctx_deinit,
@@ -187,6 +188,14 @@ void lv_disp_remove(lv_disp_t * disp)
         lv_obj_del(disp->screens[0]);
     }
 
+    _lv_draw_layer_buf_pool_deinit(&disp->layer_buf_pool);
+
+    if(disp->draw_ctx) {
+        if(disp->draw_ctx_deinit) disp->draw_ctx_deinit(disp, disp->draw_ctx);
+        lv_free(disp->draw_ctx);
+        disp->draw_ctx = NULL;
+    }
+
     _lv_ll_remove(&LV_GC_ROOT(_lv_disp_ll), disp);
     if(disp->refr_timer) lv_timer_del(disp->refr_timer);
     lv_free(disp);
@@ -413,6 +422,15 @@ void lv_disp_set_color_format(lv_disp_t * disp, lv_color_format_t color_format)
     if(disp == NULL) return;
 
     disp->color_format = color_format;
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_PREMULTIPLIED_ALPHA
+    /*Render premultiplied, the flush_cb gets straight alpha from `lv_draw_sw_buffer_convert`*/
+    if(color_format == LV_COLOR_FORMAT_NATIVE_ALPHA &&
+       disp->draw_ctx->buffer_convert == lv_draw_sw_buffer_convert) {
+        color_format = LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED;
+    }
+#endif
+
     disp->draw_ctx->color_format = color_format;
 }
 
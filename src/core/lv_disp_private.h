@@ -108,6 +108,9 @@ struct _lv_disp_t {
     void (*draw_ctx_deinit)(struct _lv_disp_t * disp, lv_draw_ctx_t * draw_ctx);
     size_t draw_ctx_size;
 
+    /** Buffers of the destroyed layers kept for the next layers*/
+    lv_draw_layer_buf_pool_t layer_buf_pool;
+
     /*---------------------
      * Screens
      *--------------------*/
@@ -17,6 +17,7 @@
 #include "../misc/lv_assert.h"
 #include "../draw/lv_draw.h"
 #include "../draw/lv_img_cache_builtin.h"
+#include "../draw/sw/lv_draw_sw.h"
 #include "../misc/lv_anim.h"
 #include "../misc/lv_timer.h"
 #include "../misc/lv_async.h"
@@ -24,6 +25,7 @@
 #include "../misc/lv_gc.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_log.h"
+#include "../font/lv_font_fmt_txt.h"
 #include "../libs/bmp/lv_bmp.h"
 #include "../libs/ffmpeg/lv_ffmpeg.h"
 #include "../libs/freetype/lv_freetype.h"
@@ -168,6 +170,10 @@ void lv_init(void)
 
     _lv_img_cache_builtin_init();
 
+    _lv_img_transform_cache_init();
+
+    _lv_obj_layer_cache_init();
+
     /*Test if the IDE has UTF-8 encoding*/
     const char * txt = "Á";
 
@@ -270,6 +276,16 @@ void lv_init(void)
 
 void lv_deinit(void)
 {
+#if LV_FONT_FMT_TXT_GLYPH_ID_LUT
+    _lv_font_glyph_id_lut_deinit_fmt_txt();
+#endif
+    lv_txt_size_cache_invalidate();
+    lv_img_transform_cache_invalidate_src(NULL);
+#if LV_USE_DRAW_SW
+    lv_draw_sw_glyph_cache_invalidate();
+    _lv_draw_sw_arc_cache_cleanup();
+#endif
+
     _lv_gc_clear_roots();
 
     lv_disp_set_default(NULL);
@@ -344,6 +360,8 @@ void lv_obj_clear_flag(lv_obj_t * obj, lv_obj_flag_t f)
 
     obj->flags &= (~f);
 
+    if(f & LV_OBJ_FLAG_CACHE_LAYER) _lv_obj_layer_cache_remove(obj);
+
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
         if(lv_obj_is_layout_positioned(obj)) {
@@ -531,6 +549,9 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     /*Remove the animations from this object*/
     lv_anim_del(obj, NULL);
 
+    /*Free the cached layer*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_LAYER)) _lv_obj_layer_cache_remove(obj);
+
     /*Delete from the group*/
     lv_group_t * group = lv_obj_get_group(obj);
     if(group) lv_group_remove_obj(obj);
@@ -117,6 +117,7 @@ typedef enum {
     LV_OBJ_FLAG_IGNORE_LAYOUT   = (1L << 17), /**< Make the object position-able by the layouts*/
     LV_OBJ_FLAG_FLOATING        = (1L << 18), /**< Do not scroll the object when the parent scrolls and ignore layout*/
     LV_OBJ_FLAG_OVERFLOW_VISIBLE = (1L << 19), /**< Do not clip the children's content to the parent's boundary*/
+    LV_OBJ_FLAG_CACHE_LAYER     = (1L << 20), /**< Render the object with its children into a layer once and reuse it until something changes inside*/
 
     LV_OBJ_FLAG_LAYOUT_1        = (1L << 23), /**< Custom flag, free to use by layouts*/
     LV_OBJ_FLAG_LAYOUT_2        = (1L << 24), /**< Custom flag, free to use by layouts*/
@@ -151,6 +152,7 @@ typedef enum {
 #include "lv_obj_scroll.h"
 #include "lv_obj_style.h"
 #include "lv_obj_draw.h"
+#include "lv_obj_layer_cache.h"
 #include "lv_obj_class.h"
 #include "lv_obj_event.h"
 #include "lv_group.h"
@@ -0,0 +1,193 @@
+/**
+ * @file lv_obj_layer_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj_layer_cache.h"
+#include "lv_obj.h"
+#include "lv_disp_private.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_gc.h"
+#include "../misc/lv_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static _lv_obj_layer_cache_entry_t * entry_find(const lv_obj_t * obj);
+static void entry_remove(_lv_obj_layer_cache_entry_t * entry);
+static void layer_destroy(lv_disp_t * disp, lv_draw_layer_ctx_t * layer_ctx);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t max_size;
+static uint32_t used_size;
+static uint32_t hit_cnt;
+static uint32_t miss_cnt;
+static uint32_t evict_cnt;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_obj_layer_cache_init(void)
+{
+    _lv_ll_init(&LV_GC_ROOT(_lv_obj_layer_cache_ll), sizeof(_lv_obj_layer_cache_entry_t));
+    max_size = LV_OBJ_LAYER_CACHE_SIZE;
+    used_size = 0;
+    hit_cnt = 0;
+    miss_cnt = 0;
+    evict_cnt = 0;
+}
+
+_lv_obj_layer_cache_entry_t * _lv_obj_layer_cache_get(lv_obj_t * obj, lv_disp_t * disp)
+{
+    _lv_obj_layer_cache_entry_t * entry = entry_find(obj);
+    if(entry && entry->valid && entry->disp == disp && _lv_area_is_equal(&entry->obj_coords, &obj->coords)) {
+        /*Keep the recently used entries at the head*/
+        lv_ll_t * ll = &LV_GC_ROOT(_lv_obj_layer_cache_ll);
+        _lv_ll_move_before(ll, entry, _lv_ll_get_head(ll));
+        hit_cnt++;
+        return entry;
+    }
+
+    if(entry) entry_remove(entry);
+    miss_cnt++;
+    return NULL;
+}
+
+bool _lv_obj_layer_cache_make_room(uint32_t size)
+{
+    if(size > max_size) return false;
+
+    /*Drop the outdated layers first, they wouldn't be used anyway*/
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_obj_layer_cache_ll);
+    _lv_obj_layer_cache_entry_t * entry = _lv_ll_get_tail(ll);
+    while(entry && used_size + size > max_size) {
+        _lv_obj_layer_cache_entry_t * entry_prev = _lv_ll_get_prev(ll, entry);
+        if(!entry->valid) entry_remove(entry);
+        entry = entry_prev;
+    }
+
+    while(used_size + size > max_size) {
+        entry_remove(_lv_ll_get_tail(ll));
+        evict_cnt++;
+    }
+
+    return true;
+}
+
+_lv_obj_layer_cache_entry_t * _lv_obj_layer_cache_add(lv_obj_t * obj, lv_disp_t * disp,
+                                                      lv_draw_layer_ctx_t * layer_ctx, lv_color_format_t color_format)
+{
+    _lv_obj_layer_cache_entry_t * entry = _lv_ll_ins_head(&LV_GC_ROOT(_lv_obj_layer_cache_ll));
+    LV_ASSERT_MALLOC(entry);
+    if(entry == NULL) {
+        layer_destroy(disp, layer_ctx);
+        return NULL;
+    }
+
+    entry->obj = obj;
+    entry->disp = disp;
+    entry->layer_ctx = layer_ctx;
+    entry->obj_coords = obj->coords;
+    entry->size = lv_area_get_size(&layer_ctx->area_full) * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+    entry->color_format = color_format;
+    entry->valid = 1;
+    used_size += entry->size;
+
+    return entry;
+}
+
+void _lv_obj_layer_cache_invalidate(const lv_obj_t * obj)
+{
+    if(_lv_ll_get_head(&LV_GC_ROOT(_lv_obj_layer_cache_ll)) == NULL) return;
+
+    /*It's called on every invalidation so access the fields directly to skip the asserts*/
+    while(obj) {
+        if(obj->flags & LV_OBJ_FLAG_CACHE_LAYER) {
+            _lv_obj_layer_cache_entry_t * entry = entry_find(obj);
+            if(entry) entry->valid = 0;
+        }
+        obj = obj->parent;
+    }
+}
+
+void _lv_obj_layer_cache_remove(const lv_obj_t * obj)
+{
+    _lv_obj_layer_cache_entry_t * entry = entry_find(obj);
+    if(entry) entry_remove(entry);
+}
+
+void lv_obj_layer_cache_set_size(uint32_t new_size)
+{
+    max_size = new_size;
+
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_obj_layer_cache_ll);
+    while(used_size > max_size) {
+        entry_remove(_lv_ll_get_tail(ll));
+        evict_cnt++;
+    }
+}
+
+void lv_obj_layer_cache_get_stats(lv_obj_layer_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    stats->hit_cnt = hit_cnt;
+    stats->miss_cnt = miss_cnt;
+    stats->evict_cnt = evict_cnt;
+    stats->entry_cnt = _lv_ll_get_len(&LV_GC_ROOT(_lv_obj_layer_cache_ll));
+    stats->used_size = used_size;
+    stats->max_size = max_size;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static _lv_obj_layer_cache_entry_t * entry_find(const lv_obj_t * obj)
+{
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_obj_layer_cache_ll);
+    _lv_obj_layer_cache_entry_t * entry;
+    _LV_LL_READ(ll, entry) {
+        if(entry->obj == obj) return entry;
+    }
+
+    return NULL;
+}
+
+static void entry_remove(_lv_obj_layer_cache_entry_t * entry)
+{
+    layer_destroy(entry->disp, entry->layer_ctx);
+
+    used_size -= entry->size;
+    _lv_ll_remove(&LV_GC_ROOT(_lv_obj_layer_cache_ll), entry);
+    lv_free(entry);
+}
+
+static void layer_destroy(lv_disp_t * disp, lv_draw_layer_ctx_t * layer_ctx)
+{
+    /*The layer might be destroyed while the display is being rendered,
+     *so make the restoring of the draw_ctx a no-op*/
+    lv_draw_ctx_t * draw_ctx = disp->draw_ctx;
+    layer_ctx->original.buf = draw_ctx->buf;
+    layer_ctx->original.buf_area = draw_ctx->buf_area;
+    layer_ctx->original.clip_area = draw_ctx->clip_area;
+    layer_ctx->original.color_format = draw_ctx->color_format;
+    lv_draw_layer_destroy(draw_ctx, layer_ctx);
+}
@@ -0,0 +1,124 @@
+/**
+ * @file lv_obj_layer_cache.h
+ *
+ */
+
+#ifndef LV_OBJ_LAYER_CACHE_H
+#define LV_OBJ_LAYER_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../misc/lv_area.h"
+#include "../misc/lv_color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_obj_t;
+struct _lv_disp_t;
+struct _lv_draw_layer_ctx_t;
+
+/**
+ * Objects with `LV_OBJ_FLAG_CACHE_LAYER` are rendered with their children into a layer
+ * which is kept and blended again in the next refreshes until something is invalidated in the subtree.
+ */
+typedef struct {
+    struct _lv_obj_t * obj;
+    struct _lv_disp_t * disp;                       /**< The display whose draw_ctx has created the layer*/
+    struct _lv_draw_layer_ctx_t * layer_ctx;        /**< The rendered layer*/
+    lv_area_t obj_coords;                           /**< Coordinates of the object when it was rendered*/
+    uint32_t size;                                  /**< Size of the layer's buffer in bytes*/
+    lv_color_format_t color_format;                 /**< Color format of the layer's buffer*/
+    uint8_t valid : 1;                              /**< 0: something has changed in the subtree*/
+} _lv_obj_layer_cache_entry_t;
+
+typedef struct {
+    uint32_t hit_cnt;           /**< Number of times a cached layer was used*/
+    uint32_t miss_cnt;          /**< Number of times the object had to be rendered again*/
+    uint32_t evict_cnt;         /**< Number of entries dropped to free space*/
+    uint32_t entry_cnt;         /**< Number of cached layers*/
+    uint32_t used_size;         /**< Memory used by the cached layers in bytes*/
+    uint32_t max_size;          /**< The memory budget in bytes*/
+} lv_obj_layer_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the layer cache with `LV_OBJ_LAYER_CACHE_SIZE` budget
+ */
+void _lv_obj_layer_cache_init(void);
+
+/**
+ * Get the cached layer of an object if it's still usable.
+ * Outdated layers (the subtree was invalidated or the object was moved) are dropped.
+ * @param obj       pointer to an object with `LV_OBJ_FLAG_CACHE_LAYER`
+ * @param disp      the display being refreshed
+ * @return          pointer to the entry or NULL if the object needs to be rendered
+ */
+_lv_obj_layer_cache_entry_t * _lv_obj_layer_cache_get(struct _lv_obj_t * obj, struct _lv_disp_t * disp);
+
+/**
+ * Drop the least recently used layers to have `size` bytes free for a new layer
+ * @param size      size of the new layer in bytes
+ * @return          true: there is enough space; false: the layer can't be cached
+ */
+bool _lv_obj_layer_cache_make_room(uint32_t size);
+
+/**
+ * Store the rendered layer of an object. The layer is destroyed on error.
+ * @param obj           pointer to the object
+ * @param disp          the display whose draw_ctx has created the layer
+ * @param layer_ctx     the layer with the rendered object
+ * @param color_format  color format of the layer's buffer
+ * @return              pointer to the new entry or NULL on error
+ */
+_lv_obj_layer_cache_entry_t * _lv_obj_layer_cache_add(struct _lv_obj_t * obj, struct _lv_disp_t * disp,
+                                                      struct _lv_draw_layer_ctx_t * layer_ctx, lv_color_format_t color_format);
+
+/**
+ * Mark the cached layer of an object and its parents as outdated.
+ * Called when an area of the object is invalidated.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_layer_cache_invalidate(const struct _lv_obj_t * obj);
+
+/**
+ * Free the cached layer of an object
+ * @param obj       pointer to an object
+ */
+void _lv_obj_layer_cache_remove(const struct _lv_obj_t * obj);
+
+/**
+ * Set the memory budget of the layer cache. The least recently used layers are dropped if needed.
+ * @param new_size  the new budget in bytes. 0: disable caching
+ */
+void lv_obj_layer_cache_set_size(uint32_t new_size);
+
+/**
+ * Get the statistics of the layer cache
+ * @param stats     store the statistics here
+ */
+void lv_obj_layer_cache_get_stats(lv_obj_layer_cache_stats_t * stats);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_LAYER_CACHE_H*/
@@ -819,6 +819,9 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*Something has changed so the cached layers of the parents are outdated*/
+    _lv_obj_layer_cache_invalidate(obj);
+
     lv_disp_t * disp   = lv_obj_get_disp(obj);
     if(!lv_disp_is_invalidation_enabled(disp)) return;
 
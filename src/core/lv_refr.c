@@ -16,11 +16,21 @@
 #include "../misc/lv_gc.h"
 #include "../misc/lv_profiler.h"
 #include "../draw/lv_draw.h"
+#include "../draw/sw/lv_draw_sw_simd.h"
 #include "../font/lv_font_fmt_txt.h"
 
 /*********************
  *      DEFINES
  *********************/
+/*Rotate the draw_buf in blocks of this many pixels per side so the source and destination lines stay in the cache*/
+#define ROTATE_BLOCK    32
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_SIMD && (LV_COLOR_DEPTH == 16 || LV_COLOR_DEPTH == 32)
+    #define ROTATE_SIMD     1
+    #define ROTATE_TILE     ((lv_coord_t)(16 / sizeof(lv_color_t)))  /*Pixels in a vector: 4x4 or 8x8 tiles*/
+#else
+    #define ROTATE_SIMD     0
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -514,11 +524,6 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
 
     if(draw_ctx->init_buf) draw_ctx->init_buf(draw_ctx);
 
-    /*If the screen is transparent initialize it when the flushing is ready*/
-    if(lv_color_format_has_alpha(disp_refr->color_format)) {
-        if(draw_ctx->buffer_clear) draw_ctx->buffer_clear(draw_ctx);
-    }
-
     lv_obj_t * top_act_scr = NULL;
     lv_obj_t * top_prev_scr = NULL;
 
@@ -528,6 +533,12 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
         top_prev_scr = lv_refr_get_top_obj(draw_ctx->buf_area, disp_refr->prev_scr);
     }
 
+    /*If the screen is transparent initialize it when the flushing is ready.
+     *Not required if an opaque object covers the whole area anyway.*/
+    if(lv_color_format_has_alpha(disp_refr->color_format) && top_act_scr == NULL && top_prev_scr == NULL) {
+        if(draw_ctx->buffer_clear) draw_ctx->buffer_clear(draw_ctx);
+    }
+
     /*Draw a bottom layer background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
         refr_obj_and_children(draw_ctx, lv_disp_get_layer_bottom(disp_refr));
@@ -582,6 +593,9 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
     lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
     if(info.res == LV_COVER_RES_MASKED) return NULL;
 
+    /*Draw the cached objects as a whole*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_LAYER)) return info.res == LV_COVER_RES_COVER ? obj : NULL;
+
     int32_t i;
     int32_t child_cnt = lv_obj_get_child_cnt(obj);
     for(i = child_cnt - 1; i >= 0; i--) {
@@ -728,10 +742,103 @@ static void layer_alpha_test(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx, lv_draw_l
 }
 
 
+/**
+ * Initialize the descriptor to blend the layer of an object
+ */
+static void layer_draw_dsc_init(lv_obj_t * obj, lv_opa_t opa, lv_draw_img_dsc_t * draw_dsc, lv_point_t * pivot)
+{
+    pivot->x = lv_obj_get_style_transform_pivot_x(obj, 0);
+    pivot->y = lv_obj_get_style_transform_pivot_y(obj, 0);
+
+    if(LV_COORD_IS_PCT(pivot->x)) {
+        pivot->x = (LV_COORD_GET_PCT(pivot->x) * lv_area_get_width(&obj->coords)) / 100;
+    }
+    if(LV_COORD_IS_PCT(pivot->y)) {
+        pivot->y = (LV_COORD_GET_PCT(pivot->y) * lv_area_get_height(&obj->coords)) / 100;
+    }
+
+    lv_draw_img_dsc_init(draw_dsc);
+    draw_dsc->opa = opa;
+    draw_dsc->angle = lv_obj_get_style_transform_angle(obj, 0);
+    if(draw_dsc->angle > 3600) draw_dsc->angle -= 3600;
+    else if(draw_dsc->angle < 0) draw_dsc->angle += 3600;
+
+    draw_dsc->zoom = lv_obj_get_style_transform_zoom_safe(obj, 0);
+    draw_dsc->blend_mode = lv_obj_get_style_blend_mode(obj, 0);
+    draw_dsc->antialias = disp_refr->antialiasing;
+}
+
+/**
+ * Draw an object with `LV_OBJ_FLAG_CACHE_LAYER` from its cached layer.
+ * If there is no valid cached layer render the object and its children into a new one first.
+ * @return  true: the object is drawn; false: it couldn't be cached, draw it normally
+ */
+static bool refr_obj_cached(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+    lv_opa_t opa = lv_obj_get_style_opa(obj, 0);
+    if(opa < LV_OPA_MIN) return true;
+
+    _lv_obj_layer_cache_entry_t * entry = _lv_obj_layer_cache_get(obj, disp_refr);
+    lv_draw_layer_ctx_t * layer_ctx;
+    if(entry) {
+        layer_ctx = entry->layer_ctx;
+
+        /*Prepare the draw_ctx as if the layer was just rendered*/
+        layer_ctx->original.buf = draw_ctx->buf;
+        layer_ctx->original.buf_area = draw_ctx->buf_area;
+        layer_ctx->original.clip_area = draw_ctx->clip_area;
+        layer_ctx->original.color_format = draw_ctx->color_format;
+        draw_ctx->buf = layer_ctx->buf;
+        draw_ctx->buf_area = &layer_ctx->area_act;
+        draw_ctx->clip_area = &layer_ctx->area_act;
+        draw_ctx->color_format = entry->color_format;
+    }
+    else {
+        /*Render the whole object, not only the invalidated area, to use it later for any area.
+         *Transformed objects can be rotated into the screen from outside, so cache them fully.*/
+        lv_area_t layer_area;
+        lv_coord_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+        lv_obj_get_coords(obj, &layer_area);
+        lv_area_increase(&layer_area, ext_draw_size, ext_draw_size);
+        if(_lv_obj_get_layer_type(obj) != LV_LAYER_TYPE_TRANSFORM) {
+            lv_area_t disp_area;
+            lv_area_set(&disp_area, 0, 0, lv_disp_get_hor_res(disp_refr) - 1, lv_disp_get_ver_res(disp_refr) - 1);
+            if(!_lv_area_intersect(&layer_area, &layer_area, &disp_area)) return true;
+        }
+
+        if(!_lv_obj_layer_cache_make_room(lv_area_get_size(&layer_area) * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE)) return false;
+
+        layer_ctx = lv_draw_layer_create(draw_ctx, &layer_area, LV_DRAW_LAYER_FLAG_HAS_ALPHA);
+        if(layer_ctx == NULL) return false;
+
+        lv_obj_redraw(draw_ctx, obj);
+        lv_draw_wait_for_finish(draw_ctx);
+
+        entry = _lv_obj_layer_cache_add(obj, disp_refr, layer_ctx, draw_ctx->color_format);
+        if(entry == NULL) {
+            LV_LOG_WARN("Couldn't cache the layer");
+            return false;
+        }
+    }
+
+    lv_point_t pivot;
+    lv_draw_img_dsc_t draw_dsc;
+    layer_draw_dsc_init(obj, opa, &draw_dsc, &pivot);
+    draw_dsc.pivot.x = obj->coords.x1 + pivot.x - layer_ctx->area_act.x1;
+    draw_dsc.pivot.y = obj->coords.y1 + pivot.y - layer_ctx->area_act.y1;
+
+    /*It restores the original draw_ctx*/
+    lv_draw_layer_blend(draw_ctx, layer_ctx, &draw_dsc);
+
+    return true;
+}
+
 void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 {
     /*Do not refresh hidden objects*/
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_LAYER) && refr_obj_cached(draw_ctx, obj)) return;
+
     lv_layer_type_t layer_type = _lv_obj_get_layer_type(obj);
     if(layer_type == LV_LAYER_TYPE_NONE) {
         lv_obj_redraw(draw_ctx, obj);
@@ -761,28 +868,10 @@ void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
             LV_LOG_WARN("Couldn't create a new layer context");
             return;
         }
-        lv_point_t pivot = {
-            .x = lv_obj_get_style_transform_pivot_x(obj, 0),
-            .y = lv_obj_get_style_transform_pivot_y(obj, 0)
-        };
-
-        if(LV_COORD_IS_PCT(pivot.x)) {
-            pivot.x = (LV_COORD_GET_PCT(pivot.x) * lv_area_get_width(&obj->coords)) / 100;
-        }
-        if(LV_COORD_IS_PCT(pivot.y)) {
-            pivot.y = (LV_COORD_GET_PCT(pivot.y) * lv_area_get_height(&obj->coords)) / 100;
-        }
 
+        lv_point_t pivot;
         lv_draw_img_dsc_t draw_dsc;
-        lv_draw_img_dsc_init(&draw_dsc);
-        draw_dsc.opa = opa;
-        draw_dsc.angle = lv_obj_get_style_transform_angle(obj, 0);
-        if(draw_dsc.angle > 3600) draw_dsc.angle -= 3600;
-        else if(draw_dsc.angle < 0) draw_dsc.angle += 3600;
-
-        draw_dsc.zoom = lv_obj_get_style_transform_zoom_safe(obj, 0);
-        draw_dsc.blend_mode = lv_obj_get_style_blend_mode(obj, 0);
-        draw_dsc.antialias = disp_refr->antialiasing;
+        layer_draw_dsc_init(obj, opa, &draw_dsc, &pivot);
 
         if(flags & LV_DRAW_LAYER_FLAG_CAN_SUBDIVIDE) {
             layer_ctx->area_act = layer_ctx->area_full;
@@ -852,21 +941,137 @@ static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area
     return max_row;
 }
 
+#if ROTATE_SIMD
+/**
+ * Transpose a ROTATE_TILE x ROTATE_TILE tile: `dst[x * dst_stride + y] = src[y * src_stride + x]`
+ */
+static inline void rotate_tile(const lv_color_t * src, int32_t src_stride, lv_color_t * dst, int32_t dst_stride)
+{
+#if LV_COLOR_DEPTH == 32
+    lv_simd_u32_t r0 = lv_simd_load_u32(src);
+    lv_simd_u32_t r1 = lv_simd_load_u32(src + src_stride);
+    lv_simd_u32_t r2 = lv_simd_load_u32(src + 2 * src_stride);
+    lv_simd_u32_t r3 = lv_simd_load_u32(src + 3 * src_stride);
+
+    /*a0 b0 a1 b1, a2 b2 a3 b3, c0 d0 c1 d1, c2 d2 c3 d3*/
+    lv_simd_u32_t t0 = LV_SIMD_SHUFFLE(lv_simd_u32_t, r0, r1, 0, 4, 1, 5);
+    lv_simd_u32_t t1 = LV_SIMD_SHUFFLE(lv_simd_u32_t, r0, r1, 2, 6, 3, 7);
+    lv_simd_u32_t t2 = LV_SIMD_SHUFFLE(lv_simd_u32_t, r2, r3, 0, 4, 1, 5);
+    lv_simd_u32_t t3 = LV_SIMD_SHUFFLE(lv_simd_u32_t, r2, r3, 2, 6, 3, 7);
+
+    lv_simd_store_u32(dst, LV_SIMD_SHUFFLE(lv_simd_u32_t, t0, t2, 0, 1, 4, 5));
+    lv_simd_store_u32(dst + dst_stride, LV_SIMD_SHUFFLE(lv_simd_u32_t, t0, t2, 2, 3, 6, 7));
+    lv_simd_store_u32(dst + 2 * dst_stride, LV_SIMD_SHUFFLE(lv_simd_u32_t, t1, t3, 0, 1, 4, 5));
+    lv_simd_store_u32(dst + 3 * dst_stride, LV_SIMD_SHUFFLE(lv_simd_u32_t, t1, t3, 2, 3, 6, 7));
+#else
+    lv_simd_u16_t r[8];
+    lv_simd_u16_t t[8];
+    lv_simd_u32_t u[8];
+    int32_t i;
+    for(i = 0; i < 8; i++) r[i] = (lv_simd_u16_t)lv_simd_load_u32(src + i * src_stride);
+
+    /*Interleave the pixels of row pairs: a0 b0 a1 b1 ... a3 b3 and a4 b4 ... a7 b7*/
+    for(i = 0; i < 4; i++) {
+        t[2 * i] = LV_SIMD_SHUFFLE(lv_simd_u16_t, r[2 * i], r[2 * i + 1], 0, 8, 1, 9, 2, 10, 3, 11);
+        t[2 * i + 1] = LV_SIMD_SHUFFLE(lv_simd_u16_t, r[2 * i], r[2 * i + 1], 4, 12, 5, 13, 6, 14, 7, 15);
+    }
+
+    /*Interleave the pixel pairs: a0 b0 c0 d0 a1 b1 c1 d1, ...*/
+    for(i = 0; i < 2; i++) {
+        lv_simd_u32_t * u_act = &u[4 * i];
+        lv_simd_u32_t lo1 = (lv_simd_u32_t)t[4 * i];
+        lv_simd_u32_t hi1 = (lv_simd_u32_t)t[4 * i + 1];
+        lv_simd_u32_t lo2 = (lv_simd_u32_t)t[4 * i + 2];
+        lv_simd_u32_t hi2 = (lv_simd_u32_t)t[4 * i + 3];
+        u_act[0] = LV_SIMD_SHUFFLE(lv_simd_u32_t, lo1, lo2, 0, 4, 1, 5);
+        u_act[1] = LV_SIMD_SHUFFLE(lv_simd_u32_t, lo1, lo2, 2, 6, 3, 7);
+        u_act[2] = LV_SIMD_SHUFFLE(lv_simd_u32_t, hi1, hi2, 0, 4, 1, 5);
+        u_act[3] = LV_SIMD_SHUFFLE(lv_simd_u32_t, hi1, hi2, 2, 6, 3, 7);
+    }
+
+    /*Join the upper and lower 4 rows into the columns*/
+    for(i = 0; i < 4; i++) {
+        lv_simd_u64_t top = (lv_simd_u64_t)u[i];
+        lv_simd_u64_t bottom = (lv_simd_u64_t)u[i + 4];
+        lv_simd_store_u32(dst + (2 * i) * dst_stride, (lv_simd_u32_t)LV_SIMD_SHUFFLE(lv_simd_u64_t, top, bottom, 0, 2));
+        lv_simd_store_u32(dst + (2 * i + 1) * dst_stride, (lv_simd_u32_t)LV_SIMD_SHUFFLE(lv_simd_u64_t, top, bottom, 1, 3));
+    }
+#endif
+}
+#endif /*ROTATE_SIMD*/
+
+/**
+ * Transpose a block of pixels: `dst[x * dst_stride + y] = src[y * src_stride + x]`.
+ * The strides can be negative to mirror the source or destination.
+ */
+static LV_ATTRIBUTE_FAST_MEM void rotate_block(const lv_color_t * src, int32_t src_stride,
+                                               lv_color_t * dst, int32_t dst_stride, lv_coord_t w, lv_coord_t h)
+{
+    lv_coord_t x_start = 0;
+#if ROTATE_SIMD
+    lv_coord_t w_tile = w - w % ROTATE_TILE;
+    lv_coord_t h_tile = h - h % ROTATE_TILE;
+    lv_coord_t x, y;
+    for(y = 0; y < h_tile; y += ROTATE_TILE) {
+        for(x = 0; x < w_tile; x += ROTATE_TILE) {
+            rotate_tile(src + y * src_stride + x, src_stride, dst + x * dst_stride + y, dst_stride);
+        }
+    }
+
+    /*Handle the remaining bottom rows below the tiles, the right columns are handled below*/
+    for(x = 0; x < w_tile; x++) {
+        const lv_color_t * src_col = src + x;
+        lv_color_t * dst_row = dst + x * dst_stride;
+        for(y = h_tile; y < h; y++) dst_row[y] = src_col[y * src_stride];
+    }
+    x_start = w_tile;
+#endif
+
+    lv_coord_t i, j;
+    for(i = x_start; i < w; i++) {
+        const lv_color_t * src_col = src + i;
+        lv_color_t * dst_row = dst + i * dst_stride;
+        for(j = 0; j < h; j++) dst_row[j] = src_col[j * src_stride];
+    }
+}
+
 static void draw_buf_rotate_180(lv_disp_t * disp, lv_area_t * area, lv_color_t * color_p)
 {
     lv_coord_t area_w = lv_area_get_width(area);
     lv_coord_t area_h = lv_area_get_height(area);
     uint32_t total = area_w * area_h;
     /*Swap the beginning and end values*/
+    lv_color_t * head = color_p;
+    lv_color_t * tail = color_p + total;
+#if ROTATE_SIMD
+    /*Swap and mirror whole vectors while they don't overlap*/
+    while(tail - head >= 2 * ROTATE_TILE) {
+        tail -= ROTATE_TILE;
+        lv_simd_u32_t h_v = lv_simd_load_u32(head);
+        lv_simd_u32_t t_v = lv_simd_load_u32(tail);
+#if LV_COLOR_DEPTH == 32
+        h_v = LV_SIMD_SHUFFLE(lv_simd_u32_t, h_v, h_v, 3, 2, 1, 0);
+        t_v = LV_SIMD_SHUFFLE(lv_simd_u32_t, t_v, t_v, 3, 2, 1, 0);
+#else
+        lv_simd_u16_t h_v16 = (lv_simd_u16_t)h_v;
+        lv_simd_u16_t t_v16 = (lv_simd_u16_t)t_v;
+        h_v = (lv_simd_u32_t)LV_SIMD_SHUFFLE(lv_simd_u16_t, h_v16, h_v16, 7, 6, 5, 4, 3, 2, 1, 0);
+        t_v = (lv_simd_u32_t)LV_SIMD_SHUFFLE(lv_simd_u16_t, t_v16, t_v16, 7, 6, 5, 4, 3, 2, 1, 0);
+#endif
+        lv_simd_store_u32(head, t_v);
+        lv_simd_store_u32(tail, h_v);
+        head += ROTATE_TILE;
+    }
+#endif
     lv_color_t tmp;
-    uint32_t i = total - 1, j = 0;
-    while(i > j) {
-        tmp = color_p[i];
-        color_p[i] = color_p[j];
-        color_p[j] = tmp;
-        i--;
-        j++;
+    while(tail - head > 1) {
+        tail--;
+        tmp = *head;
+        *head = *tail;
+        *tail = tmp;
+        head++;
     }
+
     lv_coord_t tmp_coord;
     tmp_coord = area->y2;
     area->y2 = disp->ver_res - area->y1 - 1;
@@ -879,19 +1084,22 @@ static void draw_buf_rotate_180(lv_disp_t * disp, lv_area_t * area, lv_color_t *
 static LV_ATTRIBUTE_FAST_MEM void draw_buf_rotate_90(bool invert_i, lv_coord_t area_w, lv_coord_t area_h,
                                                      lv_color_t * orig_color_p, lv_color_t * rot_buf)
 {
-
-    uint32_t invert = (area_w * area_h) - 1;
-    uint32_t initial_i = ((area_w - 1) * area_h);
-    for(lv_coord_t y = 0; y < area_h; y++) {
-        uint32_t i = initial_i + y;
-        if(invert_i)
-            i = invert - i;
-        for(lv_coord_t x = 0; x < area_w; x++) {
-            rot_buf[i] = *(orig_color_p++);
-            if(invert_i)
-                i += area_h;
-            else
-                i -= area_h;
+    /*Go block by block so the read and written lines are still in the cache when they are used again*/
+    lv_coord_t x, y;
+    for(y = 0; y < area_h; y += ROTATE_BLOCK) {
+        lv_coord_t block_h = LV_MIN(ROTATE_BLOCK, area_h - y);
+        for(x = 0; x < area_w; x += ROTATE_BLOCK) {
+            lv_coord_t block_w = LV_MIN(ROTATE_BLOCK, area_w - x);
+            if(invert_i) {
+                /*270: rot_buf[x * h + h - 1 - y] = orig[y * w + x], i.e. read the rows upward*/
+                rotate_block(orig_color_p + (y + block_h - 1) * area_w + x, -area_w,
+                             rot_buf + x * area_h + area_h - block_h - y, area_h, block_w, block_h);
+            }
+            else {
+                /*90: rot_buf[(w - 1 - x) * h + y] = orig[y * w + x], i.e. write the rows upward*/
+                rotate_block(orig_color_p + y * area_w + x, area_w,
+                             rot_buf + (area_w - 1 - x) * area_h + y, -area_h, block_w, block_h);
+            }
         }
     }
 }
@@ -911,31 +1119,39 @@ static inline void draw_buf_rotate4(lv_color_t * a, lv_color_t * b, lv_color_t *
 
 /**
  * Rotate a square image 90/270 degrees in place.
+ * The 4-cycles are visited in blocks to keep the 4 touched regions in the cache.
  * @note inspired by https://stackoverflow.com/a/43694906
  */
 static void draw_buf_rotate_90_sqr(bool is_270, lv_coord_t w, lv_color_t * color_p)
 {
-    for(lv_coord_t i = 0; i < w / 2; i++) {
-        for(lv_coord_t j = 0; j < (w + 1) / 2; j++) {
-            lv_coord_t inv_i = (w - 1) - i;
-            lv_coord_t inv_j = (w - 1) - j;
-            if(is_270) {
-                draw_buf_rotate4(
-                    &color_p[i * w + j],
-                    &color_p[inv_j * w + i],
-                    &color_p[inv_i * w + inv_j],
-                    &color_p[j * w + inv_i]
-                );
-            }
-            else {
-                draw_buf_rotate4(
-                    &color_p[i * w + j],
-                    &color_p[j * w + inv_i],
-                    &color_p[inv_i * w + inv_j],
-                    &color_p[inv_j * w + i]
-                );
+    lv_coord_t i_end = w / 2;
+    lv_coord_t j_end = (w + 1) / 2;
+    for(lv_coord_t i_block = 0; i_block < i_end; i_block += ROTATE_BLOCK) {
+        lv_coord_t i_block_end = LV_MIN(i_block + ROTATE_BLOCK, i_end);
+        for(lv_coord_t j_block = 0; j_block < j_end; j_block += ROTATE_BLOCK) {
+            lv_coord_t j_block_end = LV_MIN(j_block + ROTATE_BLOCK, j_end);
+            for(lv_coord_t i = i_block; i < i_block_end; i++) {
+                lv_coord_t inv_i = (w - 1) - i;
+                for(lv_coord_t j = j_block; j < j_block_end; j++) {
+                    lv_coord_t inv_j = (w - 1) - j;
+                    if(is_270) {
+                        draw_buf_rotate4(
+                            &color_p[i * w + j],
+                            &color_p[inv_j * w + i],
+                            &color_p[inv_i * w + inv_j],
+                            &color_p[j * w + inv_i]
+                        );
+                    }
+                    else {
+                        draw_buf_rotate4(
+                            &color_p[i * w + j],
+                            &color_p[j * w + inv_i],
+                            &color_p[inv_i * w + inv_j],
+                            &color_p[inv_j * w + i]
+                        );
+                    }
+                }
             }
-
         }
     }
 }
@@ -960,6 +1176,10 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
         lv_coord_t area_h = lv_area_get_height(area);
         /*Determine the maximum number of rows that can be rotated at a time*/
         lv_coord_t max_row = LV_MIN((lv_coord_t)((LV_DISP_ROT_MAX_BUF / sizeof(lv_color_t)) / area_w), area_h);
+#if ROTATE_SIMD
+        /*Rotate only whole tiles in the chunks if possible*/
+        if(max_row < area_h && max_row > ROTATE_TILE) max_row -= max_row % ROTATE_TILE;
+#endif
         lv_coord_t init_y_off;
         init_y_off = area->y1;
         if(disp_refr->rotation == LV_DISP_ROTATION_90) {
@@ -974,34 +1194,33 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
         /*Rotate the screen in chunks, flushing after each one*/
         lv_coord_t row = 0;
         while(row < area_h) {
-            lv_coord_t height = LV_MIN(max_row, area_h - row);
-            disp_refr->flushing = 1;
-            if((row == 0) && (area_h >= area_w)) {
-                /*Rotate the initial area as a square*/
+            lv_coord_t height;
+            lv_color_t * flush_p;
+            if(area_h - row >= area_w) {
+                /*Rotate square parts in place, no copy is required*/
                 height = area_w;
                 draw_buf_rotate_90_sqr(disp_refr->rotation == LV_DISP_ROTATION_270, area_w, color_p);
-                if(disp_refr->rotation == LV_DISP_ROTATION_90) {
-                    area->x1 = init_y_off;
-                    area->x2 = init_y_off + area_w - 1;
-                }
-                else {
-                    area->x2 = disp_refr->hor_res - 1 - init_y_off;
-                    area->x1 = area->x2 - area_w + 1;
-                }
+                flush_p = color_p;
             }
             else {
-                /*Rotate other areas using a maximum buffer size*/
-                if(rot_buf == NULL) rot_buf = lv_malloc(LV_DISP_ROT_MAX_BUF);
+                /*Rotate the remaining rows using a maximum buffer size*/
+                height = LV_MIN(max_row, area_h - row);
+                if(rot_buf == NULL) {
+                    rot_buf = lv_malloc(LV_DISP_ROT_MAX_BUF);
+                    LV_ASSERT_MALLOC(rot_buf);
+                    if(rot_buf == NULL) return;
+                }
                 draw_buf_rotate_90(disp_refr->rotation == LV_DISP_ROTATION_270, area_w, height, color_p, rot_buf);
+                flush_p = rot_buf;
+            }
 
-                if(disp_refr->rotation == LV_DISP_ROTATION_90) {
-                    area->x1 = init_y_off + row;
-                    area->x2 = init_y_off + row + height - 1;
-                }
-                else {
-                    area->x2 = disp_refr->hor_res - 1 - init_y_off - row;
-                    area->x1 = area->x2 - height + 1;
-                }
+            if(disp_refr->rotation == LV_DISP_ROTATION_90) {
+                area->x1 = init_y_off + row;
+                area->x2 = init_y_off + row + height - 1;
+            }
+            else {
+                area->x2 = disp_refr->hor_res - 1 - init_y_off - row;
+                area->x1 = area->x2 - height + 1;
             }
 
             /* The original part (chunk of the current area) were split into more parts here.
@@ -1014,7 +1233,8 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
             }
 
             /*Flush the completed area to the display*/
-            call_flush_cb(disp_refr, area, rot_buf == NULL ? color_p : rot_buf);
+            disp_refr->flushing = 1;
+            call_flush_cb(disp_refr, area, flush_p);
             /*FIXME: Rotation forces legacy behavior where rendering and flushing are done serially*/
             while(disp_refr->flushing) {
                 if(disp_refr->wait_cb) disp_refr->wait_cb(disp_refr);
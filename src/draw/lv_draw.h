@@ -29,6 +29,7 @@ extern "C" {
 #include "lv_draw_arc.h"
 #include "lv_draw_mask.h"
 #include "lv_draw_transform.h"
+#include "lv_img_transform_cache.h"
 #include "lv_draw_layer.h"
 
 /*********************
@@ -98,6 +99,13 @@ typedef struct _lv_draw_ctx_t  {
     void (*draw_letter)(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,  const lv_point_t * pos_p,
                         uint32_t letter);
 
+    /**
+     * Draw letters of the same line with the same style at once. Optional, `draw_letter` is used for each letter if `NULL`.
+     * Backends replacing `draw_letter` of an other draw context should set it too or clear it.
+     */
+    void (*draw_letters)(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_arr,
+                         const uint32_t * letters, uint32_t letter_cnt);
+
 
     void (*draw_line)(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
                       const lv_point_t * point2);
@@ -159,6 +159,17 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
     /*The decoder could open the image and gave the entire uncompressed image.
      *Just draw it!*/
     if(cdsc->dec_dsc.img_data) {
+        /*Draw a downscaled copy if the image is zoomed out a lot*/
+        const lv_img_decoder_dsc_t * dec_dsc = &cdsc->dec_dsc;
+        lv_img_decoder_dsc_t mip_dec_dsc;
+        lv_draw_img_dsc_t mip_draw_dsc;
+        lv_area_t mip_coords;
+        if(_lv_img_transform_cache_get_mipmap(dec_dsc, draw_dsc, coords, &mip_dec_dsc, &mip_draw_dsc, &mip_coords)) {
+            dec_dsc = &mip_dec_dsc;
+            draw_dsc = &mip_draw_dsc;
+            coords = &mip_coords;
+        }
+
         lv_area_t map_area_rot;
         lv_area_copy(&map_area_rot, coords);
         if(draw_dsc->angle || draw_dsc->zoom != LV_ZOOM_NONE) {
@@ -182,9 +193,25 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t decode_and_draw(lv_draw_ctx_t * draw_ctx,
             return LV_RES_OK;
         }
 
+        const _lv_img_transform_cache_entry_t * tr_entry = NULL;
+        if(draw_dsc->angle || draw_dsc->zoom != LV_ZOOM_NONE) {
+            tr_entry = _lv_img_transform_cache_get(draw_ctx, dec_dsc, draw_dsc, coords, &sup);
+        }
+
         const lv_area_t * clip_area_ori = draw_ctx->clip_area;
         draw_ctx->clip_area = &clip_com;
-        lv_draw_img_decoded(draw_ctx, draw_dsc, coords, cdsc->dec_dsc.img_data, &sup, cdsc->dec_dsc.header.cf);
+        if(tr_entry) {
+            /*The image is already transformed, draw it as a simple image on the transformed area*/
+            lv_draw_img_dsc_t tr_dsc = *draw_dsc;
+            tr_dsc.angle = 0;
+            tr_dsc.zoom = LV_ZOOM_NONE;
+            lv_draw_img_sup_t tr_sup = sup;
+            tr_sup.chroma_keyed = 0;
+            lv_draw_img_decoded(draw_ctx, &tr_dsc, &map_area_rot, tr_entry->buf, &tr_sup, LV_COLOR_FORMAT_NATIVE_ALPHA);
+        }
+        else {
+            lv_draw_img_decoded(draw_ctx, draw_dsc, coords, dec_dsc->img_data, &sup, dec_dsc->header.cf);
+        }
         draw_ctx->clip_area = clip_area_ori;
     }
     /*The whole uncompressed image is not available. Try to read it line-by-line*/
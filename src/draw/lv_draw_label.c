@@ -19,6 +19,7 @@
  *********************/
 #define LABEL_RECOLOR_PAR_LENGTH 6
 #define LV_LABEL_HINT_UPDATE_TH 1024 /*Update the "hint" if the label's y coordinates have changed more then this*/
+#define LABEL_LETTER_RUN_MAX 16 /*Max. number of letters drawn at once*/
 
 /**********************
  *      TYPEDEFS
@@ -30,11 +31,25 @@ enum {
 };
 typedef uint8_t cmd_state_t;
 
+/*Letters collected to be drawn at once with the same style*/
+typedef struct {
+    lv_point_t pos[LABEL_LETTER_RUN_MAX];
+    uint32_t letters[LABEL_LETTER_RUN_MAX];
+    uint32_t cnt;
+} letter_run_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
 static uint8_t hex_char_to_num(char hex);
+static void letter_run_flush(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, letter_run_t * run);
+#if LV_USE_BIDI
+    static bool bidi_cache_prepare(lv_draw_label_bidi_cache_t * cache, const lv_draw_label_dsc_t * dsc, const char * txt,
+                                   lv_coord_t w, lv_base_dir_t base_dir, bool with_pos);
+    static char * bidi_cache_get_line(lv_draw_label_bidi_cache_t * cache, const char * txt, uint32_t line_start,
+                                      uint32_t line_end);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -189,6 +204,14 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         sel_start = sel_end;
         sel_end = tmp;
     }
+
+#if LV_USE_BIDI
+    lv_draw_label_bidi_cache_t * bidi_cache = dsc->bidi_cache;
+    if(bidi_cache && !bidi_cache_prepare(bidi_cache, dsc, txt, w, base_dir,
+                                         sel_start != 0xFFFF && sel_end != 0xFFFF)) {
+        bidi_cache = NULL;
+    }
+#endif
     lv_draw_line_dsc_t line_dsc;
 
     if((dsc->decor & LV_TEXT_DECOR_UNDERLINE) || (dsc->decor & LV_TEXT_DECOR_STRIKETHROUGH)) {
@@ -210,6 +233,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     lv_draw_rect_dsc_init(&draw_dsc_sel);
     draw_dsc_sel.bg_color = dsc->sel_bg_color;
 
+    letter_run_t run;
+    run.cnt = 0;
+
     int32_t pos_x_start = pos.x;
     /*Write out all lines*/
     while(txt[line_start] != '\0') {
@@ -219,8 +245,21 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         cmd_state = CMD_STATE_WAIT;
         i         = 0;
 #if LV_USE_BIDI
-        char * bidi_txt = lv_malloc(line_end - line_start + 1);
-        _lv_bidi_process_paragraph(txt + line_start, bidi_txt, line_end - line_start, base_dir, NULL, 0);
+        const char * bidi_txt;
+        char * bidi_buf = NULL;
+        uint32_t line_char_start = 0;
+        if(bidi_cache && bidi_cache->no_rtl) {
+            bidi_txt = txt + line_start;    /*Nothing to reorder*/
+        }
+        else if(bidi_cache) {
+            bidi_txt = bidi_cache_get_line(bidi_cache, txt, line_start, line_end);
+            if(sel_start != 0xFFFF && sel_end != 0xFFFF) line_char_start = _lv_txt_encoded_get_char_id(txt, line_start);
+        }
+        else {
+            bidi_buf = lv_malloc(line_end - line_start + 1);
+            _lv_bidi_process_paragraph(txt + line_start, bidi_buf, line_end - line_start, base_dir, NULL, 0);
+            bidi_txt = bidi_buf;
+        }
 #else
         const char * bidi_txt = txt + line_start;
 #endif
@@ -229,9 +268,17 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
             uint32_t logical_char_pos = 0;
             if(sel_start != 0xFFFF && sel_end != 0xFFFF) {
 #if LV_USE_BIDI
-                logical_char_pos = _lv_txt_encoded_get_char_id(txt, line_start);
-                uint32_t t = _lv_txt_encoded_get_char_id(bidi_txt, i);
-                logical_char_pos += _lv_bidi_get_logical_pos(bidi_txt, NULL, line_end - line_start, base_dir, t, NULL);
+                if(bidi_cache && bidi_cache->no_rtl) {
+                    logical_char_pos = _lv_txt_encoded_get_char_id(txt, line_start + i);
+                }
+                else if(bidi_cache) {
+                    logical_char_pos = line_char_start + bidi_cache->logical_pos[line_start + i];
+                }
+                else {
+                    logical_char_pos = _lv_txt_encoded_get_char_id(txt, line_start);
+                    uint32_t t = _lv_txt_encoded_get_char_id(bidi_txt, i);
+                    logical_char_pos += _lv_bidi_get_logical_pos(bidi_txt, NULL, line_end - line_start, base_dir, t, NULL);
+                }
 #else
                 logical_char_pos = _lv_txt_encoded_get_char_id(txt, line_start + i);
 #endif
@@ -240,6 +287,10 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
             uint32_t letter;
             uint32_t letter_next;
             _lv_txt_encoded_letter_next_2(bidi_txt, &letter, &letter_next, &i);
+#if LV_USE_BIDI
+            /*The cached lines are not '\0' terminated but there is no kerning with the next line*/
+            if(i >= line_end - line_start) letter_next = 0;
+#endif
             /*Handle the re-color command*/
             if((dsc->flag & LV_TEXT_FLAG_RECOLOR) != 0) {
                 if(letter == (uint32_t)LV_TXT_COLOR_CMD[0]) {
@@ -288,6 +339,8 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 
             if(sel_start != 0xFFFF && sel_end != 0xFFFF) {
                 if(logical_char_pos >= sel_start && logical_char_pos < sel_end) {
+                    /*Draw the previous letters first as they might overlap with the selection*/
+                    letter_run_flush(draw_ctx, &dsc_mod, &run);
                     lv_area_t sel_coords;
                     sel_coords.x1 = pos.x;
                     sel_coords.y1 = pos.y;
@@ -298,14 +351,21 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
                 }
             }
 
+            if(run.cnt == LABEL_LETTER_RUN_MAX || !lv_color_eq(dsc_mod.color, color)) {
+                letter_run_flush(draw_ctx, &dsc_mod, &run);
+            }
             dsc_mod.color = color;
-            lv_draw_letter(draw_ctx, &dsc_mod, &pos, letter);
+            run.pos[run.cnt] = pos;
+            run.letters[run.cnt] = letter;
+            run.cnt++;
 
             if(letter_w > 0) {
                 pos.x += letter_w + dsc->letter_space;
             }
         }
 
+        letter_run_flush(draw_ctx, &dsc_mod, &run);
+
         if(dsc->decor & LV_TEXT_DECOR_STRIKETHROUGH) {
             lv_point_t p1;
             lv_point_t p2;
@@ -329,8 +389,8 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         }
 
 #if LV_USE_BIDI
-        lv_free(bidi_txt);
-        bidi_txt = NULL;
+        lv_free(bidi_buf);
+        bidi_buf = NULL;
 #endif
         /*Go to next line*/
         line_start = line_end;
@@ -369,11 +429,47 @@ void lv_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
     LV_PROFILER_END;
 }
 
+void lv_draw_letters(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_arr,
+                     const uint32_t * letters, uint32_t letter_cnt)
+{
+    LV_PROFILER_BEGIN;
+    if(draw_ctx->draw_letters) {
+        draw_ctx->draw_letters(draw_ctx, dsc, pos_arr, letters, letter_cnt);
+    }
+    else {
+        uint32_t i;
+        for(i = 0; i < letter_cnt; i++) {
+            draw_ctx->draw_letter(draw_ctx, dsc, &pos_arr[i], letters[i]);
+        }
+    }
+    LV_PROFILER_END;
+}
+
+#if LV_USE_BIDI
+void lv_draw_label_bidi_cache_free(lv_draw_label_bidi_cache_t * cache)
+{
+    lv_free(cache->bidi_txt);
+    lv_free(cache->logical_pos);
+    lv_free(cache->line_done);
+    lv_memzero(cache, sizeof(lv_draw_label_bidi_cache_t));
+}
+#endif
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Draw the collected letters and empty the run
+ */
+static void letter_run_flush(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, letter_run_t * run)
+{
+    if(run->cnt == 0) return;
+
+    lv_draw_letters(draw_ctx, dsc, run->pos, run->letters, run->cnt);
+    run->cnt = 0;
+}
+
 /**
  * Convert a hexadecimal characters to a number (0..15)
  * @param hex Pointer to a hexadecimal character (0..9, A..F)
@@ -417,3 +513,100 @@ static uint8_t hex_char_to_num(char hex)
     return result;
 }
 
+#if LV_USE_BIDI
+/**
+ * Drop the cached lines if they were processed for an other text or with other parameters
+ * and allocate the buffers if needed.
+ * @param with_pos  true: the logical positions of the characters are needed too
+ * @return          true: the cache can be used
+ */
+static bool bidi_cache_prepare(lv_draw_label_bidi_cache_t * cache, const lv_draw_label_dsc_t * dsc, const char * txt,
+                               lv_coord_t w, lv_base_dir_t base_dir, bool with_pos)
+{
+    if(cache->txt != txt || cache->font != dsc->font || cache->w != w || cache->letter_space != dsc->letter_space ||
+       cache->flag != dsc->flag || cache->base_dir != base_dir) {
+        lv_draw_label_bidi_cache_free(cache);
+        cache->txt = txt;
+        cache->font = dsc->font;
+        cache->w = w;
+        cache->letter_space = dsc->letter_space;
+        cache->flag = dsc->flag;
+        cache->base_dir = base_dir;
+    }
+
+    if(cache->no_rtl) return true;
+
+    if(cache->bidi_txt == NULL) {
+        if(base_dir == LV_BASE_DIR_LTR && !_lv_bidi_has_rtl_letter(txt)) {
+            cache->no_rtl = 1;
+            return true;
+        }
+
+        cache->txt_len = lv_strlen(txt);
+        cache->bidi_txt = lv_malloc(cache->txt_len + 1);
+        cache->line_done = lv_malloc(cache->txt_len / 8 + 1);
+        if(cache->bidi_txt == NULL || cache->line_done == NULL) {
+            lv_draw_label_bidi_cache_free(cache);
+            return false;
+        }
+        cache->bidi_txt[cache->txt_len] = '\0';
+        lv_memzero(cache->line_done, cache->txt_len / 8 + 1);
+    }
+
+    if(with_pos && cache->logical_pos == NULL) {
+        cache->logical_pos = lv_malloc(cache->txt_len * sizeof(uint16_t));
+        if(cache->logical_pos == NULL) {
+            lv_draw_label_bidi_cache_free(cache);
+            return false;
+        }
+        /*Process the lines again to get the positions too*/
+        lv_memzero(cache->line_done, cache->txt_len / 8 + 1);
+    }
+
+    return true;
+}
+
+/**
+ * Get a line in visual order from the cache. Process it if it's not processed yet.
+ * @param line_start    byte index of the line's first character
+ * @param line_end      byte index after the line's last character
+ * @return              the processed line. It's not '\0' terminated.
+ */
+static char * bidi_cache_get_line(lv_draw_label_bidi_cache_t * cache, const char * txt, uint32_t line_start,
+                                  uint32_t line_end)
+{
+    char * line = &cache->bidi_txt[line_start];
+    if(cache->line_done[line_start >> 3] & (1 << (line_start & 0x7))) return line;
+
+    /*The terminating '\0' would overwrite the first character of the next line*/
+    uint32_t len = line_end - line_start;
+    char next_char = line[len];
+    _lv_bidi_process_paragraph(&txt[line_start], line, len, cache->base_dir, NULL, 0);
+    line[len] = next_char;
+
+    if(cache->logical_pos) {
+        /*Get the positions by character into the line's part of the table
+         *and move them to the byte index of their characters.
+         *The byte index is never smaller than the character index so go backward.*/
+        uint16_t * pos = &cache->logical_pos[line_start];
+        uint32_t char_cnt = 0;
+        uint32_t i = 0;
+        while(i < len) {
+            _lv_txt_encoded_next(line, &i);
+            char_cnt++;
+        }
+
+        _lv_bidi_get_logical_pos_table(line, len, cache->base_dir, pos, char_cnt);
+
+        i = len;
+        while(char_cnt > 0) {
+            char_cnt--;
+            _lv_txt_encoded_prev(line, &i);
+            pos[i] = pos[char_cnt];
+        }
+    }
+
+    cache->line_done[line_start >> 3] |= 1 << (line_start & 0x7);
+    return line;
+}
+#endif
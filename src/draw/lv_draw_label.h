@@ -27,6 +27,26 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_BIDI
+/** Store the bidi processed lines of a text to not process them again on every redraw.
+ * It's filled by `lv_draw_label` line by line. Initially it should be zeroed and
+ * freed with `lv_draw_label_bidi_cache_free` if the text changes or it's not needed anymore.*/
+typedef struct {
+    const char * txt;           /**< The text the cache belongs to*/
+    char * bidi_txt;            /**< The processed lines at the same byte index as in `txt`*/
+    uint16_t * logical_pos;     /**< Logical char. position in the line of the visual characters, by byte index.
+                                     Allocated only if there is a selection*/
+    uint8_t * line_done;        /**< 1 bit for each byte: the line starting there is processed*/
+    uint32_t txt_len;
+    const lv_font_t * font;
+    lv_coord_t w;
+    lv_coord_t letter_space;
+    lv_text_flag_t flag;
+    lv_base_dir_t base_dir;
+    uint8_t no_rtl : 1;         /**< LTR text without RTL characters: it can be drawn without processing*/
+} lv_draw_label_bidi_cache_t;
+#endif
+
 typedef struct {
     const lv_font_t * font;
     uint32_t sel_start;
@@ -44,6 +64,9 @@ typedef struct {
     lv_text_flag_t flag;
     lv_text_decor_t decor : 3;
     lv_blend_mode_t blend_mode: 3;
+#if LV_USE_BIDI
+    lv_draw_label_bidi_cache_t * bidi_cache;    /**< Optional, store the bidi processed lines here*/
+#endif
 } lv_draw_label_dsc_t;
 
 /** Store some info to speed up drawing of very large texts
@@ -82,9 +105,28 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label_dsc_init(lv_draw_label_dsc_t * dsc);
 LV_ATTRIBUTE_FAST_MEM void lv_draw_label(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
                                          const lv_area_t * coords, const char * txt, lv_draw_label_hint_t * hint);
 
+#if LV_USE_BIDI
+/**
+ * Free the bidi processed lines stored by `lv_draw_label`
+ * @param cache     pointer to a bidi cache. It will be zeroed.
+ */
+void lv_draw_label_bidi_cache_free(lv_draw_label_bidi_cache_t * cache);
+#endif
+
 void lv_draw_letter(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,  const lv_point_t * pos_p,
                     uint32_t letter);
 
+/**
+ * Draw letters of the same line with the same style
+ * @param draw_ctx      pointer to the current draw context
+ * @param dsc           pointer to draw descriptor
+ * @param pos_arr       left-top coordinates of the letters
+ * @param letters       the letters to draw
+ * @param letter_cnt    number of letters
+ */
+void lv_draw_letters(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_arr,
+                     const uint32_t * letters, uint32_t letter_cnt);
+
 /***********************
  * GLOBAL VARIABLES
  ***********************/
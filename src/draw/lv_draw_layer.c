@@ -9,6 +9,7 @@
 #include "lv_draw.h"
 #include "lv_draw_arc.h"
 #include "../core/lv_refr.h"
+#include "../core/lv_disp_private.h"
 
 /*********************
  *      DEFINES
@@ -18,9 +19,19 @@
  *      TYPEDEFS
  **********************/
 
+/*Stored at the beginning of the free buffers to link them*/
+typedef struct _free_buf_t {
+    struct _free_buf_t * next;
+    uint32_t size;
+} free_buf_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static uint32_t get_bucket(uint32_t size);
+static void * take_from_bucket(lv_draw_layer_buf_pool_t * pool, uint32_t bucket, uint32_t min_size, uint32_t max_size,
+                               uint32_t * real_size);
+static void shrink(lv_draw_layer_buf_pool_t * pool, uint32_t size);
 
 /**********************
  *  STATIC VARIABLES
@@ -94,6 +105,138 @@ void lv_draw_layer_destroy(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer
     LV_PROFILER_END;
 }
 
+void lv_draw_layer_buf_pool_set_size(lv_disp_t * disp, uint32_t size)
+{
+    if(disp == NULL) disp = lv_disp_get_default();
+    if(disp == NULL) return;
+
+    disp->layer_buf_pool.stats.max_size = size;
+    shrink(&disp->layer_buf_pool, size);
+}
+
+void lv_draw_layer_buf_pool_get_stats(lv_disp_t * disp, lv_draw_layer_buf_pool_stats_t * stats)
+{
+    if(disp == NULL) disp = lv_disp_get_default();
+    if(disp == NULL) {
+        lv_memzero(stats, sizeof(lv_draw_layer_buf_pool_stats_t));
+        return;
+    }
+
+    *stats = disp->layer_buf_pool.stats;
+}
+
+void _lv_draw_layer_buf_pool_init(lv_draw_layer_buf_pool_t * pool)
+{
+    lv_memzero(pool, sizeof(lv_draw_layer_buf_pool_t));
+    pool->stats.max_size = LV_DRAW_LAYER_BUF_POOL_SIZE;
+}
+
+void _lv_draw_layer_buf_pool_deinit(lv_draw_layer_buf_pool_t * pool)
+{
+    shrink(pool, 0);
+}
+
+void * _lv_draw_layer_buf_get(lv_draw_layer_buf_pool_t * pool, uint32_t size, uint32_t * real_size)
+{
+    *real_size = size;
+    if(pool == NULL) return lv_malloc(size);
+
+    /*Use a buffer from the same bucket if it's large enough or a buffer from the next bucket
+     *if it's less than twice as large. This way at most half of a buffer is wasted.*/
+    uint32_t bucket = get_bucket(size);
+    void * buf = take_from_bucket(pool, bucket, size, UINT32_MAX, real_size);
+    if(buf == NULL && bucket + 1 < _LV_DRAW_LAYER_BUF_POOL_BUCKET_CNT) {
+        uint32_t max_size = size <= UINT32_MAX / 2 ? size * 2 - 1 : UINT32_MAX;
+        buf = take_from_bucket(pool, bucket + 1, size, max_size, real_size);
+    }
+
+    if(buf) {
+        pool->stats.reuse_cnt++;
+        return buf;
+    }
+
+    pool->stats.alloc_cnt++;
+    buf = lv_malloc(size);
+    if(buf == NULL && pool->stats.buf_cnt) {
+        /*The kept buffers might take the memory. Free them and try again.*/
+        shrink(pool, 0);
+        buf = lv_malloc(size);
+    }
+
+    return buf;
+}
+
+void _lv_draw_layer_buf_release(lv_draw_layer_buf_pool_t * pool, void * buf, uint32_t real_size)
+{
+    if(buf == NULL) return;
+
+    if(pool == NULL || real_size < sizeof(free_buf_t) ||
+       pool->stats.used_size + real_size > pool->stats.max_size) {
+        if(pool) pool->stats.drop_cnt++;
+        lv_free(buf);
+        return;
+    }
+
+    uint32_t bucket = get_bucket(real_size);
+    free_buf_t * fb = buf;
+    fb->next = pool->buckets[bucket];
+    fb->size = real_size;
+    pool->buckets[bucket] = fb;
+
+    pool->stats.buf_cnt++;
+    pool->stats.used_size += real_size;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+static uint32_t get_bucket(uint32_t size)
+{
+    uint32_t bucket = 0;
+    while(size > 1) {
+        size >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static void * take_from_bucket(lv_draw_layer_buf_pool_t * pool, uint32_t bucket, uint32_t min_size, uint32_t max_size,
+                               uint32_t * real_size)
+{
+    free_buf_t ** prev_next = (free_buf_t **)&pool->buckets[bucket];
+    free_buf_t * fb = *prev_next;
+    while(fb) {
+        if(fb->size >= min_size && fb->size <= max_size) {
+            *prev_next = fb->next;
+            *real_size = fb->size;
+            pool->stats.buf_cnt--;
+            pool->stats.used_size -= fb->size;
+            return fb;
+        }
+        prev_next = &fb->next;
+        fb = fb->next;
+    }
+
+    return NULL;
+}
+
+/**
+ * Free the buffers, the largest first, until the pool is not larger than `size`
+ */
+static void shrink(lv_draw_layer_buf_pool_t * pool, uint32_t size)
+{
+    int32_t bucket = _LV_DRAW_LAYER_BUF_POOL_BUCKET_CNT - 1;
+    while(pool->stats.used_size > size && bucket >= 0) {
+        free_buf_t * fb = pool->buckets[bucket];
+        if(fb == NULL) {
+            bucket--;
+            continue;
+        }
+
+        pool->buckets[bucket] = fb->next;
+        pool->stats.buf_cnt--;
+        pool->stats.used_size -= fb->size;
+        lv_free(fb);
+    }
+}
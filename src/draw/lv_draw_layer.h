@@ -20,12 +20,15 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+/*Number of size buckets of the layer buffer pool. Bucket `i` holds the buffers of 2^i..2^(i+1)-1 bytes*/
+#define _LV_DRAW_LAYER_BUF_POOL_BUCKET_CNT    32
 
 /**********************
  *      TYPEDEFS
  **********************/
 struct _lv_draw_ctx_t;
 struct _lv_draw_layer_ctx_t;
+struct _lv_disp_t;
 
 typedef enum {
     LV_DRAW_LAYER_FLAG_NONE,
@@ -33,6 +36,25 @@ typedef enum {
     LV_DRAW_LAYER_FLAG_CAN_SUBDIVIDE,
 } lv_draw_layer_flags_t;
 
+typedef struct {
+    uint32_t reuse_cnt;     /**< Number of buffers taken from the pool*/
+    uint32_t alloc_cnt;     /**< Number of buffers allocated as there was no fitting one in the pool*/
+    uint32_t drop_cnt;      /**< Number of released buffers freed because they didn't fit into the budget*/
+    uint32_t buf_cnt;       /**< Number of buffers currently kept in the pool*/
+    uint32_t used_size;     /**< Size of the buffers currently kept in the pool [bytes]*/
+    uint32_t max_size;      /**< The retention budget of the pool [bytes]*/
+} lv_draw_layer_buf_pool_stats_t;
+
+/**
+ * Keeps the buffers of the destroyed layers to reuse them for the next layers of similar size.
+ * The software renderer uses it for the mask buffers of the letters too.
+ * Each display has its own pool.
+ */
+typedef struct {
+    void * buckets[_LV_DRAW_LAYER_BUF_POOL_BUCKET_CNT];   /**< Linked lists of the free buffers*/
+    lv_draw_layer_buf_pool_stats_t stats;
+} lv_draw_layer_buf_pool_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -74,6 +96,50 @@ void lv_draw_layer_blend(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_layer
  */
 void lv_draw_layer_destroy(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_layer_ctx_t * layer_ctx);
 
+/**
+ * Set how many bytes of layer buffers can be kept by a display for reuse.
+ * The buffers above the new size are freed immediately.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @param size      the retention budget in bytes, 0: don't keep any buffers
+ */
+void lv_draw_layer_buf_pool_set_size(struct _lv_disp_t * disp, uint32_t size);
+
+/**
+ * Get the statistics of the layer buffer pool of a display
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @param stats     store the statistics here
+ */
+void lv_draw_layer_buf_pool_get_stats(struct _lv_disp_t * disp, lv_draw_layer_buf_pool_stats_t * stats);
+
+/**
+ * Initialize a layer buffer pool with `LV_DRAW_LAYER_BUF_POOL_SIZE` budget
+ * @param pool      pointer to a pool
+ */
+void _lv_draw_layer_buf_pool_init(lv_draw_layer_buf_pool_t * pool);
+
+/**
+ * Free all the buffers kept in a pool
+ * @param pool      pointer to a pool
+ */
+void _lv_draw_layer_buf_pool_deinit(lv_draw_layer_buf_pool_t * pool);
+
+/**
+ * Get a layer buffer from a pool or allocate a new one
+ * @param pool      pointer to a pool. If NULL the buffer is simply allocated.
+ * @param size      the required size in bytes
+ * @param real_size store the real size of the buffer here. Can be larger than `size`.
+ * @return          pointer to the buffer or NULL on error
+ */
+void * _lv_draw_layer_buf_get(lv_draw_layer_buf_pool_t * pool, uint32_t size, uint32_t * real_size);
+
+/**
+ * Give back a layer buffer to a pool. It's freed if it doesn't fit into the budget.
+ * @param pool      pointer to a pool. If NULL the buffer is simply freed.
+ * @param buf       pointer to the buffer returned by `_lv_draw_layer_buf_get`
+ * @param real_size the real size of the buffer returned by `_lv_draw_layer_buf_get`
+ */
+void _lv_draw_layer_buf_release(lv_draw_layer_buf_pool_t * pool, void * buf, uint32_t real_size);
+
 /**********************
  *      MACROS
  **********************/
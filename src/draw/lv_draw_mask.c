@@ -12,13 +12,23 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_gc.h"
+#include "sw/lv_draw_sw_simd.h"
 
 /*********************
  *      DEFINES
  *********************/
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_SIMD && LV_BIG_ENDIAN_SYSTEM == 0
+    #define MASK_MIX_SIMD   1
+#else
+    #define MASK_MIX_SIMD   0
+#endif
+
 #define CIRCLE_CACHE_LIFE_MAX   1000
 #define CIRCLE_CACHE_AGING(life, r)   life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
 
+/*Number of sub-scanlines per row when calculating the coverage of polygons*/
+#define POLYGON_SUBSAMPLE_CNT   16
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -52,6 +62,10 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t line_mask_steep(lv_opa_t * mask_
                                                                 lv_coord_t len,
                                                                 lv_draw_mask_line_param_t * p);
 
+LV_ATTRIBUTE_FAST_MEM static inline void polygon_add_span(lv_draw_mask_polygon_param_t * param, int32_t xa, int32_t xb,
+                                                          int32_t clip_x1, int32_t clip_x2);
+static void polygon_sort_edges(_lv_draw_mask_polygon_edge_t * edges, uint32_t edge_cnt);
+
 static void circ_init(lv_point_t * c, lv_coord_t * tmp, lv_coord_t radius);
 static bool circ_cont(lv_point_t * c);
 static void circ_next(lv_point_t * c, lv_coord_t * tmp);
@@ -59,6 +73,9 @@ static void circ_calc_aa4(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t radi
 static lv_opa_t * get_next_line(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t y, lv_coord_t * len,
                                 lv_coord_t * x_start);
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
+LV_ATTRIBUTE_FAST_MEM static void mask_mix_opa(lv_opa_t * mask_buf, lv_opa_t opa, int32_t len);
+LV_ATTRIBUTE_FAST_MEM static void mask_mix_map(lv_opa_t * mask_buf, const lv_opa_t * map, int32_t len);
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t mask_line_res(const lv_opa_t * mask_buf, lv_coord_t len);
 
 /**********************
  *  STATIC VARIABLES
@@ -105,7 +122,7 @@ int16_t lv_draw_mask_add(void * param, void * custom_id)
  * @param len length of the line to calculate (in pixel count)
  * @return One of these values:
  * - `LV_DRAW_MASK_RES_FULL_TRANSP`: the whole line is transparent. `mask_buf` is not set to zero
- * - `LV_DRAW_MASK_RES_FULL_COVER`: the whole line is fully visible. `mask_buf` is unchanged
+ * - `LV_DRAW_MASK_RES_FULL_COVER`: the whole line is fully visible. `mask_buf` is unchanged or all `LV_OPA_COVER`
  * - `LV_DRAW_MASK_RES_CHANGED`: `mask_buf` has changed, it shows the desired opacity of each pixel in the given line
  */
 LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
@@ -126,7 +143,7 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf,
         m++;
     }
 
-    return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+    return changed ? mask_line_res(mask_buf, len) : LV_DRAW_MASK_RES_FULL_COVER;
 }
 
 /**
@@ -139,7 +156,7 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf,
  * @param ids_count number of ID array
  * @return One of these values:
  * - `LV_DRAW_MASK_RES_FULL_TRANSP`: the whole line is transparent. `mask_buf` is not set to zero
- * - `LV_DRAW_MASK_RES_FULL_COVER`: the whole line is fully visible. `mask_buf` is unchanged
+ * - `LV_DRAW_MASK_RES_FULL_COVER`: the whole line is fully visible. `mask_buf` is unchanged or all `LV_OPA_COVER`
  * - `LV_DRAW_MASK_RES_CHANGED`: `mask_buf` has changed, it shows the desired opacity of each pixel in the given line
  */
 LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply_ids(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
@@ -159,7 +176,7 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply_ids(lv_opa_t * mask_
         else if(res == LV_DRAW_MASK_RES_CHANGED) changed = true;
     }
 
-    return changed ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+    return changed ? mask_line_res(mask_buf, len) : LV_DRAW_MASK_RES_FULL_COVER;
 }
 
 /**
@@ -225,6 +242,7 @@ void lv_draw_mask_free_param(void * p)
     else if(pdsc->type == LV_DRAW_MASK_TYPE_POLYGON) {
         lv_draw_mask_polygon_param_t * poly_p = (lv_draw_mask_polygon_param_t *) p;
         lv_free(poly_p->cfg.points);
+        lv_free(poly_p->edges);
     }
 }
 
@@ -566,6 +584,12 @@ void lv_draw_mask_map_init(lv_draw_mask_map_param_t * param, const lv_area_t * c
 
 void lv_draw_mask_polygon_init(lv_draw_mask_polygon_param_t * param, const lv_point_t * points, uint16_t point_cnt)
 {
+    lv_memzero(param, sizeof(lv_draw_mask_polygon_param_t));
+    param->dsc.cb = (lv_draw_mask_xcb_t)lv_draw_mask_polygon;
+    param->dsc.type = LV_DRAW_MASK_TYPE_POLYGON;
+    param->cfg.fill_rule = LV_DRAW_POLYGON_FILL_NON_ZERO;
+    param->y_prev = LV_COORD_MIN;
+
     /*Join adjacent points if they are on the same coordinate*/
     lv_point_t * p = lv_malloc(point_cnt * sizeof(lv_point_t));
     if(p == NULL) return;
@@ -585,8 +609,60 @@ void lv_draw_mask_polygon_init(lv_draw_mask_polygon_param_t * param, const lv_po
     }
     param->cfg.points = p;
     param->cfg.point_cnt = pcnt;
-    param->dsc.cb = (lv_draw_mask_xcb_t)lv_draw_mask_polygon;
-    param->dsc.type = LV_DRAW_MASK_TYPE_POLYGON;
+    if(pcnt < 3) return;
+
+    lv_area_set(&param->coords, LV_COORD_MAX, LV_COORD_MAX, LV_COORD_MIN, LV_COORD_MIN);
+    uint16_t edge_cnt = 0;
+    for(i = 0; i < pcnt; i++) {
+        param->coords.x1 = LV_MIN(param->coords.x1, p[i].x);
+        param->coords.y1 = LV_MIN(param->coords.y1, p[i].y);
+        param->coords.x2 = LV_MAX(param->coords.x2, p[i].x);
+        param->coords.y2 = LV_MAX(param->coords.y2, p[i].y);
+        if(p[i].y != p[i + 1 < pcnt ? i + 1 : 0].y) edge_cnt++;
+    }
+    if(edge_cnt == 0) return;
+
+    /*Allocate the edges and the buffers of the rasterizer in one block.
+     *The coverage buffers have an extra element as a span can end right after the last pixel.*/
+    uint32_t w = lv_area_get_width(&param->coords);
+    uint32_t edges_size = edge_cnt * sizeof(_lv_draw_mask_polygon_edge_t);
+    uint32_t crossings_size = edge_cnt * sizeof(_lv_draw_mask_polygon_crossing_t);
+    uint32_t row_size = (w + 1) * sizeof(int32_t);
+    uint8_t * buf = lv_malloc(edges_size + crossings_size + 2 * row_size + edge_cnt * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL) return;
+
+    param->edges = (_lv_draw_mask_polygon_edge_t *)buf;
+    param->crossings = (_lv_draw_mask_polygon_crossing_t *)(buf + edges_size);
+    param->cover = (int32_t *)(buf + edges_size + crossings_size);
+    param->area = (int32_t *)(buf + edges_size + crossings_size + row_size);
+    param->active = (uint16_t *)(buf + edges_size + crossings_size + 2 * row_size);
+
+    /*Store the edges from top to bottom with their direction.
+     *The points are in the center of the pixels so shift X by half pixel to make
+     *a pixel cover the [x, x + 1) range in the rasterizer.*/
+    _lv_draw_mask_polygon_edge_t * e = param->edges;
+    for(i = 0; i < pcnt; i++) {
+        lv_point_t p1 = p[i];
+        lv_point_t p2 = p[i + 1 < pcnt ? i + 1 : 0];
+        if(p1.y == p2.y) continue;
+
+        e->dir = p1.y < p2.y ? 1 : -1;
+        if(e->dir < 0) {
+            lv_point_t tmp = p1;
+            p1 = p2;
+            p2 = tmp;
+        }
+
+        e->y1 = p1.y * 32;
+        e->y2 = p2.y * 32;
+        e->x1 = (int64_t)p1.x * ((int64_t)1 << 32) + ((int64_t)1 << 31);
+        e->slope = (int64_t)(p2.x - p1.x) * ((int64_t)1 << 32) / (e->y2 - e->y1);
+        e++;
+    }
+
+    polygon_sort_edges(param->edges, edge_cnt);
+    param->edge_cnt = edge_cnt;
 }
 
 /**********************
@@ -1185,18 +1261,12 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_fade(lv_opa_t * mas
         mask_buf += x_ofs;
     }
 
-    int32_t i;
-
     if(abs_y <= p->cfg.y_top) {
-        for(i = 0; i < len; i++) {
-            mask_buf[i] = mask_mix(mask_buf[i], p->cfg.opa_top);
-        }
+        mask_mix_opa(mask_buf, p->cfg.opa_top, len);
         return LV_DRAW_MASK_RES_CHANGED;
     }
     else if(abs_y >= p->cfg.y_bottom) {
-        for(i = 0; i < len; i++) {
-            mask_buf[i] = mask_mix(mask_buf[i], p->cfg.opa_bottom);
-        }
+        mask_mix_opa(mask_buf, p->cfg.opa_bottom, len);
         return LV_DRAW_MASK_RES_CHANGED;
     }
     else {
@@ -1206,9 +1276,7 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_fade(lv_opa_t * mas
         lv_opa_t opa_act = (int32_t)((int32_t)(abs_y - p->cfg.y_top) * opa_diff) / y_diff;
         opa_act += p->cfg.opa_top;
 
-        for(i = 0; i < len; i++) {
-            mask_buf[i] = mask_mix(mask_buf[i], opa_act);
-        }
+        mask_mix_opa(mask_buf, opa_act, len);
         return LV_DRAW_MASK_RES_CHANGED;
     }
 }
@@ -1239,87 +1307,177 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_map(lv_opa_t * mask
         map_tmp += (abs_x - p->cfg.coords.x1);
     }
 
-    int32_t i;
-    for(i = 0; i < len; i++) {
-        mask_buf[i] = mask_mix(mask_buf[i], map_tmp[i]);
-    }
+    mask_mix_map(mask_buf, map_tmp, len);
 
     return LV_DRAW_MASK_RES_CHANGED;
 }
 
+/**
+ * Scanline rasterizer with an active edge table.
+ * Each row is sampled on `POLYGON_SUBSAMPLE_CNT` sub-scanlines and the horizontal coverage
+ * of the spans is calculated exactly on each of them.
+ */
 LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_polygon(lv_opa_t * mask_buf, lv_coord_t abs_x,
                                                                      lv_coord_t abs_y, lv_coord_t len,
                                                                      lv_draw_mask_polygon_param_t * param)
 {
-    uint16_t i;
-    struct {
-        lv_point_t p1;
-        lv_point_t p2;
-    } lines[2], tmp;
-    uint16_t line_cnt = 0;
-    lv_memzero(&lines, sizeof(lines));
-    int psign_prev = 0;
-    for(i = 0; i < param->cfg.point_cnt; i++) {
-        lv_point_t p1 = param->cfg.points[i];
-        lv_point_t p2 = param->cfg.points[i + 1 < param->cfg.point_cnt ? i + 1 : 0];
-        int pdiff = p1.y - p2.y, psign = pdiff / LV_ABS(pdiff);
-        if(pdiff > 0) {
-            if(abs_y > p1.y || abs_y < p2.y) continue;
-            lines[line_cnt].p1 = p2;
-            lines[line_cnt].p2 = p1;
+    if(param->edge_cnt == 0) return LV_DRAW_MASK_RES_TRANSP;
+    if(abs_y < param->coords.y1 || abs_y > param->coords.y2) return LV_DRAW_MASK_RES_TRANSP;
+
+    int32_t x_start = LV_MAX(abs_x, param->coords.x1);
+    int32_t x_end = LV_MIN(abs_x + len - 1, param->coords.x2);
+    if(x_start > x_end) return LV_DRAW_MASK_RES_TRANSP;
+
+    /*The sub-scanlines are in the middle of the 1/16 slices of the row.
+     *The Y coordinates are in 1/32 pixel units so the edges (on full pixels) never cross them exactly.*/
+    int32_t y_sub_first = abs_y * 32 - (POLYGON_SUBSAMPLE_CNT - 1);
+    int32_t y_sub_last = abs_y * 32 + (POLYGON_SUBSAMPLE_CNT - 1);
+
+    /*The rows are usually processed from top to bottom so the active edges can be updated incrementally.
+     *Start again from the first edge if going upward.*/
+    if(abs_y < param->y_prev) {
+        param->active_cnt = 0;
+        param->edge_next = 0;
+    }
+    param->y_prev = abs_y;
+
+    uint32_t i;
+    uint32_t k;
+    uint32_t active_cnt = 0;
+    for(i = 0; i < param->active_cnt; i++) {
+        if(param->edges[param->active[i]].y2 > y_sub_first) {
+            param->active[active_cnt] = param->active[i];
+            active_cnt++;
         }
-        else {
-            if(abs_y < p1.y || abs_y > p2.y) continue;
-            lines[line_cnt].p1 = p1;
-            lines[line_cnt].p2 = p2;
-        }
-        if(psign_prev && psign_prev == psign) continue;
-        psign_prev = psign;
-        line_cnt++;
-        if(line_cnt == 2) break;
-    }
-    if(line_cnt != 2) return LV_DRAW_MASK_RES_TRANSP;
-    if(lines[0].p1.x > lines[1].p1.x || lines[0].p2.x > lines[1].p2.x) {
-        tmp = lines[0];
-        lines[0] = lines[1];
-        lines[1] = tmp;
-    }
-    lv_draw_mask_line_param_t line_p;
-    lv_draw_mask_line_points_init(&line_p, lines[0].p1.x, lines[0].p1.y, lines[0].p2.x, lines[0].p2.y,
-                                  LV_DRAW_MASK_LINE_SIDE_RIGHT);
-    if(line_p.steep == 0 && line_p.flat) {
-        lv_coord_t x1 = LV_MIN(lines[0].p1.x, lines[0].p2.x);
-        lv_coord_t x2 = LV_MAX(lines[0].p1.x, lines[0].p2.x);
-        for(i = 0; i < len; i++) {
-            mask_buf[i] = mask_mix(mask_buf[i], (abs_x + i >= x1 && abs_x + i <= x2) * 0xFF);
-        }
-        lv_draw_mask_free_param(&line_p);
-        return LV_DRAW_MASK_RES_CHANGED;
     }
-    lv_draw_mask_res_t res1 = lv_draw_mask_line(mask_buf, abs_x, abs_y, len, &line_p);
-    lv_draw_mask_free_param(&line_p);
-    if(res1 == LV_DRAW_MASK_RES_TRANSP) {
-        return LV_DRAW_MASK_RES_TRANSP;
+
+    while(param->edge_next < param->edge_cnt && param->edges[param->edge_next].y1 < y_sub_last) {
+        if(param->edges[param->edge_next].y2 > y_sub_first) {
+            param->active[active_cnt] = param->edge_next;
+            active_cnt++;
+        }
+        param->edge_next++;
     }
-    lv_draw_mask_line_points_init(&line_p, lines[1].p1.x, lines[1].p1.y, lines[1].p2.x, lines[1].p2.y,
-                                  LV_DRAW_MASK_LINE_SIDE_LEFT);
-    if(line_p.steep == 0 && line_p.flat) {
-        lv_coord_t x1 = LV_MIN(lines[1].p1.x, lines[1].p2.x);
-        lv_coord_t x2 = LV_MAX(lines[1].p1.x, lines[1].p2.x);
-        for(i = 0; i < len; i++) {
-            mask_buf[i] = mask_mix(mask_buf[i], (abs_x + i >= x1 && abs_x + i <= x2) * 0xFF);
+    param->active_cnt = active_cnt;
+
+    if(active_cnt == 0) return LV_DRAW_MASK_RES_TRANSP;
+
+    int32_t w = x_end - x_start + 1;
+    int32_t clip_x1 = x_start * 256;
+    int32_t clip_x2 = (x_end + 1) * 256;
+    lv_memzero(param->cover, (w + 1) * sizeof(int32_t));
+    lv_memzero(param->area, (w + 1) * sizeof(int32_t));
+
+    _lv_draw_mask_polygon_crossing_t * crossings = param->crossings;
+    int32_t s;
+    for(s = 0; s < POLYGON_SUBSAMPLE_CNT; s++) {
+        int32_t y_sub = y_sub_first + s * 2;
+
+        /*Collect the crossings on the sub-scanline sorted by X*/
+        uint32_t cnt = 0;
+        for(i = 0; i < active_cnt; i++) {
+            const _lv_draw_mask_polygon_edge_t * e = &param->edges[param->active[i]];
+            if(y_sub < e->y1 || y_sub >= e->y2) continue;
+
+            int32_t x = (int32_t)((e->x1 + e->slope * (y_sub - e->y1)) >> 24);
+            for(k = cnt; k > 0 && crossings[k - 1].x > x; k--) {
+                crossings[k] = crossings[k - 1];
+            }
+            crossings[k].x = x;
+            crossings[k].dir = e->dir;
+            cnt++;
+        }
+
+        if(param->cfg.fill_rule == LV_DRAW_POLYGON_FILL_EVEN_ODD) {
+            for(i = 0; i + 1 < cnt; i += 2) {
+                polygon_add_span(param, crossings[i].x, crossings[i + 1].x, clip_x1, clip_x2);
+            }
+        }
+        else {
+            int32_t winding = 0;
+            int32_t x_span = 0;
+            for(i = 0; i < cnt; i++) {
+                if(winding == 0) x_span = crossings[i].x;
+                winding += crossings[i].dir;
+                if(winding == 0) polygon_add_span(param, x_span, crossings[i].x, clip_x1, clip_x2);
+            }
         }
-        lv_draw_mask_free_param(&line_p);
-        return LV_DRAW_MASK_RES_CHANGED;
     }
-    lv_draw_mask_res_t res2 = lv_draw_mask_line(mask_buf, abs_x, abs_y, len, &line_p);
-    lv_draw_mask_free_param(&line_p);
-    if(res2 == LV_DRAW_MASK_RES_TRANSP) {
-        return LV_DRAW_MASK_RES_TRANSP;
+
+    /*Clear the pixels out of the polygon*/
+    if(x_start > abs_x) lv_memzero(mask_buf, x_start - abs_x);
+    if(x_end < abs_x + len - 1) lv_memzero(&mask_buf[x_end + 1 - abs_x], abs_x + len - 1 - x_end);
+
+    /*Sum up the coverage. A fully covered pixel has POLYGON_SUBSAMPLE_CNT * 256 coverage.*/
+    lv_opa_t * buf = &mask_buf[x_start - abs_x];
+    int32_t cover = 0;
+    lv_opa_t opa_and = LV_OPA_COVER;
+    lv_opa_t opa_or = LV_OPA_TRANSP;
+    int32_t x;
+    for(x = 0; x < w; x++) {
+        cover += param->cover[x];
+        int32_t v = cover + param->area[x];
+        lv_opa_t opa = v >= POLYGON_SUBSAMPLE_CNT * 256 ? LV_OPA_COVER : (lv_opa_t)(v / POLYGON_SUBSAMPLE_CNT);
+        buf[x] = mask_mix(buf[x], opa);
+        opa_and &= opa;
+        opa_or |= opa;
     }
-    if(res1 == LV_DRAW_MASK_RES_CHANGED || res2 == LV_DRAW_MASK_RES_CHANGED) return LV_DRAW_MASK_RES_CHANGED;
-    return res1;
+
+    if(opa_or == LV_OPA_TRANSP) return LV_DRAW_MASK_RES_TRANSP;
+    if(opa_and == LV_OPA_COVER && w == len) return LV_DRAW_MASK_RES_FULL_COVER;
+    return LV_DRAW_MASK_RES_CHANGED;
 }
+
+/**
+ * Add the coverage of a span of a sub-scanline to the row
+ * @param param     the polygon mask
+ * @param xa        start of the span (inclusive) in 24.8 fixed point format
+ * @param xb        end of the span (exclusive) in 24.8 fixed point format
+ * @param clip_x1   the first X coordinate of the row in 24.8 format
+ * @param clip_x2   the X coordinate after the row in 24.8 format
+ */
+LV_ATTRIBUTE_FAST_MEM static inline void polygon_add_span(lv_draw_mask_polygon_param_t * param, int32_t xa, int32_t xb,
+                                                          int32_t clip_x1, int32_t clip_x2)
+{
+    xa = LV_MAX(xa, clip_x1) - clip_x1;
+    xb = LV_MIN(xb, clip_x2) - clip_x1;
+    if(xa >= xb) return;
+
+    int32_t ia = xa >> 8;
+    int32_t ib = xb >> 8;
+    if(ia == ib) {
+        param->area[ia] += xb - xa;
+    }
+    else {
+        /*Partial coverage on the first and last pixels and full coverage between them*/
+        param->area[ia] += 256 - (xa & 0xFF);
+        param->cover[ia + 1] += 256;
+        param->cover[ib] -= 256;
+        param->area[ib] += xb & 0xFF;
+    }
+}
+
+/**
+ * Sort the edges by their top coordinate with shell sort
+ * @param edges     array of edges
+ * @param edge_cnt  number of edges
+ */
+static void polygon_sort_edges(_lv_draw_mask_polygon_edge_t * edges, uint32_t edge_cnt)
+{
+    uint32_t gap;
+    for(gap = edge_cnt / 2; gap > 0; gap /= 2) {
+        uint32_t i;
+        for(i = gap; i < edge_cnt; i++) {
+            _lv_draw_mask_polygon_edge_t tmp = edges[i];
+            uint32_t j;
+            for(j = i; j >= gap && edges[j - gap].y1 > tmp.y1; j -= gap) {
+                edges[j] = edges[j - gap];
+            }
+            edges[j] = tmp;
+        }
+    }
+}
+
 /**
  * Initialize the circle drawing
  * @param c pointer to a point. The coordinates will be calculated here
@@ -1528,5 +1686,109 @@ LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_
     return LV_UDIV255(mask_act * mask_new);// >> 8);
 }
 
+/*Mix a whole line with the same opacity*/
+LV_ATTRIBUTE_FAST_MEM static void mask_mix_opa(lv_opa_t * mask_buf, lv_opa_t opa, int32_t len)
+{
+    if(len <= 0 || opa >= LV_OPA_MAX) return;
+    if(opa <= LV_OPA_MIN) {
+        lv_memzero(mask_buf, len);
+        return;
+    }
+
+    int32_t i = 0;
+#if MASK_MIX_SIMD
+    lv_simd_u8_t zero = {0};
+    lv_simd_u16_t opa16 = (lv_simd_u16_t)LV_SIMD_U32(opa | (opa << 16));
+    for(; i + 16 <= len; i += 16) {
+        lv_simd_u8_t m = (lv_simd_u8_t)lv_simd_load_u32(&mask_buf[i]);
+        lv_simd_u16_t lo = (lv_simd_u16_t)LV_SIMD_SHUFFLE(lv_simd_u8_t, m, zero,
+                                                           0, 16, 1, 16, 2, 16, 3, 16, 4, 16, 5, 16, 6, 16, 7, 16);
+        lv_simd_u16_t hi = (lv_simd_u16_t)LV_SIMD_SHUFFLE(lv_simd_u8_t, m, zero,
+                                                           8, 16, 9, 16, 10, 16, 11, 16, 12, 16, 13, 16, 14, 16, 15, 16);
+        lo = lv_simd_udiv255_u16(lo * opa16);
+        hi = lv_simd_udiv255_u16(hi * opa16);
+        m = LV_SIMD_SHUFFLE(lv_simd_u8_t, (lv_simd_u8_t)lo, (lv_simd_u8_t)hi,
+                            0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+        lv_simd_store_u32(&mask_buf[i], (lv_simd_u32_t)m);
+    }
+#endif
+
+    for(; i < len; i++) {
+        mask_buf[i] = LV_UDIV255(mask_buf[i] * opa);
+    }
+}
+
+/*Mix a line with a line of an other mask. The same as calling `mask_mix` on each pixel.*/
+LV_ATTRIBUTE_FAST_MEM static void mask_mix_map(lv_opa_t * mask_buf, const lv_opa_t * map, int32_t len)
+{
+    int32_t i = 0;
+#if MASK_MIX_SIMD
+    lv_simd_u8_t zero = {0};
+    lv_simd_u8_t opa_max = (lv_simd_u8_t)LV_SIMD_U32(LV_OPA_MAX * 0x01010101U);
+    lv_simd_u8_t opa_min = (lv_simd_u8_t)LV_SIMD_U32(LV_OPA_MIN * 0x01010101U);
+    for(; i + 16 <= len; i += 16) {
+        lv_simd_u8_t m = (lv_simd_u8_t)lv_simd_load_u32(&mask_buf[i]);
+        lv_simd_u8_t n = (lv_simd_u8_t)lv_simd_load_u32(&map[i]);
+        lv_simd_u16_t m_lo = (lv_simd_u16_t)LV_SIMD_SHUFFLE(lv_simd_u8_t, m, zero,
+                                                             0, 16, 1, 16, 2, 16, 3, 16, 4, 16, 5, 16, 6, 16, 7, 16);
+        lv_simd_u16_t m_hi = (lv_simd_u16_t)LV_SIMD_SHUFFLE(lv_simd_u8_t, m, zero,
+                                                             8, 16, 9, 16, 10, 16, 11, 16, 12, 16, 13, 16, 14, 16, 15, 16);
+        lv_simd_u16_t n_lo = (lv_simd_u16_t)LV_SIMD_SHUFFLE(lv_simd_u8_t, n, zero,
+                                                             0, 16, 1, 16, 2, 16, 3, 16, 4, 16, 5, 16, 6, 16, 7, 16);
+        lv_simd_u16_t n_hi = (lv_simd_u16_t)LV_SIMD_SHUFFLE(lv_simd_u8_t, n, zero,
+                                                             8, 16, 9, 16, 10, 16, 11, 16, 12, 16, 13, 16, 14, 16, 15, 16);
+        m_lo = lv_simd_udiv255_u16(m_lo * n_lo);
+        m_hi = lv_simd_udiv255_u16(m_hi * n_hi);
+        lv_simd_u8_t res = LV_SIMD_SHUFFLE(lv_simd_u8_t, (lv_simd_u8_t)m_lo, (lv_simd_u8_t)m_hi,
+                                           0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+
+        /*Keep the original value where the new mask is opaque and clear where it's transparent*/
+        lv_simd_u8_t keep = (lv_simd_u8_t)(n >= opa_max);
+        lv_simd_u8_t clear = (lv_simd_u8_t)(n <= opa_min);
+        res = ((m & keep) | (res & ~keep)) & ~clear;
+        lv_simd_store_u32(&mask_buf[i], (lv_simd_u32_t)res);
+    }
+#endif
+
+    for(; i < len; i++) {
+        mask_buf[i] = mask_mix(mask_buf[i], map[i]);
+    }
+}
+
+/*Tell if a changed line became fully transparent or fully opaque*/
+LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t mask_line_res(const lv_opa_t * mask_buf, lv_coord_t len)
+{
+    if(len <= 0) return LV_DRAW_MASK_RES_CHANGED;
+
+    lv_coord_t span_len;
+    lv_draw_mask_res_t res = lv_draw_mask_get_span(mask_buf, len, &span_len);
+    return span_len == len ? res : LV_DRAW_MASK_RES_CHANGED;
+}
+
 
 #endif /*LV_USE_DRAW_MASKS*/
+
+/*The blend functions use it even without masks*/
+LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_get_span(const lv_opa_t * mask_buf, lv_coord_t len,
+                                                               lv_coord_t * span_len)
+{
+    lv_opa_t v = mask_buf[0];
+    lv_coord_t i = 1;
+
+    if(v != LV_OPA_TRANSP && v != LV_OPA_COVER) {
+        while(i < len && mask_buf[i] != LV_OPA_TRANSP && mask_buf[i] != LV_OPA_COVER) i++;
+        *span_len = i;
+        return LV_DRAW_MASK_RES_CHANGED;
+    }
+
+    /*Compare 4 values at once when aligned*/
+    while(i < len && ((lv_uintptr_t)&mask_buf[i] & 0x3) && mask_buf[i] == v) i++;
+    if(i < len && ((lv_uintptr_t)&mask_buf[i] & 0x3) == 0) {
+        uint32_t v32 = v == LV_OPA_COVER ? 0xFFFFFFFF : 0;
+        while(i + 4 <= len && *((const uint32_t *)&mask_buf[i]) == v32) i += 4;
+    }
+    while(i < len && mask_buf[i] == v) i++;
+
+    *span_len = i;
+    return v == LV_OPA_COVER ? LV_DRAW_MASK_RES_FULL_COVER : LV_DRAW_MASK_RES_TRANSP;
+}
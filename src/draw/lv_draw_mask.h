@@ -217,6 +217,19 @@ typedef struct _lv_draw_mask_map_param_t {
     } cfg;
 } lv_draw_mask_map_param_t;
 
+typedef struct {
+    int32_t y1;                 /*Top of the edge in 1/32 pixel units*/
+    int32_t y2;                 /*Bottom of the edge in 1/32 pixel units*/
+    int64_t x1;                 /*X coordinate on `y1` in 32.32 fixed point format*/
+    int64_t slope;              /*X change per 1/32 pixel in 32.32 fixed point format*/
+    int8_t dir;                 /*1: the edge goes downward, -1: upward*/
+} _lv_draw_mask_polygon_edge_t;
+
+typedef struct {
+    int32_t x;                  /*X coordinate in 24.8 fixed point format*/
+    int32_t dir;
+} _lv_draw_mask_polygon_crossing_t;
+
 typedef struct {
     /*The first element must be the common descriptor*/
     _lv_draw_mask_common_dsc_t dsc;
@@ -224,7 +237,20 @@ typedef struct {
     struct {
         lv_point_t * points;
         uint16_t point_cnt;
+        uint8_t fill_rule;          /*An element of `lv_draw_polygon_fill_rule_t`*/
     } cfg;
+
+    /*Scanline rasterizer state*/
+    _lv_draw_mask_polygon_edge_t * edges;   /*The non-horizontal edges sorted by their top*/
+    uint16_t * active;                      /*Index of the edges crossing the current row*/
+    _lv_draw_mask_polygon_crossing_t * crossings;
+    int32_t * cover;                        /*Coverage change at each pixel of a row*/
+    int32_t * area;                         /*Partial coverage of each pixel of a row*/
+    lv_area_t coords;                       /*Bounding box of the polygon*/
+    uint16_t edge_cnt;
+    uint16_t active_cnt;
+    uint16_t edge_next;                     /*The first edge which was not activated yet*/
+    lv_coord_t y_prev;                      /*The last processed row*/
 } lv_draw_mask_polygon_param_t;
 
 
@@ -250,7 +276,7 @@ int16_t lv_draw_mask_add(void * param, void * custom_id);
  * @param len length of the line to calculate (in pixel count)
  * @return One of these values:
  * - `LV_DRAW_MASK_RES_FULL_TRANSP`: the whole line is transparent. `mask_buf` is not set to zero
- * - `LV_DRAW_MASK_RES_FULL_COVER`: the whole line is fully visible. `mask_buf` is unchanged
+ * - `LV_DRAW_MASK_RES_FULL_COVER`: the whole line is fully visible. `mask_buf` is unchanged or all `LV_OPA_COVER`
  * - `LV_DRAW_MASK_RES_CHANGED`: `mask_buf` has changed, it shows the desired opacity of each pixel in the given line
  */
 LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
@@ -266,7 +292,7 @@ LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply(lv_opa_t * mask_buf,
  * @param ids_count number of ID array
  * @return One of these values:
  * - `LV_DRAW_MASK_RES_FULL_TRANSP`: the whole line is transparent. `mask_buf` is not set to zero
- * - `LV_DRAW_MASK_RES_FULL_COVER`: the whole line is fully visible. `mask_buf` is unchanged
+ * - `LV_DRAW_MASK_RES_FULL_COVER`: the whole line is fully visible. `mask_buf` is unchanged or all `LV_OPA_COVER`
  * - `LV_DRAW_MASK_RES_CHANGED`: `mask_buf` has changed, it shows the desired opacity of each pixel in the given line
  */
 LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_apply_ids(lv_opa_t * mask_buf, lv_coord_t abs_x, lv_coord_t abs_y,
@@ -391,10 +417,33 @@ void lv_draw_mask_fade_init(lv_draw_mask_fade_param_t * param, const lv_area_t *
  */
 void lv_draw_mask_map_init(lv_draw_mask_map_param_t * param, const lv_area_t * coords, const lv_opa_t * map);
 
+/**
+ * Initialize a polygon mask. Concave and self-intersecting polygons are supported too.
+ * The edges are anti-aliased and the points are considered to be in the center of the pixels.
+ * By default the inside of the polygon is determined by the non-zero rule,
+ * set `param->cfg.fill_rule` to `LV_DRAW_POLYGON_FILL_EVEN_ODD` to use the even-odd rule.
+ * @param param pointer to a `lv_draw_mask_param_t` to initialize
+ * @param points array of the points of the polygon (absolute coordinates)
+ * @param point_cnt number of points
+ */
 void lv_draw_mask_polygon_init(lv_draw_mask_polygon_param_t * param, const lv_point_t * points, uint16_t point_cnt);
 
 #endif /*LV_USE_DRAW_MASKS*/
 
+/**
+ * Get the run of similar mask values at the beginning of a mask line.
+ * Used by the blend functions to skip or simply fill the fully transparent and fully covered parts.
+ * @param mask_buf the mask line
+ * @param len length of the mask line, has to be greater than 0
+ * @param span_len store the length of the run here
+ * @return One of these values:
+ * - `LV_DRAW_MASK_RES_TRANSP`: all the values in the run are `LV_OPA_TRANSP`
+ * - `LV_DRAW_MASK_RES_FULL_COVER`: all the values in the run are `LV_OPA_COVER`
+ * - `LV_DRAW_MASK_RES_CHANGED`: none of the values in the run are `LV_OPA_TRANSP` or `LV_OPA_COVER`
+ */
+LV_ATTRIBUTE_FAST_MEM lv_draw_mask_res_t lv_draw_mask_get_span(const lv_opa_t * mask_buf, lv_coord_t len,
+                                                               lv_coord_t * span_len);
+
 /**********************
  *      MACROS
  **********************/
@@ -29,9 +29,24 @@ LV_EXPORT_CONST_INT(LV_RADIUS_CIRCLE);
  *      TYPEDEFS
  **********************/
 
+/**
+ * Determines which parts of a self-intersecting polygon are inside.
+ */
+enum _lv_draw_polygon_fill_rule_t {
+    LV_DRAW_POLYGON_FILL_NON_ZERO = 0,  /**< Fill where the edges around the point don't cancel each other*/
+    LV_DRAW_POLYGON_FILL_EVEN_ODD,      /**< Fill where a ray from the point crosses odd number of edges*/
+};
+
+#ifdef DOXYGEN
+typedef _lv_draw_polygon_fill_rule_t lv_draw_polygon_fill_rule_t;
+#else
+typedef uint8_t lv_draw_polygon_fill_rule_t;
+#endif /*DOXYGEN*/
+
 typedef struct {
     lv_coord_t radius;
     lv_blend_mode_t blend_mode;
+    lv_draw_polygon_fill_rule_t fill_rule;  /**< Used only by `lv_draw_polygon()`*/
 
     /*Background*/
     lv_opa_t bg_opa;
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "lv_img_cache.h"
+#include "lv_img_transform_cache.h"
 
 /*********************
  *      DEFINES
@@ -62,6 +63,8 @@ void lv_img_cache_invalidate_src(const void * src)
 {
     LV_ASSERT_NULL(img_cache_manager.invalidate_src_cb);
     img_cache_manager.invalidate_src_cb(src);
+
+    lv_img_transform_cache_invalidate_src(src);
 }
 
 /**********************
@@ -0,0 +1,554 @@
+/**
+ * @file lv_img_transform_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_img_transform_cache.h"
+#include "lv_draw.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_gc.h"
+#include "../misc/lv_mem.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void key_init(_lv_img_transform_cache_key_t * key, const lv_img_decoder_dsc_t * dec_dsc,
+                     const lv_draw_img_dsc_t * draw_dsc, const lv_area_t * coords);
+static bool key_eq(const _lv_img_transform_cache_key_t * key1, const _lv_img_transform_cache_key_t * key2);
+static bool entry_match_src(const _lv_img_transform_cache_entry_t * entry, const void * src);
+static _lv_img_transform_cache_entry_t * entry_create(lv_draw_ctx_t * draw_ctx, const lv_img_decoder_dsc_t * dec_dsc,
+                                                      const lv_draw_img_dsc_t * draw_dsc, const lv_draw_img_sup_t * sup,
+                                                      const _lv_img_transform_cache_key_t * key);
+static uint32_t entry_get_size(const lv_img_decoder_dsc_t * dec_dsc, uint32_t buf_size);
+static bool make_room(uint32_t size, const uint8_t * keep_buf);
+static _lv_img_transform_cache_entry_t * entry_add(const lv_img_decoder_dsc_t * dec_dsc,
+                                                   const _lv_img_transform_cache_key_t * key,
+                                                   const lv_area_t * area, uint8_t * buf, uint32_t size);
+static void entry_remove(_lv_img_transform_cache_entry_t * entry);
+static void to_native_alpha(uint8_t * dest, const lv_color_t * cbuf, const lv_opa_t * abuf, uint32_t px_cnt);
+#if LV_USE_IMG_MIPMAP
+static const _lv_img_transform_cache_entry_t * mipmap_get_level(const lv_img_decoder_dsc_t * dec_dsc,
+                                                                  _lv_img_transform_cache_key_t * key, uint8_t level);
+static void mipmap_downscale(uint8_t * dest, const uint8_t * src, lv_coord_t src_w, lv_coord_t dest_w,
+                             lv_coord_t dest_h, lv_color_format_t cf);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t max_size;
+static uint32_t used_size;
+static uint32_t hit_cnt;
+static uint32_t miss_cnt;
+static uint32_t evict_cnt;
+
+/*The last transformation which wasn't found in the cache*/
+static _lv_img_transform_cache_key_t last_miss;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_img_transform_cache_init(void)
+{
+    _lv_ll_init(&LV_GC_ROOT(_lv_img_transform_cache_ll), sizeof(_lv_img_transform_cache_entry_t));
+    max_size = LV_IMG_TRANSFORM_CACHE_SIZE;
+    used_size = 0;
+    hit_cnt = 0;
+    miss_cnt = 0;
+    evict_cnt = 0;
+    lv_memzero(&last_miss, sizeof(last_miss));
+}
+
+const _lv_img_transform_cache_entry_t * _lv_img_transform_cache_get(lv_draw_ctx_t * draw_ctx,
+                                                                     const lv_img_decoder_dsc_t * dec_dsc,
+                                                                     const lv_draw_img_dsc_t * draw_dsc,
+                                                                     const lv_area_t * coords,
+                                                                     const lv_draw_img_sup_t * sup)
+{
+    if(max_size == 0) return NULL;
+    if(dec_dsc->img_data == NULL) return NULL;
+    if(draw_ctx->draw_transform == NULL) return NULL;
+
+    /*The result of the transformation is stored as NATIVE_ALPHA, so only the formats
+     *which can be transformed into colors and alpha values are supported*/
+    lv_color_format_t cf = dec_dsc->header.cf;
+    if(cf != LV_COLOR_FORMAT_NATIVE && cf != LV_COLOR_FORMAT_NATIVE_ALPHA &&
+       cf != LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED &&
+       !(cf == LV_COLOR_FORMAT_RGB565A8 && LV_COLOR_DEPTH == 16)) {
+        return NULL;
+    }
+
+    _lv_img_transform_cache_key_t key;
+    key_init(&key, dec_dsc, draw_dsc, coords);
+
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_transform_cache_ll);
+    _lv_img_transform_cache_entry_t * entry;
+    _LV_LL_READ(ll, entry) {
+        if(key_eq(&entry->key, &key)) {
+            /*Keep the recently used entries at the head*/
+            _lv_ll_move_before(ll, entry, _lv_ll_get_head(ll));
+            hit_cnt++;
+            return entry;
+        }
+    }
+
+    miss_cnt++;
+
+    /*Cache only if the same transformation is used again.
+     *This way continuously changing transformations don't flush the cache.*/
+    if(!key_eq(&last_miss, &key)) {
+        last_miss = key;
+        return NULL;
+    }
+
+    lv_memzero(&last_miss, sizeof(last_miss));
+    return entry_create(draw_ctx, dec_dsc, draw_dsc, sup, &key);
+}
+
+bool _lv_img_transform_cache_get_mipmap(const lv_img_decoder_dsc_t * dec_dsc, const lv_draw_img_dsc_t * draw_dsc,
+                                        const lv_area_t * coords, lv_img_decoder_dsc_t * mip_dec_dsc,
+                                        lv_draw_img_dsc_t * mip_draw_dsc, lv_area_t * mip_coords)
+{
+#if LV_USE_IMG_MIPMAP
+    if(max_size == 0) return false;
+    if(draw_dsc->zoom >= LV_ZOOM_NONE / 2) return false;
+    if(dec_dsc->img_data == NULL) return false;
+
+    lv_color_format_t cf = dec_dsc->header.cf;
+    if(cf != LV_COLOR_FORMAT_NATIVE && cf != LV_COLOR_FORMAT_NATIVE_ALPHA &&
+       cf != LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED) return false;
+
+    /*Use the level which is zoomed in the (50%, 100%] range*/
+    uint8_t level = 0;
+    while((draw_dsc->zoom << (level + 1)) <= LV_ZOOM_NONE) level++;
+
+    _lv_img_transform_cache_key_t key;
+    key_init(&key, dec_dsc, draw_dsc, coords);
+    key.angle = 0;
+    key.zoom = 0;
+    key.pivot.x = 0;
+    key.pivot.y = 0;
+    key.antialias = 0;
+
+    /*Smaller images are not worth it*/
+    while(level > 0 && ((key.w >> level) < 2 || (key.h >> level) < 2)) level--;
+    if(level == 0) return false;
+
+    const _lv_img_transform_cache_entry_t * entry = mipmap_get_level(dec_dsc, &key, level);
+    if(entry == NULL) return false;
+
+    lv_coord_t mip_w = lv_area_get_width(&entry->area);
+    lv_coord_t mip_h = lv_area_get_height(&entry->area);
+
+    *mip_dec_dsc = *dec_dsc;
+    mip_dec_dsc->img_data = entry->buf;
+    mip_dec_dsc->header.w = mip_w;
+    mip_dec_dsc->header.h = mip_h;
+
+    /*Keep the pivot on the same place on the screen*/
+    *mip_draw_dsc = *draw_dsc;
+    mip_draw_dsc->zoom = draw_dsc->zoom << level;
+    mip_draw_dsc->pivot.x = draw_dsc->pivot.x >> level;
+    mip_draw_dsc->pivot.y = draw_dsc->pivot.y >> level;
+
+    mip_coords->x1 = coords->x1 + draw_dsc->pivot.x - mip_draw_dsc->pivot.x;
+    mip_coords->y1 = coords->y1 + draw_dsc->pivot.y - mip_draw_dsc->pivot.y;
+    mip_coords->x2 = mip_coords->x1 + mip_w - 1;
+    mip_coords->y2 = mip_coords->y1 + mip_h - 1;
+
+    return true;
+#else
+    LV_UNUSED(dec_dsc);
+    LV_UNUSED(draw_dsc);
+    LV_UNUSED(coords);
+    LV_UNUSED(mip_dec_dsc);
+    LV_UNUSED(mip_draw_dsc);
+    LV_UNUSED(mip_coords);
+    return false;
+#endif
+}
+
+void lv_img_transform_cache_set_size(uint32_t new_size)
+{
+    max_size = new_size;
+
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_transform_cache_ll);
+    while(used_size > max_size) {
+        entry_remove(_lv_ll_get_tail(ll));
+        evict_cnt++;
+    }
+}
+
+void lv_img_transform_cache_invalidate_src(const void * src)
+{
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_transform_cache_ll);
+    _lv_img_transform_cache_entry_t * entry = _lv_ll_get_head(ll);
+    while(entry) {
+        _lv_img_transform_cache_entry_t * entry_next = _lv_ll_get_next(ll, entry);
+        if(src == NULL || entry_match_src(entry, src)) {
+            entry_remove(entry);
+        }
+        entry = entry_next;
+    }
+
+    lv_memzero(&last_miss, sizeof(last_miss));
+}
+
+void lv_img_transform_cache_get_stats(lv_img_transform_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    stats->hit_cnt = hit_cnt;
+    stats->miss_cnt = miss_cnt;
+    stats->evict_cnt = evict_cnt;
+    stats->entry_cnt = _lv_ll_get_len(&LV_GC_ROOT(_lv_img_transform_cache_ll));
+    stats->used_size = used_size;
+    stats->max_size = max_size;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void key_init(_lv_img_transform_cache_key_t * key, const lv_img_decoder_dsc_t * dec_dsc,
+                     const lv_draw_img_dsc_t * draw_dsc, const lv_area_t * coords)
+{
+    lv_memzero(key, sizeof(_lv_img_transform_cache_key_t));
+    key->src = dec_dsc->src;
+    /*The data of a variable image might be replaced while keeping the same descriptor*/
+    key->src_data = dec_dsc->src_type == LV_IMG_SRC_VARIABLE ? dec_dsc->img_data : NULL;
+    key->frame_id = dec_dsc->frame_id;
+    key->color = dec_dsc->color;
+    key->w = lv_area_get_width(coords);
+    key->h = lv_area_get_height(coords);
+    key->angle = draw_dsc->angle;
+    key->zoom = draw_dsc->zoom;
+    key->pivot = draw_dsc->pivot;
+    key->cf = dec_dsc->header.cf;
+    key->antialias = draw_dsc->antialias;
+}
+
+/**
+ * Compare two keys. If `key1` has a `src_path` the paths are compared instead of the `src` pointers.
+ */
+static bool key_eq(const _lv_img_transform_cache_key_t * key1, const _lv_img_transform_cache_key_t * key2)
+{
+    if(key1->src_path) {
+        if(lv_img_src_get_type(key2->src) != LV_IMG_SRC_FILE) return false;
+        if(strcmp(key1->src_path, key2->src) != 0) return false;
+    }
+    else if(key1->src != key2->src) {
+        return false;
+    }
+
+    return key1->src_data == key2->src_data &&
+           key1->mip_level == key2->mip_level &&
+           key1->frame_id == key2->frame_id &&
+           lv_color_eq(key1->color, key2->color) &&
+           key1->w == key2->w &&
+           key1->h == key2->h &&
+           key1->angle == key2->angle &&
+           key1->zoom == key2->zoom &&
+           key1->pivot.x == key2->pivot.x &&
+           key1->pivot.y == key2->pivot.y &&
+           key1->cf == key2->cf &&
+           key1->antialias == key2->antialias;
+}
+
+static bool entry_match_src(const _lv_img_transform_cache_entry_t * entry, const void * src)
+{
+    if(entry->key.src_path) {
+        return lv_img_src_get_type(src) == LV_IMG_SRC_FILE && strcmp(entry->key.src_path, src) == 0;
+    }
+
+    return entry->key.src == src;
+}
+
+static _lv_img_transform_cache_entry_t * entry_create(lv_draw_ctx_t * draw_ctx, const lv_img_decoder_dsc_t * dec_dsc,
+                                                      const lv_draw_img_dsc_t * draw_dsc, const lv_draw_img_sup_t * sup,
+                                                      const _lv_img_transform_cache_key_t * key)
+{
+    lv_area_t area;
+    _lv_img_buf_get_transformed_area(&area, key->w, key->h, key->angle, key->zoom, &key->pivot);
+
+    uint32_t buf_size = lv_area_get_size(&area) * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+    uint32_t size = entry_get_size(dec_dsc, buf_size);
+
+    /*The source can be a mipmap level in the cache too, don't drop it*/
+    if(!make_room(size, dec_dsc->img_data)) {
+        LV_LOG_INFO("the transformed image doesn't fit into the cache (%"LV_PRIu32" bytes)", size);
+        return NULL;
+    }
+
+    lv_coord_t area_w = lv_area_get_width(&area);
+    uint8_t * buf = lv_malloc(buf_size);
+    lv_color_t * cbuf = lv_malloc(area_w * sizeof(lv_color_t));
+    lv_opa_t * abuf = lv_malloc(area_w);
+    if(buf == NULL || cbuf == NULL || abuf == NULL) {
+        LV_LOG_WARN("couldn't allocate memory for the transformed image");
+        lv_free(buf);
+        lv_free(cbuf);
+        lv_free(abuf);
+        return NULL;
+    }
+
+    /*Transform line-by-line to need only one line of temporary buffers*/
+    lv_area_t line;
+    lv_area_copy(&line, &area);
+    uint8_t * buf_line = buf;
+    for(line.y1 = area.y1; line.y1 <= area.y2; line.y1++) {
+        line.y2 = line.y1;
+        lv_draw_transform(draw_ctx, &line, dec_dsc->img_data, key->w, key->h, key->w,
+                          draw_dsc, sup, key->cf, cbuf, abuf);
+        to_native_alpha(buf_line, cbuf, abuf, area_w);
+        buf_line += area_w * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+    }
+
+    lv_free(cbuf);
+    lv_free(abuf);
+
+    return entry_add(dec_dsc, key, &area, buf, size);
+}
+
+static uint32_t entry_get_size(const lv_img_decoder_dsc_t * dec_dsc, uint32_t buf_size)
+{
+    uint32_t path_size = dec_dsc->src_type == LV_IMG_SRC_FILE ? strlen(dec_dsc->src) + 1 : 0;
+    return sizeof(_lv_img_transform_cache_entry_t) + buf_size + path_size;
+}
+
+/**
+ * Drop the least recently used entries to have `size` bytes free.
+ * The entry whose buffer is `keep_buf` is not dropped.
+ */
+static bool make_room(uint32_t size, const uint8_t * keep_buf)
+{
+    if(size > max_size) return false;
+
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_transform_cache_ll);
+    _lv_img_transform_cache_entry_t * entry = _lv_ll_get_tail(ll);
+    while(entry && used_size + size > max_size) {
+        _lv_img_transform_cache_entry_t * entry_prev = _lv_ll_get_prev(ll, entry);
+        if(entry->buf != keep_buf) {
+            entry_remove(entry);
+            evict_cnt++;
+        }
+        entry = entry_prev;
+    }
+
+    return used_size + size <= max_size;
+}
+
+/**
+ * Add a new entry to the head of the cache. `buf` is freed on error.
+ */
+static _lv_img_transform_cache_entry_t * entry_add(const lv_img_decoder_dsc_t * dec_dsc,
+                                                   const _lv_img_transform_cache_key_t * key,
+                                                   const lv_area_t * area, uint8_t * buf, uint32_t size)
+{
+    char * src_path = NULL;
+    if(dec_dsc->src_type == LV_IMG_SRC_FILE) {
+        size_t path_size = strlen(dec_dsc->src) + 1;
+        src_path = lv_malloc(path_size);
+        LV_ASSERT_MALLOC(src_path);
+        if(src_path == NULL) {
+            lv_free(buf);
+            return NULL;
+        }
+        lv_memcpy(src_path, dec_dsc->src, path_size);
+    }
+
+    _lv_img_transform_cache_entry_t * entry = _lv_ll_ins_head(&LV_GC_ROOT(_lv_img_transform_cache_ll));
+    LV_ASSERT_MALLOC(entry);
+    if(entry == NULL) {
+        lv_free(buf);
+        lv_free(src_path);
+        return NULL;
+    }
+
+    entry->key = *key;
+    if(src_path) {
+        entry->key.src = NULL;
+        entry->key.src_path = src_path;
+    }
+    entry->area = *area;
+    entry->buf = buf;
+    entry->size = size;
+    used_size += size;
+
+    return entry;
+}
+
+static void entry_remove(_lv_img_transform_cache_entry_t * entry)
+{
+    used_size -= entry->size;
+    lv_free(entry->buf);
+    lv_free(entry->key.src_path);
+    _lv_ll_remove(&LV_GC_ROOT(_lv_img_transform_cache_ll), entry);
+    lv_free(entry);
+}
+
+static void to_native_alpha(uint8_t * dest, const lv_color_t * cbuf, const lv_opa_t * abuf, uint32_t px_cnt)
+{
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+#if LV_COLOR_DEPTH == 8
+        dest[0] = lv_color_to_int(cbuf[i]);
+#elif LV_COLOR_DEPTH == 16
+        uint16_t c = lv_color_to_int(cbuf[i]);
+        dest[0] = c & 0xFF;
+        dest[1] = c >> 8;
+#elif LV_COLOR_DEPTH == 24 || LV_COLOR_DEPTH == 32
+        dest[0] = cbuf[i].blue;
+        dest[1] = cbuf[i].green;
+        dest[2] = cbuf[i].red;
+#endif
+        dest[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS] = abuf[i];
+        dest += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+    }
+}
+
+#if LV_USE_IMG_MIPMAP
+
+/**
+ * Get a mipmap level from the cache or create it from the previous level.
+ */
+static const _lv_img_transform_cache_entry_t * mipmap_get_level(const lv_img_decoder_dsc_t * dec_dsc,
+                                                                  _lv_img_transform_cache_key_t * key, uint8_t level)
+{
+    key->mip_level = level;
+
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_img_transform_cache_ll);
+    _lv_img_transform_cache_entry_t * entry;
+    _LV_LL_READ(ll, entry) {
+        if(key_eq(&entry->key, key)) {
+            _lv_ll_move_before(ll, entry, _lv_ll_get_head(ll));
+            hit_cnt++;
+            return entry;
+        }
+    }
+
+    miss_cnt++;
+
+    const uint8_t * src_buf = dec_dsc->img_data;
+    lv_coord_t src_w = key->w;
+    lv_coord_t src_h = key->h;
+    if(level > 1) {
+        const _lv_img_transform_cache_entry_t * entry_prev = mipmap_get_level(dec_dsc, key, level - 1);
+        key->mip_level = level;
+        if(entry_prev == NULL) return NULL;
+        src_buf = entry_prev->buf;
+        src_w = lv_area_get_width(&entry_prev->area);
+        src_h = lv_area_get_height(&entry_prev->area);
+    }
+
+    lv_area_t area;
+    lv_area_set(&area, 0, 0, src_w / 2 - 1, src_h / 2 - 1);
+
+    uint32_t px_size = key->cf == LV_COLOR_FORMAT_NATIVE ? sizeof(lv_color_t) : LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+    uint32_t buf_size = lv_area_get_size(&area) * px_size;
+    uint32_t size = entry_get_size(dec_dsc, buf_size);
+    if(!make_room(size, src_buf)) return NULL;
+
+    uint8_t * buf = lv_malloc(buf_size);
+    if(buf == NULL) {
+        LV_LOG_WARN("couldn't allocate memory for the mipmap");
+        return NULL;
+    }
+
+    mipmap_downscale(buf, src_buf, src_w, lv_area_get_width(&area), lv_area_get_height(&area), key->cf);
+
+    return entry_add(dec_dsc, key, &area, buf, size);
+}
+
+/**
+ * Create the next mipmap level by averaging 2x2 pixels.
+ * The colors are weighted by the alpha to avoid dark edges around transparent areas.
+ * Premultiplied colors are already weighted so they are simply averaged.
+ */
+static void mipmap_downscale(uint8_t * dest, const uint8_t * src, lv_coord_t src_w, lv_coord_t dest_w,
+                             lv_coord_t dest_h, lv_color_format_t cf)
+{
+    bool premult = cf == LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED;
+    bool has_alpha = cf == LV_COLOR_FORMAT_NATIVE_ALPHA || premult;
+    uint32_t px_size = has_alpha ? LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE : sizeof(lv_color_t);
+    uint32_t src_stride = src_w * px_size;
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < dest_h; y++) {
+        const uint8_t * src_line = src + 2 * y * src_stride;
+        for(x = 0; x < dest_w; x++) {
+            const uint8_t * px[4];
+            px[0] = src_line + 2 * x * px_size;
+            px[1] = px[0] + px_size;
+            px[2] = px[0] + src_stride;
+            px[3] = px[2] + px_size;
+
+            uint32_t r = 0;
+            uint32_t g = 0;
+            uint32_t b = 0;
+            uint32_t a_sum = 0;
+            uint32_t w_sum = 0;
+            uint32_t i;
+            for(i = 0; i < 4; i++) {
+                lv_color_t c;
+#if LV_COLOR_DEPTH == 16
+                lv_color_set_int(&c, px[i][0] + (px[i][1] << 8));
+#else
+                lv_memcpy(&c, px[i], sizeof(lv_color_t));
+#endif
+                uint32_t a = has_alpha ? px[i][LV_COLOR_FORMAT_NATIVE_ALPHA_OFS] : 0xFF;
+                uint32_t w = premult ? 1 : a;
+#if LV_COLOR_DEPTH == 8
+                r += lv_color_to_int(c) * w;
+#else
+                r += LV_COLOR_GET_R(c) * w;
+                g += LV_COLOR_GET_G(c) * w;
+                b += LV_COLOR_GET_B(c) * w;
+#endif
+                a_sum += a;
+                w_sum += w;
+            }
+
+            lv_color_t res = lv_color_black();
+            if(w_sum) {
+#if LV_COLOR_DEPTH == 8
+                lv_color_set_int(&res, r / w_sum);
+                LV_UNUSED(g);
+                LV_UNUSED(b);
+#else
+                LV_COLOR_SET_R(res, r / w_sum);
+                LV_COLOR_SET_G(res, g / w_sum);
+                LV_COLOR_SET_B(res, b / w_sum);
+#endif
+            }
+
+#if LV_COLOR_DEPTH == 16
+            uint16_t res_int = lv_color_to_int(res);
+            dest[0] = res_int & 0xFF;
+            dest[1] = res_int >> 8;
+#else
+            lv_memcpy(dest, &res, sizeof(lv_color_t));
+#endif
+            if(has_alpha) dest[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS] = (a_sum + 2) >> 2;
+            dest += px_size;
+        }
+    }
+}
+
+#endif /*LV_USE_IMG_MIPMAP*/
@@ -0,0 +1,139 @@
+/**
+ * @file lv_img_transform_cache.h
+ *
+ */
+
+#ifndef LV_IMG_TRANSFORM_CACHE_H
+#define LV_IMG_TRANSFORM_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../misc/lv_area.h"
+#include "lv_img_decoder.h"
+#include "lv_draw_img.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_draw_ctx_t;
+
+/**
+ * Rotating and zooming an image is expensive and static rotated or zoomed images
+ * would be transformed again and again in every refresh.
+ *
+ * To avoid it the result of the transformation can be cached.
+ * The entries are stored in `LV_COLOR_FORMAT_NATIVE_ALPHA` format.
+ */
+typedef struct {
+    const void * src;           /**< The image source as passed to the decoder. Not used for files*/
+    char * src_path;            /**< Copy of the path for file sources, else `NULL`*/
+    const uint8_t * src_data;   /**< The decoded data of variable sources*/
+    int32_t frame_id;
+    lv_color_t color;
+    lv_coord_t w;
+    lv_coord_t h;
+    int16_t angle;
+    uint16_t zoom;
+    lv_point_t pivot;
+    lv_color_format_t cf;
+    uint8_t antialias;
+    uint8_t mip_level;          /**< 0: transformed image, >0: the image downscaled by 2^mip_level*/
+} _lv_img_transform_cache_key_t;
+
+typedef struct {
+    _lv_img_transform_cache_key_t key;
+    lv_area_t area;             /**< The transformed area relative to the image's coordinates*/
+    uint8_t * buf;              /**< The transformed pixels in `LV_COLOR_FORMAT_NATIVE_ALPHA` format*/
+    uint32_t size;              /**< Memory used by the entry in bytes*/
+} _lv_img_transform_cache_entry_t;
+
+typedef struct {
+    uint32_t hit_cnt;           /**< Number of times a cached transformation was used*/
+    uint32_t miss_cnt;          /**< Number of times the image had to be transformed*/
+    uint32_t evict_cnt;         /**< Number of entries dropped to free space*/
+    uint32_t entry_cnt;         /**< Number of cached transformations*/
+    uint32_t used_size;         /**< Memory used by the cached transformations in bytes*/
+    uint32_t max_size;          /**< The memory budget in bytes*/
+} lv_img_transform_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the transformed image cache. Called by `lv_init()`.
+ */
+void _lv_img_transform_cache_init(void);
+
+/**
+ * Get the cached transformation of an image or create it if the same transformation was requested
+ * last time too. Transformations which are always changing (e.g. an animated rotation) are not cached.
+ * @param draw_ctx  draw context to use for the transformation
+ * @param dec_dsc   the opened image
+ * @param draw_dsc  the draw descriptor with angle, zoom, pivot and antialias
+ * @param coords    the coordinates of the image (without transformation)
+ * @param sup       palette, chroma key and similar info about the source image
+ * @return          the cache entry or `NULL` if the image should be drawn without the cache
+ */
+const _lv_img_transform_cache_entry_t * _lv_img_transform_cache_get(struct _lv_draw_ctx_t * draw_ctx,
+                                                                     const lv_img_decoder_dsc_t * dec_dsc,
+                                                                     const lv_draw_img_dsc_t * draw_dsc,
+                                                                     const lv_area_t * coords,
+                                                                     const lv_draw_img_sup_t * sup);
+
+/**
+ * Get a downscaled copy (mipmap level) of an image if it's zoomed out below 50%.
+ * The levels are created on demand by averaging 2x2 pixels of the previous level and stored in the cache.
+ * @param dec_dsc       the opened image
+ * @param draw_dsc      the draw descriptor with the zoom and pivot
+ * @param coords        the coordinates of the image
+ * @param mip_dec_dsc   store the descriptor of the downscaled image here
+ * @param mip_draw_dsc  store the draw descriptor adjusted to the downscaled image here
+ * @param mip_coords    store the coordinates of the downscaled image here
+ * @return              true: draw the downscaled image instead of the original
+ */
+bool _lv_img_transform_cache_get_mipmap(const lv_img_decoder_dsc_t * dec_dsc, const lv_draw_img_dsc_t * draw_dsc,
+                                        const lv_area_t * coords, lv_img_decoder_dsc_t * mip_dec_dsc,
+                                        lv_draw_img_dsc_t * mip_draw_dsc, lv_area_t * mip_coords);
+
+/**
+ * Set the memory budget of the transformed image cache.
+ * Entries are dropped in least recently used order to fit into the new size.
+ * @param new_size  the maximal memory usage in bytes. 0: disable caching
+ */
+void lv_img_transform_cache_set_size(uint32_t new_size);
+
+/**
+ * Drop the cached transformations of an image source.
+ * Called by `lv_img_cache_invalidate_src()` too.
+ * @param src   an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ *              `NULL` to drop all the entries.
+ */
+void lv_img_transform_cache_invalidate_src(const void * src);
+
+/**
+ * Get the statistics of the transformed image cache
+ * @param stats store the result here
+ */
+void lv_img_transform_cache_get_stats(lv_img_transform_cache_stats_t * stats);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_IMG_TRANSFORM_CACHE_H*/
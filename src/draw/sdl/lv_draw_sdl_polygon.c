@@ -48,25 +48,16 @@ void lv_draw_sdl_polygon(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dr
 
     lv_draw_mask_polygon_param_t polygon_param;
     lv_draw_mask_polygon_init(&polygon_param, points, point_cnt);
+    polygon_param.cfg.fill_rule = draw_dsc->fill_rule;
 
-    if(polygon_param.cfg.point_cnt < 3) {
+    if(polygon_param.edge_cnt == 0) {
         lv_draw_mask_free_param(&polygon_param);
         return;
     }
 
-    lv_area_t poly_coords = {.x1 = LV_COORD_MAX, .y1 = LV_COORD_MAX, .x2 = LV_COORD_MIN, .y2 = LV_COORD_MIN};
-
-    uint16_t i;
-    for(i = 0; i < point_cnt; i++) {
-        poly_coords.x1 = LV_MIN(poly_coords.x1, polygon_param.cfg.points[i].x);
-        poly_coords.y1 = LV_MIN(poly_coords.y1, polygon_param.cfg.points[i].y);
-        poly_coords.x2 = LV_MAX(poly_coords.x2, polygon_param.cfg.points[i].x);
-        poly_coords.y2 = LV_MAX(poly_coords.y2, polygon_param.cfg.points[i].y);
-    }
-
     bool is_common;
     lv_area_t draw_area;
-    is_common = _lv_area_intersect(&draw_area, &poly_coords, draw_ctx->clip_area);
+    is_common = _lv_area_intersect(&draw_area, &polygon_param.coords, draw_ctx->clip_area);
     if(!is_common) {
         lv_draw_mask_free_param(&polygon_param);
         return;
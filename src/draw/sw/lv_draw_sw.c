@@ -10,6 +10,7 @@
 #if LV_USE_DRAW_SW
 
 #include "lv_draw_sw.h"
+#include "lv_draw_sw_simd.h"
 
 /*********************
  *      DEFINES
@@ -22,6 +23,7 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void buf_zero(uint8_t * buf, uint32_t len);
 
 /**********************
  *  GLOBAL PROTOTYPES
@@ -49,6 +51,7 @@ void lv_draw_sw_init_ctx(lv_disp_t * disp, lv_draw_ctx_t * draw_ctx)
     draw_sw_ctx->base_draw.draw_arc = lv_draw_sw_arc;
     draw_sw_ctx->base_draw.draw_rect = lv_draw_sw_rect;
     draw_sw_ctx->base_draw.draw_letter = lv_draw_sw_letter;
+    draw_sw_ctx->base_draw.draw_letters = lv_draw_sw_letters;
     draw_sw_ctx->base_draw.draw_img_decoded = lv_draw_sw_img_decoded;
     draw_sw_ctx->base_draw.draw_line = lv_draw_sw_line;
     draw_sw_ctx->base_draw.draw_polygon = lv_draw_sw_polygon;
@@ -108,11 +111,51 @@ void lv_draw_sw_buffer_copy(lv_draw_ctx_t * draw_ctx,
     }
 }
 
+void lv_draw_sw_rgb565_swap(void * buf, uint32_t buf_size_px)
+{
+    uint16_t * buf16 = buf;
+    uint32_t i = 0;
+
+#if LV_USE_DRAW_SW_SIMD
+    for(; i + 16 <= buf_size_px; i += 16) {
+        lv_simd_u16_t c0 = (lv_simd_u16_t)lv_simd_load_u32(&buf16[i]);
+        lv_simd_u16_t c1 = (lv_simd_u16_t)lv_simd_load_u32(&buf16[i + 8]);
+        lv_simd_store_u32(&buf16[i], (lv_simd_u32_t)((c0 >> 8) | (c0 << 8)));
+        lv_simd_store_u32(&buf16[i + 8], (lv_simd_u32_t)((c1 >> 8) | (c1 << 8)));
+    }
+#endif
+
+    /*Align to 4 bytes and swap 2 pixels at once*/
+    if(i < buf_size_px && ((uintptr_t)&buf16[i] & 0x3)) {
+        buf16[i] = ((buf16[i] & 0xff00) >> 8) + ((buf16[i] & 0x00ff) << 8);
+        i++;
+    }
+
+    uint32_t * buf32 = (uint32_t *)&buf16[i];
+    uint32_t u32_cnt = (buf_size_px - i) / 2;
+    i += u32_cnt * 2;
+    while(u32_cnt) {
+        *buf32 = ((uint32_t)(*buf32 & 0xff00ff00) >> 8) + ((uint32_t)(*buf32 & 0x00ff00ff) << 8);
+        buf32++;
+        u32_cnt--;
+    }
+
+    if(i < buf_size_px) {
+        buf16[i] = ((buf16[i] & 0xff00) >> 8) + ((buf16[i] & 0x00ff) << 8);
+    }
+}
+
 void lv_draw_sw_buffer_convert(lv_draw_ctx_t * draw_ctx)
 {
     /*Keep the rendered image as it is*/
     if(draw_ctx->color_format == LV_COLOR_FORMAT_NATIVE) return;
 
+    /*Premultiplied buffers are flushed with straight alpha*/
+    if(draw_ctx->color_format == LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED) {
+        lv_color_unpremultiply(draw_ctx->buf, lv_area_get_size(draw_ctx->buf_area));
+        return;
+    }
+
 #if LV_COLOR_DEPTH == 8
     if(draw_ctx->color_format == LV_COLOR_FORMAT_L8) return;
 #endif
@@ -120,38 +163,8 @@ void lv_draw_sw_buffer_convert(lv_draw_ctx_t * draw_ctx)
 #if LV_COLOR_DEPTH == 16
     if(draw_ctx->color_format == LV_COLOR_FORMAT_RGB565) return;
 
-    /*Make both the clip and buf area relative to the buf area*/
     if(draw_ctx->color_format == LV_COLOR_FORMAT_NATIVE_REVERSED) {
-        uint32_t px_cnt = lv_area_get_size(draw_ctx->buf_area);
-        uint32_t u32_cnt = px_cnt / 2;
-        uint16_t * buf16 = draw_ctx->buf;
-        uint32_t * buf32 = (uint32_t *) buf16 ;
-
-        /*Swap all byte pairs*/
-        while(u32_cnt >= 8) {
-            buf32[0] = ((uint32_t)(buf32[0] & 0xff00ff00) >> 8) + ((uint32_t)(buf32[0] & 0x00ff00ff) << 8);
-            buf32[1] = ((uint32_t)(buf32[1] & 0xff00ff00) >> 8) + ((uint32_t)(buf32[1] & 0x00ff00ff) << 8);
-            buf32[2] = ((uint32_t)(buf32[2] & 0xff00ff00) >> 8) + ((uint32_t)(buf32[2] & 0x00ff00ff) << 8);
-            buf32[3] = ((uint32_t)(buf32[3] & 0xff00ff00) >> 8) + ((uint32_t)(buf32[3] & 0x00ff00ff) << 8);
-            buf32[4] = ((uint32_t)(buf32[4] & 0xff00ff00) >> 8) + ((uint32_t)(buf32[4] & 0x00ff00ff) << 8);
-            buf32[5] = ((uint32_t)(buf32[5] & 0xff00ff00) >> 8) + ((uint32_t)(buf32[5] & 0x00ff00ff) << 8);
-            buf32[6] = ((uint32_t)(buf32[6] & 0xff00ff00) >> 8) + ((uint32_t)(buf32[6] & 0x00ff00ff) << 8);
-            buf32[7] = ((uint32_t)(buf32[7] & 0xff00ff00) >> 8) + ((uint32_t)(buf32[7] & 0x00ff00ff) << 8);
-            buf32 += 8;
-            u32_cnt -= 8;
-        }
-
-        while(u32_cnt) {
-            *buf32 = ((uint32_t)(*buf32 & 0xff00ff00) >> 8) + ((uint32_t)(*buf32 & 0x00ff00ff) << 8);
-            buf32++;
-            u32_cnt--;
-        }
-
-        if(px_cnt & 0x1) {
-            uint32_t e = px_cnt - 1;
-            buf16[e] = ((buf16[e] & 0xff00) >> 8) + ((buf16[e] & 0x00ff) << 8);
-        }
-
+        lv_draw_sw_rgb565_swap(draw_ctx->buf, lv_area_get_size(draw_ctx->buf_area));
         return;
     }
 #endif
@@ -177,19 +190,28 @@ void lv_draw_sw_buffer_convert(lv_draw_ctx_t * draw_ctx)
 
 void lv_draw_sw_buffer_clear(lv_draw_ctx_t * draw_ctx)
 {
-    uint8_t px_size = lv_color_format_get_size(draw_ctx->color_format);
-    uint8_t * buf8 = draw_ctx->buf;
+    /*Clear only the clip area which can be smaller than the buffer*/
     lv_area_t a;
-    lv_area_copy(&a, draw_ctx->clip_area);
+    if(!_lv_area_intersect(&a, draw_ctx->clip_area, draw_ctx->buf_area)) return;
     lv_area_move(&a, -draw_ctx->buf_area->x1, -draw_ctx->buf_area->y1);
-    lv_coord_t w = lv_area_get_width(&a);
-    buf8 += a.y1 * w * px_size;
+
+    uint8_t px_size = lv_color_format_get_size(draw_ctx->color_format);
+    uint32_t stride = lv_area_get_width(draw_ctx->buf_area) * px_size;
+    uint32_t line_length = lv_area_get_width(&a) * px_size;
+    uint8_t * buf8 = draw_ctx->buf;
+    buf8 += a.y1 * stride;
     buf8 += a.x1 * px_size;
 
+    /*The lines are continuous if the whole width is cleared*/
+    if(line_length == stride) {
+        buf_zero(buf8, stride * lv_area_get_height(&a));
+        return;
+    }
+
     lv_coord_t y;
     for(y = a.y1; y <= a.y2; y++) {
-        lv_memzero(buf8, w * px_size);
-        buf8 += w * px_size;
+        buf_zero(buf8, line_length);
+        buf8 += stride;
     }
 }
 
@@ -197,4 +219,28 @@ void lv_draw_sw_buffer_clear(lv_draw_ctx_t * draw_ctx)
  *   STATIC FUNCTIONS
  **********************/
 
+static void buf_zero(uint8_t * buf, uint32_t len)
+{
+#if LV_USE_DRAW_SW_SIMD
+    /*Align to 16 bytes and clear 64 bytes at once*/
+    uint32_t head = (16 - ((lv_uintptr_t)buf & 0xF)) & 0xF;
+    if(head < len) {
+        lv_memzero(buf, head);
+        buf += head;
+        len -= head;
+
+        lv_simd_u32_t zero = LV_SIMD_U32(0);
+        for(; len >= 64; len -= 64) {
+            lv_simd_store_u32(buf, zero);
+            lv_simd_store_u32(buf + 16, zero);
+            lv_simd_store_u32(buf + 32, zero);
+            lv_simd_store_u32(buf + 48, zero);
+            buf += 64;
+        }
+    }
+#endif
+
+    lv_memzero(buf, len);
+}
+
 #endif /*LV_USE_DRAW_SW*/
@@ -39,6 +39,8 @@ typedef struct {
 typedef struct {
     lv_draw_layer_ctx_t base_draw;
     uint32_t buf_size_bytes;
+    uint32_t buf_real_size_bytes;               /**< Size of the buffer got from the pool. Can be larger than `buf_size_bytes`*/
+    lv_draw_layer_buf_pool_t * buf_pool;        /**< The pool of the display or NULL if there is no display*/
 } lv_draw_sw_layer_ctx_t;
 
 /**********************
@@ -53,11 +55,26 @@ void lv_draw_sw_wait_for_finish(lv_draw_ctx_t * draw_ctx);
 void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center, uint16_t radius,
                     uint16_t start_angle, uint16_t end_angle);
 
+/**
+ * Free the ring coverage tables cached by `lv_draw_sw_arc` (see `LV_DRAW_SW_ARC_CACHE_SIZE`).
+ * The rings are kept between the refreshes. Called by `lv_deinit()`.
+ */
+void _lv_draw_sw_arc_cache_cleanup(void);
+
 void lv_draw_sw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 
 void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
                        uint32_t letter);
 
+void lv_draw_sw_letters(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_arr,
+                        const uint32_t * letters, uint32_t letter_cnt);
+
+/**
+ * Drop the glyphs cached by the software renderer (see `LV_DRAW_SW_GLYPH_CACHE_SIZE`).
+ * Needs to be called when a font is freed because a new font might be created at the same address.
+ */
+void lv_draw_sw_glyph_cache_invalidate(void);
+
 LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_img_decoded(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * draw_dsc,
                                                   const lv_area_t * coords,
                                                   const uint8_t * src_buf, const lv_draw_img_sup_t * sup, lv_color_format_t cf);
@@ -74,6 +91,17 @@ void lv_draw_sw_buffer_copy(lv_draw_ctx_t * draw_ctx,
 
 void lv_draw_sw_buffer_convert(lv_draw_ctx_t * draw_ctx);
 
+/**
+ * Swap the high and low bytes of RGB565 pixels, e.g. for displays connected via SPI
+ * @param buf           pointer to the pixels
+ * @param buf_size_px   number of pixels
+ */
+void lv_draw_sw_rgb565_swap(void * buf, uint32_t buf_size_px);
+
+/**
+ * Clear the clip area of the draw buffer to fully transparent black
+ * @param draw_ctx      pointer to a draw context
+ */
 void lv_draw_sw_buffer_clear(lv_draw_ctx_t * draw_ctx);
 
 void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area, const void * src_buf,
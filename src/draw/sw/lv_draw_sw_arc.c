@@ -12,40 +12,80 @@
 #include "../../misc/lv_math.h"
 #include "../../misc/lv_log.h"
 #include "../../misc/lv_mem.h"
+#include "../../misc/lv_gc.h"
 #include "../lv_draw.h"
 
 /*********************
  *      DEFINES
  *********************/
-#define SPLIT_RADIUS_LIMIT 10  /*With radius greater than this the arc will drawn in quarters. A quarter is drawn only if there is arc in it*/
-#define SPLIT_ANGLE_GAP_LIMIT 60  /*With small gaps in the arc don't bother with splitting because there is nothing to skip.*/
+#define ARC_CACHE_LIFE_MAX          1000
+#define ARC_CACHE_AGING(life, r)    life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), ARC_CACHE_LIFE_MAX)
+#define ROW_BUF_STACK_SIZE          128
+#define IMG_MAP_SIZE_MAX            (8 * 1024)  /*Draw arcs with image in strips using a mask map not larger than this*/
+#define DIST_HALF_PX                32768       /*Half pixel in the 1/65536 pixel units of the angle limits*/
 
 /**********************
  *      TYPEDEFS
  **********************/
+
+/*The coverage of a row in the bottom right quarter of the ring. `i` is the pixel's distance from the center.
+ *[x_start, full_start) and [full_end, x_end) are anti-aliased and [full_start, full_end) is fully covered.*/
+typedef struct {
+    uint16_t x_start;
+    uint16_t full_start;
+    uint16_t full_end;
+    uint16_t x_end;
+    uint32_t opa_ofs;       /*Index of the row's first anti-aliased pixel in `opa`*/
+} arc_row_t;
+
+/*The radial coverage of a ring. It depends only on the radius and width so it can be cached.*/
 typedef struct {
-    const lv_point_t * center;
+    arc_row_t * rows;       /*`radius` rows from the center outwards*/
+    lv_opa_t * opa;         /*Opacity of the anti-aliased pixels of all rows*/
+    int32_t life;           /*How many times the entry was used*/
     lv_coord_t radius;
-    uint16_t start_angle;
-    uint16_t end_angle;
-    uint16_t start_quarter;
-    uint16_t end_quarter;
     lv_coord_t width;
-    lv_draw_rect_dsc_t * draw_dsc;
-    const lv_area_t * draw_area;
-    lv_draw_ctx_t * draw_ctx;
-} quarter_draw_dsc_t;
+} arc_table_t;
+
+typedef struct {
+    int32_t x_rel;          /*Center of the rounded end relative to the arc's center in 1/256 pixel units*/
+    int32_t y_rel;
+    lv_area_t area;         /*Absolute coordinates of the pixels which might be affected*/
+} arc_cap_t;
+
+typedef struct {
+    const arc_table_t * table;
+    lv_point_t center;
+    int32_t start_x;        /*Direction of the start and end angles where `1 << LV_TRIGO_SHIFT` means 1*/
+    int32_t start_y;
+    int32_t end_x;
+    int32_t end_y;
+    int32_t cap_r;          /*Radius of the rounded ends in 1/256 pixel units*/
+    arc_cap_t caps[2];
+    uint8_t cap_cnt;
+    uint8_t full_ring : 1;
+    uint8_t wide : 1;       /*Larger than 180 degrees*/
+} arc_dsc_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-#if LV_USE_DRAW_MASKS
-    static void draw_quarter_0(quarter_draw_dsc_t * q);
-    static void draw_quarter_1(quarter_draw_dsc_t * q);
-    static void draw_quarter_2(quarter_draw_dsc_t * q);
-    static void draw_quarter_3(quarter_draw_dsc_t * q);
-    static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness, lv_area_t * res_area);
-#endif /*LV_USE_DRAW_MASKS*/
+static const arc_table_t * get_table(lv_coord_t radius, lv_coord_t width, arc_table_t * tmp);
+static bool table_build(arc_table_t * table, lv_coord_t radius, lv_coord_t width);
+static void table_free(arc_table_t * table);
+static void cap_init(arc_dsc_t * arc, uint16_t angle, lv_coord_t radius, lv_coord_t width);
+static uint32_t get_row_spans(const arc_dsc_t * arc, lv_coord_t y, const lv_area_t * clip, lv_coord_t spans[2][2]);
+static bool get_span(const arc_dsc_t * arc, lv_opa_t * buf, lv_coord_t y, lv_coord_t x1, lv_coord_t x2);
+static void fill_radial(lv_opa_t * buf, const arc_row_t * row, const lv_opa_t * row_opa, int32_t i, int32_t len,
+                        int32_t dir);
+static void fill_radial_mirrored(lv_opa_t * buf, const arc_row_t * row, const lv_opa_t * row_opa, int32_t x_rel,
+                                 int32_t len);
+static void apply_cap(const arc_dsc_t * arc, const arc_cap_t * cap, lv_opa_t * buf, lv_coord_t y, lv_coord_t x1,
+                      lv_coord_t x2);
+static void draw_color(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const arc_dsc_t * arc,
+                       const lv_area_t * draw_area);
+static void draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const arc_dsc_t * arc,
+                     const lv_area_t * draw_area, const lv_area_t * coords);
 
 /**********************
  *  STATIC VARIABLES
@@ -62,479 +102,562 @@ typedef struct {
 void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center, uint16_t radius,
                     uint16_t start_angle, uint16_t end_angle)
 {
-#if LV_USE_DRAW_MASKS
     if(dsc->opa <= LV_OPA_MIN) return;
     if(dsc->width == 0) return;
+    if(radius == 0) return;
     if(start_angle == end_angle) return;
 
     lv_coord_t width = dsc->width;
     if(width > radius) width = radius;
 
-    lv_draw_rect_dsc_t cir_dsc;
-    lv_draw_rect_dsc_init(&cir_dsc);
-    cir_dsc.blend_mode = dsc->blend_mode;
-    if(dsc->img_src) {
-        cir_dsc.bg_opa = LV_OPA_TRANSP;
-        cir_dsc.bg_img_src = dsc->img_src;
-        cir_dsc.bg_img_opa = dsc->opa;
-    }
-    else {
-        cir_dsc.bg_opa = dsc->opa;
-        cir_dsc.bg_color = dsc->color;
-    }
-
     lv_area_t area_out;
     area_out.x1 = center->x - radius;
     area_out.y1 = center->y - radius;
     area_out.x2 = center->x + radius - 1;  /*-1 because the center already belongs to the left/bottom part*/
     area_out.y2 = center->y + radius - 1;
 
-    lv_area_t area_in;
-    lv_area_copy(&area_in, &area_out);
-    area_in.x1 += dsc->width;
-    area_in.y1 += dsc->width;
-    area_in.x2 -= dsc->width;
-    area_in.y2 -= dsc->width;
-
-    /*Create inner the mask*/
-    int16_t mask_in_id = LV_MASK_ID_INV;
-    lv_draw_mask_radius_param_t mask_in_param;
-    bool mask_in_param_valid = false;
-    if(lv_area_get_width(&area_in) > 0 && lv_area_get_height(&area_in) > 0) {
-        lv_draw_mask_radius_init(&mask_in_param, &area_in, LV_RADIUS_CIRCLE, true);
-        mask_in_param_valid = true;
-        mask_in_id = lv_draw_mask_add(&mask_in_param, NULL);
-    }
+    lv_area_t draw_area;
+    if(!_lv_area_intersect(&draw_area, &area_out, draw_ctx->clip_area)) return;
 
-    lv_draw_mask_radius_param_t mask_out_param;
-    lv_draw_mask_radius_init(&mask_out_param, &area_out, LV_RADIUS_CIRCLE, false);
-    int16_t mask_out_id = lv_draw_mask_add(&mask_out_param, NULL);
+    arc_dsc_t arc;
+    lv_memzero(&arc, sizeof(arc));
+    arc.center = *center;
 
-    /*Draw a full ring*/
     if(start_angle + 360 == end_angle || start_angle == end_angle + 360) {
-        cir_dsc.radius = LV_RADIUS_CIRCLE;
-        lv_draw_rect(draw_ctx, &cir_dsc, &area_out);
-
-        lv_draw_mask_remove_id(mask_out_id);
-        if(mask_in_id != LV_MASK_ID_INV) lv_draw_mask_remove_id(mask_in_id);
-
-        lv_draw_mask_free_param(&mask_out_param);
-        if(mask_in_param_valid) {
-            lv_draw_mask_free_param(&mask_in_param);
-        }
-
-        return;
-    }
-
-    while(start_angle >= 360) start_angle -= 360;
-    while(end_angle >= 360) end_angle -= 360;
-
-    lv_draw_mask_angle_param_t mask_angle_param;
-    lv_draw_mask_angle_init(&mask_angle_param, center->x, center->y, start_angle, end_angle);
-    int16_t mask_angle_id = lv_draw_mask_add(&mask_angle_param, NULL);
-
-    int32_t angle_gap;
-    if(end_angle > start_angle) {
-        angle_gap = 360 - (end_angle - start_angle);
+        arc.full_ring = 1;
     }
     else {
-        angle_gap = start_angle - end_angle;
+        while(start_angle >= 360) start_angle -= 360;
+        while(end_angle >= 360) end_angle -= 360;
+        if(start_angle == end_angle) return;
+
+        int32_t angle_size = end_angle > start_angle ? end_angle - start_angle : end_angle + 360 - start_angle;
+        arc.wide = angle_size > 180 ? 1 : 0;
+        arc.start_x = lv_trigo_cos(start_angle);
+        arc.start_y = lv_trigo_sin(start_angle);
+        arc.end_x = lv_trigo_cos(end_angle);
+        arc.end_y = lv_trigo_sin(end_angle);
+
+        if(dsc->rounded) {
+            cap_init(&arc, start_angle, radius, width);
+            cap_init(&arc, end_angle, radius, width);
+        }
     }
 
-    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    arc_table_t tmp_table;
+    arc.table = get_table(radius, width, &tmp_table);
+    if(arc.table == NULL) return;
 
-    if(angle_gap > SPLIT_ANGLE_GAP_LIMIT && radius > SPLIT_RADIUS_LIMIT) {
-        /*Handle each quarter individually and skip which is empty*/
-        quarter_draw_dsc_t q_dsc;
-        q_dsc.center = center;
-        q_dsc.radius = radius;
-        q_dsc.start_angle = start_angle;
-        q_dsc.end_angle = end_angle;
-        q_dsc.start_quarter = (start_angle / 90) & 0x3;
-        q_dsc.end_quarter = (end_angle / 90) & 0x3;
-        q_dsc.width = width;
-        q_dsc.draw_dsc = &cir_dsc;
-        q_dsc.draw_area = &area_out;
-        q_dsc.draw_ctx = draw_ctx;
-
-        draw_quarter_0(&q_dsc);
-        draw_quarter_1(&q_dsc);
-        draw_quarter_2(&q_dsc);
-        draw_quarter_3(&q_dsc);
-    }
-    else {
-        lv_draw_rect(draw_ctx, &cir_dsc, &area_out);
-    }
+    if(dsc->img_src) draw_img(draw_ctx, dsc, &arc, &draw_area, &area_out);
+    else draw_color(draw_ctx, dsc, &arc, &draw_area);
 
-    lv_draw_mask_free_param(&mask_angle_param);
-    lv_draw_mask_free_param(&mask_out_param);
-    if(mask_in_param_valid) {
-        lv_draw_mask_free_param(&mask_in_param);
-    }
+    if(arc.table == &tmp_table) table_free(&tmp_table);
+}
 
-    lv_draw_mask_remove_id(mask_angle_id);
-    lv_draw_mask_remove_id(mask_out_id);
-    if(mask_in_id != LV_MASK_ID_INV) lv_draw_mask_remove_id(mask_in_id);
-
-    if(dsc->rounded) {
-
-        lv_draw_mask_radius_param_t mask_end_param;
-
-        lv_area_t round_area;
-        get_rounded_area(start_angle, radius, width, &round_area);
-        round_area.x1 += center->x;
-        round_area.x2 += center->x;
-        round_area.y1 += center->y;
-        round_area.y2 += center->y;
-        lv_area_t clip_area2;
-        if(_lv_area_intersect(&clip_area2, clip_area_ori, &round_area)) {
-            lv_draw_mask_radius_init(&mask_end_param, &round_area, LV_RADIUS_CIRCLE, false);
-            int16_t mask_end_id = lv_draw_mask_add(&mask_end_param, NULL);
-
-            draw_ctx->clip_area = &clip_area2;
-            lv_draw_rect(draw_ctx, &cir_dsc, &area_out);
-            lv_draw_mask_remove_id(mask_end_id);
-            lv_draw_mask_free_param(&mask_end_param);
-        }
+void _lv_draw_sw_arc_cache_cleanup(void)
+{
+#if LV_DRAW_SW_ARC_CACHE_SIZE
+    arc_table_t * cache = LV_GC_ROOT(_lv_draw_sw_arc_cache);
+    if(cache == NULL) return;
 
-        get_rounded_area(end_angle, radius, width, &round_area);
-        round_area.x1 += center->x;
-        round_area.x2 += center->x;
-        round_area.y1 += center->y;
-        round_area.y2 += center->y;
-        if(_lv_area_intersect(&clip_area2, clip_area_ori, &round_area)) {
-            lv_draw_mask_radius_init(&mask_end_param, &round_area, LV_RADIUS_CIRCLE, false);
-            int16_t mask_end_id = lv_draw_mask_add(&mask_end_param, NULL);
-
-            draw_ctx->clip_area = &clip_area2;
-            lv_draw_rect(draw_ctx, &cir_dsc, &area_out);
-            lv_draw_mask_remove_id(mask_end_id);
-            lv_draw_mask_free_param(&mask_end_param);
-        }
-        draw_ctx->clip_area = clip_area_ori;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_SW_ARC_CACHE_SIZE; i++) {
+        table_free(&cache[i]);
     }
-#else
-    LV_LOG_WARN("Can't draw arc with LV_USE_DRAW_MASKS == 0");
-    LV_UNUSED(center);
-    LV_UNUSED(radius);
-    LV_UNUSED(start_angle);
-    LV_UNUSED(end_angle);
-    LV_UNUSED(draw_ctx);
-    LV_UNUSED(dsc);
-#endif /*LV_USE_DRAW_MASKS*/
+
+    lv_free(cache);
+    LV_GC_ROOT(_lv_draw_sw_arc_cache) = NULL;
+#endif
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
-#if LV_USE_DRAW_MASKS
-static void draw_quarter_0(quarter_draw_dsc_t * q)
+/**
+ * Get the coverage table of a ring from the cache or create it
+ * @param radius    radius of the ring
+ * @param width     width of the ring
+ * @param tmp       used to create the table if it can't be cached. Should be freed with `table_free` if returned.
+ * @return          pointer to the table or NULL on error
+ */
+static const arc_table_t * get_table(lv_coord_t radius, lv_coord_t width, arc_table_t * tmp)
 {
-    const lv_area_t * clip_area_ori = q->draw_ctx->clip_area;
-    lv_area_t quarter_area;
-
-    if(q->start_quarter == 0 && q->end_quarter == 0 && q->start_angle < q->end_angle) {
-        /*Small arc here*/
-        quarter_area.y1 = q->center->y + ((lv_trigo_sin(q->start_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-        quarter_area.x2 = q->center->x + ((lv_trigo_sin(q->start_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
-
-        quarter_area.y2 = q->center->y + ((lv_trigo_sin(q->end_angle) * q->radius) >> LV_TRIGO_SHIFT);
-        quarter_area.x1 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+#if LV_DRAW_SW_ARC_CACHE_SIZE
+    arc_table_t * cache = LV_GC_ROOT(_lv_draw_sw_arc_cache);
+    if(cache == NULL) {
+        cache = lv_malloc(sizeof(arc_table_t) * LV_DRAW_SW_ARC_CACHE_SIZE);
+        LV_ASSERT_MALLOC(cache);
+        if(cache) {
+            lv_memzero(cache, sizeof(arc_table_t) * LV_DRAW_SW_ARC_CACHE_SIZE);
+            LV_GC_ROOT(_lv_draw_sw_arc_cache) = cache;
         }
     }
-    else if(q->start_quarter == 0 || q->end_quarter == 0) {
-        /*Start and/or end arcs here*/
-        if(q->start_quarter == 0) {
-            quarter_area.x1 = q->center->x;
-            quarter_area.y2 = q->center->y + q->radius;
-
-            quarter_area.y1 = q->center->y + ((lv_trigo_sin(q->start_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-            quarter_area.x2 = q->center->x + ((lv_trigo_sin(q->start_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
-
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-            }
-        }
-        if(q->end_quarter == 0) {
-            quarter_area.x2 = q->center->x + q->radius;
-            quarter_area.y1 = q->center->y;
 
-            quarter_area.y2 = q->center->y + ((lv_trigo_sin(q->end_angle) * q->radius) >> LV_TRIGO_SHIFT);
-            quarter_area.x1 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+    if(cache) {
+        uint32_t i;
+        for(i = 0; i < LV_DRAW_SW_ARC_CACHE_SIZE; i++) {
+            if(cache[i].rows && cache[i].radius == radius && cache[i].width == width) {
+                ARC_CACHE_AGING(cache[i].life, radius);
+                return &cache[i];
             }
         }
-    }
-    else if((q->start_quarter == q->end_quarter && q->start_quarter != 0 && q->end_angle < q->start_angle) ||
-            (q->start_quarter == 2 && q->end_quarter == 1) ||
-            (q->start_quarter == 3 && q->end_quarter == 2) ||
-            (q->start_quarter == 3 && q->end_quarter == 1)) {
-        /*Arc crosses here*/
-        quarter_area.x1 = q->center->x;
-        quarter_area.y1 = q->center->y;
-        quarter_area.x2 = q->center->x + q->radius;
-        quarter_area.y2 = q->center->y + q->radius;
-
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+
+        /*Not found, replace the entry with the lowest life*/
+        arc_table_t * entry = &cache[0];
+        for(i = 1; i < LV_DRAW_SW_ARC_CACHE_SIZE; i++) {
+            if(cache[i].life < entry->life) entry = &cache[i];
         }
+
+        table_free(entry);
+        if(!table_build(entry, radius, width)) return NULL;
+        ARC_CACHE_AGING(entry->life, radius);
+        return entry;
     }
-    q->draw_ctx->clip_area = clip_area_ori;
+#endif
+
+    if(!table_build(tmp, radius, width)) return NULL;
+    return tmp;
 }
 
-static void draw_quarter_1(quarter_draw_dsc_t * q)
+/**
+ * Find the first pixel whose center is at least `sqrt(u_sqr)` far from the center horizontally
+ * @param u_sqr     the squared distance in 1/2 pixel units
+ * @return          index of the pixel
+ */
+static inline uint16_t first_i_from(int64_t u_sqr)
 {
-    const lv_area_t * clip_area_ori = q->draw_ctx->clip_area;
-    lv_area_t quarter_area;
-
-    if(q->start_quarter == 1 && q->end_quarter == 1 && q->start_angle < q->end_angle) {
-        /*Small arc here*/
-        quarter_area.y2 = q->center->y + ((lv_trigo_sin(q->start_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
-        quarter_area.x2 = q->center->x + ((lv_trigo_sin(q->start_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
+    if(u_sqr <= 1) return 0;
+    int64_t u = lv_sqrt64(u_sqr);
+    if(u * u < u_sqr) u++;
 
-        quarter_area.y1 = q->center->y + ((lv_trigo_sin(q->end_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-        quarter_area.x1 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
+    /*The center of the `i`th pixel is at `2 * i + 1`*/
+    return (uint16_t)(u / 2);
+}
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-        }
-    }
-    else if(q->start_quarter == 1 || q->end_quarter == 1) {
-        /*Start and/or end arcs here*/
-        if(q->start_quarter == 1) {
-            quarter_area.x1 = q->center->x - q->radius;
-            quarter_area.y1 = q->center->y;
-
-            quarter_area.y2 = q->center->y + ((lv_trigo_sin(q->start_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
-            quarter_area.x2 = q->center->x + ((lv_trigo_sin(q->start_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-            }
+static bool table_build(arc_table_t * table, lv_coord_t radius, lv_coord_t width)
+{
+    lv_memzero(table, sizeof(arc_table_t));
+    table->rows = lv_malloc(radius * sizeof(arc_row_t));
+    LV_ASSERT_MALLOC(table->rows);
+    if(table->rows == NULL) return false;
+
+    table->radius = radius;
+    table->width = width;
+
+    /*Use 1/2 pixel units so the pixel centers are integers. A pixel is
+     *partially covered if its center is closer than 1/2 pixel to an edge.*/
+    int64_t r_out = radius * 2;
+    int64_t r_in = (radius - width) * 2;
+    int64_t out_end_sqr = (r_out + 1) * (r_out + 1);
+    int64_t out_full_sqr = (r_out - 1) * (r_out - 1);
+    int64_t in_start_sqr = (r_in - 1) * (r_in - 1);
+    int64_t in_full_sqr = (r_in + 1) * (r_in + 1);
+
+    uint32_t opa_cnt = 0;
+    int32_t k;
+    for(k = 0; k < radius; k++) {
+        int64_t v_sqr = (int64_t)(2 * k + 1) * (2 * k + 1);
+        arc_row_t * row = &table->rows[k];
+        row->x_start = first_i_from(in_start_sqr + 1 - v_sqr);
+        row->full_start = first_i_from(in_full_sqr - v_sqr);
+        row->full_end = first_i_from(out_full_sqr + 1 - v_sqr);
+        row->x_end = first_i_from(out_end_sqr - v_sqr);
+
+        /*The edges are so close that there is no fully covered pixel*/
+        if(row->full_start >= row->full_end) {
+            row->full_start = row->x_end;
+            row->full_end = row->x_end;
         }
-        if(q->end_quarter == 1) {
-            quarter_area.x2 = q->center->x - 1;
-            quarter_area.y2 = q->center->y + q->radius;
 
-            quarter_area.y1 = q->center->y + ((lv_trigo_sin(q->end_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-            quarter_area.x1 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
+        row->opa_ofs = opa_cnt;
+        opa_cnt += (row->full_start - row->x_start) + (row->x_end - row->full_end);
+    }
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-            }
-        }
+    table->opa = lv_malloc(LV_MAX(opa_cnt, 1));
+    LV_ASSERT_MALLOC(table->opa);
+    if(table->opa == NULL) {
+        table_free(table);
+        return false;
     }
-    else if((q->start_quarter == q->end_quarter && q->start_quarter != 1 && q->end_angle < q->start_angle) ||
-            (q->start_quarter == 0 && q->end_quarter == 2) ||
-            (q->start_quarter == 0 && q->end_quarter == 3) ||
-            (q->start_quarter == 3 && q->end_quarter == 2)) {
-        /*Arc crosses here*/
-        quarter_area.x1 = q->center->x - q->radius;
-        quarter_area.y1 = q->center->y;
-        quarter_area.x2 = q->center->x - 1;
-        quarter_area.y2 = q->center->y + q->radius;
-
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+
+    /*Coverage of the pixel's width (centered on the pixel) between the inner and outer circles*/
+    int32_t r_out_256 = radius * 256;
+    int32_t r_in_256 = (radius - width) * 256;
+    lv_opa_t * opa_p = table->opa;
+    for(k = 0; k < radius; k++) {
+        const arc_row_t * row = &table->rows[k];
+        int64_t v_sqr = (int64_t)(2 * k + 1) * (2 * k + 1);
+        int32_t i;
+        for(i = row->x_start; i < row->x_end; i++) {
+            if(i == row->full_start) i = row->full_end;
+            if(i >= row->x_end) break;
+
+            int64_t u_sqr = (int64_t)(2 * i + 1) * (2 * i + 1);
+            int32_t dist = lv_sqrt64((uint64_t)(u_sqr + v_sqr) << 14);   /*1/256 pixel units*/
+            int32_t cov = LV_MIN(dist + 128, r_out_256) - LV_MAX(dist - 128, r_in_256);
+            *opa_p = LV_CLAMP(0, cov, LV_OPA_COVER);
+            opa_p++;
         }
     }
-    q->draw_ctx->clip_area = clip_area_ori;
+
+    return true;
+}
+
+static void table_free(arc_table_t * table)
+{
+    lv_free(table->rows);
+    lv_free(table->opa);
+    lv_memzero(table, sizeof(arc_table_t));
+}
+
+/**
+ * Add a rounded end to the arc. It's a circle on the middle of the ring with `width` diameter.
+ */
+static void cap_init(arc_dsc_t * arc, uint16_t angle, lv_coord_t radius, lv_coord_t width)
+{
+    arc_cap_t * cap = &arc->caps[arc->cap_cnt];
+    arc->cap_cnt++;
+
+    int64_t mid = (int64_t)(radius * 2 - width) * 128;
+    cap->x_rel = (int32_t)((mid * lv_trigo_cos(angle)) >> LV_TRIGO_SHIFT);
+    cap->y_rel = (int32_t)((mid * lv_trigo_sin(angle)) >> LV_TRIGO_SHIFT);
+    arc->cap_r = width * 128;
+
+    /*The pixel centers are at `(x - center) * 256 + 128`*/
+    cap->area.x1 = arc->center.x + ((cap->x_rel - arc->cap_r - 256) >> 8);
+    cap->area.x2 = arc->center.x + ((cap->x_rel + arc->cap_r) >> 8);
+    cap->area.y1 = arc->center.y + ((cap->y_rel - arc->cap_r - 256) >> 8);
+    cap->area.y2 = arc->center.y + ((cap->y_rel + arc->cap_r) >> 8);
 }
 
-static void draw_quarter_2(quarter_draw_dsc_t * q)
+/**
+ * Get the ranges of a row where the ring has pixels
+ * @param arc       the arc descriptor
+ * @param y         the row
+ * @param clip      clip the spans to this area
+ * @param spans     store the start and end X coordinates of the spans here
+ * @return          number of spans (0..2)
+ */
+static uint32_t get_row_spans(const arc_dsc_t * arc, lv_coord_t y, const lv_area_t * clip, lv_coord_t spans[2][2])
 {
-    const lv_area_t * clip_area_ori = q->draw_ctx->clip_area;
-    lv_area_t quarter_area;
+    lv_coord_t cx = arc->center.x;
+    lv_coord_t cy = arc->center.y;
+    const arc_row_t * row = &arc->table->rows[y >= cy ? y - cy : cy - 1 - y];
+    if(row->x_start >= row->x_end) return 0;
+
+    lv_coord_t ranges[2][2];
+    uint32_t range_cnt;
+    if(row->x_start == 0) {
+        /*There is no hole in this row*/
+        ranges[0][0] = cx - row->x_end;
+        ranges[0][1] = cx + row->x_end - 1;
+        range_cnt = 1;
+    }
+    else {
+        ranges[0][0] = cx - row->x_end;
+        ranges[0][1] = cx - 1 - row->x_start;
+        ranges[1][0] = cx + row->x_start;
+        ranges[1][1] = cx + row->x_end - 1;
+        range_cnt = 2;
+    }
 
-    if(q->start_quarter == 2 && q->end_quarter == 2 && q->start_angle < q->end_angle) {
-        /*Small arc here*/
-        quarter_area.x1 = q->center->x + ((lv_trigo_sin(q->start_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
-        quarter_area.y2 = q->center->y + ((lv_trigo_sin(q->start_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < range_cnt; i++) {
+        lv_coord_t x1 = LV_MAX(ranges[i][0], clip->x1);
+        lv_coord_t x2 = LV_MIN(ranges[i][1], clip->x2);
+        if(x1 > x2) continue;
+        spans[cnt][0] = x1;
+        spans[cnt][1] = x2;
+        cnt++;
+    }
 
-        quarter_area.y1 = q->center->y + ((lv_trigo_sin(q->end_angle) * q->radius) >> LV_TRIGO_SHIFT);
-        quarter_area.x2 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
+    return cnt;
+}
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-        }
+/**
+ * Get the coverage of the arc in a part of a row
+ * @param arc       the arc descriptor
+ * @param buf       store the coverage here
+ * @param y         the row
+ * @param x1        start X coordinate
+ * @param x2        end X coordinate
+ * @return          false if no pixels are covered; true: `buf` is filled
+ */
+static bool get_span(const arc_dsc_t * arc, lv_opa_t * buf, lv_coord_t y, lv_coord_t x1, lv_coord_t x2)
+{
+    lv_coord_t cx = arc->center.x;
+    lv_coord_t cy = arc->center.y;
+    const arc_row_t * row = &arc->table->rows[y >= cy ? y - cy : cy - 1 - y];
+    const lv_opa_t * row_opa = &arc->table->opa[row->opa_ofs];
+    int32_t len = x2 - x1 + 1;
+
+    if(arc->full_ring) {
+        fill_radial_mirrored(buf, row, row_opa, x1 - cx, len);
+        return true;
     }
-    else if(q->start_quarter == 2 || q->end_quarter == 2) {
-        /*Start and/or end arcs here*/
-        if(q->start_quarter == 2) {
-            quarter_area.x2 = q->center->x - 1;
-            quarter_area.y1 = q->center->y - q->radius;
-
-            quarter_area.x1 = q->center->x + ((lv_trigo_sin(q->start_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
-            quarter_area.y2 = q->center->y + ((lv_trigo_sin(q->start_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-            }
-        }
-        if(q->end_quarter == 2) {
-            quarter_area.x1 = q->center->x - q->radius;
-            quarter_area.y2 = q->center->y - 1;
 
-            quarter_area.x2 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-            quarter_area.y1 = q->center->y + ((lv_trigo_sin(q->end_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
+    bool has_cap = false;
+    uint32_t c;
+    for(c = 0; c < arc->cap_cnt; c++) {
+        const lv_area_t * ca = &arc->caps[c].area;
+        if(y >= ca->y1 && y <= ca->y2 && x1 <= ca->x2 && x2 >= ca->x1) has_cap = true;
+    }
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+    /*Signed distance from the start and end lines in 1/65536 pixel units.
+     *Positive on the side of the arc. Calculate with the pixel centers in 1/2 pixel units.*/
+    int64_t u = 2 * (x1 - cx) + 1;
+    int64_t v = 2 * (y - cy) + 1;
+    int64_t ds = arc->start_x * v - arc->start_y * u;
+    int64_t de = arc->end_y * u - arc->end_x * v;
+    int64_t ds_step = -2 * arc->start_y;
+    int64_t de_step = 2 * arc->end_y;
+    int64_t ds_last = ds + ds_step * (len - 1);
+    int64_t de_last = de + de_step * (len - 1);
+
+    /*The distances change linearly so checking the ends is enough*/
+    bool out_s = ds <= -DIST_HALF_PX && ds_last <= -DIST_HALF_PX;
+    bool out_e = de <= -DIST_HALF_PX && de_last <= -DIST_HALF_PX;
+    bool in_s = ds >= DIST_HALF_PX && ds_last >= DIST_HALF_PX;
+    bool in_e = de >= DIST_HALF_PX && de_last >= DIST_HALF_PX;
+
+    /*Up to 180 degrees the arc is on the positive side of both lines, else of either of them*/
+    bool ang_none = arc->wide ? (out_s && out_e) : (out_s || out_e);
+    bool ang_full = arc->wide ? (in_s || in_e) : (in_s && in_e);
+
+    if(ang_none) {
+        if(!has_cap) return false;
+        lv_memzero(buf, len);
+    }
+    else {
+        fill_radial_mirrored(buf, row, row_opa, x1 - cx, len);
+        if(!ang_full) {
+            int32_t i;
+            for(i = 0; i < len; i++, ds += ds_step, de += de_step) {
+                if(buf[i] == LV_OPA_TRANSP) continue;
+                int32_t cov_s = (int32_t)LV_CLAMP(0, (ds + DIST_HALF_PX) >> 8, 256);
+                int32_t cov_e = (int32_t)LV_CLAMP(0, (de + DIST_HALF_PX) >> 8, 256);
+                int32_t cov = arc->wide ? LV_MAX(cov_s, cov_e) : LV_MIN(cov_s, cov_e);
+                buf[i] = (buf[i] * cov) >> 8;
             }
         }
     }
-    else if((q->start_quarter == q->end_quarter && q->start_quarter != 2 && q->end_angle < q->start_angle) ||
-            (q->start_quarter == 0 && q->end_quarter == 3) ||
-            (q->start_quarter == 1 && q->end_quarter == 3) ||
-            (q->start_quarter == 1 && q->end_quarter == 0)) {
-        /*Arc crosses here*/
-        quarter_area.x1 = q->center->x - q->radius;
-        quarter_area.y1 = q->center->y - q->radius;
-        quarter_area.x2 = q->center->x - 1;
-        quarter_area.y2 = q->center->y - 1;
-
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+
+    if(has_cap) {
+        for(c = 0; c < arc->cap_cnt; c++) apply_cap(arc, &arc->caps[c], buf, y, x1, x2);
+    }
+
+    return true;
+}
+
+/**
+ * Copy the radial coverage of a row from the table
+ * @param buf       store the coverage here
+ * @param row       the row from the table
+ * @param row_opa   the anti-aliased pixels of the row
+ * @param i         distance of the first pixel from the center
+ * @param len       number of pixels
+ * @param dir       1: go outwards (right side); -1: go inwards (left side)
+ */
+static void fill_radial(lv_opa_t * buf, const arc_row_t * row, const lv_opa_t * row_opa, int32_t i, int32_t len,
+                        int32_t dir)
+{
+    int32_t j = 0;
+    while(j < len) {
+        if(i >= row->full_start && i < row->full_end) {
+            int32_t full_len = dir > 0 ? row->full_end - i : i - row->full_start + 1;
+            full_len = LV_MIN(full_len, len - j);
+            lv_memset(&buf[j], LV_OPA_COVER, full_len);
+            j += full_len;
+            i += dir * full_len;
+        }
+        else {
+            if(i < row->x_start || i >= row->x_end) buf[j] = LV_OPA_TRANSP;
+            else if(i < row->full_start) buf[j] = row_opa[i - row->x_start];
+            else buf[j] = row_opa[row->full_start - row->x_start + i - row->full_end];
+            j++;
+            i += dir;
         }
     }
-    q->draw_ctx->clip_area = clip_area_ori;
 }
 
-static void draw_quarter_3(quarter_draw_dsc_t * q)
+/**
+ * Copy the radial coverage of a part of a row. The table stores a quarter so mirror it on the left side.
+ * @param buf       store the coverage here
+ * @param row       the row from the table
+ * @param row_opa   the anti-aliased pixels of the row
+ * @param x_rel     the first pixel's X coordinate relative to the center
+ * @param len       number of pixels
+ */
+static void fill_radial_mirrored(lv_opa_t * buf, const arc_row_t * row, const lv_opa_t * row_opa, int32_t x_rel,
+                                 int32_t len)
 {
-    const lv_area_t * clip_area_ori = q->draw_ctx->clip_area;
-    lv_area_t quarter_area;
+    if(x_rel < 0) {
+        int32_t left_len = LV_MIN(len, -x_rel);
+        fill_radial(buf, row, row_opa, -x_rel - 1, left_len, -1);
+        if(left_len < len) fill_radial(&buf[left_len], row, row_opa, 0, len - left_len, 1);
+    }
+    else {
+        fill_radial(buf, row, row_opa, x_rel, len, 1);
+    }
+}
 
-    if(q->start_quarter == 3 && q->end_quarter == 3 && q->start_angle < q->end_angle) {
-        /*Small arc here*/
-        quarter_area.x1 = q->center->x + ((lv_trigo_sin(q->start_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-        quarter_area.y1 = q->center->y + ((lv_trigo_sin(q->start_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
+/**
+ * Add the coverage of a rounded end to a span
+ */
+static void apply_cap(const arc_dsc_t * arc, const arc_cap_t * cap, lv_opa_t * buf, lv_coord_t y, lv_coord_t x1,
+                      lv_coord_t x2)
+{
+    if(y < cap->area.y1 || y > cap->area.y2) return;
 
-        quarter_area.x2 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
-        quarter_area.y2 = q->center->y + ((lv_trigo_sin(q->end_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
+    lv_coord_t x_start = LV_MAX(x1, cap->area.x1);
+    lv_coord_t x_end = LV_MIN(x2, cap->area.x2);
 
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-        }
+    int64_t r_full = arc->cap_r + 128;
+    int64_t r_in = arc->cap_r - 128;
+    uint64_t r_full_sqr = r_full * r_full;
+    uint64_t r_in_sqr = r_in > 0 ? r_in * r_in : 0;
+
+    int64_t dy = (y - arc->center.y) * 256 + 128 - cap->y_rel;
+    lv_coord_t x;
+    for(x = x_start; x <= x_end; x++) {
+        int64_t dx = (x - arc->center.x) * 256 + 128 - cap->x_rel;
+        uint64_t dist_sqr = dx * dx + dy * dy;
+        if(dist_sqr >= r_full_sqr) continue;
+
+        int32_t cov;
+        if(dist_sqr <= r_in_sqr) cov = LV_OPA_COVER;
+        else cov = LV_MIN((int32_t)(r_full - lv_sqrt64(dist_sqr)), LV_OPA_COVER);
+
+        if(cov > buf[x - x1]) buf[x - x1] = cov;
     }
-    else if(q->start_quarter == 3 || q->end_quarter == 3) {
-        /*Start and/or end arcs here*/
-        if(q->start_quarter == 3) {
-            quarter_area.x2 = q->center->x + q->radius;
-            quarter_area.y2 = q->center->y - 1;
-
-            quarter_area.x1 = q->center->x + ((lv_trigo_sin(q->start_angle + 90) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
-            quarter_area.y1 = q->center->y + ((lv_trigo_sin(q->start_angle) * (q->radius)) >> LV_TRIGO_SHIFT);
-
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
-            }
-        }
-        if(q->end_quarter == 3) {
-            quarter_area.x1 = q->center->x;
-            quarter_area.y1 = q->center->y - q->radius;
+}
 
-            quarter_area.x2 = q->center->x + ((lv_trigo_sin(q->end_angle + 90) * (q->radius)) >> LV_TRIGO_SHIFT);
-            quarter_area.y2 = q->center->y + ((lv_trigo_sin(q->end_angle) * (q->radius - q->width)) >> LV_TRIGO_SHIFT);
+static void draw_color(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const arc_dsc_t * arc,
+                       const lv_area_t * draw_area)
+{
+    lv_opa_t row_buf_stack[ROW_BUF_STACK_SIZE];
+    int32_t row_buf_size = lv_area_get_width(draw_area);
+    lv_opa_t * row_buf = row_buf_size <= ROW_BUF_STACK_SIZE ? row_buf_stack : lv_malloc(row_buf_size);
+    LV_ASSERT_MALLOC(row_buf);
+    if(row_buf == NULL) return;
 
-            bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-            if(ok) {
-                q->draw_ctx->clip_area = &quarter_area;
-                lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+#if LV_USE_DRAW_MASKS
+    bool masked = lv_draw_mask_is_any(draw_area);
+#endif
+
+    lv_area_t row_area;
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memzero(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.blend_area = &row_area;
+    blend_dsc.mask_area = &row_area;
+    blend_dsc.color = dsc->color;
+    blend_dsc.opa = dsc->opa;
+    blend_dsc.blend_mode = dsc->blend_mode;
+
+    lv_coord_t y;
+    for(y = draw_area->y1; y <= draw_area->y2; y++) {
+        lv_coord_t spans[2][2];
+        uint32_t span_cnt = get_row_spans(arc, y, draw_area, spans);
+        uint32_t s;
+        for(s = 0; s < span_cnt; s++) {
+            lv_coord_t x_start = spans[s][0];
+            lv_coord_t x_end = spans[s][1];
+            if(!get_span(arc, row_buf, y, x_start, x_end)) continue;
+
+            /*Skip the not covered pixels on the sides*/
+            lv_opa_t * row_p = row_buf;
+            while(x_start <= x_end && row_p[0] == LV_OPA_TRANSP) {
+                row_p++;
+                x_start++;
             }
-        }
-    }
-    else if((q->start_quarter == q->end_quarter && q->start_quarter != 3 && q->end_angle < q->start_angle) ||
-            (q->start_quarter == 2 && q->end_quarter == 0) ||
-            (q->start_quarter == 1 && q->end_quarter == 0) ||
-            (q->start_quarter == 2 && q->end_quarter == 1)) {
-        /*Arc crosses here*/
-        quarter_area.x1 = q->center->x;
-        quarter_area.y1 = q->center->y - q->radius;
-        quarter_area.x2 = q->center->x + q->radius;
-        quarter_area.y2 = q->center->y - 1;
-
-        bool ok = _lv_area_intersect(&quarter_area, &quarter_area, clip_area_ori);
-        if(ok) {
-            q->draw_ctx->clip_area = &quarter_area;
-            lv_draw_rect(q->draw_ctx, q->draw_dsc, q->draw_area);
+            while(x_end >= x_start && row_p[x_end - x_start] == LV_OPA_TRANSP) {
+                x_end--;
+            }
+            if(x_start > x_end) continue;
+
+            row_area.x1 = x_start;
+            row_area.x2 = x_end;
+            row_area.y1 = y;
+            row_area.y2 = y;
+            blend_dsc.mask_buf = row_p;
+            blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+#if LV_USE_DRAW_MASKS
+            if(masked) {
+                blend_dsc.mask_res = lv_draw_mask_apply(row_p, x_start, y, x_end - x_start + 1);
+                if(blend_dsc.mask_res == LV_DRAW_MASK_RES_TRANSP) continue;
+                blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+            }
+#endif
+            lv_draw_sw_blend(draw_ctx, &blend_dsc);
         }
     }
 
-    q->draw_ctx->clip_area = clip_area_ori;
+    if(row_buf != row_buf_stack) lv_free(row_buf);
 }
 
-static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness, lv_area_t * res_area)
+/**
+ * Draw an arc with image. The coverage is rendered into a mask map and the image is drawn as
+ * the background image of a rectangle.
+ */
+static void draw_img(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const arc_dsc_t * arc,
+                     const lv_area_t * draw_area, const lv_area_t * coords)
 {
-    const uint8_t ps = 8;
-    const uint8_t pa = 127;
+#if LV_USE_DRAW_MASKS
+    int32_t w = lv_area_get_width(draw_area);
+    int32_t strip_h = LV_CLAMP(1, IMG_MAP_SIZE_MAX / w, lv_area_get_height(draw_area));
+    lv_opa_t * map = lv_malloc(w * strip_h);
+    LV_ASSERT_MALLOC(map);
+    if(map == NULL) return;
 
-    int32_t thick_half = thickness / 2;
-    uint8_t thick_corr = (thickness & 0x01) ? 0 : 1;
+    lv_draw_rect_dsc_t cir_dsc;
+    lv_draw_rect_dsc_init(&cir_dsc);
+    cir_dsc.blend_mode = dsc->blend_mode;
+    cir_dsc.bg_opa = LV_OPA_TRANSP;
+    cir_dsc.bg_img_src = dsc->img_src;
+    cir_dsc.bg_img_opa = dsc->opa;
 
-    int32_t cir_x;
-    int32_t cir_y;
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    lv_area_t strip = *draw_area;
+    for(strip.y1 = draw_area->y1; strip.y1 <= draw_area->y2; strip.y1 += strip_h) {
+        strip.y2 = LV_MIN(strip.y1 + strip_h - 1, draw_area->y2);
+        lv_memzero(map, w * lv_area_get_height(&strip));
+
+        bool any = false;
+        lv_coord_t y;
+        for(y = strip.y1; y <= strip.y2; y++) {
+            lv_coord_t spans[2][2];
+            uint32_t span_cnt = get_row_spans(arc, y, draw_area, spans);
+            uint32_t s;
+            for(s = 0; s < span_cnt; s++) {
+                lv_opa_t * map_p = &map[(y - strip.y1) * w + spans[s][0] - strip.x1];
+                if(get_span(arc, map_p, y, spans[s][0], spans[s][1])) any = true;
+            }
+        }
+        if(!any) continue;
 
-    cir_x = ((radius - thick_half) * lv_trigo_sin(90 - angle)) >> (LV_TRIGO_SHIFT - ps);
-    cir_y = ((radius - thick_half) * lv_trigo_sin(angle)) >> (LV_TRIGO_SHIFT - ps);
+        lv_draw_mask_map_param_t map_param;
+        lv_draw_mask_map_init(&map_param, &strip, map);
+        int16_t map_id = lv_draw_mask_add(&map_param, NULL);
 
-    /*Actually the center of the pixel need to be calculated so apply 1/2 px offset*/
-    if(cir_x > 0) {
-        cir_x = (cir_x - pa) >> ps;
-        res_area->x1 = cir_x - thick_half + thick_corr;
-        res_area->x2 = cir_x + thick_half;
-    }
-    else {
-        cir_x = (cir_x + pa) >> ps;
-        res_area->x1 = cir_x - thick_half;
-        res_area->x2 = cir_x + thick_half - thick_corr;
-    }
+        draw_ctx->clip_area = &strip;
+        lv_draw_rect(draw_ctx, &cir_dsc, coords);
 
-    if(cir_y > 0) {
-        cir_y = (cir_y - pa) >> ps;
-        res_area->y1 = cir_y - thick_half + thick_corr;
-        res_area->y2 = cir_y + thick_half;
+        lv_draw_mask_remove_id(map_id);
+        lv_draw_mask_free_param(&map_param);
     }
-    else {
-        cir_y = (cir_y + pa) >> ps;
-        res_area->y1 = cir_y - thick_half;
-        res_area->y2 = cir_y + thick_half - thick_corr;
-    }
-}
 
+    draw_ctx->clip_area = clip_area_ori;
+    lv_free(map);
+#else
+    LV_LOG_WARN("Can't draw arc with image with LV_USE_DRAW_MASKS == 0");
+    LV_UNUSED(draw_ctx);
+    LV_UNUSED(dsc);
+    LV_UNUSED(arc);
+    LV_UNUSED(draw_area);
+    LV_UNUSED(coords);
 #endif /*LV_USE_DRAW_MASKS*/
+}
+
 #endif /*LV_USE_DRAW_SW*/
@@ -31,7 +31,8 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(lv_color_t * dest_buf, const lv_ar
 
 
 LV_ATTRIBUTE_FAST_MEM static void fill_argb(lv_color_t * dest_buf, const lv_area_t * dest_area,
-                                            lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride);
+                                            lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride,
+                                            bool premult);
 
 static void fill_blended(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride, lv_color_t color,
                          lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride, lv_blend_mode_t blend_mode);
@@ -41,7 +42,7 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
 
 LV_ATTRIBUTE_FAST_MEM static void map_argb(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
                                            const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
-                                           const lv_opa_t * mask, lv_coord_t mask_stride, lv_blend_mode_t blend_mode);
+                                           const lv_opa_t * mask, lv_coord_t mask_stride, lv_blend_mode_t blend_mode, bool premult);
 
 static void map_blended(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
                         const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
@@ -58,18 +59,10 @@ static inline lv_color_t color_blend_true_color_multiply(lv_color_t fg, lv_color
 /**********************
  *      MACROS
  **********************/
-#define FILL_NORMAL_MASK_PX(color)                                                          \
-    if(*mask == LV_OPA_COVER) *dest_buf = color;                                 \
-    else *dest_buf = LV_COLOR_MIX(color, *dest_buf, *mask);            \
-    mask++;                                                         \
-    dest_buf++;
-
-#define MAP_NORMAL_MASK_PX(x)                                                          \
-    if(*mask_tmp_x) {          \
-        if(*mask_tmp_x == LV_OPA_COVER) dest_buf[x] = src_buf[x];                                 \
-        else dest_buf[x] = LV_COLOR_MIX(src_buf[x], dest_buf[x], *mask_tmp_x);            \
-    }                                                                                               \
-    mask_tmp_x++;
+/*Premultiplied and straight alpha buffers differ only in how a pixel is set*/
+#define SET_PX_ARGB(buf, color, opa)                                                    \
+    if(premult) set_px_argb_premult(buf, color, opa);                                  \
+    else set_px_argb(buf, color, opa);
 
 
 /**********************
@@ -138,11 +131,13 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx, cons
 
 
     if(lv_color_format_has_alpha(draw_ctx->color_format)) {
+        bool premult = draw_ctx->color_format == LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED;
         if(dsc->src_buf == NULL) {
-            fill_argb(dest_buf, &blend_area, dest_stride, dsc->color, dsc->opa, mask, mask_stride);
+            fill_argb(dest_buf, &blend_area, dest_stride, dsc->color, dsc->opa, mask, mask_stride, premult);
         }
         else {
-            map_argb(dest_buf, &blend_area, dest_stride, src_buf, src_stride, dsc->opa, mask, mask_stride, dsc->blend_mode);
+            map_argb(dest_buf, &blend_area, dest_stride, src_buf, src_stride, dsc->opa, mask, mask_stride, dsc->blend_mode,
+                     premult);
         }
     }
     else if(dsc->blend_mode == LV_BLEND_MODE_NORMAL) {
@@ -216,59 +211,25 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(lv_color_t * dest_buf, const lv_ar
     }
     /*Masked*/
     else {
-#if LV_COLOR_DEPTH == 16
-        uint16_t cint16 = lv_color_to_int(color);
-        uint32_t c32 = cint16 + ((uint32_t)cint16 << 16);
-#endif
+        /*Go through the runs of transparent, fully covered and mixed mask values*/
+        lv_coord_t span;
+        int32_t i;
         /*Only the mask matters*/
         if(opa >= LV_OPA_MAX) {
-            int32_t x_end4 = w - 4;
             for(y = 0; y < h; y++) {
-                for(x = 0; x < w && ((lv_uintptr_t)(mask) & 0x3); x++) {
-                    FILL_NORMAL_MASK_PX(color)
-                }
-
-                for(; x <= x_end4; x += 4) {
-                    uint32_t mask32 = *((uint32_t *)mask);
-                    if(mask32 == 0xFFFFFFFF) {
-#if LV_COLOR_DEPTH == 16
-                        if((lv_uintptr_t)dest_buf & 0x3) {
-                            *(dest_buf + 0) = color;
-                            uint32_t * d = (uint32_t *)(dest_buf + 1);
-                            *d = c32;
-                            *(dest_buf + 3) = color;
-                        }
-                        else {
-                            uint32_t * d = (uint32_t *)dest_buf;
-                            *d = c32;
-                            *(d + 1) = c32;
-                        }
-#else
-                        dest_buf[0] = color;
-                        dest_buf[1] = color;
-                        dest_buf[2] = color;
-                        dest_buf[3] = color;
-#endif
-                        dest_buf += 4;
-                        mask += 4;
-                    }
-                    else if(mask32) {
-                        FILL_NORMAL_MASK_PX(color)
-                        FILL_NORMAL_MASK_PX(color)
-                        FILL_NORMAL_MASK_PX(color)
-                        FILL_NORMAL_MASK_PX(color)
+                for(x = 0; x < w; x += span) {
+                    lv_draw_mask_res_t span_res = lv_draw_mask_get_span(&mask[x], w - x, &span);
+                    if(span_res == LV_DRAW_MASK_RES_FULL_COVER) {
+                        lv_color_fill(&dest_buf[x], color, span);
                     }
-                    else {
-                        mask += 4;
-                        dest_buf += 4;
+                    else if(span_res == LV_DRAW_MASK_RES_CHANGED) {
+                        for(i = x; i < x + span; i++) {
+                            dest_buf[i] = LV_COLOR_MIX(color, dest_buf[i], mask[i]);
+                        }
                     }
                 }
-
-                for(; x < w ; x++) {
-                    FILL_NORMAL_MASK_PX(color)
-                }
-                dest_buf += (dest_stride - w);
-                mask += (mask_stride - w);
+                dest_buf += dest_stride;
+                mask += mask_stride;
             }
         }
         /*With opacity*/
@@ -282,22 +243,23 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(lv_color_t * dest_buf, const lv_ar
             lv_opa_t opa_tmp = LV_OPA_TRANSP;
 
             for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    if(*mask) {
-                        if(*mask != last_mask) opa_tmp = *mask == LV_OPA_COVER ? opa :
-                                                             (uint32_t)((uint32_t)(*mask) * opa) >> 8;
-                        if(*mask != last_mask || !lv_color_eq(last_dest_color, dest_buf[x])) {
+                for(x = 0; x < w; x += span) {
+                    if(lv_draw_mask_get_span(&mask[x], w - x, &span) == LV_DRAW_MASK_RES_TRANSP) continue;
+
+                    for(i = x; i < x + span; i++) {
+                        if(mask[i] != last_mask) opa_tmp = mask[i] == LV_OPA_COVER ? opa :
+                                                               (uint32_t)((uint32_t)(mask[i]) * opa) >> 8;
+                        if(mask[i] != last_mask || !lv_color_eq(last_dest_color, dest_buf[i])) {
                             if(opa_tmp == LV_OPA_COVER) last_res_color = color;
-                            else last_res_color = LV_COLOR_MIX(color, dest_buf[x], opa_tmp);
-                            last_mask = *mask;
-                            last_dest_color = dest_buf[x];
+                            else last_res_color = LV_COLOR_MIX(color, dest_buf[i], opa_tmp);
+                            last_mask = mask[i];
+                            last_dest_color = dest_buf[i];
                         }
-                        dest_buf[x] = last_res_color;
+                        dest_buf[i] = last_res_color;
                     }
-                    mask++;
                 }
                 dest_buf += dest_stride;
-                mask += (mask_stride - w);
+                mask += mask_stride;
             }
         }
     }
@@ -330,8 +292,30 @@ static inline void set_px_argb(uint8_t * buf, lv_color_t color, lv_opa_t opa)
 #endif
 }
 
+/**
+ * Blend a color onto a premultiplied pixel.
+ * As the background is already weighted by its alpha it's a simple mix and an alpha update
+ * instead of the division of `lv_color_mix_with_alpha`.
+ */
+static inline void set_px_argb_premult(uint8_t * buf, lv_color_t color, lv_opa_t opa)
+{
+    if(opa <= LV_OPA_MIN) return;
+
+    if(opa >= LV_OPA_MAX) {
+        lv_memcpy(buf, &color, sizeof(lv_color_t));
+        buf[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS] = LV_OPA_COVER;
+        return;
+    }
+
+    lv_color_t bg_color = lv_color_from_buf(buf);
+    lv_opa_t bg_opa = buf[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS];
+    lv_color_t res_color = LV_COLOR_MIX(color, bg_color, opa);
+    lv_memcpy(buf, &res_color, sizeof(lv_color_t));
+    buf[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS] = opa + LV_UDIV255(bg_opa * (255 - opa));
+}
+
 static inline void set_px_argb_blend(uint8_t * buf, lv_color_t color, lv_opa_t opa, lv_color_t (*blend_fp)(lv_color_t,
-                                                                                                           lv_color_t, lv_opa_t))
+                                                                                                           lv_color_t, lv_opa_t), bool premult)
 {
     static lv_color_t last_dest_color;
     static lv_color_t last_src_color;
@@ -352,6 +336,12 @@ static inline void set_px_argb_blend(uint8_t * buf, lv_color_t color, lv_opa_t o
     bg_color = *((lv_color_t *)buf);
 #endif
 
+    /*The premultiplied BG is `alpha * bg` so the added or subtracted color needs to be weighted the same way.
+     *Multiply scales with the BG so it's correct without that.*/
+    if(premult && blend_fp != color_blend_true_color_multiply) {
+        color = LV_COLOR_MIX(color, lv_color_black(), buf[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS]);
+    }
+
     /*Get the result color*/
     if(!lv_color_eq(last_dest_color, bg_color) || !lv_color_eq(last_src_color, color) || last_opa != opa) {
         last_dest_color = bg_color;
@@ -376,7 +366,8 @@ static inline void set_px_argb_blend(uint8_t * buf, lv_color_t color, lv_opa_t o
 }
 
 LV_ATTRIBUTE_FAST_MEM static void fill_argb(lv_color_t * dest_buf, const lv_area_t * dest_area,
-                                            lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride)
+                                            lv_coord_t dest_stride, lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride,
+                                            bool premult)
 {
     uint8_t * dest_buf8 = (uint8_t *) dest_buf;
     int32_t w = lv_area_get_width(dest_area);
@@ -387,7 +378,7 @@ LV_ATTRIBUTE_FAST_MEM static void fill_argb(lv_color_t * dest_buf, const lv_area
 
     uint8_t ctmp[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE];
     lv_memcpy(ctmp, &color, sizeof(lv_color_t));
-    ctmp[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1] = opa;
+    ctmp[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1] = premult ? LV_OPA_COVER : opa;
 
     /*No mask*/
     if(mask == NULL) {
@@ -409,7 +400,7 @@ LV_ATTRIBUTE_FAST_MEM static void fill_argb(lv_color_t * dest_buf, const lv_area
             uint8_t * dest_buf8_row = dest_buf8;
             for(y = 0; y < h; y++) {
                 for(x = 0; x < w; x++) {
-                    set_px_argb(dest_buf8, color, opa);
+                    SET_PX_ARGB(dest_buf8, color, opa);
                     dest_buf8 += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
                 }
                 dest_buf8_row += dest_stride * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
@@ -424,7 +415,7 @@ LV_ATTRIBUTE_FAST_MEM static void fill_argb(lv_color_t * dest_buf, const lv_area
             uint8_t * dest_buf8_row = dest_buf8;
             for(y = 0; y < h; y++) {
                 for(x = 0; x < w; x++) {
-                    set_px_argb(dest_buf8, color,  *mask);
+                    SET_PX_ARGB(dest_buf8, color,  *mask);
                     mask++;
                     dest_buf8 += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
                 }
@@ -445,7 +436,7 @@ LV_ATTRIBUTE_FAST_MEM static void fill_argb(lv_color_t * dest_buf, const lv_area
                         if(*mask != last_mask) opa_tmp = *mask == LV_OPA_COVER ? opa :
                                                              (uint32_t)((uint32_t)(*mask) * opa) >> 8;
 
-                        set_px_argb(dest_buf8, color,  opa_tmp);
+                        SET_PX_ARGB(dest_buf8, color,  opa_tmp);
                     }
                     dest_buf8 += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
                     mask++;
@@ -560,46 +551,23 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
     }
     /*Masked*/
     else {
+        /*Go through the runs of transparent, fully covered and mixed mask values*/
+        lv_coord_t span;
+        int32_t i;
         /*Only the mask matters*/
         if(opa > LV_OPA_MAX) {
-            int32_t x_end4 = w - 4;
-
             for(y = 0; y < h; y++) {
-                const lv_opa_t * mask_tmp_x = mask;
-#if 0
-                for(x = 0; x < w; x++) {
-                    MAP_NORMAL_MASK_PX(x);
-                }
-#else
-                for(x = 0; x < w && ((lv_uintptr_t)mask_tmp_x & 0x3); x++) {
-                    MAP_NORMAL_MASK_PX(x)
-                }
-
-                uint32_t * mask32 = (uint32_t *)mask_tmp_x;
-                for(; x < x_end4; x += 4) {
-                    if(*mask32) {
-                        if((*mask32) == 0xFFFFFFFF) {
-                            dest_buf[x] = src_buf[x];
-                            dest_buf[x + 1] = src_buf[x + 1];
-                            dest_buf[x + 2] = src_buf[x + 2];
-                            dest_buf[x + 3] = src_buf[x + 3];
-                        }
-                        else {
-                            mask_tmp_x = (const lv_opa_t *)mask32;
-                            MAP_NORMAL_MASK_PX(x)
-                            MAP_NORMAL_MASK_PX(x + 1)
-                            MAP_NORMAL_MASK_PX(x + 2)
-                            MAP_NORMAL_MASK_PX(x + 3)
+                for(x = 0; x < w; x += span) {
+                    lv_draw_mask_res_t span_res = lv_draw_mask_get_span(&mask[x], w - x, &span);
+                    if(span_res == LV_DRAW_MASK_RES_FULL_COVER) {
+                        lv_memcpy(&dest_buf[x], &src_buf[x], span * sizeof(lv_color_t));
+                    }
+                    else if(span_res == LV_DRAW_MASK_RES_CHANGED) {
+                        for(i = x; i < x + span; i++) {
+                            dest_buf[i] = LV_COLOR_MIX(src_buf[i], dest_buf[i], mask[i]);
                         }
                     }
-                    mask32++;
-                }
-
-                mask_tmp_x = (const lv_opa_t *)mask32;
-                for(; x < w ; x++) {
-                    MAP_NORMAL_MASK_PX(x)
                 }
-#endif
                 dest_buf += dest_stride;
                 src_buf += src_stride;
                 mask += mask_stride;
@@ -608,10 +576,18 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
         /*Handle opa and mask values too*/
         else {
             for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    if(mask[x]) {
-                        lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
-                        dest_buf[x] = LV_COLOR_MIX(src_buf[x], dest_buf[x], opa_tmp);
+                for(x = 0; x < w; x += span) {
+                    lv_draw_mask_res_t span_res = lv_draw_mask_get_span(&mask[x], w - x, &span);
+                    if(span_res == LV_DRAW_MASK_RES_FULL_COVER) {
+                        for(i = x; i < x + span; i++) {
+                            dest_buf[i] = LV_COLOR_MIX(src_buf[i], dest_buf[i], opa);
+                        }
+                    }
+                    else if(span_res == LV_DRAW_MASK_RES_CHANGED) {
+                        for(i = x; i < x + span; i++) {
+                            lv_opa_t opa_tmp = mask[i] >= LV_OPA_MAX ? opa : ((opa * mask[i]) >> 8);
+                            dest_buf[i] = LV_COLOR_MIX(src_buf[i], dest_buf[i], opa_tmp);
+                        }
                     }
                 }
                 dest_buf += dest_stride;
@@ -624,7 +600,7 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
 
 LV_ATTRIBUTE_FAST_MEM static void map_argb(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
                                            const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
-                                           const lv_opa_t * mask, lv_coord_t mask_stride, lv_blend_mode_t blend_mode)
+                                           const lv_opa_t * mask, lv_coord_t mask_stride, lv_blend_mode_t blend_mode, bool premult)
 
 {
     uint8_t * dest_buf8 = (uint8_t *) dest_buf;
@@ -665,13 +641,13 @@ LV_ATTRIBUTE_FAST_MEM static void map_argb(lv_color_t * dest_buf, const lv_area_
                 for(y = 0; y < h; y++) {
                     if(blend_fp == NULL) {
                         for(x = 0; x < w; x++) {
-                            set_px_argb(dest_buf8, src_buf[x], LV_OPA_COVER);
+                            SET_PX_ARGB(dest_buf8, src_buf[x], LV_OPA_COVER);
                             dest_buf8 += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
                         }
                     }
                     else {
                         for(x = 0; x < w; x++) {
-                            set_px_argb_blend(dest_buf8, src_buf[x], LV_OPA_COVER, blend_fp);
+                            set_px_argb_blend(dest_buf8, src_buf[x], LV_OPA_COVER, blend_fp, premult);
                             dest_buf8 += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
                         }
                     }
@@ -688,13 +664,13 @@ LV_ATTRIBUTE_FAST_MEM static void map_argb(lv_color_t * dest_buf, const lv_area_
             for(y = 0; y < h; y++) {
                 if(blend_fp == NULL) {
                     for(x = 0; x < w; x++) {
-                        set_px_argb(dest_buf8, src_buf[x], opa);
+                        SET_PX_ARGB(dest_buf8, src_buf[x], opa);
                         dest_buf8 += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
                     }
                 }
                 else {
                     for(x = 0; x < w; x++) {
-                        set_px_argb_blend(dest_buf8, src_buf[x], opa, blend_fp);
+                        set_px_argb_blend(dest_buf8, src_buf[x], opa, blend_fp, premult);
                         dest_buf8 += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
                     }
                 }
@@ -713,13 +689,13 @@ LV_ATTRIBUTE_FAST_MEM static void map_argb(lv_color_t * dest_buf, const lv_area_
             for(y = 0; y < h; y++) {
                 if(blend_fp == NULL) {
                     for(x = 0; x < w; x++) {
-                        set_px_argb(dest_buf8, src_buf[x], mask[x]);
+                        SET_PX_ARGB(dest_buf8, src_buf[x], mask[x]);
                         dest_buf8 += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
                     }
                 }
                 else {
                     for(x = 0; x < w; x++) {
-                        set_px_argb_blend(dest_buf8, src_buf[x], mask[x], blend_fp);
+                        set_px_argb_blend(dest_buf8, src_buf[x], mask[x], blend_fp, premult);
                         dest_buf8 += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
                     }
                 }
@@ -737,7 +713,7 @@ LV_ATTRIBUTE_FAST_MEM static void map_argb(lv_color_t * dest_buf, const lv_area_
                     for(x = 0; x < w; x++) {
                         if(mask[x]) {
                             lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
-                            set_px_argb(dest_buf8, src_buf[x], opa_tmp);
+                            SET_PX_ARGB(dest_buf8, src_buf[x], opa_tmp);
                         }
                         dest_buf8 += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
                     }
@@ -746,7 +722,7 @@ LV_ATTRIBUTE_FAST_MEM static void map_argb(lv_color_t * dest_buf, const lv_area_
                     for(x = 0; x < w; x++) {
                         if(mask[x]) {
                             lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
-                            set_px_argb_blend(dest_buf8, src_buf[x], opa_tmp, blend_fp);
+                            set_px_argb_blend(dest_buf8, src_buf[x], opa_tmp, blend_fp, premult);
                         }
                         dest_buf8 += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
                     }
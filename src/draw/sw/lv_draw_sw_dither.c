@@ -10,26 +10,35 @@
 #if LV_USE_DRAW_SW
 
 #include "lv_draw_sw_gradient.h"
+#include "lv_draw_sw_simd.h"
 #include "../../misc/lv_color.h"
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
-
 #if _DITHER_GRADIENT
 
-LV_ATTRIBUTE_FAST_MEM void lv_dither_none(lv_grad_t * grad, lv_coord_t x, lv_coord_t y, lv_coord_t w)
-{
-    LV_UNUSED(x);
-    LV_UNUSED(y);
-    if(grad == NULL || grad->filled) return;
-    for(lv_coord_t i = 0; i < w; i++) {
-        grad->map[i] = lv_color_hex(grad->hmap[i].full);
-    }
-    grad->filled = 1;
-}
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_USE_DRAW_SW_SIMD && LV_COLOR_DEPTH == 16 && LV_BIG_ENDIAN_SYSTEM == 0
+    #define DITHER_SIMD 1
+#else
+    #define DITHER_SIMD 0
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void ordered_hor_row(const lv_grad_t * grad, lv_color_t * row, uint32_t row_id, lv_coord_t w);
+static inline lv_color_t ordered_px(lv_color32_t c, int32_t factor);
+#if DITHER_SIMD
+static inline lv_simd_u32_t ordered_rgb565_simd(lv_simd_u32_t c, lv_simd_i32_t factor);
+#endif
+#if LV_DRAW_SW_GRADIENT_DITHER_ERROR_DIFFUSION == 1
+static inline lv_color_t quantize(int32_t r, int32_t g, int32_t b, lv_scolor24_t * err);
+#endif
 
+/**********************
+ *  STATIC VARIABLES
+ **********************/
 static const uint8_t dither_ordered_threshold_matrix[8 * 8] = {
     0,  48, 12, 60,  3, 51, 15, 63,
     32, 16, 44, 28, 35, 19, 47, 31,
@@ -41,6 +50,20 @@ static const uint8_t dither_ordered_threshold_matrix[8 * 8] = {
     42, 26, 38, 22, 41, 25, 37, 21
 }; /* Shift by 6 to normalize */
 
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+LV_ATTRIBUTE_FAST_MEM void lv_dither_none(lv_grad_t * grad, lv_coord_t x, lv_coord_t y, lv_coord_t w)
+{
+    LV_UNUSED(x);
+    LV_UNUSED(y);
+    if(grad == NULL || grad->filled) return;
+    for(lv_coord_t i = 0; i < w; i++) {
+        grad->map[i] = lv_color_make(grad->hmap[i].red, grad->hmap[i].green, grad->hmap[i].blue);
+    }
+    grad->filled = 1;
+}
 
 LV_ATTRIBUTE_FAST_MEM void lv_dither_ordered_hor(lv_grad_t * grad, lv_coord_t x, lv_coord_t y, lv_coord_t w)
 {
@@ -53,18 +76,21 @@ LV_ATTRIBUTE_FAST_MEM void lv_dither_ordered_hor(lv_grad_t * grad, lv_coord_t x,
          3. It means that a pixel i,j only depends on the value of a pixel i-7, j-7 to i,j and no other one.
        Then we compute a complete row of ordered dither and store it in out. */
 
-    /*The apply the algorithm for this patch*/
-    for(lv_coord_t j = 0; j < w; j++) {
-        int8_t factor = dither_ordered_threshold_matrix[(y & 7) * 8 + ((j) & 7)] - 32;
-        lv_color32_t tmp = grad->hmap[LV_CLAMP(0, j - 4, grad->size)];
-        lv_color32_t t;
-        t.ch.red   = LV_CLAMP(0, tmp.ch.red + factor, 255);
-        t.ch.green = LV_CLAMP(0, tmp.ch.green + factor, 255);
-        t.ch.blue  = LV_CLAMP(0, tmp.ch.blue + factor, 255);
-
-        grad->map[j] = lv_color_hex(t.full);
+    /*The pattern repeats in every 8 rows, so compute each of them only once if there is place to store them*/
+    uint32_t row_id = y & 7;
+    if(grad->dither_rows == NULL) {
+        ordered_hor_row(grad, grad->map, row_id, w);
+        return;
+    }
+
+    lv_color_t * row = &grad->dither_rows[row_id * grad->size];
+    if((grad->dither_rows_filled & (1 << row_id)) == 0) {
+        ordered_hor_row(grad, row, row_id, grad->size);
+        grad->dither_rows_filled |= 1 << row_id;
     }
+    lv_memcpy(grad->map, row, LV_MIN(w, grad->size) * sizeof(lv_color_t));
 }
+
 LV_ATTRIBUTE_FAST_MEM void lv_dither_ordered_ver(lv_grad_t * grad, lv_coord_t x, lv_coord_t y, lv_coord_t w)
 {
     /* For vertical dithering, the error is spread on the next column (and not next line).
@@ -79,23 +105,17 @@ LV_ATTRIBUTE_FAST_MEM void lv_dither_ordered_ver(lv_grad_t * grad, lv_coord_t x,
     lv_color32_t tmp = grad->hmap[LV_CLAMP(0, y - 4, grad->size)];
 
     /*The apply the algorithm for this patch*/
-    for(lv_coord_t j = 0; j < 8; j++) {
-        int8_t factor = dither_ordered_threshold_matrix[(y & 7) * 8 + ((j + x) & 7)] - 32;
-        lv_color32_t t;
-        t.ch.red   = LV_CLAMP(0, tmp.ch.red + factor, 255);
-        t.ch.green = LV_CLAMP(0, tmp.ch.green + factor, 255);
-        t.ch.blue  = LV_CLAMP(0, tmp.ch.blue + factor, 255);
-
-        grad->map[j] = lv_color_hex(t.full);
-    }
-    /*Finally fill the line*/
-    lv_coord_t j = 8;
-    for(; j < w - 8; j += 8) {
-        lv_memcpy(grad->map + j, grad->map, 8 * sizeof(*grad->map));
+    const uint8_t * th = &dither_ordered_threshold_matrix[(y & 7) * 8];
+    lv_coord_t j;
+    for(j = 0; j < 8 && j < w; j++) {
+        grad->map[j] = ordered_px(tmp, th[(j + x) & 7] - 32);
     }
-    /* Prevent overwriting */
-    for(; j < w; j++) {
-        grad->map[j] = grad->map[j & 7];
+
+    /*Finally fill the line by doubling the already filled part*/
+    while(j < w) {
+        lv_coord_t len = LV_MIN(j, w - j);
+        lv_memcpy(grad->map + j, grad->map, len * sizeof(*grad->map));
+        j += len;
     }
 }
 
@@ -111,48 +131,41 @@ LV_ATTRIBUTE_FAST_MEM void lv_dither_err_diff_hor(lv_grad_t * grad, lv_coord_t x
         Coefs are:   x 7
                    3 5 1
                    / 16
-        Can be implemented as:            x       (x<<3 - x)
-                              (x<<2 - x) (x<<2+x)   x
-    */
-    int coef[4] = {0, 0, 0, 0};
-#define FS_COMPUTE_ERROR(e) { coef[0] = (e<<3) - e; coef[1] = (e<<2) - e; coef[2] = (e<<2) + e; coef[3] = e; }
-#define FS_COMPONENTS(A, OP, B, C) A.ch.red = LV_CLAMP(0, A.ch.red OP B.r OP C.r, 255); A.ch.green = LV_CLAMP(0, A.ch.green OP B.g OP C.g, 255); A.ch.blue = LV_CLAMP(0, A.ch.blue OP B.b OP C.b, 255);
-#define FS_QUANT_ERROR(e, t, q) { lv_color32_t u; u.full = lv_color_to32(q); e.r = (int8_t)(t.ch.red - u.ch.red); e.g = (int8_t)(t.ch.green - u.ch.green); e.b = (int8_t)(t.ch.blue - u.ch.blue); }
-    lv_scolor24_t next_px_err = {0}, next_l = {0}, error;
+       `error_acc` is a line buffer: left to `x` it already has the error of the current line for the next line,
+       from `x` it still has the error of the previous line.*/
+    lv_scolor24_t * acc = grad->error_acc;
+    const lv_color32_t * hmap = grad->hmap;
+    int32_t next_r = 0, next_g = 0, next_b = 0;     /*The error spread to the next pixel*/
+    lv_scolor24_t next_l = {0, 0, 0};               /*The error of the previous line for the next pixel*/
+    lv_scolor24_t error;
+
     /*First last pixel are not dithered */
-    grad->map[0] = lv_color_hex(grad->hmap[0].full);
+    grad->map[0] = lv_color_make(hmap[0].red, hmap[0].green, hmap[0].blue);
     for(lv_coord_t x = 1; x < grad->size - 1; x++) {
-        lv_color32_t t = grad->hmap[x];
-        lv_color_t q;
         /*Add error term*/
-        FS_COMPONENTS(t, +, next_px_err, next_l);
-        next_l = grad->error_acc[x + 1];
-        /*Quantify*/
-        q = lv_color_hex(t.full);
-        /*Then compute error*/
-        FS_QUANT_ERROR(error, t, q);
-        /*Dither the error*/
-        FS_COMPUTE_ERROR(error.r);
-        next_px_err.r      = coef[0] >> 4;
-        grad->error_acc[x - 1].r += coef[1] >> 4;
-        grad->error_acc[x].r     += coef[2] >> 4;
-        grad->error_acc[x + 1].r = coef[3] >> 4;
-
-        FS_COMPUTE_ERROR(error.g);
-        next_px_err.g      = coef[0] >> 4;
-        grad->error_acc[x - 1].g += coef[1] >> 4;
-        grad->error_acc[x].g     += coef[2] >> 4;
-        grad->error_acc[x + 1].g = coef[3] >> 4;
-
-        FS_COMPUTE_ERROR(error.b);
-        next_px_err.b      = coef[0] >> 4;
-        grad->error_acc[x - 1].b += coef[1] >> 4;
-        grad->error_acc[x].b     += coef[2] >> 4;
-        grad->error_acc[x + 1].b = coef[3] >> 4;
-
-        grad->map[x] = q;
+        int32_t r = LV_CLAMP(0, hmap[x].red + next_r + next_l.r, 255);
+        int32_t g = LV_CLAMP(0, hmap[x].green + next_g + next_l.g, 255);
+        int32_t b = LV_CLAMP(0, hmap[x].blue + next_b + next_l.b, 255);
+        next_l = acc[x + 1];
+
+        /*Quantify and dither the error*/
+        grad->map[x] = quantize(r, g, b, &error);
+        next_r = (int8_t)((error.r * 7) >> 4);
+        next_g = (int8_t)((error.g * 7) >> 4);
+        next_b = (int8_t)((error.b * 7) >> 4);
+
+        acc[x - 1].r += (error.r * 3) >> 4;
+        acc[x - 1].g += (error.g * 3) >> 4;
+        acc[x - 1].b += (error.b * 3) >> 4;
+        acc[x].r += (error.r * 5) >> 4;
+        acc[x].g += (error.g * 5) >> 4;
+        acc[x].b += (error.b * 5) >> 4;
+        acc[x + 1].r = error.r >> 4;
+        acc[x + 1].g = error.g >> 4;
+        acc[x + 1].b = error.b >> 4;
     }
-    grad->map[grad->size - 1] = lv_color_hex(grad->hmap[grad->size - 1].full);
+    lv_color32_t last = hmap[grad->size - 1];
+    grad->map[grad->size - 1] = lv_color_make(last.red, last.green, last.blue);
 }
 
 LV_ATTRIBUTE_FAST_MEM void lv_dither_err_diff_ver(lv_grad_t * grad, lv_coord_t xs, lv_coord_t y, lv_coord_t w)
@@ -176,41 +189,119 @@ LV_ATTRIBUTE_FAST_MEM void lv_dither_err_diff_ver(lv_grad_t * grad, lv_coord_t x
        Let's remove it and re-dispatch the error factor accordingly so they stays normalized:
            e(i,j) ~= 1/16 * [ e(i-1,j) * 6 + e(i-1,j-1) * 1 + e(i,j-1) * 9]
 
-       That's the idea of this pseudo Floyd Steinberg dithering */
-#define FS_APPLY(d, s, c) d.r = (int8_t)(s.r * c) >> 4; d.g = (int8_t)(s.g * c) >> 4; d.b = (int8_t)(s.b * c) >> 4;
-#define FS_COMPONENTS3(A, OP, B, b, C, c, D, d) \
-    A.ch.red   = LV_CLAMP(0, A.ch.red   OP ((B.r * b OP C.r * c OP D.r * d) >> 4), 255); \
-    A.ch.green = LV_CLAMP(0, A.ch.green OP ((B.r * b OP C.r * c OP D.r * d) >> 4), 255); \
-    A.ch.blue  = LV_CLAMP(0, A.ch.blue  OP ((B.r * b OP C.r * c OP D.r * d) >> 4), 255);
+       That's the idea of this pseudo Floyd Steinberg dithering.
+       All the pixels of the line have the same source color, only the errors are different.*/
+    lv_scolor24_t * acc = grad->error_acc;
+    lv_color32_t c = grad->hmap[y];
+    lv_scolor24_t next_px_err;
+    lv_scolor24_t prev_l = acc[0];
 
-    lv_scolor24_t next_px_err, prev_l = grad->error_acc[0];
     /*Compute the error term for the current pixel (first pixel is never dithered)*/
-    if(xs == 0) {
-        grad->map[0] = lv_color_hex(grad->hmap[y].full);
-        FS_QUANT_ERROR(next_px_err, grad->hmap[y], grad->map[0]);
-    }
-    else {
-        lv_color_t tmp = lv_color_hex(grad->hmap[y].full);
-        lv_color32_t t = grad->hmap[y];
-        FS_QUANT_ERROR(next_px_err, grad->hmap[y], tmp);
-        FS_COMPONENTS3(t, +, next_px_err, 6, prev_l, 1, grad->error_acc[0], 9);
-        grad->map[0] = lv_color_hex(t.full);
+    grad->map[0] = quantize(c.red, c.green, c.blue, &next_px_err);
+    if(xs != 0) {
+        int32_t r = LV_CLAMP(0, c.red + ((next_px_err.r * 6 + prev_l.r + acc[0].r * 9) >> 4), 255);
+        int32_t g = LV_CLAMP(0, c.green + ((next_px_err.g * 6 + prev_l.g + acc[0].g * 9) >> 4), 255);
+        int32_t b = LV_CLAMP(0, c.blue + ((next_px_err.b * 6 + prev_l.b + acc[0].b * 9) >> 4), 255);
+        grad->map[0] = lv_color_make(r, g, b);
     }
 
     for(lv_coord_t x = 1; x < w; x++) {
-        lv_color32_t t = grad->hmap[y];
-        lv_color_t q;
         /*Add the current error term*/
-        FS_COMPONENTS3(t, +, next_px_err, 6, prev_l, 1, grad->error_acc[x], 9);
-        prev_l = grad->error_acc[x];
-        /*Quantize and compute error term*/
-        q = lv_color_hex(t.full);
-        FS_QUANT_ERROR(next_px_err, t, q);
-        /*Store error for next line computation*/
-        grad->error_acc[x] = next_px_err;
-        grad->map[x] = q;
+        int32_t r = LV_CLAMP(0, c.red + ((next_px_err.r * 6 + prev_l.r + acc[x].r * 9) >> 4), 255);
+        int32_t g = LV_CLAMP(0, c.green + ((next_px_err.g * 6 + prev_l.g + acc[x].g * 9) >> 4), 255);
+        int32_t b = LV_CLAMP(0, c.blue + ((next_px_err.b * 6 + prev_l.b + acc[x].b * 9) >> 4), 255);
+        prev_l = acc[x];
+
+        /*Quantize and store the error for the next line too*/
+        grad->map[x] = quantize(r, g, b, &next_px_err);
+        acc[x] = next_px_err;
+    }
+}
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void ordered_hor_row(const lv_grad_t * grad, lv_color_t * row, uint32_t row_id, lv_coord_t w)
+{
+    const uint8_t * th = &dither_ordered_threshold_matrix[row_id * 8];
+    const lv_color32_t * hmap = grad->hmap;
+    lv_coord_t j = 0;
+
+#if DITHER_SIMD
+    /*The source is shifted by 4 pixels, so start the vector part at the 8th pixel
+     *where the pattern also starts again*/
+    for(; j < 8 && j < w; j++) {
+        row[j] = ordered_px(hmap[LV_MAX(j - 4, 0)], th[j & 7] - 32);
+    }
+
+    lv_simd_i32_t factor_lo = {th[0] - 32, th[1] - 32, th[2] - 32, th[3] - 32};
+    lv_simd_i32_t factor_hi = {th[4] - 32, th[5] - 32, th[6] - 32, th[7] - 32};
+    for(; j + 8 <= w; j += 8) {
+        lv_simd_u32_t lo = ordered_rgb565_simd(lv_simd_load_u32(&hmap[j - 4]), factor_lo);
+        lv_simd_u32_t hi = ordered_rgb565_simd(lv_simd_load_u32(&hmap[j]), factor_hi);
+        lv_simd_u16_t px = LV_SIMD_SHUFFLE(lv_simd_u16_t, (lv_simd_u16_t)lo, (lv_simd_u16_t)hi,
+                                           0, 2, 4, 6, 8, 10, 12, 14);
+        __builtin_memcpy(&row[j], &px, sizeof(px));
+    }
+#endif
+
+    for(; j < w; j++) {
+        row[j] = ordered_px(hmap[LV_MAX(j - 4, 0)], th[j & 7] - 32);
     }
 }
+
+static inline lv_color_t ordered_px(lv_color32_t c, int32_t factor)
+{
+    return lv_color_make(LV_CLAMP(0, c.red + factor, 255),
+                         LV_CLAMP(0, c.green + factor, 255),
+                         LV_CLAMP(0, c.blue + factor, 255));
+}
+
+#if DITHER_SIMD
+/*Add the factors to 4 XRGB8888 pixels with saturation and convert them to RGB565*/
+static inline lv_simd_u32_t ordered_rgb565_simd(lv_simd_u32_t c, lv_simd_i32_t factor)
+{
+    lv_simd_i32_t r = (lv_simd_i32_t)((c >> 16) & 0xFF) + factor;
+    lv_simd_i32_t g = (lv_simd_i32_t)((c >> 8) & 0xFF) + factor;
+    lv_simd_i32_t b = (lv_simd_i32_t)(c & 0xFF) + factor;
+
+    /*Negative values to 0, then values above 255 to 255*/
+    r &= ~(r >> 31);
+    g &= ~(g >> 31);
+    b &= ~(b >> 31);
+    r |= (255 - r) >> 31;
+    g |= (255 - g) >> 31;
+    b |= (255 - b) >> 31;
+
+    lv_simd_u32_t ur = (lv_simd_u32_t)r;
+    lv_simd_u32_t ug = (lv_simd_u32_t)g;
+    lv_simd_u32_t ub = (lv_simd_u32_t)b;
+    return ((ur & 0xF8) << 8) | ((ug & 0xFC) << 3) | ((ub & 0xFF) >> 3);
+}
+#endif
+
+#if LV_DRAW_SW_GRADIENT_DITHER_ERROR_DIFFUSION == 1
+/*Quantize the channels to the native color and get how much was lost*/
+static inline lv_color_t quantize(int32_t r, int32_t g, int32_t b, lv_scolor24_t * err)
+{
+    lv_color_t q = lv_color_make(r, g, b);
+#if LV_COLOR_DEPTH == 16
+    /*The same as `lv_color_to32` but without packing and unpacking the channels*/
+    err->r = (int8_t)(r - ((((r >> 3) * 263) + 7) >> 5));
+    err->g = (int8_t)(g - ((((g >> 2) * 259) + 3) >> 6));
+    err->b = (int8_t)(b - ((((b >> 3) * 263) + 7) >> 5));
+#else
+    lv_color32_t u = lv_color_to32(q);
+    err->r = (int8_t)(r - u.red);
+    err->g = (int8_t)(g - u.green);
+    err->b = (int8_t)(b - u.blue);
 #endif
+    return q;
+}
 #endif
+
+#endif /*_DITHER_GRADIENT*/
+
 #endif /*LV_USE_DRAW_SW*/
@@ -17,7 +17,7 @@
  *********************/
 #if _DITHER_GRADIENT
     #define GRAD_CM(r,g,b) LV_COLOR_MAKE32(r,g,b)
-    #define GRAD_CONV(t, x) t.full = lv_color_to32(x)
+    #define GRAD_CONV(t, x) t = lv_color_to32(x)
 #else
     #define GRAD_CM(r,g,b) LV_COLOR_MAKE(r,g,b)
     #define GRAD_CONV(t, x) t = x
@@ -79,6 +79,7 @@ static size_t get_cache_item_size(lv_grad_t * c)
 #if LV_DRAW_SW_GRADIENT_DITHER_ERROR_DIFFUSION == 1
     s += ALIGN(c->w * sizeof(lv_scolor24_t));
 #endif
+    if(c->dither_rows) s += ALIGN(8 * c->size * sizeof(lv_color_t));
 #endif
     return s;
 }
@@ -132,6 +133,7 @@ static void free_item(lv_grad_t * c)
 #if LV_DRAW_SW_GRADIENT_DITHER_ERROR_DIFFUSION == 1
             c->error_acc = (lv_scolor24_t *)(((uint8_t *)c->error_acc) - size);
 #endif
+            if(c->dither_rows) c->dither_rows = (lv_color_t *)(((uint8_t *)c->dither_rows) - size);
 #endif
             c = (lv_grad_t *)(((uint8_t *)c) + get_cache_item_size(c));
         }
@@ -169,6 +171,12 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
 #if LV_DRAW_SW_GRADIENT_DITHER_ERROR_DIFFUSION == 1
     req_size += ALIGN(w * sizeof(lv_scolor24_t));
 #endif
+    /*The ordered dithering of horizontal gradients repeats in every 8 rows so store them at the end*/
+    size_t rows_size = 0;
+    if(g->dir == LV_GRAD_DIR_HOR && g->dither == LV_DITHER_ORDERED) {
+        rows_size = ALIGN(8 * size * sizeof(lv_color_t));
+        req_size += rows_size;
+    }
 #endif
 
     size_t act_size = (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
@@ -203,6 +211,10 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
     item->filled = 0;
     item->alloc_size = map_size;
     item->size = size;
+#if _DITHER_GRADIENT
+    item->dither_rows = rows_size ? (lv_color_t *)((uint8_t *)item + req_size - rows_size) : NULL;
+    item->dither_rows_filled = 0;
+#endif
     if(item->not_cached) {
         uint8_t * p = (uint8_t *)item;
         item->map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
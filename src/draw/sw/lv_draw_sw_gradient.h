@@ -53,6 +53,9 @@ typedef struct _lv_gradient_cache_t {
 #if _DITHER_GRADIENT
     lv_color32_t  * hmap;         /**< If dithering, we need to store the current, high bitdepth gradient
                                    * map too, points to the cache's buffer, no free needed */
+    lv_color_t   *  dither_rows;  /**< The 8 rows of the ordered dithering of horizontal gradients as the pattern
+                                   * repeats vertically. NULL if not used, else points to the cache's buffer */
+    uint8_t         dither_rows_filled; /**< A bit for each row of `dither_rows` which is already computed */
 #if LV_DRAW_SW_GRADIENT_DITHER_ERROR_DIFFUSION == 1
     lv_scolor24_t * error_acc;    /**< Error diffusion dithering algorithm requires storing the last error
                                    * drawn, points to the cache's buffer, no free needed  */
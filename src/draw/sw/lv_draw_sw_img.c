@@ -31,6 +31,7 @@
  **********************/
 static void convert_cb(const lv_area_t * dest_area, const void * src_buf, lv_coord_t src_w, lv_coord_t src_h,
                        lv_coord_t src_stride, const lv_draw_img_sup_t * sup, lv_color_format_t cf, lv_color_t * cbuf, lv_opa_t * abuf);
+static void blend_premult(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const uint8_t * src_buf, lv_opa_t opa);
 
 /**********************
  *  STATIC VARIABLES
@@ -84,6 +85,12 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_img_decoded(struct _lv_draw_ctx_t * draw_c
         blend_dsc.blend_area = coords;
         lv_draw_sw_blend(draw_ctx, &blend_dsc);
     }
+    else if(!mask_any && !transform && cf == LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED &&
+            draw_dsc->recolor_opa == LV_OPA_TRANSP && draw_dsc->blend_mode == LV_BLEND_MODE_NORMAL &&
+            (draw_ctx->color_format == LV_COLOR_FORMAT_NATIVE ||
+             draw_ctx->color_format == LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED)) {
+        blend_premult(draw_ctx, coords, src_buf, draw_dsc->opa);
+    }
 #if LV_COLOR_DEPTH == 16
     else if(!mask_any && !transform && cf == LV_COLOR_FORMAT_RGB565A8 && draw_dsc->recolor_opa == LV_OPA_TRANSP) {
         lv_coord_t src_w = lv_area_get_width(coords);
@@ -237,7 +244,7 @@ static void convert_cb(const lv_area_t * dest_area, const void * src_buf, lv_coo
             cbuf_tmp += dest_w;
         }
     }
-    else if(cf == LV_COLOR_FORMAT_NATIVE_ALPHA) {
+    else if(cf == LV_COLOR_FORMAT_NATIVE_ALPHA || cf == LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED) {
         src_tmp8 += (src_stride * dest_area->y1 * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE) + dest_area->x1 *
                     LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
 
@@ -268,6 +275,11 @@ static void convert_cb(const lv_area_t * dest_area, const void * src_buf, lv_coo
             abuf += dest_w;
             src_tmp8 += src_new_line_step_byte;
         }
+
+        /*The rest of the pipeline (recolor, masks, blending) works with straight alpha*/
+        if(cf == LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED) {
+            lv_color_unpremultiply_split(cbuf_ori, abuf_ori, lv_area_get_size(dest_area));
+        }
     }
 #if LV_COLOR_DEPTH == 16
     else if(cf == LV_COLOR_FORMAT_RGB565A8) {
@@ -360,4 +372,83 @@ static void convert_cb(const lv_area_t * dest_area, const void * src_buf, lv_coo
     }
 }
 
+/**
+ * `src + dest * (255 - src_opa) / 255` on each channel of a premultiplied source color
+ */
+static inline lv_color_t color_over_premult(lv_color_t src, lv_color_t dest, lv_opa_t src_opa)
+{
+    uint32_t inv = 255 - src_opa;
+#if LV_COLOR_DEPTH == 8
+    src.level = LV_MIN(src.level + LV_UDIV255(dest.level * inv), 0xFF);
+#elif LV_COLOR_DEPTH == 16
+    src.red = LV_MIN(src.red + LV_UDIV255(dest.red * inv), 0x1F);
+    src.green = LV_MIN(src.green + LV_UDIV255(dest.green * inv), 0x3F);
+    src.blue = LV_MIN(src.blue + LV_UDIV255(dest.blue * inv), 0x1F);
+#else
+    src.red = LV_MIN(src.red + LV_UDIV255(dest.red * inv), 0xFF);
+    src.green = LV_MIN(src.green + LV_UDIV255(dest.green * inv), 0xFF);
+    src.blue = LV_MIN(src.blue + LV_UDIV255(dest.blue * inv), 0xFF);
+#endif
+    LV_COLOR_SET_A(src, 0xFF);
+    return src;
+}
+
+/**
+ * Blend a premultiplied image onto a NATIVE or premultiplied draw buffer.
+ * The colors are already weighted by the alpha so a pixel is only an addition and a multiplication
+ * without normalizing by the result alpha.
+ */
+static void blend_premult(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const uint8_t * src_buf, lv_opa_t opa)
+{
+    if(opa <= LV_OPA_MIN) return;
+
+    lv_area_t blend_area;
+    if(!_lv_area_intersect(&blend_area, coords, draw_ctx->clip_area)) return;
+
+    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+
+    bool dest_alpha = draw_ctx->color_format == LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED;
+    uint32_t dest_px_size = dest_alpha ? LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE : sizeof(lv_color_t);
+    uint32_t dest_stride = lv_area_get_width(draw_ctx->buf_area) * dest_px_size;
+    uint32_t src_stride = lv_area_get_width(coords) * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+    lv_coord_t w = lv_area_get_width(&blend_area);
+    lv_coord_t h = lv_area_get_height(&blend_area);
+
+    uint8_t * dest = (uint8_t *)draw_ctx->buf;
+    dest += (blend_area.y1 - draw_ctx->buf_area->y1) * dest_stride;
+    dest += (blend_area.x1 - draw_ctx->buf_area->x1) * dest_px_size;
+    src_buf += (blend_area.y1 - coords->y1) * src_stride;
+    src_buf += (blend_area.x1 - coords->x1) * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < h; y++) {
+        const uint8_t * src_px = src_buf;
+        uint8_t * dest_px = dest;
+        for(x = 0; x < w; x++) {
+            lv_opa_t src_opa = src_px[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS];
+            lv_color_t src_color = lv_color_from_buf(src_px);
+            if(opa < LV_OPA_MAX) {
+                src_opa = LV_UDIV255(src_opa * opa);
+                src_color = LV_COLOR_MIX(src_color, lv_color_black(), opa);
+            }
+
+            if(src_opa == LV_OPA_COVER) {
+                lv_memcpy(dest_px, &src_color, sizeof(lv_color_t));
+                if(dest_alpha) dest_px[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS] = LV_OPA_COVER;
+            }
+            else if(src_opa > LV_OPA_TRANSP) {
+                lv_opa_t dest_opa = dest_alpha ? dest_px[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS] : LV_OPA_COVER;
+                lv_color_t res = color_over_premult(src_color, lv_color_from_buf(dest_px), src_opa);
+                lv_memcpy(dest_px, &res, sizeof(lv_color_t));
+                if(dest_alpha) dest_px[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS] = src_opa + LV_UDIV255(dest_opa * (255 - src_opa));
+            }
+            src_px += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+            dest_px += dest_px_size;
+        }
+        src_buf += src_stride;
+        dest += dest_stride;
+    }
+}
+
 #endif /*LV_USE_DRAW_SW*/
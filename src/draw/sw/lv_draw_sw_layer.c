@@ -12,10 +12,16 @@
 #include "../../core/lv_disp.h"
 #include "../../misc/lv_area.h"
 #include "../../core/lv_refr.h"
+#include "../../core/lv_disp_private.h"
 
 /*********************
  *      DEFINES
  *********************/
+#if LV_DRAW_SW_PREMULTIPLIED_ALPHA
+    #define LAYER_CF_ALPHA  LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED
+#else
+    #define LAYER_CF_ALPHA  LV_COLOR_FORMAT_NATIVE_ALPHA
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -47,16 +53,24 @@ struct _lv_draw_layer_ctx_t * lv_draw_sw_layer_create(struct _lv_draw_ctx_t * dr
 {
     lv_draw_sw_layer_ctx_t * layer_sw_ctx = (lv_draw_sw_layer_ctx_t *) layer_ctx;
     uint32_t px_size = flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA ? LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE : sizeof(lv_color_t);
+
+    /*Reuse the buffers of the earlier layers if rendering a display.
+     *The canvas has its own draw_ctx, so it just allocates.*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    layer_sw_ctx->buf_pool = disp && disp->draw_ctx == draw_ctx ? &disp->layer_buf_pool : NULL;
+
     if(flags & LV_DRAW_LAYER_FLAG_CAN_SUBDIVIDE) {
         layer_sw_ctx->buf_size_bytes = LV_DRAW_SW_LAYER_SIMPLE_BUF_SIZE;
         uint32_t full_size = lv_area_get_size(&layer_sw_ctx->base_draw.area_full) * px_size;
         if(layer_sw_ctx->buf_size_bytes > full_size) layer_sw_ctx->buf_size_bytes = full_size;
-        layer_sw_ctx->base_draw.buf = lv_malloc(layer_sw_ctx->buf_size_bytes);
+        layer_sw_ctx->base_draw.buf = _lv_draw_layer_buf_get(layer_sw_ctx->buf_pool, layer_sw_ctx->buf_size_bytes,
+                                                             &layer_sw_ctx->buf_real_size_bytes);
         if(layer_sw_ctx->base_draw.buf == NULL) {
             LV_LOG_WARN("Cannot allocate %"LV_PRIu32" bytes for layer buffer. Allocating %"LV_PRIu32" bytes instead. (Reduced performance)",
                         (uint32_t)layer_sw_ctx->buf_size_bytes, (uint32_t)LV_DRAW_SW_LAYER_SIMPLE_FALLBACK_BUF_SIZE * px_size);
             layer_sw_ctx->buf_size_bytes = LV_DRAW_SW_LAYER_SIMPLE_FALLBACK_BUF_SIZE;
-            layer_sw_ctx->base_draw.buf = lv_malloc(layer_sw_ctx->buf_size_bytes);
+            layer_sw_ctx->base_draw.buf = _lv_draw_layer_buf_get(layer_sw_ctx->buf_pool, layer_sw_ctx->buf_size_bytes,
+                                                                 &layer_sw_ctx->buf_real_size_bytes);
             if(layer_sw_ctx->base_draw.buf == NULL) {
                 return NULL;
             }
@@ -70,7 +84,8 @@ struct _lv_draw_layer_ctx_t * lv_draw_sw_layer_create(struct _lv_draw_ctx_t * dr
     else {
         layer_sw_ctx->base_draw.area_act = layer_sw_ctx->base_draw.area_full;
         layer_sw_ctx->buf_size_bytes = lv_area_get_size(&layer_sw_ctx->base_draw.area_full) * px_size;
-        layer_sw_ctx->base_draw.buf = lv_malloc(layer_sw_ctx->buf_size_bytes);
+        layer_sw_ctx->base_draw.buf = _lv_draw_layer_buf_get(layer_sw_ctx->buf_pool, layer_sw_ctx->buf_size_bytes,
+                                                             &layer_sw_ctx->buf_real_size_bytes);
         LV_ASSERT_MALLOC(layer_sw_ctx->base_draw.buf);
         if(layer_sw_ctx->base_draw.buf == NULL) return NULL;
 
@@ -79,7 +94,7 @@ struct _lv_draw_layer_ctx_t * lv_draw_sw_layer_create(struct _lv_draw_ctx_t * dr
         draw_ctx->buf = layer_sw_ctx->base_draw.buf;
         draw_ctx->buf_area = &layer_sw_ctx->base_draw.area_act;
         draw_ctx->clip_area = &layer_sw_ctx->base_draw.area_act;
-        draw_ctx->color_format = flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA ? LV_COLOR_FORMAT_NATIVE_ALPHA : LV_COLOR_FORMAT_NATIVE;
+        draw_ctx->color_format = flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA ? LAYER_CF_ALPHA : LV_COLOR_FORMAT_NATIVE;
     }
 
     return layer_ctx;
@@ -92,7 +107,7 @@ void lv_draw_sw_layer_adjust(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_l
     lv_draw_sw_layer_ctx_t * layer_sw_ctx = (lv_draw_sw_layer_ctx_t *) layer_ctx;
     if(flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA) {
         lv_memzero(layer_ctx->buf, layer_sw_ctx->buf_size_bytes);
-        draw_ctx->color_format = LV_COLOR_FORMAT_NATIVE_ALPHA;
+        draw_ctx->color_format = LAYER_CF_ALPHA;
     }
     else {
         draw_ctx->color_format = LV_COLOR_FORMAT_NATIVE;
@@ -106,12 +121,8 @@ void lv_draw_sw_layer_adjust(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_l
 void lv_draw_sw_layer_blend(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_layer_ctx_t * layer_ctx,
                             const lv_draw_img_dsc_t * draw_dsc)
 {
-    lv_img_dsc_t img;
-    img.data = draw_ctx->buf;
-    img.header.always_zero = 0;
-    img.header.w = lv_area_get_width(draw_ctx->buf_area);
-    img.header.h = lv_area_get_height(draw_ctx->buf_area);
-    img.header.cf = draw_ctx->color_format;
+    const uint8_t * buf = draw_ctx->buf;
+    lv_color_format_t cf = draw_ctx->color_format;
 
     /*Restore the original draw_ctx*/
     draw_ctx->buf = layer_ctx->original.buf;
@@ -119,17 +130,37 @@ void lv_draw_sw_layer_blend(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_la
     draw_ctx->clip_area = layer_ctx->original.clip_area;
     draw_ctx->color_format = layer_ctx->original.color_format;
 
-    /*Blend the layer*/
-    lv_draw_img(draw_ctx, draw_dsc, &layer_ctx->area_act, &img);
+    if(draw_dsc->opa <= LV_OPA_MIN) return;
+
+    /*The layer is already in a native format, so blend it directly instead of going through
+     *`lv_draw_img()`, i.e. the image decoder and the image and transformation caches*/
+    const lv_area_t * coords = &layer_ctx->area_act;
+    lv_area_t draw_area = *coords;
+    if(draw_dsc->angle || draw_dsc->zoom != LV_ZOOM_NONE) {
+        _lv_img_buf_get_transformed_area(&draw_area, lv_area_get_width(coords), lv_area_get_height(coords),
+                                         draw_dsc->angle, draw_dsc->zoom, &draw_dsc->pivot);
+        lv_area_move(&draw_area, coords->x1, coords->y1);
+    }
+
+    lv_area_t clip_area;
+    if(!_lv_area_intersect(&clip_area, draw_ctx->clip_area, &draw_area)) return;
+
+    lv_draw_img_sup_t sup;
+    lv_memzero(&sup, sizeof(sup));
+
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    draw_ctx->clip_area = &clip_area;
+    lv_draw_img_decoded(draw_ctx, draw_dsc, coords, buf, &sup, cf);
     lv_draw_wait_for_finish(draw_ctx);
-    lv_img_cache_invalidate_src(&img);
+    draw_ctx->clip_area = clip_area_ori;
 }
 
 void lv_draw_sw_layer_destroy(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx)
 {
     LV_UNUSED(draw_ctx);
 
-    lv_free(layer_ctx->buf);
+    lv_draw_sw_layer_ctx_t * layer_sw_ctx = (lv_draw_sw_layer_ctx_t *) layer_ctx;
+    _lv_draw_layer_buf_release(layer_sw_ctx->buf_pool, layer_ctx->buf, layer_sw_ctx->buf_real_size_bytes);
 }
 
 
@@ -9,22 +9,42 @@
 #include "lv_draw_sw.h"
 #if LV_USE_DRAW_SW
 
+#include "lv_draw_sw_simd.h"
 #include "../../core/lv_disp.h"
 #include "../../misc/lv_math.h"
 #include "../../misc/lv_assert.h"
 #include "../../misc/lv_area.h"
 #include "../../misc/lv_style.h"
 #include "../../font/lv_font.h"
+#include "../../font/lv_font_fmt_txt.h"
 #include "../../core/lv_refr.h"
+#include "../../core/lv_disp_private.h"
 
 /*********************
  *      DEFINES
  *********************/
+#define LETTER_RUN_MAX  16  /*Max. number of letters rendered into the same mask buffer*/
+
+#if LV_DRAW_SW_GLYPH_CACHE_SIZE
+#define GLYPH_CACHE_SLOT_CNT    (LV_DRAW_SW_GLYPH_CACHE_SIZE / 64 + 1)  /*Assume ~64 bytes per glyph*/
+#define GLYPH_CACHE_GLYPH_MAX   (LV_DRAW_SW_GLYPH_CACHE_SIZE / 4)       /*Don't cache larger glyphs than this*/
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_DRAW_SW_GLYPH_CACHE_SIZE
+typedef struct {
+    const lv_font_t * font;     /*NULL if the slot is unused*/
+    uint32_t letter;
+    uint32_t buf_ofs;           /*Index of the glyph's first pixel in `glyph_cache_buf`*/
+    uint32_t lap;               /*Value of `glyph_cache_lap` when the glyph was written*/
+    uint16_t box_w;
+    uint16_t box_h;
+} glyph_cache_slot_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -33,6 +53,22 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
                                                      const lv_point_t * pos, lv_font_glyph_dsc_t * g, const uint8_t * map_p);
 
 
+static uint32_t draw_letter_run(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_arr,
+                                const uint32_t * letters, uint32_t letter_cnt);
+LV_ATTRIBUTE_FAST_MEM static void letter_run_add_glyph(lv_opa_t * mask_buf, const lv_area_t * run_area,
+                                                       const lv_area_t * clipped_area, const lv_point_t * gpos, const lv_font_glyph_dsc_t * g, const uint8_t * map_p,
+                                                       lv_opa_t opa);
+LV_ATTRIBUTE_FAST_MEM static void glyph_row_to_opa(lv_opa_t * dest, const uint8_t * src, uint32_t col_bit,
+                                                   int32_t px_cnt, uint32_t bpp, lv_opa_t opa, const lv_opa_t * opa_table);
+LV_ATTRIBUTE_FAST_MEM static void mask_scale_opa(lv_opa_t * mask, int32_t px_cnt, lv_opa_t opa);
+static const lv_opa_t * get_opa_table(uint32_t bpp);
+#if LV_DRAW_SW_GLYPH_LUT
+static const lv_opa_t * get_glyph_lut(uint32_t bpp, const lv_opa_t * opa_table);
+#endif
+static const uint8_t * get_glyph_bitmap(lv_font_glyph_dsc_t * g, uint32_t letter);
+static bool letter_has_placeholder(uint32_t letter);
+static lv_coord_t get_letter_real_h(const lv_draw_label_dsc_t * dsc, const lv_font_glyph_dsc_t * g);
+
 #if LV_DRAW_SW_FONT_SUBPX
 static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos,
                               lv_font_glyph_dsc_t * g, const uint8_t * map_p);
@@ -42,6 +78,23 @@ static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_
  *  STATIC VARIABLES
  **********************/
 
+#if LV_DRAW_SW_GLYPH_LUT
+/*The opacity of 8, 4 and 2 pixels for every possible byte of the 1, 2 and 4 bpp glyphs*/
+static lv_opa_t glyph_lut_1bpp[256 * 8];
+static lv_opa_t glyph_lut_2bpp[256 * 4];
+static lv_opa_t glyph_lut_4bpp[256 * 2];
+static bool glyph_lut_ready[3];
+#endif
+
+#if LV_DRAW_SW_GLYPH_CACHE_SIZE
+/*The cached glyphs are written one after the other into `glyph_cache_buf` and the oldest ones are overwritten
+ *when the writing restarts from the beginning of the buffer*/
+static LV_ATTRIBUTE_LARGE_RAM_ARRAY lv_opa_t glyph_cache_buf[LV_DRAW_SW_GLYPH_CACHE_SIZE];
+static glyph_cache_slot_t glyph_cache_slots[GLYPH_CACHE_SLOT_CNT];
+static uint32_t glyph_cache_pos;
+static uint32_t glyph_cache_lap;
+#endif
+
 /**********************
  *  GLOBAL VARIABLES
  **********************/
@@ -102,9 +155,7 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
     if(g_ret == false) {
         /*Add warning if the dsc is not found
          *but do not print warning for non printable ASCII chars (e.g. '\n')*/
-        if(letter >= 0x20 &&
-           letter != 0xf8ff && /*LV_SYMBOL_DUMMY*/
-           letter != 0x200c) { /*ZERO WIDTH NON-JOINER*/
+        if(letter_has_placeholder(letter)) {
             LV_LOG_INFO("glyph dsc not found for U+%" LV_PRIX32, letter);
 
 #if LV_USE_FONT_PLACEHOLDER
@@ -130,17 +181,7 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
     /*Don't draw anything if the character is empty. E.g. space*/
     if((g.box_h == 0) || (g.box_w == 0)) return;
 
-    lv_coord_t real_h;
-#if LV_USE_IMGFONT
-    if(g.bpp == LV_IMGFONT_BPP) {
-        /*Center imgfont's drawing position*/
-        real_h = (dsc->font->line_height - g.box_h) / 2;
-    }
-    else
-#endif
-    {
-        real_h = (dsc->font->line_height - dsc->font->base_line) - g.box_h;
-    }
+    lv_coord_t real_h = get_letter_real_h(dsc, &g);
 
     lv_point_t gpos;
     gpos.x = pos_p->x + g.ofs_x;
@@ -154,7 +195,7 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
         return;
     }
 
-    const uint8_t * map_p = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+    const uint8_t * map_p = get_glyph_bitmap(&g, letter);
     if(map_p == NULL) {
         LV_LOG_WARN("character's bitmap not found");
         return;
@@ -172,20 +213,495 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
     }
 }
 
+/**
+ * Draw letters of the same line with the same style.
+ * The letters are rendered into one mask buffer which is blended at once.
+ * @param draw_ctx      pointer to the draw context
+ * @param dsc           pointer to draw descriptor
+ * @param pos_arr       left-top coordinates of the letters
+ * @param letters       the letters to draw
+ * @param letter_cnt    number of letters
+ */
+void lv_draw_sw_letters(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_arr,
+                        const uint32_t * letters, uint32_t letter_cnt)
+{
+    while(letter_cnt > 0) {
+        uint32_t cnt = draw_letter_run(draw_ctx, dsc, pos_arr, letters, LV_MIN(letter_cnt, LETTER_RUN_MAX));
+        if(cnt == 0) {
+            /*Draw the letters one by one if they can't be rendered together*/
+            cnt = LV_MIN(letter_cnt, LETTER_RUN_MAX);
+            uint32_t i;
+            for(i = 0; i < cnt; i++) {
+                lv_draw_sw_letter(draw_ctx, dsc, &pos_arr[i], letters[i]);
+            }
+        }
+
+        pos_arr += cnt;
+        letters += cnt;
+        letter_cnt -= cnt;
+    }
+}
+
+void lv_draw_sw_glyph_cache_invalidate(void)
+{
+#if LV_DRAW_SW_GLYPH_CACHE_SIZE
+    lv_memzero(glyph_cache_slots, sizeof(glyph_cache_slots));
+    glyph_cache_pos = 0;
+    glyph_cache_lap = 0;
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Render a few letters into a mask buffer and blend them at once.
+ * The run ends before the first letter whose box overlaps the box of an earlier letter
+ * as blending them at once would give slightly different colors than blending them one after the other.
+ * @return the number of letters drawn (at least 1), or 0 if the letters need to be drawn one by one.
+ *         Nothing is drawn in the latter case.
+ */
+static uint32_t draw_letter_run(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_arr,
+                                const uint32_t * letters, uint32_t letter_cnt)
+{
+    lv_font_glyph_dsc_t g_arr[LETTER_RUN_MAX];
+    lv_point_t gpos_arr[LETTER_RUN_MAX];
+    lv_area_t clipped_arr[LETTER_RUN_MAX];
+    bool visible_arr[LETTER_RUN_MAX];
+    lv_area_t run_area;
+    bool run_visible = false;
+
+    /*Collect the glyphs and the area they cover*/
+    uint32_t i;
+    for(i = 0; i < letter_cnt; i++) {
+        lv_font_glyph_dsc_t * g = &g_arr[i];
+        visible_arr[i] = false;
+        if(lv_font_get_glyph_dsc(dsc->font, g, letters[i], '\0') == false) {
+            /*Let `lv_draw_sw_letter` draw the placeholder*/
+            if(letter_has_placeholder(letters[i])) return 0;
+            continue;
+        }
+
+        /*Empty letter, e.g. space*/
+        if((g->box_h == 0) || (g->box_w == 0)) continue;
+
+        /*Only the plain bitmap fonts can be rendered together*/
+        if(g->resolved_font->subpx) return 0;
+        if(g->bpp != 1 && g->bpp != 2 && g->bpp != 3 && g->bpp != 4 && g->bpp != 8) return 0;
+
+        gpos_arr[i].x = pos_arr[i].x + g->ofs_x;
+        gpos_arr[i].y = pos_arr[i].y + get_letter_real_h(dsc, g) - g->ofs_y;
+
+        lv_area_t * g_area = &clipped_arr[i];
+        g_area->x1 = gpos_arr[i].x;
+        g_area->y1 = gpos_arr[i].y;
+        g_area->x2 = g_area->x1 + g->box_w - 1;
+        g_area->y2 = g_area->y1 + g->box_h - 1;
+        if(!_lv_area_intersect(g_area, g_area, draw_ctx->clip_area)) continue;
+
+        /*Overlapping glyphs, e.g. kerned or italic letters, are drawn in the next run*/
+        uint32_t j;
+        for(j = 0; j < i; j++) {
+            if(visible_arr[j] && _lv_area_is_on(g_area, &clipped_arr[j])) break;
+        }
+        if(j < i) break;
+
+        visible_arr[i] = true;
+        if(run_visible) {
+            _lv_area_join(&run_area, &run_area, g_area);
+        }
+        else {
+            run_area = *g_area;
+            run_visible = true;
+        }
+    }
+
+    letter_cnt = i;
+    if(run_visible == false) return letter_cnt;
+
+    /*Don't allocate much more than drawing the letters one by one would do*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    lv_coord_t hor_res = lv_disp_get_hor_res(disp);
+    uint32_t mask_buf_size = lv_area_get_size(&run_area);
+    if(mask_buf_size > (uint32_t)hor_res * LETTER_RUN_MAX) return 0;
+
+    /*Reuse the buffers of the display's layer buffer pool*/
+    lv_draw_layer_buf_pool_t * buf_pool = disp && disp->draw_ctx == draw_ctx ? &disp->layer_buf_pool : NULL;
+    uint32_t mask_buf_real_size;
+    lv_opa_t * mask_buf = _lv_draw_layer_buf_get(buf_pool, mask_buf_size, &mask_buf_real_size);
+    if(mask_buf == NULL) return 0;
+    lv_memzero(mask_buf, mask_buf_size);
+
+    for(i = 0; i < letter_cnt; i++) {
+        if(visible_arr[i] == false) continue;
+
+        lv_font_glyph_dsc_t * g = &g_arr[i];
+        const uint8_t * map_p = get_glyph_bitmap(g, letters[i]);
+        if(map_p == NULL) {
+            LV_LOG_WARN("character's bitmap not found");
+            continue;
+        }
+
+        letter_run_add_glyph(mask_buf, &run_area, &clipped_arr[i], &gpos_arr[i], g, map_p, dsc->opa);
+    }
+
+#if LV_USE_DRAW_MASKS
+    /*Apply masks if any*/
+    if(lv_draw_mask_is_any(&run_area)) {
+        lv_coord_t run_w = lv_area_get_width(&run_area);
+        lv_opa_t * mask_row = mask_buf;
+        lv_coord_t y;
+        for(y = run_area.y1; y <= run_area.y2; y++) {
+            lv_draw_mask_res_t res = lv_draw_mask_apply(mask_row, run_area.x1, y, run_w);
+            if(res == LV_DRAW_MASK_RES_TRANSP) lv_memzero(mask_row, run_w);
+            mask_row += run_w;
+        }
+    }
+#endif
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memzero(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.color = dsc->color;
+    blend_dsc.opa = LV_OPA_COVER;
+    blend_dsc.blend_mode = dsc->blend_mode;
+    blend_dsc.blend_area = &run_area;
+    blend_dsc.mask_area = &run_area;
+    blend_dsc.mask_buf = mask_buf;
+    blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+    lv_draw_sw_blend(draw_ctx, &blend_dsc);
+
+    _lv_draw_layer_buf_release(buf_pool, mask_buf, mask_buf_real_size);
+
+    return letter_cnt;
+}
+
+/**
+ * Write the opacity of a glyph into the mask buffer of a letter run.
+ * The glyph can't overlap the other glyphs of the run so its pixels are written directly.
+ */
+LV_ATTRIBUTE_FAST_MEM static void letter_run_add_glyph(lv_opa_t * mask_buf, const lv_area_t * run_area,
+                                                       const lv_area_t * clipped_area, const lv_point_t * gpos, const lv_font_glyph_dsc_t * g, const uint8_t * map_p,
+                                                       lv_opa_t opa)
+{
+    uint32_t bpp = g->bpp;
+    if(bpp == 3) bpp = 4;
+
+    const lv_opa_t * opa_table = get_opa_table(bpp);
+    int32_t width_bit = g->box_w * bpp; /*Letter width in bits*/
+    int32_t col_start = clipped_area->x1 - gpos->x;
+    int32_t px_cnt = lv_area_get_width(clipped_area);
+    int32_t row_start = clipped_area->y1 - gpos->y;
+    int32_t row_end = clipped_area->y2 - gpos->y + 1;
+    lv_coord_t run_w = lv_area_get_width(run_area);
+
+    lv_opa_t * mask_row = mask_buf + (clipped_area->y1 - run_area->y1) * run_w + (clipped_area->x1 - run_area->x1);
+
+    int32_t row;
+    for(row = row_start; row < row_end; row++) {
+        uint32_t bit_ofs = (row * width_bit) + (col_start * bpp);
+        glyph_row_to_opa(mask_row, map_p + (bit_ofs >> 3), bit_ofs & 0x7, px_cnt, bpp, opa, opa_table);
+        mask_row += run_w;
+    }
+}
+
+/**
+ * Convert a row of glyph pixels to opacity values.
+ * The whole bytes of the 1, 2 and 4 bpp glyphs are converted at once with lookup tables.
+ * The tables are for full opacity, `opa` is applied on the converted pixels.
+ * @param dest      store the opacity values here
+ * @param src       the byte of the first pixel in the glyph's bitmap
+ * @param col_bit   the bit index of the first pixel in `src`
+ * @param px_cnt    number of pixels to convert
+ * @param bpp       bit per pixel of the glyph (1, 2, 4 or 8)
+ * @param opa       opacity of the letter
+ * @param opa_table the result of `get_opa_table(bpp)`
+ */
+LV_ATTRIBUTE_FAST_MEM static void glyph_row_to_opa(lv_opa_t * dest, const uint8_t * src, uint32_t col_bit,
+                                                   int32_t px_cnt, uint32_t bpp, lv_opa_t opa, const lv_opa_t * opa_table)
+{
+    if(bpp == 8) {
+        lv_memcpy(dest, src, px_cnt);
+        if(opa < LV_OPA_MAX) mask_scale_opa(dest, px_cnt, opa);
+        return;
+    }
+
+    lv_opa_t * dest_start = dest;
+    int32_t px_cnt_start = px_cnt;
+
+    uint32_t px_mask = (1 << bpp) - 1;
+
+    /*The pixels of the first byte if it's not used from its first bit*/
+    while(col_bit != 0 && px_cnt > 0) {
+        *dest = opa_table[(*src >> (8 - bpp - col_bit)) & px_mask];
+        dest++;
+        px_cnt--;
+        col_bit += bpp;
+        if(col_bit == 8) {
+            col_bit = 0;
+            src++;
+        }
+    }
+
+#if LV_DRAW_SW_GLYPH_LUT
+    uint32_t px_per_byte = 8 / bpp;
+    int32_t byte_cnt = px_cnt / px_per_byte;
+
+#if LV_USE_DRAW_SW_SIMD
+    if(bpp == 4) {
+        /*Split 16 bytes to 32 pixels and scale them from 0..15 to 0..255 like `_lv_bpp4_opa_table`*/
+        for(; byte_cnt >= 16; byte_cnt -= 16) {
+            lv_simd_u8_t v;
+            __builtin_memcpy(&v, src, sizeof(v));
+            lv_simd_u8_t hi = v >> 4;
+            lv_simd_u8_t lo = v & 0x0F;
+            lv_simd_u8_t px1 = LV_SIMD_SHUFFLE(lv_simd_u8_t, hi, lo, 0, 16, 1, 17, 2, 18, 3, 19,
+                                               4, 20, 5, 21, 6, 22, 7, 23);
+            lv_simd_u8_t px2 = LV_SIMD_SHUFFLE(lv_simd_u8_t, hi, lo, 8, 24, 9, 25, 10, 26, 11, 27,
+                                               12, 28, 13, 29, 14, 30, 15, 31);
+            px1 = (px1 << 4) | px1;
+            px2 = (px2 << 4) | px2;
+            __builtin_memcpy(dest, &px1, sizeof(px1));
+            __builtin_memcpy(dest + 16, &px2, sizeof(px2));
+            src += 16;
+            dest += 32;
+            px_cnt -= 32;
+        }
+    }
+#endif
+
+    const lv_opa_t * lut = get_glyph_lut(bpp, opa_table);
+    px_cnt -= byte_cnt * px_per_byte;
+    switch(bpp) {
+        case 1:
+            for(; byte_cnt > 0; byte_cnt--) {
+                const lv_opa_t * lut_px = &lut[*src * 8];
+                dest[0] = lut_px[0];
+                dest[1] = lut_px[1];
+                dest[2] = lut_px[2];
+                dest[3] = lut_px[3];
+                dest[4] = lut_px[4];
+                dest[5] = lut_px[5];
+                dest[6] = lut_px[6];
+                dest[7] = lut_px[7];
+                dest += 8;
+                src++;
+            }
+            break;
+        case 2:
+            for(; byte_cnt > 0; byte_cnt--) {
+                const lv_opa_t * lut_px = &lut[*src * 4];
+                dest[0] = lut_px[0];
+                dest[1] = lut_px[1];
+                dest[2] = lut_px[2];
+                dest[3] = lut_px[3];
+                dest += 4;
+                src++;
+            }
+            break;
+        default:
+            for(; byte_cnt > 0; byte_cnt--) {
+                const lv_opa_t * lut_px = &lut[*src * 2];
+                dest[0] = lut_px[0];
+                dest[1] = lut_px[1];
+                dest += 2;
+                src++;
+            }
+            break;
+    }
+#endif
+
+    /*The remaining pixels one by one*/
+    while(px_cnt > 0) {
+        *dest = opa_table[(*src >> (8 - bpp - col_bit)) & px_mask];
+        dest++;
+        px_cnt--;
+        col_bit += bpp;
+        if(col_bit == 8) {
+            col_bit = 0;
+            src++;
+        }
+    }
+
+    if(opa < LV_OPA_MAX) mask_scale_opa(dest_start, px_cnt_start, opa);
+}
+
+/**
+ * Apply the opacity of a letter on its converted pixels
+ * @param mask      the opacity values of the pixels
+ * @param px_cnt    number of pixels
+ * @param opa       opacity of the letter
+ */
+LV_ATTRIBUTE_FAST_MEM static void mask_scale_opa(lv_opa_t * mask, int32_t px_cnt, lv_opa_t opa)
+{
+    int32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        mask[i] = mask[i] == LV_OPA_COVER ? opa : ((mask[i] * opa) >> 8);
+    }
+}
+
+/**
+ * Get a table to convert the pixels of a glyph to opacity
+ * @param bpp   bit per pixel of the glyph
+ * @return      table with `2^bpp` elements or NULL if the bpp is invalid
+ */
+static const lv_opa_t * get_opa_table(uint32_t bpp)
+{
+    switch(bpp) {
+        case 1:
+            return _lv_bpp1_opa_table;
+        case 2:
+            return _lv_bpp2_opa_table;
+        case 3:
+        case 4:
+            return _lv_bpp4_opa_table;
+        case 8:
+            return _lv_bpp8_opa_table;
+        default:
+            return NULL;
+    }
+}
+
+#if LV_DRAW_SW_GLYPH_LUT
+/**
+ * Get a table with the opacity of the pixels of every possible byte of a glyph.
+ * The tables are created on first use.
+ * @param bpp       bit per pixel of the glyph (1, 2 or 4)
+ * @param opa_table the result of `get_opa_table(bpp)`
+ * @return          table with `256 * 8 / bpp` elements
+ */
+static const lv_opa_t * get_glyph_lut(uint32_t bpp, const lv_opa_t * opa_table)
+{
+    lv_opa_t * lut;
+    uint32_t lut_id;
+    switch(bpp) {
+        case 1:
+            lut = glyph_lut_1bpp;
+            lut_id = 0;
+            break;
+        case 2:
+            lut = glyph_lut_2bpp;
+            lut_id = 1;
+            break;
+        default:
+            lut = glyph_lut_4bpp;
+            lut_id = 2;
+            break;
+    }
+
+    if(glyph_lut_ready[lut_id]) return lut;
+
+    uint32_t px_per_byte = 8 / bpp;
+    uint32_t px_mask = (1 << bpp) - 1;
+    uint32_t byte;
+    for(byte = 0; byte < 256; byte++) {
+        uint32_t i;
+        for(i = 0; i < px_per_byte; i++) {
+            lut[byte * px_per_byte + i] = opa_table[(byte >> (8 - bpp * (i + 1))) & px_mask];
+        }
+    }
+    glyph_lut_ready[lut_id] = true;
+
+    return lut;
+}
+#endif
+
+/**
+ * Get the bitmap of a glyph.
+ * The glyphs of the `lv_font_fmt_txt` fonts are returned from the glyph cache expanded to 8 bpp if enabled.
+ * @param g         the glyph's descriptor. `bpp` is set to 8 if a cached bitmap is returned.
+ * @param letter    the letter
+ * @return          the bitmap or NULL if not found
+ */
+static const uint8_t * get_glyph_bitmap(lv_font_glyph_dsc_t * g, uint32_t letter)
+{
+    const lv_font_t * font = g->resolved_font;
+#if LV_DRAW_SW_GLYPH_CACHE_SIZE
+    /*The glyphs of other fonts can change (e.g. when the size of a TTF font is changed)*/
+    uint32_t size = (uint32_t)g->box_w * g->box_h;
+    if(font->get_glyph_dsc != lv_font_get_glyph_dsc_fmt_txt || font->subpx || size > GLYPH_CACHE_GLYPH_MAX) {
+        return lv_font_get_glyph_bitmap(font, letter);
+    }
+
+    uint32_t hash = ((uint32_t)(lv_uintptr_t)font >> 4) ^ (letter * 2654435761U);
+    glyph_cache_slot_t * slot = &glyph_cache_slots[hash % GLYPH_CACHE_SLOT_CNT];
+
+    /*The glyphs written in the previous lap are still valid until they are overwritten*/
+    if(slot->font == font && slot->letter == letter && slot->box_w == g->box_w && slot->box_h == g->box_h &&
+       (slot->lap == glyph_cache_lap || (slot->lap + 1 == glyph_cache_lap && slot->buf_ofs >= glyph_cache_pos))) {
+        g->bpp = 8;
+        return &glyph_cache_buf[slot->buf_ofs];
+    }
+
+    const uint8_t * map_p = lv_font_get_glyph_bitmap(font, letter);
+    if(map_p == NULL) return NULL;
+
+    uint32_t bpp = g->bpp == 3 ? 4 : g->bpp;
+    const lv_opa_t * opa_table = get_opa_table(bpp);
+    if(opa_table == NULL) return map_p;
+
+    if(glyph_cache_pos + size > LV_DRAW_SW_GLYPH_CACHE_SIZE) {
+        glyph_cache_pos = 0;
+        glyph_cache_lap++;
+    }
+
+    slot->font = font;
+    slot->letter = letter;
+    slot->box_w = g->box_w;
+    slot->box_h = g->box_h;
+    slot->buf_ofs = glyph_cache_pos;
+    slot->lap = glyph_cache_lap;
+    glyph_cache_pos += size;
+
+    lv_opa_t * cached = &glyph_cache_buf[slot->buf_ofs];
+    uint32_t width_bit = g->box_w * bpp;
+    uint32_t row;
+    for(row = 0; row < g->box_h; row++) {
+        uint32_t bit_ofs = row * width_bit;
+        glyph_row_to_opa(cached + row * g->box_w, map_p + (bit_ofs >> 3), bit_ofs & 0x7, g->box_w, bpp, LV_OPA_COVER,
+                         opa_table);
+    }
+
+    g->bpp = 8;
+    return cached;
+#else
+    return lv_font_get_glyph_bitmap(font, letter);
+#endif
+}
+
+/**
+ * Tell if a placeholder should be drawn for a letter which is not in the font.
+ * No placeholder for the non printable ASCII characters (e.g. `\n`) and a few special letters.
+ */
+static bool letter_has_placeholder(uint32_t letter)
+{
+    return letter >= 0x20 &&
+           letter != 0xf8ff && /*LV_SYMBOL_DUMMY*/
+           letter != 0x200c;   /*ZERO WIDTH NON-JOINER*/
+}
+
+/**
+ * Get the offset of the glyph's top from the top of the line
+ */
+static lv_coord_t get_letter_real_h(const lv_draw_label_dsc_t * dsc, const lv_font_glyph_dsc_t * g)
+{
+#if LV_USE_IMGFONT
+    if(g->bpp == LV_IMGFONT_BPP) {
+        /*Center imgfont's drawing position*/
+        return (dsc->font->line_height - g->box_h) / 2;
+    }
+#endif
+
+    return (dsc->font->line_height - dsc->font->base_line) - g->box_h;
+}
+
 LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
                                                      const lv_point_t * pos, lv_font_glyph_dsc_t * g, const uint8_t * map_p)
 {
 
     const uint8_t * bpp_opa_table_p;
-    uint32_t bitmask_init;
-    uint32_t bitmask;
     uint32_t bpp = g->bpp;
     lv_opa_t opa = dsc->opa;
-    uint32_t shades;
     if(bpp == 3) bpp = 4;
 
 #if LV_USE_IMGFONT
@@ -206,48 +722,13 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
     }
 #endif
 
-    switch(bpp) {
-        case 1:
-            bpp_opa_table_p = _lv_bpp1_opa_table;
-            bitmask_init  = 0x80;
-            shades = 2;
-            break;
-        case 2:
-            bpp_opa_table_p = _lv_bpp2_opa_table;
-            bitmask_init  = 0xC0;
-            shades = 4;
-            break;
-        case 4:
-            bpp_opa_table_p = _lv_bpp4_opa_table;
-            bitmask_init  = 0xF0;
-            shades = 16;
-            break;
-        case 8:
-            bpp_opa_table_p = _lv_bpp8_opa_table;
-            bitmask_init  = 0xFF;
-            shades = 256;
-            break;       /*No opa table, pixel value will be used directly*/
-        default:
-            LV_LOG_WARN("invalid bpp");
-            return; /*Invalid bpp. Can't render the letter*/
+    bpp_opa_table_p = get_opa_table(bpp);
+    if(bpp_opa_table_p == NULL) {
+        LV_LOG_WARN("invalid bpp");
+        return; /*Invalid bpp. Can't render the letter*/
     }
 
-    static lv_opa_t opa_table[256];
-    static lv_opa_t prev_opa = LV_OPA_TRANSP;
-    static uint32_t prev_bpp = 0;
-    if(opa < LV_OPA_MAX) {
-        if(prev_opa != opa || prev_bpp != bpp) {
-            uint32_t i;
-            for(i = 0; i < shades; i++) {
-                opa_table[i] = bpp_opa_table_p[i] == LV_OPA_COVER ? opa : ((bpp_opa_table_p[i] * opa) >> 8);
-            }
-        }
-        bpp_opa_table_p = opa_table;
-        prev_opa = opa;
-        prev_bpp = bpp;
-    }
-
-    int32_t col, row;
+    int32_t row;
     int32_t box_w = g->box_w;
     int32_t box_h = g->box_h;
     int32_t width_bit = box_w * bpp; /*Letter width in bits*/
@@ -258,14 +739,6 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
     int32_t row_start = pos->y >= draw_ctx->clip_area->y1 ? 0 : draw_ctx->clip_area->y1 - pos->y;
     int32_t row_end   = pos->y + box_h <= draw_ctx->clip_area->y2 ? box_h : draw_ctx->clip_area->y2 - pos->y + 1;
 
-    /*Move on the map too*/
-    uint32_t bit_ofs = (row_start * width_bit) + (col_start * bpp);
-    map_p += bit_ofs >> 3;
-
-    uint8_t letter_px;
-    uint32_t col_bit;
-    col_bit = bit_ofs & 0x7; /*"& 0x7" equals to "% 8" just faster*/
-
     lv_draw_sw_blend_dsc_t blend_dsc;
     lv_memzero(&blend_dsc, sizeof(blend_dsc));
     blend_dsc.color = dsc->color;
@@ -293,38 +766,15 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
     blend_dsc.blend_area = &fill_area;
     blend_dsc.mask_area = &fill_area;
 
-    uint32_t col_bit_max = 8 - bpp;
-    uint32_t col_bit_row_ofs = (box_w + col_start - col_end) * bpp;
-
     for(row = row_start ; row < row_end; row++) {
 #if LV_USE_DRAW_MASKS
         int32_t mask_p_start = mask_p;
 #endif
-        bitmask = bitmask_init >> col_bit;
-        for(col = col_start; col < col_end; col++) {
-            /*Load the pixel's opacity into the mask*/
-            letter_px = (*map_p & bitmask) >> (col_bit_max - col_bit);
-            if(letter_px) {
-                mask_buf[mask_p] = bpp_opa_table_p[letter_px];
-            }
-            else {
-                mask_buf[mask_p] = 0;
-            }
-
-            /*Go to the next column*/
-            if(col_bit < col_bit_max) {
-                col_bit += bpp;
-                bitmask = bitmask >> bpp;
-            }
-            else {
-                col_bit = 0;
-                bitmask = bitmask_init;
-                map_p++;
-            }
-
-            /*Next mask byte*/
-            mask_p++;
-        }
+        /*Load the pixels' opacity into the mask*/
+        uint32_t bit_ofs = (row * width_bit) + (col_start * bpp);
+        glyph_row_to_opa(mask_buf + mask_p, map_p + (bit_ofs >> 3), bit_ofs & 0x7, col_end - col_start, bpp, opa,
+                         bpp_opa_table_p);
+        mask_p += col_end - col_start;
 
 #if LV_USE_DRAW_MASKS
         /*Apply masks if any*/
@@ -348,10 +798,6 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
             fill_area.y2 = fill_area.y1;
             mask_p = 0;
         }
-
-        col_bit += col_bit_row_ofs;
-        map_p += (col_bit >> 3);
-        col_bit = col_bit & 0x7;
     }
 
     /*Flush the last part*/
@@ -16,6 +16,8 @@
 /*********************
  *      DEFINES
  *********************/
+/*Use a buffer on the stack for the coverage of the rows up to this width*/
+#define SKEW_ROW_BUF_STACK_SIZE     128
 
 /**********************
  *      TYPEDEFS
@@ -71,11 +73,16 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_line(struct _lv_draw_ctx_t * draw_ctx, con
     const lv_area_t * clip_area_ori = draw_ctx->clip_area;
     draw_ctx->clip_area = &clip_line;
 
+    bool skew = false;
     if(point1->y == point2->y) draw_line_hor(draw_ctx, dsc, point1, point2);
     else if(point1->x == point2->x) draw_line_ver(draw_ctx, dsc, point1, point2);
-    else draw_line_skew(draw_ctx, dsc, point1, point2);
+    else {
+        draw_line_skew(draw_ctx, dsc, point1, point2);
+        skew = true;
+    }
 
-    if(dsc->round_end || dsc->round_start) {
+    /*The skewed lines draw the round endings too*/
+    if(!skew && (dsc->round_end || dsc->round_start)) {
         lv_draw_rect_dsc_t cir_dsc;
         lv_draw_rect_dsc_init(&cir_dsc);
         cir_dsc.bg_color = dsc->color;
@@ -277,170 +284,182 @@ LV_ATTRIBUTE_FAST_MEM static void draw_line_ver(struct _lv_draw_ctx_t * draw_ctx
 #endif /*LV_USE_DRAW_MASKS*/
 }
 
+/**
+ * Draw a skewed line by calculating the coverage of the pixels directly from their
+ * distance to the center line (across) and to the end points (along the line).
+ * Only the pixels touched by the line are processed and blended row by row.
+ * The endings, round endings and dashes are handled here too.
+ * The distances are in 1/256 pixel units.
+ */
 LV_ATTRIBUTE_FAST_MEM static void draw_line_skew(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc,
                                                  const lv_point_t * point1, const lv_point_t * point2)
 {
-#if LV_USE_DRAW_MASKS
-    /*Keep the great y in p1*/
+    /*Keep the smaller y in p1*/
     lv_point_t p1;
     lv_point_t p2;
+    bool round_start;
+    bool round_end;
     if(point1->y < point2->y) {
-        p1.y = point1->y;
-        p2.y = point2->y;
-        p1.x = point1->x;
-        p2.x = point2->x;
+        p1 = *point1;
+        p2 = *point2;
+        round_start = dsc->round_start;
+        round_end = dsc->round_end;
     }
     else {
-        p1.y = point2->y;
-        p2.y = point1->y;
-        p1.x = point2->x;
-        p2.x = point1->x;
+        p1 = *point2;
+        p2 = *point1;
+        round_start = dsc->round_end;
+        round_end = dsc->round_start;
     }
 
-    int32_t xdiff = p2.x - p1.x;
-    int32_t ydiff = p2.y - p1.y;
-    bool flat = LV_ABS(xdiff) > LV_ABS(ydiff) ? true : false;
+    int32_t dx = p2.x - p1.x;
+    int32_t dy = p2.y - p1.y;
+    int64_t len = lv_sqrt64(((uint64_t)((int64_t)dx * dx + (int64_t)dy * dy)) << 16);
+    if(len == 0) return;
 
-    static const uint8_t wcorr[] = {
-        128, 128, 128, 129, 129, 130, 130, 131,
-        132, 133, 134, 135, 137, 138, 140, 141,
-        143, 145, 147, 149, 151, 153, 155, 158,
-        160, 162, 165, 167, 170, 173, 175, 178,
-        181,
-    };
+    /*A pixel is fully covered if it's closer than `r_full - 256` to the center line and
+     *not covered at all if it's farther than `r_full`*/
+    int32_t r_full = dsc->width * 128 + 128;
 
-    int32_t w = dsc->width;
-    int32_t wcorr_i = 0;
-    if(flat) wcorr_i = (LV_ABS(ydiff) << 5) / LV_ABS(xdiff);
-    else wcorr_i = (LV_ABS(xdiff) << 5) / LV_ABS(ydiff);
-
-    w = (w * wcorr[wcorr_i] + 63) >> 7;     /*+ 63 for rounding*/
-    int32_t w_half0 = w >> 1;
-    int32_t w_half1 = w_half0 + (w & 0x1); /*Compensate rounding error*/
+    /*How far the line goes beyond the end points along the line*/
+    int32_t ext_start = round_start ? r_full : (dsc->raw_end ? dsc->width * 128 + 128 : 128);
+    int32_t ext_end = round_end ? r_full : (dsc->raw_end ? dsc->width * 128 + 128 : 128);
 
     lv_area_t blend_area;
-    blend_area.x1 = LV_MIN(p1.x, p2.x) - w;
-    blend_area.x2 = LV_MAX(p1.x, p2.x) + w;
-    blend_area.y1 = LV_MIN(p1.y, p2.y) - w;
-    blend_area.y2 = LV_MAX(p1.y, p2.y) + w;
-
-    /*Get the union of `coords` and `clip`*/
-    /*`clip` is already truncated to the `draw_buf` size
-     *in 'lv_refr_area' function*/
+    blend_area.x1 = LV_MIN(p1.x, p2.x) - dsc->width;
+    blend_area.x2 = LV_MAX(p1.x, p2.x) + dsc->width;
+    blend_area.y1 = p1.y - dsc->width;
+    blend_area.y2 = p2.y + dsc->width;
+
+    /*`clip` is already truncated to the `draw_buf` size in 'lv_refr_area' function*/
     bool is_common = _lv_area_intersect(&blend_area, &blend_area, draw_ctx->clip_area);
     if(is_common == false) return;
 
-    lv_draw_mask_line_param_t mask_left_param;
-    lv_draw_mask_line_param_t mask_right_param;
-    lv_draw_mask_line_param_t mask_top_param;
-    lv_draw_mask_line_param_t mask_bottom_param;
-
-    if(flat) {
-        if(xdiff > 0) {
-            lv_draw_mask_line_points_init(&mask_left_param, p1.x, p1.y - w_half0, p2.x, p2.y - w_half0,
-                                          LV_DRAW_MASK_LINE_SIDE_LEFT);
-            lv_draw_mask_line_points_init(&mask_right_param, p1.x, p1.y + w_half1, p2.x, p2.y + w_half1,
-                                          LV_DRAW_MASK_LINE_SIDE_RIGHT);
-        }
-        else {
-            lv_draw_mask_line_points_init(&mask_left_param, p1.x, p1.y + w_half1, p2.x, p2.y + w_half1,
-                                          LV_DRAW_MASK_LINE_SIDE_LEFT);
-            lv_draw_mask_line_points_init(&mask_right_param, p1.x, p1.y - w_half0, p2.x, p2.y - w_half0,
-                                          LV_DRAW_MASK_LINE_SIDE_RIGHT);
-        }
-    }
-    else {
-        lv_draw_mask_line_points_init(&mask_left_param, p1.x + w_half1, p1.y, p2.x + w_half1, p2.y,
-                                      LV_DRAW_MASK_LINE_SIDE_LEFT);
-        lv_draw_mask_line_points_init(&mask_right_param, p1.x - w_half0, p1.y, p2.x - w_half0, p2.y,
-                                      LV_DRAW_MASK_LINE_SIDE_RIGHT);
-    }
-
-    /*Use the normal vector for the endings*/
-
-    int16_t mask_left_id = lv_draw_mask_add(&mask_left_param, NULL);
-    int16_t mask_right_id = lv_draw_mask_add(&mask_right_param, NULL);
-    int16_t mask_top_id = LV_MASK_ID_INV;
-    int16_t mask_bottom_id = LV_MASK_ID_INV;
-
-    if(!dsc->raw_end) {
-        lv_draw_mask_line_points_init(&mask_top_param, p1.x, p1.y, p1.x - ydiff, p1.y + xdiff, LV_DRAW_MASK_LINE_SIDE_BOTTOM);
-        lv_draw_mask_line_points_init(&mask_bottom_param, p2.x, p2.y, p2.x - ydiff, p2.y + xdiff,  LV_DRAW_MASK_LINE_SIDE_TOP);
-        mask_top_id = lv_draw_mask_add(&mask_top_param, NULL);
-        mask_bottom_id = lv_draw_mask_add(&mask_bottom_param, NULL);
-    }
-
-    /*The real draw area is around the line.
-     *It's easy to calculate with steep lines, but the area can be very wide with very flat lines.
-     *So deal with it only with steep lines.*/
-    int32_t draw_area_w = lv_area_get_width(&blend_area);
+    bool dashed = dsc->dash_gap && dsc->dash_width ? true : false;
+    int32_t dash_period = (dsc->dash_width + dsc->dash_gap) * 256;
+    int32_t dash_width = dsc->dash_width * 256;
 
-    /*Draw the background line by line*/
-    int32_t h;
-    uint32_t hor_res = (uint32_t)lv_disp_get_hor_res(_lv_refr_get_disp_refreshing());
-    size_t mask_buf_size = LV_MIN(lv_area_get_size(&blend_area), hor_res);
-    lv_opa_t * mask_buf = lv_malloc(mask_buf_size);
+#if LV_USE_DRAW_MASKS
+    bool masked = lv_draw_mask_is_any(&blend_area);
+#endif
 
-    lv_coord_t y2 = blend_area.y2;
-    blend_area.y2 = blend_area.y1;
+    /*Change of the distances when stepping to the next pixel on the right.
+     *Use 1/65536 pixel units to keep the error small on long rows.*/
+    int64_t d_step = -(int64_t)dy * 16777216 / len;
+    int64_t t_step = (int64_t)dx * 16777216 / len;
 
-    uint32_t mask_p = 0;
-    lv_memset(mask_buf, 0xff, mask_buf_size);
+    lv_opa_t row_buf_stack[SKEW_ROW_BUF_STACK_SIZE];
+    int32_t row_buf_size = lv_area_get_width(&blend_area);
+    lv_opa_t * row_buf = row_buf_size <= SKEW_ROW_BUF_STACK_SIZE ? row_buf_stack : lv_malloc(row_buf_size);
+    LV_ASSERT_MALLOC(row_buf);
+    if(row_buf == NULL) return;
 
+    lv_area_t row_area;
     lv_draw_sw_blend_dsc_t blend_dsc;
     lv_memzero(&blend_dsc, sizeof(blend_dsc));
-    blend_dsc.blend_area = &blend_area;
+    blend_dsc.blend_area = &row_area;
     blend_dsc.color = dsc->color;
     blend_dsc.opa = dsc->opa;
-    blend_dsc.mask_buf = mask_buf;
-    blend_dsc.mask_area = &blend_area;
-
-    /*Fill the first row with 'color'*/
-    for(h = blend_area.y1; h <= y2; h++) {
-        blend_dsc.mask_res = lv_draw_mask_apply(&mask_buf[mask_p], blend_area.x1, h, draw_area_w);
-        if(blend_dsc.mask_res == LV_DRAW_MASK_RES_TRANSP) {
-            lv_memzero(&mask_buf[mask_p], draw_area_w);
+    blend_dsc.mask_buf = row_buf;
+    blend_dsc.mask_area = &row_area;
+
+    int32_t y;
+    for(y = blend_area.y1; y <= blend_area.y2; y++) {
+        /*Find the X range where the pixels are close enough to the center line.
+         *`x - p1.x = (dx * (y - p1.y) -/+ r * len) / dy` in 1/256 pixel units*/
+        int64_t row_dx = (int64_t)dx * (y - p1.y) * 256;
+        int64_t r_len = ((int64_t)r_full * len) >> 8;
+        int64_t x_min = (row_dx - r_len) / dy;
+        int64_t x_max = (row_dx + r_len) / dy;
+
+        /*Limit it to the range between the (extended) end points too.
+         *`x - p1.x = (t * len - dy * (y - p1.y)) / dx` in 1/256 pixel units*/
+        int64_t row_dy = (int64_t)dy * (y - p1.y) * 256;
+        int64_t x_t_start = (-(int64_t)ext_start * len / 256 - row_dy) / dx;
+        int64_t x_t_end = ((len + ext_end) * len / 256 - row_dy) / dx;
+        if(dx > 0) {
+            x_min = LV_MAX(x_min, x_t_start);
+            x_max = LV_MIN(x_max, x_t_end);
+        }
+        else {
+            x_min = LV_MAX(x_min, x_t_end);
+            x_max = LV_MIN(x_max, x_t_start);
         }
 
-        mask_p += draw_area_w;
-        if((uint32_t) mask_p + draw_area_w < mask_buf_size) {
-            blend_area.y2 ++;
+        /*Add 1 pixel to the sides to surely include the pixels on the edges too*/
+        int32_t x_start = LV_MAX(p1.x + (int32_t)(x_min >> 8) - 1, blend_area.x1);
+        int32_t x_end = LV_MIN(p1.x + (int32_t)(x_max >> 8) + 1, blend_area.x2);
+        if(x_start > x_end) continue;
+
+        /*The distance from the center line and along the line from p1 at the first pixel*/
+        int32_t rel_x = x_start - p1.x;
+        int32_t rel_y = y - p1.y;
+        int64_t d_fine = ((int64_t)dx * rel_y - (int64_t)dy * rel_x) * 16777216 / len;
+        int64_t t_fine = ((int64_t)dx * rel_x + (int64_t)dy * rel_y) * 16777216 / len;
+
+        int32_t x;
+        int32_t i = 0;
+        for(x = x_start; x <= x_end; x++, i++, d_fine += d_step, t_fine += t_step) {
+            int32_t d = (int32_t)(d_fine >> 8);
+            int32_t t = (int32_t)(t_fine >> 8);
+            int32_t cov;
+            if(t < 0 && round_start) {
+                uint64_t dist_sqr = (int64_t)t * t + (int64_t)d * d;
+                cov = r_full - (int32_t)lv_sqrt64(dist_sqr);
+            }
+            else if(t > len && round_end) {
+                int32_t t_end = t - (int32_t)len;
+                uint64_t dist_sqr = (int64_t)t_end * t_end + (int64_t)d * d;
+                cov = r_full - (int32_t)lv_sqrt64(dist_sqr);
+            }
+            else {
+                /*Multiply the coverage across, along and by the dashes*/
+                cov = LV_CLAMP(0, r_full - LV_ABS(d), 256);
+                int32_t cov_along = LV_MIN(t + ext_start, (int32_t)len - t + ext_end);
+                cov = (cov * LV_CLAMP(0, cov_along, 256)) >> 8;
+
+                if(dashed && t >= 0 && t <= len) {
+                    int32_t t_dash = t % dash_period;
+                    int32_t cov_dash;
+                    if(t_dash <= dash_width) cov_dash = LV_MIN(t_dash, dash_width - t_dash) + 128;
+                    else cov_dash = 128 - LV_MIN(t_dash - dash_width, dash_period - t_dash);
+                    cov = (cov * LV_CLAMP(0, cov_dash, 256)) >> 8;
+                }
+            }
+
+            if(cov <= 0) row_buf[i] = LV_OPA_TRANSP;
+            else if(cov >= 255) row_buf[i] = LV_OPA_COVER;
+            else row_buf[i] = cov;
         }
-        else {
-            blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
 
-            blend_area.y1 = blend_area.y2 + 1;
-            blend_area.y2 = blend_area.y1;
-            mask_p = 0;
-            lv_memset(mask_buf, 0xff, mask_buf_size);
+        /*Skip the not covered pixels on the sides*/
+        lv_opa_t * row_p = row_buf;
+        while(x_start <= x_end && row_p[0] == LV_OPA_TRANSP) {
+            row_p++;
+            x_start++;
         }
-    }
+        while(x_end >= x_start && row_p[x_end - x_start] == LV_OPA_TRANSP) {
+            x_end--;
+        }
+        if(x_start > x_end) continue;
 
-    /*Flush the last part*/
-    if(blend_area.y1 != blend_area.y2) {
-        blend_area.y2--;
+        row_area.x1 = x_start;
+        row_area.x2 = x_end;
+        row_area.y1 = y;
+        row_area.y2 = y;
+        blend_dsc.mask_buf = row_p;
         blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+#if LV_USE_DRAW_MASKS
+        if(masked) {
+            blend_dsc.mask_res = lv_draw_mask_apply(row_p, x_start, y, x_end - x_start + 1);
+            if(blend_dsc.mask_res == LV_DRAW_MASK_RES_TRANSP) continue;
+            blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+        }
+#endif
         lv_draw_sw_blend(draw_ctx, &blend_dsc);
     }
 
-    lv_free(mask_buf);
-
-    lv_draw_mask_free_param(&mask_left_param);
-    lv_draw_mask_free_param(&mask_right_param);
-    if(mask_top_id != LV_MASK_ID_INV) lv_draw_mask_free_param(&mask_top_param);
-    if(mask_bottom_id != LV_MASK_ID_INV) lv_draw_mask_free_param(&mask_bottom_param);
-    lv_draw_mask_remove_id(mask_left_id);
-    lv_draw_mask_remove_id(mask_right_id);
-    lv_draw_mask_remove_id(mask_top_id);
-    lv_draw_mask_remove_id(mask_bottom_id);
-#else
-    LV_UNUSED(point1);
-    LV_UNUSED(point2);
-    LV_UNUSED(draw_ctx);
-    LV_UNUSED(dsc);
-    LV_LOG_WARN("Can't draw skewed line with LV_USE_DRAW_MASKS == 0");
-#endif /*LV_USE_DRAW_MASKS*/
+    if(row_buf != row_buf_stack) lv_free(row_buf);
 }
 
 #endif /*LV_USE_DRAW_SW*/
@@ -0,0 +1,128 @@
+/**
+ * @file lv_draw_sw_simd.h
+ *
+ * Thin wrappers around the vector extensions of GCC and Clang.
+ * Only the lane types and a few helpers are defined here, the actual kernels
+ * are next to their scalar counterparts.
+ */
+
+#ifndef LV_DRAW_SW_SIMD_H
+#define LV_DRAW_SW_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_SIMD
+
+#if !defined(__GNUC__) && !defined(__clang__)
+#error "LV_USE_DRAW_SW_SIMD requires the vector extensions of GCC or Clang"
+#endif
+
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**Number of 32 bit lanes in a vector*/
+#define LV_SIMD_LANES   4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef uint32_t lv_simd_u32_t __attribute__((vector_size(16)));
+typedef int32_t lv_simd_i32_t __attribute__((vector_size(16)));
+typedef uint16_t lv_simd_u16_t __attribute__((vector_size(16)));
+typedef uint8_t lv_simd_u8_t __attribute__((vector_size(16)));
+typedef uint64_t lv_simd_u64_t __attribute__((vector_size(16)));
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**Create a vector with all the lanes set to `v`*/
+#define LV_SIMD_U32(v) ((lv_simd_u32_t){(v), (v), (v), (v)})
+
+/**
+ * Pick lanes from the concatenation of `a` and `b` by constant indices.
+ * `mask_t` is the unsigned vector type of `a` and `b` (only older GCCs need it).
+ */
+#if defined(__clang__) || __GNUC__ >= 12
+    #define LV_SIMD_SHUFFLE(mask_t, a, b, ...) __builtin_shufflevector(a, b, __VA_ARGS__)
+#else
+    #define LV_SIMD_SHUFFLE(mask_t, a, b, ...) __builtin_shuffle(a, b, (mask_t){__VA_ARGS__})
+#endif
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Load 4 lanes from a possibly unaligned address
+ * @param p     pointer to 16 bytes
+ * @return      the loaded vector
+ */
+static inline lv_simd_u32_t lv_simd_load_u32(const void * p)
+{
+    lv_simd_u32_t v;
+    __builtin_memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * Store 4 lanes to a possibly unaligned address
+ * @param p     pointer to 16 bytes
+ * @param v     the vector to store
+ */
+static inline void lv_simd_store_u32(void * p, lv_simd_u32_t v)
+{
+    __builtin_memcpy(p, &v, sizeof(v));
+}
+
+/**
+ * Divide every lane by 255 exactly like `LV_UDIV255`
+ * @param v     values in 0..0xFFFF range
+ * @return      `v / 255` per lane
+ */
+static inline lv_simd_u32_t lv_simd_udiv255(lv_simd_u32_t v)
+{
+    return (v * 0x8081U) >> 23;
+}
+
+/**
+ * Divide every 16 bit lane by 255 exactly like `LV_UDIV255`
+ * @param v     values in 0..0xFE01 range (e.g. the product of two `lv_opa_t`)
+ * @return      `v / 255` per lane
+ */
+static inline lv_simd_u16_t lv_simd_udiv255_u16(lv_simd_u16_t v)
+{
+    return (v + 1 + (v >> 8)) >> 8;
+}
+
+/**
+ * Select lanes from `a` where `mask` is all 1 and from `b` where it's 0
+ * @param mask  result of a vector comparison
+ * @param a     lanes to use where mask is set
+ * @param b     lanes to use where mask is cleared
+ * @return      the blended vector
+ */
+static inline lv_simd_u32_t lv_simd_select(lv_simd_i32_t mask, lv_simd_u32_t a, lv_simd_u32_t b)
+{
+    lv_simd_u32_t m = (lv_simd_u32_t)mask;
+    return (a & m) | (b & ~m);
+}
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_SIMD*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_SIMD_H*/
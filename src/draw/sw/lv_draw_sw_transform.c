@@ -9,6 +9,7 @@
 #include "lv_draw_sw.h"
 #if LV_USE_DRAW_SW
 
+#include "lv_draw_sw_simd.h"
 #include "../../misc/lv_assert.h"
 #include "../../misc/lv_area.h"
 #include "../../core/lv_refr.h"
@@ -18,6 +19,15 @@
  *      DEFINES
  *********************/
 
+/*The vectorized bilinear sampling reproduces the built-in `lv_color_mix` bit-by-bit.
+ *With RGB565 only the fast, non-rounding variant of it is vectorized.*/
+#if LV_USE_DRAW_SW_SIMD && LV_BIG_ENDIAN_SYSTEM == 0 && \
+    (LV_COLOR_DEPTH == 32 || (LV_COLOR_DEPTH == 16 && LV_COLOR_MIX_ROUND_OFS == 0))
+    #define TRANSFORM_AA_SIMD   1
+#else
+    #define TRANSFORM_AA_SIMD   0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,6 +45,20 @@ typedef struct {
     lv_point_t pivot;
 } point_transform_dsc_t;
 
+/**
+ * The source image as seen by the anti-aliased sampler
+ */
+typedef struct {
+    const uint8_t * src;
+    lv_coord_t src_w;
+    lv_coord_t src_h;
+    lv_coord_t src_stride;
+    lv_color_format_t cf;
+    int32_t px_size;
+    bool has_alpha;
+    bool premult;
+} aa_src_dsc_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -49,31 +73,51 @@ typedef struct {
 static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
                                      int32_t * yout);
 
-static void argb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+/**
+ * Limit `[*x_start; *x_end)` to the destination pixels whose sampled source coordinate
+ * (`(ups + ((step * x) >> 8)) >> 8`) is in `[0; size)`
+ * @param ups       upscaled source coordinate of the first pixel of the row
+ * @param step      upscaled (by 256) step of the source coordinate per destination pixel
+ * @param size      width or height of the source image
+ * @param x_start   first pixel of the span, will be increased if required
+ * @param x_end     first pixel after the span, will be decreased if required
+ */
+static void clip_span(int32_t ups, int32_t step, lv_coord_t size, int32_t * x_start, int32_t * x_end);
+
+static void argb_no_aa(const uint8_t * src, lv_coord_t src_stride,
                        int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                       int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
+                       int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
 
-static void rgb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+static void rgb_no_aa(const uint8_t * src, lv_coord_t src_stride,
                       int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                      int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
+                      int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
 
-static void rgb_no_aa_chroma_key(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+static void rgb_no_aa_chroma_key(const uint8_t * src, lv_coord_t src_stride,
                                  int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                                 int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_color_t chroma_key_color);
+                                 int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_color_t chroma_key_color);
 
 #if LV_COLOR_DEPTH == 16
-static void rgb565a8_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+static void rgb565a8_no_aa(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride,
                            int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                           int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
+                           int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
 #endif
 
 static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
                             int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                            int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_color_format_t cf);
+                            int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_color_format_t cf, bool premult);
+
+static void argb_and_rgb_aa_px(const aa_src_dsc_t * s, int32_t xs_ups, int32_t ys_ups, lv_color_t * c_out,
+                               lv_opa_t * a_out);
+
+#if TRANSFORM_AA_SIMD
+static int32_t argb_and_rgb_aa_simd(const aa_src_dsc_t * s, int32_t xs_ups, int32_t ys_ups,
+                                    int32_t xs_step, int32_t ys_step,
+                                    int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf);
+#endif
 
 static void a8_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
                   int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                  int32_t x_end, uint8_t * abuf);
+                  int32_t x_start, int32_t x_end, uint8_t * abuf);
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -93,6 +137,11 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
 {
     LV_UNUSED(draw_ctx);
 
+    /*Premultiplied images are sampled as NATIVE_ALPHA and converted to straight alpha line-by-line.
+     *Interpolating the premultiplied colors doesn't darken the edges of the transparent areas.*/
+    bool premult = cf == LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED;
+    if(premult) cf = LV_COLOR_FORMAT_NATIVE_ALPHA;
+
     point_transform_dsc_t tr_dsc;
     tr_dsc.angle = -draw_dsc->angle;
     tr_dsc.zoom = (256 * 256) / draw_dsc->zoom;
@@ -136,41 +185,53 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
         int32_t xs_ups = xs1_ups + 0x80;
         int32_t ys_ups = ys1_ups + 0x80;
 
-        if(draw_dsc->antialias == 0) {
+        /*Only the pixels in [x_start; x_end) sample the image, the others are fully transparent*/
+        int32_t x_start = 0;
+        int32_t x_end = dest_w;
+        clip_span(xs_ups, xs_step_256, src_w, &x_start, &x_end);
+        clip_span(ys_ups, ys_step_256, src_h, &x_start, &x_end);
+
+        lv_memzero(abuf, x_start);
+        lv_memzero(abuf + x_end, dest_w - x_end);
+
+        if(x_start < x_end && draw_dsc->antialias == 0) {
             switch(cf) {
                 case LV_COLOR_FORMAT_NATIVE_ALPHA:
-                    argb_no_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf);
+                    argb_no_aa(src_buf, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end, cbuf, abuf);
                     break;
                 case LV_COLOR_FORMAT_NATIVE:
                     if(sup->chroma_keyed) {
-                        rgb_no_aa_chroma_key(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf,
+                        rgb_no_aa_chroma_key(src_buf, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end, cbuf, abuf,
                                              sup->chroma_key_color);
                     }
                     else {
-                        rgb_no_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf);
+                        rgb_no_aa(src_buf, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end, cbuf, abuf);
                     }
                     break;
 
 #if LV_COLOR_DEPTH == 16
                 case LV_COLOR_FORMAT_RGB565A8:
-                    rgb565a8_no_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf);
+                    rgb565a8_no_aa(src_buf, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end, cbuf, abuf);
                     break;
 #endif
                 default:
                     break;
             }
         }
-        else {
+        else if(x_start < x_end) {
             switch(cf) {
                 case LV_COLOR_FORMAT_A8:
-                    a8_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, abuf);
+                    a8_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end, abuf);
                     break;
                 default:
-                    argb_and_rgb_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, cbuf, abuf, cf);
+                    argb_and_rgb_aa(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end,
+                                    cbuf, abuf, cf, premult);
                     break;
             }
         }
 
+        if(premult) lv_color_unpremultiply_split(cbuf, abuf, dest_w);
+
         cbuf += dest_w;
         abuf += dest_w;
     }
@@ -180,159 +241,132 @@ void lv_draw_sw_transform(lv_draw_ctx_t * draw_ctx, const lv_area_t * dest_area,
  *   STATIC FUNCTIONS
  **********************/
 
-static void rgb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+static inline int64_t div_floor(int64_t a, int64_t b)
+{
+    int64_t q = a / b;
+    if(a % b != 0 && a < 0) q--;
+    return q;
+}
+
+static void clip_span(int32_t ups, int32_t step, lv_coord_t size, int32_t * x_start, int32_t * x_end)
+{
+    /*The sampled coordinate is floor((ups * 256 + step * x) / 65536),
+     *so `0 <= ofs + step * x < max` has to be true for the pixels to keep*/
+    int64_t ofs = (int64_t)ups * 256;
+    int64_t max = (int64_t)size * 65536;
+    int64_t first;
+    int64_t last;
+
+    if(step == 0) {
+        if(ofs < 0 || ofs >= max) *x_end = *x_start;
+        return;
+    }
+    else if(step > 0) {
+        first = -div_floor(ofs, step);
+        last = div_floor(max - 1 - ofs, step);
+    }
+    else {
+        first = div_floor(ofs - max, -step) + 1;
+        last = div_floor(ofs, -step);
+    }
+
+    if(first > *x_start) *x_start = (int32_t)LV_MIN(first, (int64_t) * x_end);
+    if(last + 1 < *x_end) *x_end = (int32_t)LV_MAX(last + 1, (int64_t) * x_start);
+}
+
+static void rgb_no_aa(const uint8_t * src, lv_coord_t src_stride,
                       int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                      int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
+                      int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
+    const lv_color_t * src_c = (const lv_color_t *)src;
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
 
-    lv_memset(abuf, 0xff, x_end);
+    lv_memset(abuf + x_start, 0xff, x_end - x_start);
 
-    lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs_int = (xs_ups + (xs_acc >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + (ys_acc >> 8)) >> 8;
+        xs_acc += xs_step;
+        ys_acc += ys_step;
 
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0x00;
-        }
-        else {
-#if LV_COLOR_DEPTH == 8
-            const uint8_t * src_tmp = src;
-            src_tmp += ys_int * src_stride + xs_int;
-            lv_color_set_int(&cbuf[x], src_tmp[0]);
-#elif LV_COLOR_DEPTH == 16
-            const lv_color_t * src_tmp = (const lv_color_t *)src;
-            src_tmp += ys_int * src_stride + xs_int;
-            cbuf[x] = *src_tmp;
-#elif LV_COLOR_DEPTH == 24
-            const lv_color_t * src_tmp = (const lv_color_t *)src;
-            src_tmp += ys_int * src_stride + xs_int;
-            cbuf[x].blue = src_tmp->blue ;
-            cbuf[x].green = src_tmp->green;
-            cbuf[x].red = src_tmp->red;
-#elif LV_COLOR_DEPTH == 32
-            const uint8_t * src_tmp = src;
-            src_tmp += (ys_int * src_stride * sizeof(lv_color_t)) + xs_int * sizeof(lv_color_t);
-            cbuf[x] = *((lv_color_t *)src_tmp);
-#endif
-        }
+        cbuf[x] = src_c[ys_int * src_stride + xs_int];
     }
 }
 
-static void rgb_no_aa_chroma_key(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+static void rgb_no_aa_chroma_key(const uint8_t * src, lv_coord_t src_stride,
                                  int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                                 int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_color_t chroma_key_color)
+                                 int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_color_t chroma_key_color)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
-
-    lv_memset(abuf, 0xff, x_end);
-
-    lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
-
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0x00;
-        }
-        else if(lv_color_eq(cbuf[x], chroma_key_color)) {
-            abuf[x] = 0x00;
-        }
-        else {
-#if LV_COLOR_DEPTH == 8
-            const uint8_t * src_tmp = src;
-            src_tmp += ys_int * src_stride + xs_int;
-            lv_color_set_int(&cbuf[x], src_tmp[0]);
-#elif LV_COLOR_DEPTH == 16
-            const lv_color_t * src_tmp = (const lv_color_t *)src;
-            src_tmp += ys_int * src_stride + xs_int;
-            cbuf[x] = *src_tmp;
-#elif LV_COLOR_DEPTH == 24
-            const lv_color_t * src_tmp = (const lv_color_t *)src;
-            src_tmp += ys_int * src_stride + xs_int;
-            cbuf[x].blue = src_tmp->blue ;
-            cbuf[x].green = src_tmp->green;
-            cbuf[x].red = src_tmp->red;
-#elif LV_COLOR_DEPTH == 32
-            const uint8_t * src_tmp = src;
-            src_tmp += (ys_int * src_stride * sizeof(lv_color_t)) + xs_int * sizeof(lv_color_t);
-            cbuf[x] = *((lv_color_t *)src_tmp);
-#endif
-        }
+    const lv_color_t * src_c = (const lv_color_t *)src;
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs_int = (xs_ups + (xs_acc >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + (ys_acc >> 8)) >> 8;
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        cbuf[x] = src_c[ys_int * src_stride + xs_int];
+        abuf[x] = lv_color_eq(cbuf[x], chroma_key_color) ? 0x00 : 0xff;
     }
 }
 
-static void argb_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+static void argb_no_aa(const uint8_t * src, lv_coord_t src_stride,
                        int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                       int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
+                       int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
-
-    lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
-
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0;
-        }
-        else {
-            const uint8_t * src_tmp = src;
-            src_tmp += (ys_int * src_stride * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE) + xs_int * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs_int = (xs_ups + (xs_acc >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + (ys_acc >> 8)) >> 8;
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        const uint8_t * src_tmp = src;
+        src_tmp += (ys_int * src_stride * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE) + xs_int * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
 
 #if LV_COLOR_DEPTH == 8
-            lv_color_set_int(&cbuf[x], src_tmp[0]);
+        lv_color_set_int(&cbuf[x], src_tmp[0]);
 #elif LV_COLOR_DEPTH == 16
-            lv_color_set_int(&cbuf[x], src_tmp[0] + (src_tmp[1] << 8));
+        lv_color_set_int(&cbuf[x], src_tmp[0] + (src_tmp[1] << 8));
 #elif LV_COLOR_DEPTH == 24
-            cbuf[x].blue = *(src_tmp + 0);
-            cbuf[x].green = *(src_tmp + 1);
-            cbuf[x].red = *(src_tmp + 2);
+        cbuf[x].blue = *(src_tmp + 0);
+        cbuf[x].green = *(src_tmp + 1);
+        cbuf[x].red = *(src_tmp + 2);
 #elif LV_COLOR_DEPTH == 32
-            cbuf[x] = *((lv_color_t *)src_tmp);
+        cbuf[x] = *((lv_color_t *)src_tmp);
 #endif
-            abuf[x] = src_tmp[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1];
-        }
+        abuf[x] = src_tmp[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1];
     }
 }
 
 #if LV_COLOR_DEPTH == 16
-static void rgb565a8_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
+static void rgb565a8_no_aa(const uint8_t * src, lv_coord_t src_h, lv_coord_t src_stride,
                            int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                           int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
+                           int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
-
-    lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
-
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0;
-        }
-        else {
-            const lv_color_t * src_tmp = (const lv_color_t *)src;
-            src_tmp += ys_int * src_stride + xs_int;
-            cbuf[x] = *src_tmp;
-
-            const lv_opa_t * a_tmp = src + src_stride * src_h * sizeof(lv_color_t);
-            a_tmp += ys_int * src_stride + xs_int;
-            abuf[x] = *a_tmp;
-        }
+    const lv_color_t * src_c = (const lv_color_t *)src;
+    const lv_opa_t * src_a = src + src_stride * src_h * sizeof(lv_color_t);
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs_int = (xs_ups + (xs_acc >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + (ys_acc >> 8)) >> 8;
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+
+        int32_t ofs = ys_int * src_stride + xs_int;
+        cbuf[x] = src_c[ofs];
+        abuf[x] = src_a[ofs];
     }
 }
 #endif
@@ -340,212 +374,360 @@ static void rgb565a8_no_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src
 
 static void argb_and_rgb_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
                             int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                            int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_color_format_t cf)
+                            int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf, lv_color_format_t cf, bool premult)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
-    bool has_alpha;
-    int32_t px_size;
+    aa_src_dsc_t s;
+    s.src = src;
+    s.src_w = src_w;
+    s.src_h = src_h;
+    s.src_stride = src_stride;
+    s.cf = cf;
+    s.premult = premult;
     switch(cf) {
         case LV_COLOR_FORMAT_NATIVE:
-            has_alpha = false;
-            px_size = sizeof(lv_color_t);
+            s.has_alpha = false;
+            s.px_size = sizeof(lv_color_t);
             break;
         case LV_COLOR_FORMAT_NATIVE_ALPHA:
-            has_alpha = true;
-            px_size = LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+            s.has_alpha = true;
+            s.px_size = LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
             break;
 #if LV_COLOR_DEPTH == 16
         case LV_COLOR_FORMAT_RGB565A8:
-            has_alpha = true;
-            px_size = sizeof(lv_color_t);
+            s.has_alpha = true;
+            s.px_size = sizeof(lv_color_t);
             break;
 #endif
         default:
             return;
     }
 
-    lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
-
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-
-        /*Fully out of the image*/
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0x00;
-            continue;
-        }
-
-        /*Get the direction the hor and ver neighbor
-         *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
-        int32_t xs_fract = xs_ups & 0xFF;
-        int32_t ys_fract = ys_ups & 0xFF;
-
-        int32_t x_next;
-        int32_t y_next;
-        if(xs_fract < 0x80) {
-            x_next = -1;
-            xs_fract = (0x7F - xs_fract) * 2;
-        }
-        else {
-            x_next = 1;
-            xs_fract = (xs_fract - 0x80) * 2;
-        }
-        if(ys_fract < 0x80) {
-            y_next = -1;
-            ys_fract = (0x7F - ys_fract) * 2;
-        }
-        else {
-            y_next = 1;
-            ys_fract = (ys_fract - 0x80) * 2;
-        }
-
-        const uint8_t * src_tmp = src;
-        src_tmp += (ys_int * src_stride * px_size) + xs_int * px_size;
+    int32_t x = x_start;
+#if TRANSFORM_AA_SIMD
+    x = argb_and_rgb_aa_simd(&s, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, cbuf, abuf);
+#endif
 
+    int32_t xs_acc = xs_step * x;
+    int32_t ys_acc = ys_step * x;
+    for(; x < x_end; x++) {
+        argb_and_rgb_aa_px(&s, xs_ups + (xs_acc >> 8), ys_ups + (ys_acc >> 8), &cbuf[x], &abuf[x]);
+        xs_acc += xs_step;
+        ys_acc += ys_step;
+    }
+}
 
-        if(xs_int + x_next >= 0 &&
-           xs_int + x_next <= src_w - 1 &&
-           ys_int + y_next >= 0 &&
-           ys_int + y_next <= src_h - 1) {
+/**
+ * Sample one pixel with anti-aliasing.
+ * The caller has to be sure that `xs_ups` and `ys_ups` are on the image.
+ */
+static void argb_and_rgb_aa_px(const aa_src_dsc_t * s, int32_t xs_ups, int32_t ys_ups, lv_color_t * c_out,
+                               lv_opa_t * a_out)
+{
+    const uint8_t * src = s->src;
+    lv_coord_t src_w = s->src_w;
+    lv_coord_t src_h = s->src_h;
+    lv_coord_t src_stride = s->src_stride;
+    lv_color_format_t cf = s->cf;
+    int32_t px_size = s->px_size;
+
+    int32_t xs_int = xs_ups >> 8;
+    int32_t ys_int = ys_ups >> 8;
+
+    /*Get the direction the hor and ver neighbor
+     *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
+    int32_t xs_fract = xs_ups & 0xFF;
+    int32_t ys_fract = ys_ups & 0xFF;
+
+    int32_t x_next;
+    int32_t y_next;
+    if(xs_fract < 0x80) {
+        x_next = -1;
+        xs_fract = (0x7F - xs_fract) * 2;
+    }
+    else {
+        x_next = 1;
+        xs_fract = (xs_fract - 0x80) * 2;
+    }
+    if(ys_fract < 0x80) {
+        y_next = -1;
+        ys_fract = (0x7F - ys_fract) * 2;
+    }
+    else {
+        y_next = 1;
+        ys_fract = (ys_fract - 0x80) * 2;
+    }
 
-            const uint8_t * px_base = src_tmp;
-            const uint8_t * px_hor = src_tmp + x_next * px_size;
-            const uint8_t * px_ver = src_tmp + y_next * src_stride * px_size;
-            lv_color_t c_base;
-            lv_color_t c_ver;
-            lv_color_t c_hor;
-
-            if(has_alpha) {
-                lv_opa_t a_base;
-                lv_opa_t a_ver;
-                lv_opa_t a_hor;
-                if(cf == LV_COLOR_FORMAT_NATIVE_ALPHA) {
-                    a_base = px_base[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1];
-                    a_ver = px_ver[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1];
-                    a_hor = px_hor[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1];
-                }
+    const uint8_t * src_tmp = src;
+    src_tmp += (ys_int * src_stride * px_size) + xs_int * px_size;
+
+    if(xs_int + x_next >= 0 &&
+       xs_int + x_next <= src_w - 1 &&
+       ys_int + y_next >= 0 &&
+       ys_int + y_next <= src_h - 1) {
+
+        const uint8_t * px_base = src_tmp;
+        const uint8_t * px_hor = src_tmp + x_next * px_size;
+        const uint8_t * px_ver = src_tmp + y_next * src_stride * px_size;
+        lv_color_t c_base;
+        lv_color_t c_ver;
+        lv_color_t c_hor;
+
+        if(s->has_alpha) {
+            lv_opa_t a_base;
+            lv_opa_t a_ver;
+            lv_opa_t a_hor;
+            if(cf == LV_COLOR_FORMAT_NATIVE_ALPHA) {
+                a_base = px_base[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1];
+                a_ver = px_ver[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1];
+                a_hor = px_hor[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1];
+            }
 #if LV_COLOR_DEPTH == 16
-                else if(cf == LV_COLOR_FORMAT_RGB565A8) {
-                    const lv_opa_t * a_tmp = src + src_stride * src_h * sizeof(lv_color_t);
-                    a_base = *(a_tmp + (ys_int * src_stride) + xs_int);
-                    a_hor = *(a_tmp + (ys_int * src_stride) + xs_int + x_next);
-                    a_ver = *(a_tmp + ((ys_int + y_next) * src_stride) + xs_int);
-                }
+            else if(cf == LV_COLOR_FORMAT_RGB565A8) {
+                const lv_opa_t * a_tmp = src + src_stride * src_h * sizeof(lv_color_t);
+                a_base = *(a_tmp + (ys_int * src_stride) + xs_int);
+                a_hor = *(a_tmp + (ys_int * src_stride) + xs_int + x_next);
+                a_ver = *(a_tmp + ((ys_int + y_next) * src_stride) + xs_int);
+            }
 #endif
-                else {
-                    a_base = 0xff;
-                    a_ver = 0xff;
-                    a_hor = 0xff;
-                }
+            else {
+                a_base = 0xff;
+                a_ver = 0xff;
+                a_hor = 0xff;
+            }
 
-                if(a_ver != a_base) a_ver = ((a_ver * ys_fract) + (a_base * (0x100 - ys_fract))) >> 8;
-                if(a_hor != a_base) a_hor = ((a_hor * xs_fract) + (a_base * (0x100 - xs_fract))) >> 8;
-                abuf[x] = (a_ver + a_hor) >> 1;
+            if(a_ver != a_base) a_ver = ((a_ver * ys_fract) + (a_base * (0x100 - ys_fract))) >> 8;
+            if(a_hor != a_base) a_hor = ((a_hor * xs_fract) + (a_base * (0x100 - xs_fract))) >> 8;
+            *a_out = (a_ver + a_hor) >> 1;
 
-                if(abuf[x] == 0x00) continue;
+            if(*a_out == 0x00) return;
 
 #if LV_COLOR_DEPTH == 8
-                lv_color_set_int(&c_base, px_base[0]);
-                lv_color_set_int(&c_ver, px_ver[0]);
-                lv_color_set_int(&c_hor, px_hor[0]);
+            lv_color_set_int(&c_base, px_base[0]);
+            lv_color_set_int(&c_ver, px_ver[0]);
+            lv_color_set_int(&c_hor, px_hor[0]);
 #elif LV_COLOR_DEPTH == 16
-                lv_color_set_int(&c_base, px_base[0] + (px_base[1] << 8));
-                lv_color_set_int(&c_ver, px_ver[0] + (px_ver[1] << 8));
-                lv_color_set_int(&c_hor, px_hor[0] + (px_hor[1] << 8));
+            lv_color_set_int(&c_base, px_base[0] + (px_base[1] << 8));
+            lv_color_set_int(&c_ver, px_ver[0] + (px_ver[1] << 8));
+            lv_color_set_int(&c_hor, px_hor[0] + (px_hor[1] << 8));
 #elif LV_COLOR_DEPTH == 24
-                lv_color_set_int(&c_base, px_base[0] + (px_base[1] << 8) +  + (px_base[2] << 8));
-                lv_color_set_int(&c_ver, px_ver[0] + (px_ver[1] << 8) + (px_ver[2] << 8));
-                lv_color_set_int(&c_hor, px_hor[0] + (px_hor[1] << 8) + (px_hor[2] << 8));
+            lv_color_set_int(&c_base, px_base[0] + (px_base[1] << 8) +  + (px_base[2] << 8));
+            lv_color_set_int(&c_ver, px_ver[0] + (px_ver[1] << 8) + (px_ver[2] << 8));
+            lv_color_set_int(&c_hor, px_hor[0] + (px_hor[1] << 8) + (px_hor[2] << 8));
 #elif LV_COLOR_DEPTH == 32
-                c_base = *((lv_color_t *)px_base);
-                c_ver = *((lv_color_t *)px_ver);
-                c_hor = *((lv_color_t *)px_hor);
+            c_base = *((lv_color_t *)px_base);
+            c_ver = *((lv_color_t *)px_ver);
+            c_hor = *((lv_color_t *)px_hor);
 #endif
-            }
-            /*No alpha channel -> RGB*/
-            else {
-                c_base = *((const lv_color_t *) px_base);
-                c_hor = *((const lv_color_t *) px_hor);
-                c_ver = *((const lv_color_t *) px_ver);
-                abuf[x] = 0xff;
-            }
+        }
+        /*No alpha channel -> RGB*/
+        else {
+            c_base = *((const lv_color_t *) px_base);
+            c_hor = *((const lv_color_t *) px_hor);
+            c_ver = *((const lv_color_t *) px_ver);
+            *a_out = 0xff;
+        }
 
-            if(lv_color_eq(c_base, c_ver) && lv_color_eq(c_base, c_hor)) {
-                cbuf[x] = c_base;
-            }
-            else {
-                c_ver = LV_COLOR_MIX(c_ver, c_base, ys_fract);
-                c_hor = LV_COLOR_MIX(c_hor, c_base, xs_fract);
-                cbuf[x] = LV_COLOR_MIX(c_hor, c_ver, LV_OPA_50);
-            }
+        if(lv_color_eq(c_base, c_ver) && lv_color_eq(c_base, c_hor)) {
+            *c_out = c_base;
         }
-        /*Partially out of the image*/
         else {
+            c_ver = LV_COLOR_MIX(c_ver, c_base, ys_fract);
+            c_hor = LV_COLOR_MIX(c_hor, c_base, xs_fract);
+            *c_out = LV_COLOR_MIX(c_hor, c_ver, LV_OPA_50);
+        }
+    }
+    /*Partially out of the image*/
+    else {
 #if LV_COLOR_DEPTH == 8
-            lv_color_set_int(&cbuf[x], src_tmp[0]);
+        lv_color_set_int(c_out, src_tmp[0]);
 #elif LV_COLOR_DEPTH == 16
-            lv_color_set_int(&cbuf[x], src_tmp[0] + (src_tmp[1] << 8));
+        lv_color_set_int(c_out, src_tmp[0] + (src_tmp[1] << 8));
 #elif LV_COLOR_DEPTH == 24
-            lv_color_set_int(&cbuf[x], src_tmp[0] + (src_tmp[1] << 8) + (src_tmp[2] << 8));
+        lv_color_set_int(c_out, src_tmp[0] + (src_tmp[1] << 8) + (src_tmp[2] << 8));
 #elif LV_COLOR_DEPTH == 32
-            cbuf[x] = *((lv_color_t *)src_tmp);
+        *c_out = *((lv_color_t *)src_tmp);
 #endif
-            lv_opa_t a;
-            switch(cf) {
-                case LV_COLOR_FORMAT_NATIVE_ALPHA:
-                    a = src_tmp[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1];
-                    break;
+        lv_opa_t a;
+        switch(cf) {
+            case LV_COLOR_FORMAT_NATIVE_ALPHA:
+                a = src_tmp[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1];
+                break;
 #if LV_COLOR_DEPTH == 16
-                case LV_COLOR_FORMAT_RGB565A8:
-                    a = *(src + src_stride * src_h * sizeof(lv_color_t) + (ys_int * src_stride) + xs_int);
-                    break;
+            case LV_COLOR_FORMAT_RGB565A8:
+                a = *(src + src_stride * src_h * sizeof(lv_color_t) + (ys_int * src_stride) + xs_int);
+                break;
 #endif
-                default:
-                    a = 0xff;
-            }
+            default:
+                a = 0xff;
+        }
 
-            if((xs_int == 0 && x_next < 0) || (xs_int == src_w - 1 && x_next > 0))  {
-                abuf[x] = (a * (0xFF - xs_fract)) >> 8;
+        lv_opa_t edge_opa;
+        if((xs_int == 0 && x_next < 0) || (xs_int == src_w - 1 && x_next > 0))  {
+            edge_opa = 0xFF - xs_fract;
+        }
+        else if((ys_int == 0 && y_next < 0) || (ys_int == src_h - 1 && y_next > 0))  {
+            edge_opa = 0xFF - ys_fract;
+        }
+        else {
+            edge_opa = 0x00;
+        }
+        *a_out = (a * edge_opa) >> 8;
+
+        /*Fade the premultiplied colors too to keep them weighted by the alpha*/
+        if(s->premult) *c_out = LV_COLOR_MIX(*c_out, lv_color_black(), edge_opa);
+    }
+}
+
+#if TRANSFORM_AA_SIMD
+
+/**
+ * `lv_color_mix` on 4 colors stored as integers
+ */
+static inline lv_simd_u32_t color_mix_simd(lv_simd_u32_t c1, lv_simd_u32_t c2, lv_simd_u32_t mix)
+{
+#if LV_COLOR_DEPTH == 16
+    mix = (mix + 4) >> 3;
+    lv_simd_u32_t bg = (c2 | (c2 << 16)) & 0x7E0F81F;
+    lv_simd_u32_t fg = (c1 | (c1 << 16)) & 0x7E0F81F;
+    lv_simd_u32_t result = ((((fg - bg) * mix) >> 5) + bg) & 0x7E0F81F;
+    return ((result >> 16) | result) & 0xFFFF;
+#else
+    lv_simd_u32_t mix_inv = 255 - mix;
+    lv_simd_u32_t r = lv_simd_udiv255(((c1 >> 16) & 0xFF) * mix + ((c2 >> 16) & 0xFF) * mix_inv + LV_COLOR_MIX_ROUND_OFS);
+    lv_simd_u32_t g = lv_simd_udiv255(((c1 >> 8) & 0xFF) * mix + ((c2 >> 8) & 0xFF) * mix_inv + LV_COLOR_MIX_ROUND_OFS);
+    lv_simd_u32_t b = lv_simd_udiv255((c1 & 0xFF) * mix + (c2 & 0xFF) * mix_inv + LV_COLOR_MIX_ROUND_OFS);
+    return 0xFF000000 | (r << 16) | (g << 8) | b;
+#endif
+}
+
+static inline uint32_t color_int_at(const aa_src_dsc_t * s, const uint8_t * px)
+{
+#if LV_COLOR_DEPTH == 16
+    if(s->has_alpha) return px[0] + (px[1] << 8);
+#else
+    LV_UNUSED(s);
+#endif
+    return lv_color_to_int(*((const lv_color_t *)px));
+}
+
+/**
+ * Sample 4 pixels at once while the neighbors of all of them are on the image.
+ * The pixels close to the edges are sampled by `argb_and_rgb_aa_px`.
+ * @return the first pixel which wasn't processed
+ */
+static int32_t argb_and_rgb_aa_simd(const aa_src_dsc_t * s, int32_t xs_ups, int32_t ys_ups,
+                                    int32_t xs_step, int32_t ys_step,
+                                    int32_t x_start, int32_t x_end, lv_color_t * cbuf, uint8_t * abuf)
+{
+    const lv_opa_t * src_a = NULL;
+#if LV_COLOR_DEPTH == 16
+    if(s->cf == LV_COLOR_FORMAT_RGB565A8) src_a = s->src + s->src_stride * s->src_h * sizeof(lv_color_t);
+#endif
+
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
+    int32_t x;
+    for(x = x_start; x + LV_SIMD_LANES <= x_end; x += LV_SIMD_LANES) {
+        lv_simd_u32_t c_base = LV_SIMD_U32(0);
+        lv_simd_u32_t c_hor = LV_SIMD_U32(0);
+        lv_simd_u32_t c_ver = LV_SIMD_U32(0);
+        lv_simd_u32_t a_base = LV_SIMD_U32(0xff);
+        lv_simd_u32_t a_hor = LV_SIMD_U32(0xff);
+        lv_simd_u32_t a_ver = LV_SIMD_U32(0xff);
+        lv_simd_u32_t xs_fract = LV_SIMD_U32(0);
+        lv_simd_u32_t ys_fract = LV_SIMD_U32(0);
+        int32_t xs_ups_lane[LV_SIMD_LANES];
+        int32_t ys_ups_lane[LV_SIMD_LANES];
+        bool edge[LV_SIMD_LANES];
+
+        /*Gather the neighbors. The pixels on the edges are handled later by the scalar sampler*/
+        int32_t i;
+        for(i = 0; i < LV_SIMD_LANES; i++) {
+            xs_ups_lane[i] = xs_ups + (xs_acc >> 8);
+            ys_ups_lane[i] = ys_ups + (ys_acc >> 8);
+            xs_acc += xs_step;
+            ys_acc += ys_step;
+
+            int32_t xs_int = xs_ups_lane[i] >> 8;
+            int32_t ys_int = ys_ups_lane[i] >> 8;
+            int32_t xf = xs_ups_lane[i] & 0xFF;
+            int32_t yf = ys_ups_lane[i] & 0xFF;
+            int32_t x_next = xf < 0x80 ? -1 : 1;
+            int32_t y_next = yf < 0x80 ? -1 : 1;
+
+            edge[i] = xs_int + x_next < 0 || xs_int + x_next >= s->src_w ||
+                      ys_int + y_next < 0 || ys_int + y_next >= s->src_h;
+            if(edge[i]) continue;
+
+            xs_fract[i] = xf < 0x80 ? (0x7F - xf) * 2 : (xf - 0x80) * 2;
+            ys_fract[i] = yf < 0x80 ? (0x7F - yf) * 2 : (yf - 0x80) * 2;
+
+            const uint8_t * px_base = s->src + (ys_int * s->src_stride + xs_int) * s->px_size;
+            const uint8_t * px_hor = px_base + x_next * s->px_size;
+            const uint8_t * px_ver = px_base + y_next * s->src_stride * s->px_size;
+            c_base[i] = color_int_at(s, px_base);
+            c_hor[i] = color_int_at(s, px_hor);
+            c_ver[i] = color_int_at(s, px_ver);
+
+            if(src_a) {
+                const lv_opa_t * a_tmp = src_a + ys_int * s->src_stride + xs_int;
+                a_base[i] = a_tmp[0];
+                a_hor[i] = a_tmp[x_next];
+                a_ver[i] = a_tmp[y_next * s->src_stride];
             }
-            else if((ys_int == 0 && y_next < 0) || (ys_int == src_h - 1 && y_next > 0))  {
-                abuf[x] = (a * (0xFF - ys_fract)) >> 8;
+            else if(s->has_alpha) {
+                a_base[i] = px_base[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1];
+                a_hor[i] = px_hor[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1];
+                a_ver[i] = px_ver[LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE - 1];
+            }
+        }
+
+        /*Mixing equal values gives the same value so unlike the scalar code the alpha needs no special case*/
+        a_ver = (a_ver * ys_fract + a_base * (0x100 - ys_fract)) >> 8;
+        a_hor = (a_hor * xs_fract + a_base * (0x100 - xs_fract)) >> 8;
+        lv_simd_u32_t a_res = (a_ver + a_hor) >> 1;
+
+        lv_simd_u32_t c_ver_mix = color_mix_simd(c_ver, c_base, ys_fract);
+        lv_simd_u32_t c_hor_mix = color_mix_simd(c_hor, c_base, xs_fract);
+        lv_simd_u32_t c_res = color_mix_simd(c_hor_mix, c_ver_mix, LV_SIMD_U32(LV_OPA_50));
+        c_res = lv_simd_select((c_base == c_hor) & (c_base == c_ver), c_base, c_res);
+
+        for(i = 0; i < LV_SIMD_LANES; i++) {
+            if(edge[i]) {
+                argb_and_rgb_aa_px(s, xs_ups_lane[i], ys_ups_lane[i], &cbuf[x + i], &abuf[x + i]);
             }
             else {
-                abuf[x] = 0x00;
+                lv_color_set_int(&cbuf[x + i], c_res[i]);
+                abuf[x + i] = (lv_opa_t)a_res[i];
             }
         }
     }
+
+    return x;
 }
+#endif /*TRANSFORM_AA_SIMD*/
 
 static void a8_aa(const uint8_t * src, lv_coord_t src_w, lv_coord_t src_h, lv_coord_t src_stride,
                   int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                  int32_t x_end, uint8_t * abuf)
+                  int32_t x_start, int32_t x_end, uint8_t * abuf)
 {
-    int32_t xs_ups_start = xs_ups;
-    int32_t ys_ups_start = ys_ups;
+    int32_t xs_acc = xs_step * x_start;
+    int32_t ys_acc = ys_step * x_start;
 
-    lv_coord_t x;
-    for(x = 0; x < x_end; x++) {
-        xs_ups = xs_ups_start + ((xs_step * x) >> 8);
-        ys_ups = ys_ups_start + ((ys_step * x) >> 8);
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs_cur = xs_ups + (xs_acc >> 8);
+        int32_t ys_cur = ys_ups + (ys_acc >> 8);
+        xs_acc += xs_step;
+        ys_acc += ys_step;
 
-        int32_t xs_int = xs_ups >> 8;
-        int32_t ys_int = ys_ups >> 8;
-
-        /*Fully out of the image*/
-        if(xs_int < 0 || xs_int >= src_w || ys_int < 0 || ys_int >= src_h) {
-            abuf[x] = 0x00;
-            continue;
-        }
+        int32_t xs_int = xs_cur >> 8;
+        int32_t ys_int = ys_cur >> 8;
 
         /*Get the direction the hor and ver neighbor
          *`fract` will be in range of 0x00..0xFF and `next` (+/-1) indicates the direction*/
-        int32_t xs_fract = xs_ups & 0xFF;
-        int32_t ys_fract = ys_ups & 0xFF;
+        int32_t xs_fract = xs_cur & 0xFF;
+        int32_t ys_fract = ys_cur & 0xFF;
 
         int32_t x_next;
         int32_t y_next;
@@ -0,0 +1,316 @@
+/**
+ * @file lv_font_atlas.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_font_atlas.h"
+#include "lv_font_fmt_txt.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_mem.h"
+#include "../misc/lv_txt.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t letter;
+    uint32_t bitmap_index;  /*Start of the glyph's bitmap in `atlas_dsc_t.bitmap`*/
+    uint16_t adv_w;         /*Without kerning*/
+    uint16_t box_w;
+    uint16_t box_h;
+    int16_t ofs_x;
+    int16_t ofs_y;
+} atlas_glyph_t;
+
+typedef struct {
+    lv_font_t font;
+    const lv_font_t * base;
+    atlas_glyph_t * glyphs;     /*Ordered by letter*/
+    uint32_t glyph_cnt;
+    uint8_t * bitmap;           /*The 8 bpp bitmap of the glyphs one after the other*/
+    uint32_t bitmap_size;
+    bool kern;                  /*The advance width depends on the next letter*/
+} atlas_dsc_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool atlas_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                                uint32_t letter_next);
+static const uint8_t * atlas_get_glyph_bitmap(const lv_font_t * font, uint32_t letter);
+static const atlas_glyph_t * atlas_find_glyph(const atlas_dsc_t * dsc, uint32_t letter);
+static uint32_t collect_letters(const char * txt, uint32_t * letters);
+static bool has_kerning(const lv_font_t * font, const char * txt);
+static bool glyph_is_supported(const lv_font_glyph_dsc_t * g);
+static void glyph_to_a8(uint8_t * dest, const uint8_t * src, uint32_t px_cnt, uint32_t bpp);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_font_t * lv_font_atlas_create(const lv_font_t * font, const char * txt)
+{
+    LV_ASSERT_NULL(font);
+    LV_ASSERT_NULL(txt);
+
+    atlas_dsc_t * dsc = lv_malloc(sizeof(atlas_dsc_t));
+    LV_ASSERT_MALLOC(dsc);
+    if(dsc == NULL) return NULL;
+    lv_memzero(dsc, sizeof(atlas_dsc_t));
+    dsc->base = font;
+
+    uint32_t letter_cnt = _lv_txt_get_encoded_length(txt);
+    uint32_t * letters = NULL;
+    if(letter_cnt > 0) {
+        letters = lv_malloc(letter_cnt * sizeof(uint32_t));
+        dsc->glyphs = lv_malloc(letter_cnt * sizeof(atlas_glyph_t));
+        LV_ASSERT_MALLOC(letters);
+        LV_ASSERT_MALLOC(dsc->glyphs);
+        if(letters == NULL || dsc->glyphs == NULL) {
+            lv_free(letters);
+            lv_free(dsc->glyphs);
+            lv_free(dsc);
+            return NULL;
+        }
+    }
+
+    letter_cnt = collect_letters(txt, letters);
+
+    /*Measure the glyphs*/
+    uint32_t i;
+    for(i = 0; i < letter_cnt; i++) {
+        uint32_t letter = letters[i];
+        lv_font_glyph_dsc_t g;
+        if(!lv_font_get_glyph_dsc(font, &g, letter, '\0')) continue;
+        if(!glyph_is_supported(&g)) continue;
+
+        atlas_glyph_t * ag = &dsc->glyphs[dsc->glyph_cnt];
+        ag->letter = letter;
+        ag->adv_w = g.adv_w;
+        ag->box_w = g.box_w;
+        ag->box_h = g.box_h;
+        ag->ofs_x = g.ofs_x;
+        ag->ofs_y = g.ofs_y;
+        ag->bitmap_index = dsc->bitmap_size;
+        dsc->bitmap_size += (uint32_t)g.box_w * g.box_h;
+        dsc->glyph_cnt++;
+    }
+    lv_free(letters);
+
+    if(dsc->bitmap_size > 0) {
+        dsc->bitmap = lv_malloc(dsc->bitmap_size);
+        LV_ASSERT_MALLOC(dsc->bitmap);
+        if(dsc->bitmap == NULL) {
+            lv_free(dsc->glyphs);
+            lv_free(dsc);
+            return NULL;
+        }
+    }
+
+    /*Render the glyphs. Some font engines return the bitmap of the last measured glyph so measure them again.
+     *The glyphs whose bitmap is not found are removed and left to the base font.*/
+    uint32_t glyph_cnt = 0;
+    uint32_t bitmap_index = 0;
+    for(i = 0; i < dsc->glyph_cnt; i++) {
+        atlas_glyph_t ag = dsc->glyphs[i];
+        lv_font_glyph_dsc_t g;
+        lv_font_get_glyph_dsc(font, &g, ag.letter, '\0');
+        uint32_t px_cnt = (uint32_t)ag.box_w * ag.box_h;
+        if(px_cnt > 0) {
+            const uint8_t * map_p = lv_font_get_glyph_bitmap(g.resolved_font, ag.letter);
+            if(map_p == NULL) continue;
+            glyph_to_a8(&dsc->bitmap[bitmap_index], map_p, px_cnt, g.bpp);
+        }
+
+        ag.bitmap_index = bitmap_index;
+        bitmap_index += px_cnt;
+        dsc->glyphs[glyph_cnt] = ag;
+        glyph_cnt++;
+    }
+    dsc->glyph_cnt = glyph_cnt;
+    dsc->bitmap_size = bitmap_index;
+
+    dsc->kern = has_kerning(font, txt);
+
+    lv_font_t * atlas = &dsc->font;
+    atlas->dsc = dsc;
+    atlas->get_glyph_dsc = atlas_get_glyph_dsc;
+    atlas->get_glyph_bitmap = atlas_get_glyph_bitmap;
+    atlas->line_height = font->line_height;
+    atlas->base_line = font->base_line;
+    atlas->subpx = LV_FONT_SUBPX_NONE;
+    atlas->underline_position = font->underline_position;
+    atlas->underline_thickness = font->underline_thickness;
+    atlas->fallback = font;     /*Draw the other letters with the base font*/
+
+    return atlas;
+}
+
+uint32_t lv_font_atlas_get_glyph_count(const lv_font_t * font, uint32_t * bitmap_size)
+{
+    LV_ASSERT_NULL(font);
+    const atlas_dsc_t * dsc = (const atlas_dsc_t *)font->dsc;
+    if(bitmap_size) *bitmap_size = dsc->bitmap_size;
+    return dsc->glyph_cnt;
+}
+
+void lv_font_atlas_destroy(lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+
+    lv_txt_size_cache_invalidate();
+    atlas_dsc_t * dsc = (atlas_dsc_t *)font->dsc;
+    lv_free(dsc->glyphs);
+    lv_free(dsc->bitmap);
+    lv_free(dsc);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool atlas_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                                uint32_t letter_next)
+{
+    const atlas_dsc_t * dsc = (const atlas_dsc_t *)font->dsc;
+    const atlas_glyph_t * ag = atlas_find_glyph(dsc, letter);
+    if(ag == NULL) return false;
+
+    /*The kerning is measured by the base font but the glyph is not drawn by it*/
+    if(dsc->kern && letter_next != '\0') dsc_out->adv_w = lv_font_get_glyph_width(dsc->base, letter, letter_next);
+    else dsc_out->adv_w = ag->adv_w;
+
+    dsc_out->box_w = ag->box_w;
+    dsc_out->box_h = ag->box_h;
+    dsc_out->ofs_x = ag->ofs_x;
+    dsc_out->ofs_y = ag->ofs_y;
+    dsc_out->bpp = 8;
+    dsc_out->is_placeholder = false;
+    return true;
+}
+
+static const uint8_t * atlas_get_glyph_bitmap(const lv_font_t * font, uint32_t letter)
+{
+    const atlas_dsc_t * dsc = (const atlas_dsc_t *)font->dsc;
+    const atlas_glyph_t * ag = atlas_find_glyph(dsc, letter);
+    if(ag == NULL || dsc->bitmap == NULL) return NULL;
+
+    return &dsc->bitmap[ag->bitmap_index];
+}
+
+static const atlas_glyph_t * atlas_find_glyph(const atlas_dsc_t * dsc, uint32_t letter)
+{
+    uint32_t min = 0;
+    uint32_t max = dsc->glyph_cnt;
+    while(min < max) {
+        uint32_t mid = (min + max) / 2;
+        uint32_t mid_letter = dsc->glyphs[mid].letter;
+        if(mid_letter == letter) return &dsc->glyphs[mid];
+        if(mid_letter < letter) min = mid + 1;
+        else max = mid;
+    }
+
+    return NULL;
+}
+
+/**
+ * Collect the different printable letters of a text in increasing order
+ * @param txt       UTF-8 text
+ * @param letters   store the letters here. Needs space for all the letters of `txt`
+ * @return          the number of different letters
+ */
+static uint32_t collect_letters(const char * txt, uint32_t * letters)
+{
+    uint32_t cnt = 0;
+    uint32_t i = 0;
+    while(txt[i] != '\0') {
+        uint32_t letter = _lv_txt_encoded_next(txt, &i);
+        if(letter < 0x20) continue;
+
+        uint32_t min = 0;
+        uint32_t max = cnt;
+        while(min < max) {
+            uint32_t mid = (min + max) / 2;
+            if(letters[mid] < letter) min = mid + 1;
+            else max = mid;
+        }
+        if(min < cnt && letters[min] == letter) continue;
+
+        memmove(&letters[min + 1], &letters[min], (cnt - min) * sizeof(uint32_t));
+        letters[min] = letter;
+        cnt++;
+    }
+
+    return cnt;
+}
+
+/**
+ * Tell if the advance width of the letters of the text depends on the next letter
+ */
+static bool has_kerning(const lv_font_t * font, const char * txt)
+{
+    if(font->get_glyph_dsc == lv_font_get_glyph_dsc_fmt_txt) {
+        const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *)font->dsc;
+        if(fdsc->kern_dsc != NULL) return true;
+    }
+
+    uint32_t i = 0;
+    uint32_t letter = _lv_txt_encoded_next(txt, &i);
+    while(letter != '\0') {
+        uint32_t letter_next = _lv_txt_encoded_next(txt, &i);
+        if(letter_next == '\0') break;
+        if(lv_font_get_glyph_width(font, letter, letter_next) != lv_font_get_glyph_width(font, letter, '\0')) {
+            return true;
+        }
+        letter = letter_next;
+    }
+
+    return false;
+}
+
+static bool glyph_is_supported(const lv_font_glyph_dsc_t * g)
+{
+    if(g->is_placeholder || g->resolved_font == NULL) return false;
+    if(g->resolved_font->subpx != LV_FONT_SUBPX_NONE) return false;
+
+    return g->bpp == 1 || g->bpp == 2 || g->bpp == 3 || g->bpp == 4 || g->bpp == 8;
+}
+
+/**
+ * Convert a glyph's bitmap to 8 bpp with the same opacities the renderer uses
+ */
+static void glyph_to_a8(uint8_t * dest, const uint8_t * src, uint32_t px_cnt, uint32_t bpp)
+{
+    if(bpp == 8) {
+        lv_memcpy(dest, src, px_cnt);
+        return;
+    }
+
+    /*3 bpp glyphs are drawn as 4 bpp*/
+    if(bpp == 3) bpp = 4;
+
+    uint32_t px_max = (1 << bpp) - 1;
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        uint32_t bit_ofs = i * bpp;
+        uint32_t px = (src[bit_ofs >> 3] >> (8 - bpp - (bit_ofs & 0x7))) & px_max;
+        dest[i] = px * 255 / px_max;
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * @file lv_font_atlas.h
+ *
+ */
+
+#ifndef LV_FONT_ATLAS_H
+#define LV_FONT_ATLAS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_font.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Prerender the glyphs of some letters of a font.
+ * The returned font draws these letters from a buffer and takes all the other letters from `font`.
+ * It avoids the delay when a lot of letters appear for the first time with fonts which render the glyphs
+ * on demand (e.g. FreeType or Tiny TTF fonts) and the decompression of the compressed fonts.
+ * The glyphs are stored with 8 bpp and kept until the font is destroyed.
+ * @param font      the font to prerender. It can't be deleted while the new font is used.
+ * @param txt       UTF-8 text with the letters to prerender, e.g. the texts of a screen or a character set.
+ *                  Kerning is detected from its consecutive letters.
+ * @return          a new font to use instead of `font` or NULL on error
+ */
+lv_font_t * lv_font_atlas_create(const lv_font_t * font, const char * txt);
+
+/**
+ * Get the number of prerendered glyphs and the size of their bitmaps
+ * @param font          a font created by `lv_font_atlas_create`
+ * @param bitmap_size   store the size of the bitmaps in bytes here (can be NULL)
+ * @return              the number of prerendered glyphs
+ */
+uint32_t lv_font_atlas_get_glyph_count(const lv_font_t * font, uint32_t * bitmap_size);
+
+/**
+ * Free a font created by `lv_font_atlas_create`
+ * @param font      the font to free
+ */
+void lv_font_atlas_destroy(lv_font_t * font);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FONT_ATLAS_H*/
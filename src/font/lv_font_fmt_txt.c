@@ -18,6 +18,12 @@
 /*********************
  *      DEFINES
  *********************/
+#define GID_LUT_LATIN_NUM   256
+#define KERN_CLASS_MAX      255
+
+#if LV_FONT_FMT_TXT_KERN_CACHE_SIZE & (LV_FONT_FMT_TXT_KERN_CACHE_SIZE - 1)
+    #error "LV_FONT_FMT_TXT_KERN_CACHE_SIZE must be a power of 2"
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -28,11 +34,32 @@ typedef enum {
     RLE_STATE_COUNTER,
 } rle_state_t;
 
+#if LV_FONT_FMT_TXT_GLYPH_ID_LUT
+typedef struct {
+    /*Glyph IDs of U+0000..U+00FF. 0: not in the font*/
+    uint16_t latin[GID_LUT_LATIN_NUM];
+    /*Open addressing hash table of the other letters. 0: empty slot*/
+    uint32_t * hash_letters;
+    uint16_t * hash_gids;
+    uint32_t hash_mask;
+    uint8_t hash_shift;
+} glyph_id_lut_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t find_glyph_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
+#if LV_FONT_FMT_TXT_GLYPH_ID_LUT
+    static void glyph_id_lut_build(const lv_font_fmt_txt_dsc_t * fdsc);
+    static void glyph_id_lut_free(lv_font_fmt_txt_glyph_cache_t * cache);
+    static inline uint32_t glyph_id_lut_find(const glyph_id_lut_t * lut, uint32_t letter);
+#endif
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
+static int8_t get_kern_pair_value(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t gid_left, uint32_t gid_right);
+static inline void get_kern_pair_ids(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t i, uint32_t * gid_left,
+                                     uint32_t * gid_right);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
@@ -123,9 +150,8 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
             last_buf_size = buf_size;
         }
 
-        bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
-                   (uint8_t)fdsc->bpp, prefilter);
+        lv_font_decompress_glyph_fmt_txt(fdsc, gdsc, &fdsc->glyph_bitmap[gdsc->bitmap_index],
+                                         LV_GC_ROOT(_lv_font_decompr_buf));
         return LV_GC_ROOT(_lv_font_decompr_buf);
 #else /*!LV_USE_FONT_COMPRESSED*/
         LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
@@ -203,6 +229,233 @@ void _lv_font_clean_up_fmt_txt(void)
 #endif
 }
 
+/**
+ * Get the glyph ID of a letter.
+ * @param font      pointer to a font in lvgl's native format
+ * @param letter    a UNICODE letter code
+ * @return          index of the letter's glyph in `glyph_dsc` or 0 if the letter is not found
+ */
+uint32_t lv_font_get_glyph_id_fmt_txt(const lv_font_t * font, uint32_t letter)
+{
+    return get_glyph_dsc_id(font, letter);
+}
+
+#if LV_USE_FONT_COMPRESSED
+/**
+ * Decompress the bitmap of a glyph of a compressed font.
+ * @param fdsc      pointer to the font's descriptor
+ * @param gdsc      pointer to the glyph's descriptor
+ * @param in        the compressed bitmap of the glyph
+ * @param out       store the bitmap here. It needs to have `(box_w * box_h * bpp + 7) / 8` bytes
+ *                  where 3 bpp is handled as 4 bpp.
+ */
+void lv_font_decompress_glyph_fmt_txt(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                                      const uint8_t * in, uint8_t * out)
+{
+    bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
+    decompress(in, out, gdsc->box_w, gdsc->box_h, (uint8_t)fdsc->bpp, prefilter);
+}
+#endif
+
+/**
+ * Convert pair based kerning to class based kerning.
+ * The glyphs with the same kerning values get the same class.
+ * @param kern_pairs    pointer to pair based kerning
+ * @param glyph_cnt     number of glyphs of the font, i.e. length of the class mappings
+ * @param max_size      max. size of the class matrix in bytes
+ * @return              class based kerning whose fields are allocated one by one with `lv_malloc`,
+ *                      or NULL if the classes don't fit into `max_size` or out of memory
+ */
+lv_font_fmt_txt_kern_classes_t * lv_font_kern_pairs_to_classes_fmt_txt(const lv_font_fmt_txt_kern_pair_t * kern_pairs,
+                                                                        uint32_t glyph_cnt, uint32_t max_size)
+{
+    LV_ASSERT_NULL(kern_pairs);
+
+    const lv_font_fmt_txt_kern_pair_t * kdsc = kern_pairs;
+    lv_font_fmt_txt_kern_classes_t * kern_classes = NULL;
+    uint8_t * left_mapping = lv_malloc(glyph_cnt);
+    uint8_t * right_mapping = lv_malloc(glyph_cnt);
+    /*Index of the first pair of each left class' row and the length of the rows*/
+    uint32_t * row_start = lv_malloc(KERN_CLASS_MAX * sizeof(uint32_t));
+    uint32_t * row_len = lv_malloc(KERN_CLASS_MAX * sizeof(uint32_t));
+    /*Map the right glyphs to their columns in `cols`*/
+    uint32_t * col_ids = lv_malloc(glyph_cnt * sizeof(uint32_t));
+    int8_t * cols = NULL;
+    int8_t * values = NULL;
+    if(left_mapping == NULL || right_mapping == NULL || row_start == NULL || row_len == NULL || col_ids == NULL) {
+        goto failed;
+    }
+
+    lv_memzero(left_mapping, glyph_cnt);
+    lv_memzero(right_mapping, glyph_cnt);
+
+    /*The pairs are ordered by the left glyph so a row is the run of pairs with the same left glyph.
+     *The glyphs with the same rows get the same left class.*/
+    uint32_t left_cnt = 0;
+    uint32_t col_cnt = 0;
+    uint32_t i = 0;
+    while(i < kdsc->pair_cnt) {
+        uint32_t gid_left;
+        uint32_t gid_right;
+        get_kern_pair_ids(kdsc, i, &gid_left, &gid_right);
+        if(gid_left >= glyph_cnt || left_mapping[gid_left] != 0) goto failed;
+
+        uint32_t len = 0;
+        uint32_t gid_left_act = gid_left;
+        while(gid_left_act == gid_left) {
+            if(gid_right >= glyph_cnt) goto failed;
+            if(right_mapping[gid_right] == 0) {
+                right_mapping[gid_right] = 1;
+                col_ids[gid_right] = col_cnt;
+                col_cnt++;
+            }
+
+            len++;
+            if(i + len >= kdsc->pair_cnt) break;
+            get_kern_pair_ids(kdsc, i + len, &gid_left_act, &gid_right);
+        }
+
+        uint32_t c;
+        for(c = 0; c < left_cnt; c++) {
+            if(row_len[c] != len) continue;
+            uint32_t k;
+            for(k = 0; k < len; k++) {
+                uint32_t l1, r1, l2, r2;
+                get_kern_pair_ids(kdsc, row_start[c] + k, &l1, &r1);
+                get_kern_pair_ids(kdsc, i + k, &l2, &r2);
+                if(r1 != r2 || kdsc->values[row_start[c] + k] != kdsc->values[i + k]) break;
+            }
+            if(k == len) break;
+        }
+
+        if(c == left_cnt) {
+            if(left_cnt == KERN_CLASS_MAX) goto failed;
+            row_start[left_cnt] = i;
+            row_len[left_cnt] = len;
+            left_cnt++;
+        }
+
+        left_mapping[gid_left] = c + 1;
+        i += len;
+    }
+
+    /*Collect the kerning values of the right glyphs column by column.
+     *The glyphs with the same columns get the same right class.*/
+    if(left_cnt > max_size) goto failed;
+    cols = lv_malloc(col_cnt * left_cnt);
+    if(cols == NULL) goto failed;
+    lv_memzero(cols, col_cnt * left_cnt);
+
+    uint32_t c;
+    for(c = 0; c < left_cnt; c++) {
+        uint32_t k;
+        for(k = 0; k < row_len[c]; k++) {
+            uint32_t gid_left;
+            uint32_t gid_right;
+            get_kern_pair_ids(kdsc, row_start[c] + k, &gid_left, &gid_right);
+            cols[col_ids[gid_right] * left_cnt + c] = kdsc->values[row_start[c] + k];
+        }
+    }
+
+    /*Reuse `row_start` to store the first column of each right class*/
+    uint32_t * class_col = row_start;
+    uint32_t right_cnt = 0;
+    for(i = 0; i < glyph_cnt; i++) {
+        if(right_mapping[i] == 0) continue;
+
+        const int8_t * col = &cols[col_ids[i] * left_cnt];
+        for(c = 0; c < right_cnt; c++) {
+            const int8_t * class_col_values = &cols[class_col[c] * left_cnt];
+            uint32_t r;
+            for(r = 0; r < left_cnt; r++) {
+                if(class_col_values[r] != col[r]) break;
+            }
+            if(r == left_cnt) break;
+        }
+
+        if(c == right_cnt) {
+            if(right_cnt == KERN_CLASS_MAX || (right_cnt + 1) * left_cnt > max_size) goto failed;
+            class_col[right_cnt] = col_ids[i];
+            right_cnt++;
+        }
+
+        right_mapping[i] = c + 1;
+    }
+
+    values = lv_malloc(left_cnt * right_cnt);
+    kern_classes = lv_malloc(sizeof(lv_font_fmt_txt_kern_classes_t));
+    if(values == NULL || kern_classes == NULL) goto failed;
+
+    for(c = 0; c < right_cnt; c++) {
+        uint32_t r;
+        for(r = 0; r < left_cnt; r++) {
+            values[r * right_cnt + c] = cols[class_col[c] * left_cnt + r];
+        }
+    }
+
+    kern_classes->class_pair_values = values;
+    kern_classes->left_class_mapping = left_mapping;
+    kern_classes->right_class_mapping = right_mapping;
+    kern_classes->left_class_cnt = left_cnt;
+    kern_classes->right_class_cnt = right_cnt;
+
+    lv_free(row_start);
+    lv_free(row_len);
+    lv_free(col_ids);
+    lv_free(cols);
+    return kern_classes;
+
+failed:
+    lv_free(left_mapping);
+    lv_free(right_mapping);
+    lv_free(row_start);
+    lv_free(row_len);
+    lv_free(col_ids);
+    lv_free(cols);
+    lv_free(values);
+    lv_free(kern_classes);
+    return NULL;
+}
+
+#if LV_FONT_FMT_TXT_GLYPH_ID_LUT
+/**
+ * Build the letter to glyph ID lookup tables of a font now instead of on its first use.
+ * Has no effect if the font has no `cache` or the tables are already built.
+ * @param font pointer to a font in lvgl's native format
+ */
+void lv_font_build_glyph_id_lut_fmt_txt(const lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    if(fdsc->cache == NULL || fdsc->cache->gid_lut) return;
+
+    glyph_id_lut_build(fdsc);
+}
+
+/**
+ * Free the letter to glyph ID lookup tables of a font. They are built again on the next use of the font.
+ * @param font pointer to a font in lvgl's native format
+ */
+void lv_font_free_glyph_id_lut_fmt_txt(const lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    if(fdsc->cache == NULL) return;
+
+    glyph_id_lut_free(fdsc->cache);
+}
+
+/**
+ * Free the lookup tables of all fonts.
+ */
+void _lv_font_glyph_id_lut_deinit_fmt_txt(void)
+{
+    while(LV_GC_ROOT(_lv_font_glyph_id_lut_list)) {
+        glyph_id_lut_free(LV_GC_ROOT(_lv_font_glyph_id_lut_list));
+    }
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -213,9 +466,35 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+    if(fdsc->cache == NULL) return find_glyph_id(fdsc, letter);
+
     /*Check the cache first*/
-    if(fdsc->cache && letter == fdsc->cache->last_letter) return fdsc->cache->last_glyph_id;
+    if(letter == fdsc->cache->last_letter) return fdsc->cache->last_glyph_id;
 
+    uint32_t glyph_id;
+#if LV_FONT_FMT_TXT_GLYPH_ID_LUT
+    if(fdsc->cache->gid_lut == NULL && fdsc->cache->gid_lut_failed == 0) glyph_id_lut_build(fdsc);
+
+    if(fdsc->cache->gid_lut) glyph_id = glyph_id_lut_find(fdsc->cache->gid_lut, letter);
+    else glyph_id = find_glyph_id(fdsc, letter);
+#else
+    glyph_id = find_glyph_id(fdsc, letter);
+#endif
+
+    /*Update the cache*/
+    fdsc->cache->last_letter = letter;
+    fdsc->cache->last_glyph_id = glyph_id;
+    return glyph_id;
+}
+
+/**
+ * Search a letter in the character maps
+ * @param fdsc      pointer to a font descriptor
+ * @param letter    a Unicode letter
+ * @return          the glyph ID of the letter or 0 if not found
+ */
+static uint32_t find_glyph_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
@@ -252,22 +531,137 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             }
         }
 
-        /*Update the cache*/
-        if(fdsc->cache) {
-            fdsc->cache->last_letter = letter;
-            fdsc->cache->last_glyph_id = glyph_id;
-        }
         return glyph_id;
     }
 
-    if(fdsc->cache) {
-        fdsc->cache->last_letter = letter;
-        fdsc->cache->last_glyph_id = 0;
+    return 0;
+}
+
+#if LV_FONT_FMT_TXT_GLYPH_ID_LUT
+
+static inline uint32_t glyph_id_lut_hash(const glyph_id_lut_t * lut, uint32_t letter)
+{
+    /*Fibonacci hashing: the upper bits of the product are well distributed even for consecutive letters*/
+    return (uint32_t)(letter * 2654435761U) >> lut->hash_shift;
+}
+
+static inline uint32_t glyph_id_lut_find(const glyph_id_lut_t * lut, uint32_t letter)
+{
+    if(letter < GID_LUT_LATIN_NUM) return lut->latin[letter];
+
+    uint32_t i = glyph_id_lut_hash(lut, letter);
+    while(lut->hash_letters[i] != 0) {
+        if(lut->hash_letters[i] == letter) return lut->hash_gids[i];
+        i = (i + 1) & lut->hash_mask;
     }
+
     return 0;
+}
 
+static void glyph_id_lut_add(glyph_id_lut_t * lut, uint32_t letter, uint32_t glyph_id)
+{
+    if(letter < GID_LUT_LATIN_NUM) {
+        lut->latin[letter] = glyph_id;
+        return;
+    }
+
+    uint32_t i = glyph_id_lut_hash(lut, letter);
+    while(lut->hash_letters[i] != 0) {
+        if(lut->hash_letters[i] == letter) return;
+        i = (i + 1) & lut->hash_mask;
+    }
+    lut->hash_letters[i] = letter;
+    lut->hash_gids[i] = glyph_id;
 }
 
+/**
+ * Build the lookup tables from the results of `find_glyph_id` for all the letters of the character maps.
+ * This way overlapping character maps are handled exactly the same way as without the tables.
+ */
+static void glyph_id_lut_build(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    lv_font_fmt_txt_glyph_cache_t * cache = fdsc->cache;
+
+    /*Don't try again on every letter if the tables can't be built*/
+    cache->gid_lut_failed = 1;
+
+    uint32_t letter_cnt = 0;
+    uint16_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        if(cmap->unicode_list) letter_cnt += cmap->list_length;
+        else letter_cnt += cmap->range_length;
+    }
+
+    /*Keep the hash table at most half full for short probe sequences*/
+    uint32_t hash_size = 16;
+    uint8_t hash_shift = 28;
+    while(hash_size < letter_cnt * 2) {
+        hash_size <<= 1;
+        hash_shift--;
+    }
+
+    glyph_id_lut_t * lut = lv_malloc(sizeof(glyph_id_lut_t) + hash_size * (sizeof(uint32_t) + sizeof(uint16_t)));
+    LV_ASSERT_MALLOC(lut);
+    if(lut == NULL) {
+        LV_LOG_WARN("couldn't allocate the glyph ID lookup tables");
+        return;
+    }
+
+    lv_memzero(lut, sizeof(glyph_id_lut_t) + hash_size * (sizeof(uint32_t) + sizeof(uint16_t)));
+    lut->hash_letters = (uint32_t *)(lut + 1);
+    lut->hash_gids = (uint16_t *)(lut->hash_letters + hash_size);
+    lut->hash_mask = hash_size - 1;
+    lut->hash_shift = hash_shift;
+
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        uint32_t cnt = cmap->unicode_list ? cmap->list_length : cmap->range_length;
+        uint32_t j;
+        for(j = 0; j < cnt; j++) {
+            uint32_t letter = cmap->range_start + (cmap->unicode_list ? cmap->unicode_list[j] : j);
+            if(letter == '\0') continue;
+
+            uint32_t glyph_id = find_glyph_id(fdsc, letter);
+            if(glyph_id == 0) continue;
+            if(glyph_id > UINT16_MAX) {
+                LV_LOG_WARN("too many glyphs for the glyph ID lookup tables");
+                lv_free(lut);
+                return;
+            }
+            glyph_id_lut_add(lut, letter, glyph_id);
+        }
+    }
+
+    cache->gid_lut = lut;
+    cache->gid_lut_failed = 0;
+    cache->gid_lut_next = LV_GC_ROOT(_lv_font_glyph_id_lut_list);
+    LV_GC_ROOT(_lv_font_glyph_id_lut_list) = cache;
+}
+
+static void glyph_id_lut_free(lv_font_fmt_txt_glyph_cache_t * cache)
+{
+    if(cache->gid_lut) {
+        /*Unlink from the list of caches with lookup tables*/
+        if(LV_GC_ROOT(_lv_font_glyph_id_lut_list) == cache) {
+            LV_GC_ROOT(_lv_font_glyph_id_lut_list) = cache->gid_lut_next;
+        }
+        else {
+            lv_font_fmt_txt_glyph_cache_t * prev = LV_GC_ROOT(_lv_font_glyph_id_lut_list);
+            while(prev && prev->gid_lut_next != cache) prev = prev->gid_lut_next;
+            if(prev) prev->gid_lut_next = cache->gid_lut_next;
+        }
+
+        lv_free(cache->gid_lut);
+        cache->gid_lut = NULL;
+    }
+
+    cache->gid_lut_next = NULL;
+    cache->gid_lut_failed = 0;
+}
+
+#endif /*LV_FONT_FMT_TXT_GLYPH_ID_LUT*/
+
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
@@ -276,37 +670,18 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
 
     if(fdsc->kern_classes == 0) {
         /*Kern pairs*/
-        const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
-        if(kdsc->glyph_ids_size == 0) {
-            /*Use binary search to find the kern value.
-             *The pairs are ordered left_id first, then right_id secondly.*/
-            const uint16_t * g_ids = kdsc->glyph_ids;
-            uint16_t g_id_both = (gid_right << 8) + gid_left; /*Create one number from the ids*/
-            uint16_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 2, kern_pair_8_compare);
-
-            /*If the `g_id_both` were found get its index from the pointer*/
-            if(kid_p) {
-                lv_uintptr_t ofs = kid_p - g_ids;
-                value = kdsc->values[ofs];
+#if LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+        if(fdsc->cache && gid_left <= UINT16_MAX && gid_right <= UINT16_MAX) {
+            uint32_t pair = (gid_left << 16) | gid_right;
+            uint32_t i = ((pair * 2654435761U) >> 16) & (LV_FONT_FMT_TXT_KERN_CACHE_SIZE - 1);
+            if(fdsc->cache->kern_pairs[i] != pair) {
+                fdsc->cache->kern_pairs[i] = pair;
+                fdsc->cache->kern_values[i] = get_kern_pair_value(fdsc->kern_dsc, gid_left, gid_right);
             }
+            return fdsc->cache->kern_values[i];
         }
-        else if(kdsc->glyph_ids_size == 1) {
-            /*Use binary search to find the kern value.
-             *The pairs are ordered left_id first, then right_id secondly.*/
-            const uint32_t * g_ids = kdsc->glyph_ids;
-            uint32_t g_id_both = (gid_right << 16) + gid_left; /*Create one number from the ids*/
-            uint32_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 4, kern_pair_16_compare);
-
-            /*If the `g_id_both` were found get its index from the pointer*/
-            if(kid_p) {
-                lv_uintptr_t ofs = kid_p - g_ids;
-                value = kdsc->values[ofs];
-            }
-
-        }
-        else {
-            /*Invalid value*/
-        }
+#endif
+        value = get_kern_pair_value(fdsc->kern_dsc, gid_left, gid_right);
     }
     else {
         /*Kern classes*/
@@ -324,6 +699,59 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
     return value;
 }
 
+static int8_t get_kern_pair_value(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t gid_left, uint32_t gid_right)
+{
+    int8_t value = 0;
+
+    if(kdsc->glyph_ids_size == 0) {
+        /*Use binary search to find the kern value.
+         *The pairs are ordered left_id first, then right_id secondly.*/
+        const uint16_t * g_ids = kdsc->glyph_ids;
+        uint16_t g_id_both = (gid_right << 8) + gid_left; /*Create one number from the ids*/
+        uint16_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 2, kern_pair_8_compare);
+
+        /*If the `g_id_both` were found get its index from the pointer*/
+        if(kid_p) {
+            lv_uintptr_t ofs = kid_p - g_ids;
+            value = kdsc->values[ofs];
+        }
+    }
+    else if(kdsc->glyph_ids_size == 1) {
+        /*Use binary search to find the kern value.
+         *The pairs are ordered left_id first, then right_id secondly.*/
+        const uint32_t * g_ids = kdsc->glyph_ids;
+        uint32_t g_id_both = (gid_right << 16) + gid_left; /*Create one number from the ids*/
+        uint32_t * kid_p = _lv_utils_bsearch(&g_id_both, g_ids, kdsc->pair_cnt, 4, kern_pair_16_compare);
+
+        /*If the `g_id_both` were found get its index from the pointer*/
+        if(kid_p) {
+            lv_uintptr_t ofs = kid_p - g_ids;
+            value = kdsc->values[ofs];
+        }
+
+    }
+    else {
+        /*Invalid value*/
+    }
+
+    return value;
+}
+
+static inline void get_kern_pair_ids(const lv_font_fmt_txt_kern_pair_t * kdsc, uint32_t i, uint32_t * gid_left,
+                                     uint32_t * gid_right)
+{
+    if(kdsc->glyph_ids_size == 0) {
+        const uint8_t * g_ids = kdsc->glyph_ids;
+        *gid_left = g_ids[i * 2];
+        *gid_right = g_ids[i * 2 + 1];
+    }
+    else {
+        const uint16_t * g_ids = kdsc->glyph_ids;
+        *gid_left = g_ids[i * 2];
+        *gid_right = g_ids[i * 2 + 1];
+    }
+}
+
 static int32_t kern_pair_8_compare(const void * ref, const void * element)
 {
     const uint8_t * ref8_p = ref;
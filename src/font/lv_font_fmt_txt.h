@@ -156,9 +156,23 @@ typedef enum {
     LV_FONT_FMT_TXT_COMPRESSED_NO_PREFILTER = 1,
 } lv_font_fmt_txt_bitmap_format_t;
 
-typedef struct {
+typedef struct _lv_font_fmt_txt_glyph_cache_t {
     uint32_t last_letter;
     uint32_t last_glyph_id;
+#if LV_FONT_FMT_TXT_GLYPH_ID_LUT
+    /*Letter to glyph ID lookup tables. Built on the first use of the font*/
+    void * gid_lut;
+    /*Next cache with lookup tables to free them in `lv_deinit`*/
+    struct _lv_font_fmt_txt_glyph_cache_t * gid_lut_next;
+    /*1: the lookup tables couldn't be built, search in the character maps*/
+    uint8_t gid_lut_failed;
+#endif
+#if LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+    /*Direct mapped cache of pair based kerning values.
+     *`(glyph_id_left << 16) | glyph_id_right` for each slot, 0: empty slot*/
+    uint32_t kern_pairs[LV_FONT_FMT_TXT_KERN_CACHE_SIZE];
+    int8_t kern_values[LV_FONT_FMT_TXT_KERN_CACHE_SIZE];
+#endif
 } lv_font_fmt_txt_glyph_cache_t;
 
 /*Describe store additional data for fonts*/
@@ -231,6 +245,59 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+/**
+ * Get the glyph ID of a letter.
+ * @param font      pointer to a font in lvgl's native format
+ * @param letter    a UNICODE letter code
+ * @return          index of the letter's glyph in `glyph_dsc` or 0 if the letter is not found
+ */
+uint32_t lv_font_get_glyph_id_fmt_txt(const lv_font_t * font, uint32_t letter);
+
+#if LV_USE_FONT_COMPRESSED
+/**
+ * Decompress the bitmap of a glyph of a compressed font.
+ * @param fdsc      pointer to the font's descriptor
+ * @param gdsc      pointer to the glyph's descriptor
+ * @param in        the compressed bitmap of the glyph
+ * @param out       store the bitmap here. It needs to have `(box_w * box_h * bpp + 7) / 8` bytes
+ *                  where 3 bpp is handled as 4 bpp.
+ */
+void lv_font_decompress_glyph_fmt_txt(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                                      const uint8_t * in, uint8_t * out);
+#endif
+
+/**
+ * Convert pair based kerning to class based kerning.
+ * The glyphs with the same kerning values get the same class.
+ * @param kern_pairs    pointer to pair based kerning
+ * @param glyph_cnt     number of glyphs of the font, i.e. length of the class mappings
+ * @param max_size      max. size of the class matrix in bytes
+ * @return              class based kerning whose fields are allocated one by one with `lv_malloc`,
+ *                      or NULL if the classes don't fit into `max_size` or out of memory
+ */
+lv_font_fmt_txt_kern_classes_t * lv_font_kern_pairs_to_classes_fmt_txt(const lv_font_fmt_txt_kern_pair_t * kern_pairs,
+                                                                        uint32_t glyph_cnt, uint32_t max_size);
+
+#if LV_FONT_FMT_TXT_GLYPH_ID_LUT
+/**
+ * Build the letter to glyph ID lookup tables of a font now instead of on its first use.
+ * Has no effect if the font has no `cache` or the tables are already built.
+ * @param font pointer to a font in lvgl's native format
+ */
+void lv_font_build_glyph_id_lut_fmt_txt(const lv_font_t * font);
+
+/**
+ * Free the letter to glyph ID lookup tables of a font. They are built again on the next use of the font.
+ * @param font pointer to a font in lvgl's native format
+ */
+void lv_font_free_glyph_id_lut_fmt_txt(const lv_font_t * font);
+
+/**
+ * Free the lookup tables of all fonts.
+ */
+void _lv_font_glyph_id_lut_deinit_fmt_txt(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -12,6 +12,8 @@
 
 #include "../lvgl.h"
 #include "../misc/lv_fs.h"
+#include "../misc/lv_lru.h"
+#include "../draw/sw/lv_draw_sw.h"
 #include "lv_font_loader.h"
 
 /**********************
@@ -60,11 +62,25 @@ typedef struct cmap_table_bin {
     uint8_t padding;
 } cmap_table_bin_t;
 
+/*Descriptor of the fonts loaded by `lv_font_load_lazy`*/
+typedef struct {
+    lv_font_fmt_txt_dsc_t dsc;      /*Has to be the first member*/
+    lv_fs_file_t file;              /*Kept open to read the glyph bitmaps*/
+    uint32_t glyph_start;           /*Start of the "glyf" table in the file*/
+    uint32_t * glyph_offset;        /*Offset of each glyph in the "glyf" table + the length of the table*/
+    uint32_t glyph_cnt;
+    uint8_t glyph_header_bits;      /*Bits before the bitmap in each glyph*/
+    lv_lru_t * bitmap_cache;        /*Recently used bitmaps. Key: glyph ID*/
+    uint8_t * bitmap_uncached;      /*The last bitmap which didn't fit into the cache*/
+} font_lazy_dsc_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_font_t * load_font(const char * font_name, bool lazy, uint32_t cache_size);
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp);
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font);
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool lazy);
+static const uint8_t * get_bitmap_lazy(const lv_font_t * font, uint32_t letter);
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
 
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
@@ -85,29 +101,19 @@ static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res
  */
 lv_font_t * lv_font_load(const char * font_name)
 {
-    lv_fs_file_t file;
-    lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
-    if(res != LV_FS_RES_OK)
-        return NULL;
-
-    lv_font_t * font = lv_malloc(sizeof(lv_font_t));
-    if(font) {
-        memset(font, 0, sizeof(lv_font_t));
-        if(!lvgl_load_font(&file, font)) {
-            LV_LOG_WARN("Error loading font file: %s\n", font_name);
-            /*
-            * When `lvgl_load_font` fails it can leak some pointers.
-            * All non-null pointers can be assumed as allocated and
-            * `lv_font_free` should free them correctly.
-            */
-            lv_font_free(font);
-            font = NULL;
-        }
-    }
-
-    lv_fs_close(&file);
+    return load_font(font_name, false, 0);
+}
 
-    return font;
+/**
+ * Loads a `lv_font_t` object from a binary font file but reads the glyph bitmaps only when they are used.
+ * The file is kept open until the font is freed and the recently used bitmaps are cached.
+ * @param font_name     filename where the font file is located
+ * @param cache_size    max. size of the cached bitmaps in bytes
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_lazy(const char * font_name, uint32_t cache_size)
+{
+    return load_font(font_name, true, cache_size);
 }
 
 /**
@@ -117,10 +123,22 @@ lv_font_t * lv_font_load(const char * font_name)
 void lv_font_free(lv_font_t * font)
 {
     if(NULL != font) {
+        lv_txt_size_cache_invalidate();
+#if LV_USE_DRAW_SW
+        lv_draw_sw_glyph_cache_invalidate();
+#endif
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
         if(NULL != dsc) {
 
+            if(font->get_glyph_bitmap == get_bitmap_lazy) {
+                font_lazy_dsc_t * lazy_dsc = (font_lazy_dsc_t *)dsc;
+                if(lazy_dsc->file.drv) lv_fs_close(&lazy_dsc->file);
+                if(lazy_dsc->bitmap_cache) lv_lru_del(lazy_dsc->bitmap_cache);
+                lv_free(lazy_dsc->bitmap_uncached);
+                lv_free(lazy_dsc->glyph_offset);
+            }
+
             if(dsc->kern_classes == 0) {
                 lv_font_fmt_txt_kern_pair_t * kern_dsc =
                     (lv_font_fmt_txt_kern_pair_t *)dsc->kern_dsc;
@@ -172,6 +190,12 @@ void lv_font_free(lv_font_t * font)
             if(NULL != dsc->glyph_dsc) {
                 lv_free((void *)dsc->glyph_dsc);
             }
+            if(NULL != dsc->cache) {
+#if LV_FONT_FMT_TXT_GLYPH_ID_LUT
+                lv_font_free_glyph_id_lut_fmt_txt(font);
+#endif
+                lv_free(dsc->cache);
+            }
             lv_free(dsc);
         }
         lv_free(font);
@@ -182,6 +206,51 @@ void lv_font_free(lv_font_t * font)
  *   STATIC FUNCTIONS
  **********************/
 
+static lv_font_t * load_font(const char * font_name, bool lazy, uint32_t cache_size)
+{
+    lv_fs_file_t file;
+    lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
+    if(res != LV_FS_RES_OK)
+        return NULL;
+
+    lv_font_t * font = lv_malloc(sizeof(lv_font_t));
+    if(font) {
+        memset(font, 0, sizeof(lv_font_t));
+        if(!lvgl_load_font(&file, font, lazy)) {
+            LV_LOG_WARN("Error loading font file: %s\n", font_name);
+            /*
+            * When `lvgl_load_font` fails it can leak some pointers.
+            * All non-null pointers can be assumed as allocated and
+            * `lv_font_free` should free them correctly.
+            */
+            lv_font_free(font);
+            font = NULL;
+        }
+        else {
+#if LV_FONT_FMT_TXT_GLYPH_ID_LUT
+            lv_font_build_glyph_id_lut_fmt_txt(font);
+#endif
+            if(lazy) {
+                font_lazy_dsc_t * lazy_dsc = (font_lazy_dsc_t *)font->dsc;
+                if(cache_size > 0) {
+                    /*Size the hash table of the cache for the average glyph*/
+                    uint32_t glyph_cnt = lazy_dsc->glyph_cnt;
+                    uint32_t avg_size = glyph_cnt ? lazy_dsc->glyph_offset[glyph_cnt] / glyph_cnt : 1;
+                    avg_size = LV_CLAMP(1, avg_size, cache_size);
+                    lazy_dsc->bitmap_cache = lv_lru_create(cache_size, avg_size, lv_free, lv_free);
+                }
+                /*The font owns the file from now on*/
+                lazy_dsc->file = file;
+                return font;
+            }
+        }
+    }
+
+    lv_fs_close(&file);
+
+    return font;
+}
+
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp)
 {
     bit_iterator_t it;
@@ -335,8 +404,55 @@ static int32_t load_cmaps(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, u
     return success ? cmaps_length : -1;
 }
 
+/**
+ * Read the bitmap of a glyph
+ * @param fp        the font file
+ * @param offset    offset of the glyph in the file
+ * @param nbits     number of bits before the bitmap in the glyph
+ * @param bmp       store the bitmap here
+ * @param bmp_size  size of the bitmap in bytes
+ * @return          true: success; false: read error
+ */
+static bool load_glyph_bitmap(lv_fs_file_t * fp, uint32_t offset, int nbits, uint8_t * bmp, int bmp_size)
+{
+    lv_fs_res_t res = lv_fs_seek(fp, offset, LV_FS_SEEK_SET);
+    if(res != LV_FS_RES_OK) {
+        return false;
+    }
+    bit_iterator_t bit_it = init_bit_iterator(fp);
+
+    read_bits(&bit_it, nbits, &res);
+    if(res != LV_FS_RES_OK) {
+        return false;
+    }
+
+    if(nbits % 8 == 0) {  /*Fast path*/
+        if(lv_fs_read(fp, bmp, bmp_size, NULL) != LV_FS_RES_OK) {
+            return false;
+        }
+    }
+    else {
+        for(int k = 0; k < bmp_size - 1; ++k) {
+            bmp[k] = read_bits(&bit_it, 8, &res);
+            if(res != LV_FS_RES_OK) {
+                return false;
+            }
+        }
+        bmp[bmp_size - 1] = read_bits(&bit_it, 8 - nbits % 8, &res);
+        if(res != LV_FS_RES_OK) {
+            return false;
+        }
+
+        /*The last fragment should be on the MSB but read_bits() will place it to the LSB*/
+        bmp[bmp_size - 1] = bmp[bmp_size - 1] << (nbits % 8);
+    }
+
+    return true;
+}
+
 static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
-                          uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header)
+                          uint32_t start, uint32_t * glyph_offset, uint32_t loca_count, font_header_bin_t * header,
+                          bool load_bitmaps)
 {
     int32_t glyph_length = read_label(fp, start, "glyf");
     if(glyph_length < 0) {
@@ -414,6 +530,11 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
         }
     }
 
+    /*The bitmaps will be read when they are used*/
+    if(!load_bitmaps) {
+        return glyph_length;
+    }
+
     uint8_t * glyph_bmp = (uint8_t *)lv_malloc(sizeof(uint8_t) * cur_bmp_size);
 
     font_dsc->glyph_bitmap = glyph_bmp;
@@ -421,46 +542,16 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
     cur_bmp_size = 0;
 
     for(unsigned int i = 1; i < loca_count; ++i) {
-        lv_fs_res_t res = lv_fs_seek(fp, start + glyph_offset[i], LV_FS_SEEK_SET);
-        if(res != LV_FS_RES_OK) {
-            return -1;
-        }
-        bit_iterator_t bit_it = init_bit_iterator(fp);
-
-        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
-
-        read_bits(&bit_it, nbits, &res);
-        if(res != LV_FS_RES_OK) {
-            return -1;
-        }
-
         if(glyph_dsc[i].box_w * glyph_dsc[i].box_h == 0) {
             continue;
         }
 
+        int nbits = header->advance_width_bits + 2 * header->xy_bits + 2 * header->wh_bits;
         int next_offset = (i < loca_count - 1) ? glyph_offset[i + 1] : (uint32_t)glyph_length;
         int bmp_size = next_offset - glyph_offset[i] - nbits / 8;
 
-        if(nbits % 8 == 0) {  /*Fast path*/
-            if(lv_fs_read(fp, &glyph_bmp[cur_bmp_size], bmp_size, NULL) != LV_FS_RES_OK) {
-                return -1;
-            }
-        }
-        else {
-            for(int k = 0; k < bmp_size - 1; ++k) {
-                glyph_bmp[cur_bmp_size + k] = read_bits(&bit_it, 8, &res);
-                if(res != LV_FS_RES_OK) {
-                    return -1;
-                }
-            }
-            glyph_bmp[cur_bmp_size + bmp_size - 1] = read_bits(&bit_it, 8 - nbits % 8, &res);
-            if(res != LV_FS_RES_OK) {
-                return -1;
-            }
-
-            /*The last fragment should be on the MSB but read_bits() will place it to the LSB*/
-            glyph_bmp[cur_bmp_size + bmp_size - 1] = glyph_bmp[cur_bmp_size + bmp_size - 1] << (nbits % 8);
-
+        if(!load_glyph_bitmap(fp, start + glyph_offset[i], nbits, &glyph_bmp[cur_bmp_size], bmp_size)) {
+            return -1;
         }
 
         cur_bmp_size += bmp_size;
@@ -480,14 +571,21 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
  * `lv_font_free` will assume that all non-null pointers are allocated and
  * should be freed.
  */
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool lazy)
 {
-    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)
-                                       lv_malloc(sizeof(lv_font_fmt_txt_dsc_t));
+    /*The lazy fonts' descriptor starts with a normal descriptor*/
+    size_t dsc_size = lazy ? sizeof(font_lazy_dsc_t) : sizeof(lv_font_fmt_txt_dsc_t);
+    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)lv_malloc(dsc_size);
+    if(font_dsc == NULL) return false;
 
-    memset(font_dsc, 0, sizeof(lv_font_fmt_txt_dsc_t));
+    memset(font_dsc, 0, dsc_size);
 
     font->dsc = font_dsc;
+    font_lazy_dsc_t * lazy_dsc = lazy ? (font_lazy_dsc_t *)font_dsc : NULL;
+
+    font_dsc->cache = lv_malloc(sizeof(lv_font_fmt_txt_glyph_cache_t));
+    if(font_dsc->cache == NULL) return false;
+    memset(font_dsc->cache, 0, sizeof(lv_font_fmt_txt_glyph_cache_t));
 
     /*header*/
     int32_t header_length = read_label(fp, 0, "head");
@@ -503,7 +601,7 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
     font->base_line = -font_header.descent;
     font->line_height = font_header.ascent - font_header.descent;
     font->get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
-    font->get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    font->get_glyph_bitmap = lazy ? get_bitmap_lazy : lv_font_get_bitmap_fmt_txt;
     font->subpx = font_header.subpixels_mode;
     font->underline_position = font_header.underline_position;
     font->underline_thickness = font_header.underline_thickness;
@@ -533,6 +631,10 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 
     bool failed = false;
     uint32_t * glyph_offset = lv_malloc(sizeof(uint32_t) * (loca_count + 1));
+    if(glyph_offset == NULL) return false;
+
+    /*The lazy fonts need the offsets to read the bitmaps later*/
+    if(lazy_dsc) lazy_dsc->glyph_offset = glyph_offset;
 
     if(font_header.index_to_loc_format == 0) {
         for(unsigned int i = 0; i < loca_count; ++i) {
@@ -555,16 +657,25 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
     }
 
     if(failed) {
-        lv_free(glyph_offset);
+        if(lazy_dsc == NULL) lv_free(glyph_offset);
         return false;
     }
 
     /*glyph*/
     uint32_t glyph_start = loca_start + loca_length;
     int32_t glyph_length = load_glyph(
-                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
-
-    lv_free(glyph_offset);
+                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header, lazy_dsc == NULL);
+
+    if(lazy_dsc) {
+        lazy_dsc->glyph_start = glyph_start;
+        lazy_dsc->glyph_cnt = loca_count;
+        lazy_dsc->glyph_header_bits = font_header.advance_width_bits + 2 * font_header.xy_bits +
+                                      2 * font_header.wh_bits;
+        glyph_offset[loca_count] = glyph_length;
+    }
+    else {
+        lv_free(glyph_offset);
+    }
 
     if(glyph_length < 0) {
         return false;
@@ -580,8 +691,98 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
     uint32_t kern_start = glyph_start + glyph_length;
 
     int32_t kern_length = load_kern(fp, font_dsc, font_header.glyph_id_format, kern_start);
+    if(kern_length < 0) {
+        return false;
+    }
+
+#if LV_FONT_LOADER_KERN_CLASSES_MAX_SIZE
+    /*Class based kerning is faster as it doesn't need to search in the pairs*/
+    lv_font_fmt_txt_kern_pair_t * kern_pair = (lv_font_fmt_txt_kern_pair_t *)font_dsc->kern_dsc;
+    if(font_dsc->kern_classes == 0 && kern_pair->pair_cnt > 0) {
+        lv_font_fmt_txt_kern_classes_t * kern_classes = lv_font_kern_pairs_to_classes_fmt_txt(kern_pair, loca_count,
+                                                                                                LV_FONT_LOADER_KERN_CLASSES_MAX_SIZE);
+        if(kern_classes) {
+            lv_free((void *)kern_pair->glyph_ids);
+            lv_free((void *)kern_pair->values);
+            lv_free(kern_pair);
+            font_dsc->kern_dsc = kern_classes;
+            font_dsc->kern_classes = 1;
+        }
+    }
+#endif
+
+    return true;
+}
+
+/*
+ * Used as `get_glyph_bitmap` callback of the fonts loaded by `lv_font_load_lazy`.
+ * Reads the bitmap of the glyph from the file if it's not cached.
+ * The bitmaps of compressed fonts are cached decompressed.
+ */
+static const uint8_t * get_bitmap_lazy(const lv_font_t * font, uint32_t letter)
+{
+    if(letter == '\t') letter = ' ';
+
+    font_lazy_dsc_t * lazy_dsc = (font_lazy_dsc_t *)font->dsc;
+    lv_font_fmt_txt_dsc_t * fdsc = &lazy_dsc->dsc;
+    uint32_t gid = lv_font_get_glyph_id_fmt_txt(font, letter);
+    if(gid == 0) return NULL;
+
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    if(gdsc->box_w * gdsc->box_h == 0) return NULL;
+
+    void * bitmap = NULL;
+    if(lazy_dsc->bitmap_cache) {
+        lv_lru_get(lazy_dsc->bitmap_cache, &gid, sizeof(gid), &bitmap);
+        if(bitmap) return bitmap;
+    }
+
+    LV_PROFILER_BEGIN;
+
+    int nbits = lazy_dsc->glyph_header_bits;
+    int bmp_size = lazy_dsc->glyph_offset[gid + 1] - lazy_dsc->glyph_offset[gid] - nbits / 8;
+    uint8_t * bmp = lv_malloc(bmp_size);
+    if(bmp == NULL) {
+        LV_PROFILER_END;
+        return NULL;
+    }
+
+    if(!load_glyph_bitmap(&lazy_dsc->file, lazy_dsc->glyph_start + lazy_dsc->glyph_offset[gid], nbits, bmp, bmp_size)) {
+        LV_LOG_WARN("Couldn't read the bitmap of glyph %" LV_PRIu32, gid);
+        lv_free(bmp);
+        LV_PROFILER_END;
+        return NULL;
+    }
+
+    if(fdsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) {
+#if LV_USE_FONT_COMPRESSED
+        uint32_t bpp = fdsc->bpp == 3 ? 4 : fdsc->bpp;
+        bmp_size = (gdsc->box_w * gdsc->box_h * bpp + 7) / 8;
+        uint8_t * bmp_decompr = lv_malloc(bmp_size);
+        if(bmp_decompr) lv_font_decompress_glyph_fmt_txt(fdsc, gdsc, bmp, bmp_decompr);
+        lv_free(bmp);
+        bmp = bmp_decompr;
+        if(bmp == NULL) {
+            LV_PROFILER_END;
+            return NULL;
+        }
+#else
+        LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
+        lv_free(bmp);
+        LV_PROFILER_END;
+        return NULL;
+#endif
+    }
+
+    /*The cache owns the bitmap if it fits*/
+    if(lazy_dsc->bitmap_cache == NULL ||
+       lv_lru_set(lazy_dsc->bitmap_cache, &gid, sizeof(gid), bmp, bmp_size) != LV_LRU_OK) {
+        lv_free(lazy_dsc->bitmap_uncached);
+        lazy_dsc->bitmap_uncached = bmp;
+    }
 
-    return kern_length >= 0;
+    LV_PROFILER_END;
+    return bmp;
 }
 
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start)
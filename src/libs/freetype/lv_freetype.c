@@ -217,6 +217,7 @@ void lv_freetype_font_del(lv_font_t * font)
     LV_ASSERT_NULL(font);
     lv_freetype_font_dsc_t * dsc = (lv_freetype_font_dsc_t *)(font->dsc);
     LV_ASSERT_NULL(dsc);
+    lv_txt_size_cache_invalidate();
     FTC_Manager_RemoveFaceID(ft_ctx.cache_manager, (FTC_FaceID)dsc);
     lv_free(dsc->pathname);
     lv_free(dsc);
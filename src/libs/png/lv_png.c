@@ -16,6 +16,11 @@
 /*********************
  *      DEFINES
  *********************/
+#if LV_DRAW_SW_PREMULTIPLIED_ALPHA
+    #define PNG_CF  LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED
+#else
+    #define PNG_CF  LV_COLOR_FORMAT_NATIVE_ALPHA
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -27,7 +32,7 @@
 static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
 static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
 static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
-static void convert_color_depth(uint8_t ** img_p, uint32_t px_cnt);
+static void convert_color_depth(uint8_t ** img_p, uint32_t px_cnt, lv_color_format_t cf);
 
 /**********************
  *  STATIC VARIABLES
@@ -91,7 +96,7 @@ static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * sr
 
             /*Save the data in the header*/
             header->always_zero = 0;
-            header->cf = LV_COLOR_FORMAT_NATIVE_ALPHA;
+            header->cf = PNG_CF;
             /*The width and height are stored in Big endian format so convert them to little endian*/
             header->w = (lv_coord_t)((size[0] & 0xff000000) >> 24) + ((size[0] & 0x00ff0000) >> 8);
             header->h = (lv_coord_t)((size[1] & 0xff000000) >> 24) + ((size[1] & 0x00ff0000) >> 8);
@@ -113,7 +118,7 @@ static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * sr
             header->cf = img_dsc->header.cf;       /*Save the color format*/
         }
         else {
-            header->cf = LV_COLOR_FORMAT_NATIVE_ALPHA;
+            header->cf = PNG_CF;
         }
 
         if(img_dsc->header.w) {
@@ -185,7 +190,7 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
             }
 
             /*Convert the image to the system's color depth*/
-            convert_color_depth(&img_data,  png_width * png_height);
+            convert_color_depth(&img_data,  png_width * png_height, dsc->header.cf);
             dsc->img_data = img_data;
             return LV_RES_OK;     /*The image is fully decoded. Return with its pointer*/
         }
@@ -207,7 +212,7 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
         }
 
         /*Convert the image to the system's color depth*/
-        convert_color_depth(&img_data,  png_width * png_height);
+        convert_color_depth(&img_data,  png_width * png_height, dsc->header.cf);
 
         dsc->img_data = img_data;
         return LV_RES_OK;     /*Return with its pointer*/
@@ -232,31 +237,31 @@ static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc
  * If the display is not in 32 bit format (ARGB888) then covert the image to the current color depth
  * @param img the ARGB888 image
  * @param px_cnt number of pixels in `img`
+ * @param cf the color format of the decoded image, `LV_COLOR_FORMAT_NATIVE_ALPHA` or its premultiplied variant
  */
-static void convert_color_depth(uint8_t ** img_p, uint32_t px_cnt)
+static void convert_color_depth(uint8_t ** img_p, uint32_t px_cnt, lv_color_format_t cf)
 {
     uint8_t * img = *img_p;
 
+    /*lodepng gives RGBA pixels. Work on whole words so the compiler can vectorize the loops*/
 #if LV_COLOR_DEPTH == 32 || LV_COLOR_DEPTH == 24
-    lv_color32_t * img_argb = (lv_color32_t *)img;
-    lv_color_t c;
-    lv_color_t * img_c = (lv_color_t *)img;
+    /*Swap the red and blue channels to get BGRA*/
+    uint32_t * img_rgba = (uint32_t *)img;
     uint32_t i;
     for(i = 0; i < px_cnt; i++) {
-        c = lv_color_make(img_argb[i].red, img_argb[i].green, img_argb[i].blue);
-        img_c[i].red = c.blue;
-        img_c[i].blue = c.red;
+        uint32_t c = img_rgba[i];
+        img_rgba[i] = (c & 0xFF00FF00) | ((c & 0x000000FF) << 16) | ((c >> 16) & 0x000000FF);
     }
 #elif LV_COLOR_DEPTH == 16
-    lv_color32_t * img_argb = (lv_color32_t *)img;
-    lv_color_t c;
+    /*Convert to RGB565 + alpha in place*/
+    const uint32_t * img_rgba = (const uint32_t *)img;
     uint32_t i;
     for(i = 0; i < px_cnt; i++) {
-        c = lv_color_make(img_argb[i].blue, img_argb[i].green, img_argb[i].red);
-        uint16_t c16 = lv_color_to_int(c);
-        img[i * 3 + 2] = img_argb[i].alpha;
-        img[i * 3 + 1] = c16 >> 8;
+        uint32_t c = img_rgba[i];
+        uint32_t c16 = ((c & 0xF8) << 8) | ((c >> 5) & 0x07E0) | ((c >> 19) & 0x1F);
         img[i * 3 + 0] = c16 & 0xFF;
+        img[i * 3 + 1] = c16 >> 8;
+        img[i * 3 + 2] = c >> 24;
     }
 #elif LV_COLOR_DEPTH == 8
     lv_color32_t * img_argb = (lv_color32_t *)img;
@@ -273,6 +278,9 @@ static void convert_color_depth(uint8_t ** img_p, uint32_t px_cnt)
     /*Reallocate memory to reduce memory usage*/
     *img_p = lv_realloc(img, LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE * px_cnt);
 #endif
+
+    /*Premultiply once here instead of normalizing the alpha on each draw*/
+    if(cf == LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED) lv_color_premultiply(*img_p, px_cnt);
 }
 
 #endif /*LV_USE_PNG*/
@@ -19,201 +19,160 @@
 #define STBTT_malloc(x,u)  ((void)(u),lv_malloc(x))
 #define STBTT_free(x,u)    ((void)(u),lv_free(x))
 #define TTF_CACHE_MALLOC(x)  (lv_malloc(x))
-#define TTF_CACHE_REALLOC(x,y)  (lv_realloc(x,y))
 #define TTF_CACHE_FREE(x)    (lv_free(x))
 #define TTF_MALLOC(x)  (lv_malloc(x))
 #define TTF_FREE(x)    (lv_free(x))
-typedef void * ttf_cache_handle_t;
+
+// a glyph of a given size. its metrics are cached when it's measured and its bitmap when it's drawn.
 typedef struct ttf_cache_entry {
-    int key;
-    unsigned long long age;
-    int size;
-    void * data;
+    struct ttf_cache_entry * hash_next; // next entry in the same bucket
+    struct ttf_cache_entry * lru_prev;  // more recently used entry
+    struct ttf_cache_entry * lru_next;  // less recently used entry
+    uint32_t letter;
+    lv_coord_t line_height;
+    int glyph_index;
+    int adv_w;                          // unscaled advance width
+    lv_coord_t box_w;
+    lv_coord_t box_h;
+    lv_coord_t ofs_x;
+    lv_coord_t ofs_y;
+    uint8_t * bitmap;                   // NULL until the glyph is drawn
 } ttf_cache_entry_t;
-typedef struct ttf_cache_bucket {
-    int capacity;
-    ttf_cache_entry_t * entries;
-} ttf_cache_bucket_t;
 
+// hash table of the entries + a list of them in the order of use to find the least recently used one in O(1)
 typedef struct ttf_cache {
-    int max_size;
-    int bucket_size;
-    int total_size;
-    unsigned long long age;
-    ttf_cache_bucket_t * buckets;
+    size_t max_size;
+    size_t total_size;
+    uint32_t bucket_cnt;                // power of 2
+    ttf_cache_entry_t ** buckets;
+    ttf_cache_entry_t * lru_head;       // most recently used entry
+    ttf_cache_entry_t * lru_tail;       // least recently used entry, removed first
+    uint32_t entry_cnt;
+    uint32_t hit_cnt;
+    uint32_t miss_cnt;
 } ttf_cache_t;
 
-static unsigned long long ttf_cache_get_oldest_age(ttf_cache_handle_t * handle)
-{
-    ttf_cache_t * cache = (ttf_cache_t *)handle;
-    unsigned long long result = (unsigned long long) - 1;
-    for(int i = 0; i < cache->bucket_size; ++i) {
-        ttf_cache_bucket_t * bucket = &cache->buckets[i];
-        if(bucket->entries != NULL) {
-            for(int j = 0; j < bucket->capacity; ++j) {
-                ttf_cache_entry_t * entry = &bucket->entries[j];
-                if(entry->age != 0 && entry->age < result) {
-                    result = entry->age;
-                }
-            }
-        }
-    }
-    if(result == (unsigned long long) - 1) {
-        return 0;
-    }
-    return result;
-}
-static ttf_cache_handle_t ttf_cache_create(int max_size, int buckets)
+static ttf_cache_t * ttf_cache_create(size_t max_size)
 {
-    ttf_cache_t * result = (ttf_cache_t *)TTF_CACHE_MALLOC(sizeof(ttf_cache_t));
-    if(result == NULL) {
+    ttf_cache_t * cache = (ttf_cache_t *)TTF_CACHE_MALLOC(sizeof(ttf_cache_t));
+    if(cache == NULL) {
         return NULL;
     }
-    result->age = 1;
-    result->max_size = max_size;
-    result->total_size = 0;
-    result->bucket_size = buckets;
-    result->buckets = (ttf_cache_bucket_t *)TTF_CACHE_MALLOC(buckets * sizeof(ttf_cache_bucket_t));
-    if(result->buckets == NULL) {
-        TTF_CACHE_FREE(result);
+    lv_memzero(cache, sizeof(ttf_cache_t));
+    cache->max_size = max_size;
+    // about one entry per bucket with small glyphs
+    uint32_t bucket_cnt = LV_MAX(LV_TINY_TTF_CACHE_BUCKETS, max_size / 256);
+    cache->bucket_cnt = 1;
+    while(cache->bucket_cnt < bucket_cnt) {
+        cache->bucket_cnt <<= 1;
+    }
+    cache->buckets = (ttf_cache_entry_t **)TTF_CACHE_MALLOC(cache->bucket_cnt * sizeof(ttf_cache_entry_t *));
+    if(cache->buckets == NULL) {
+        TTF_CACHE_FREE(cache);
         return NULL;
     }
-    for(int i = 0; i < buckets; ++i) {
-        result->buckets[i].capacity = 0;
-        result->buckets[i].entries = NULL;
-    }
-    return result;
+    lv_memzero(cache->buckets, cache->bucket_cnt * sizeof(ttf_cache_entry_t *));
+    return cache;
 }
-static void * ttf_cache_get(ttf_cache_handle_t handle, int key)
+static ttf_cache_entry_t ** ttf_cache_get_bucket(ttf_cache_t * cache, uint32_t letter, lv_coord_t line_height)
 {
-    if(handle == NULL) {
-        return NULL;
-    }
-    ttf_cache_t * cache = (ttf_cache_t *)handle;
-    int ci = key % cache->bucket_size;
-    ttf_cache_bucket_t * bucket = &cache->buckets[ci];
-    for(int i = 0; i < bucket->capacity; ++i) {
-        ttf_cache_entry_t * entry = &bucket->entries[i];
-        if(entry->age != 0 && entry->key == key) {
-            entry->age = ++cache->age;
-            return entry->data;
-        }
-    }
-    return NULL;
+    uint32_t hash = (letter ^ ((uint32_t)line_height << 20)) * 2654435761u;
+    return &cache->buckets[(hash >> 16) & (cache->bucket_cnt - 1)];
 }
-static void * ttf_cache_add(ttf_cache_handle_t handle, int key, int size)
+static void ttf_cache_lru_unlink(ttf_cache_t * cache, ttf_cache_entry_t * entry)
 {
-    if(handle == NULL) {
-        return NULL;
-    }
-    ttf_cache_t * cache = (ttf_cache_t *)handle;
-    int ci = key % cache->bucket_size;
-    ttf_cache_bucket_t * bucket = &cache->buckets[ci];
-    for(int i = 0; i < bucket->capacity; ++i) {
-        ttf_cache_entry_t * entry = &bucket->entries[i];
-        if(entry->age != 0 && entry->key == key) {
-            TTF_CACHE_FREE(entry->data);
-            cache->total_size -= entry->size;
-            entry->age = 0;
-            break;
-        }
+    if(entry->lru_prev) entry->lru_prev->lru_next = entry->lru_next;
+    else cache->lru_head = entry->lru_next;
+    if(entry->lru_next) entry->lru_next->lru_prev = entry->lru_prev;
+    else cache->lru_tail = entry->lru_prev;
+}
+static void ttf_cache_lru_push(ttf_cache_t * cache, ttf_cache_entry_t * entry)
+{
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_head;
+    if(cache->lru_head) cache->lru_head->lru_prev = entry;
+    else cache->lru_tail = entry;
+    cache->lru_head = entry;
+}
+static void ttf_cache_remove(ttf_cache_t * cache, ttf_cache_entry_t * entry)
+{
+    ttf_cache_entry_t ** next_p = ttf_cache_get_bucket(cache, entry->letter, entry->line_height);
+    while(*next_p != entry) {
+        next_p = &(*next_p)->hash_next;
     }
-    while(cache->total_size > 0 && (cache->max_size < cache->total_size + size)) {
-        // expire entries
-        unsigned long long oldest = ttf_cache_get_oldest_age(handle);
-        if(oldest == 0) {
-            break;
-        }
-        for(int i = 0; i < cache->bucket_size; ++i) {
-            ttf_cache_bucket_t * bucket2 = &cache->buckets[i];
-            for(int j = 0; j < bucket2->capacity; ++j) {
-                ttf_cache_entry_t * entry = &bucket2->entries[j];
-                if(entry->age == oldest) {
-                    if(entry->data != NULL) {
-                        TTF_CACHE_FREE(entry->data);
-                        entry->data = NULL;
-                        entry->age = 0;
-                        cache->total_size -= entry->size;
-                        entry->size = 0;
-                        i = cache->bucket_size;
-                        break;
-                    }
-                }
-            }
-        }
+    *next_p = entry->hash_next;
+    ttf_cache_lru_unlink(cache, entry);
+
+    cache->total_size -= sizeof(ttf_cache_entry_t);
+    if(entry->bitmap) {
+        cache->total_size -= entry->box_w * entry->box_h;
+        TTF_CACHE_FREE(entry->bitmap);
     }
-    if(bucket->entries == NULL) {
-        bucket->capacity = 4;
-        bucket->entries = (ttf_cache_entry_t *)TTF_CACHE_MALLOC(sizeof(ttf_cache_entry_t) * bucket->capacity);
-        if(bucket->entries == NULL) {
-            return NULL;
-        }
-        for(int i = 0; i < bucket->capacity; ++i) {
-            bucket->entries[i].age = 0;
-            bucket->entries[i].data = NULL;
-            bucket->entries[i].size = 0;
-        }
+    cache->entry_cnt--;
+    TTF_CACHE_FREE(entry);
+}
+// remove the least recently used entries until the cache fits into its max. size. `keep` is never removed.
+static void ttf_cache_shrink(ttf_cache_t * cache, ttf_cache_entry_t * keep)
+{
+    while(cache->total_size > cache->max_size && cache->lru_tail != NULL && cache->lru_tail != keep) {
+        ttf_cache_remove(cache, cache->lru_tail);
     }
-    for(int i = 0; i < bucket->capacity; ++i) {
-        ttf_cache_entry_t * entry = &bucket->entries[i];
-        if(entry->age == 0) {
-            entry->data = TTF_CACHE_MALLOC(size);
-            if(entry->data == NULL) {
-                return NULL;
+}
+static ttf_cache_entry_t * ttf_cache_get(ttf_cache_t * cache, uint32_t letter, lv_coord_t line_height)
+{
+    ttf_cache_entry_t * entry = *ttf_cache_get_bucket(cache, letter, line_height);
+    while(entry != NULL) {
+        if(entry->letter == letter && entry->line_height == line_height) {
+            if(entry != cache->lru_head) {
+                ttf_cache_lru_unlink(cache, entry);
+                ttf_cache_lru_push(cache, entry);
             }
-            entry->size = size;
-            entry->age = cache->age;
-            entry->key = key;
-            cache->total_size += size;
-            return entry->data;
+            cache->hit_cnt++;
+            return entry;
         }
+        entry = entry->hash_next;
     }
-    int newcap = bucket->capacity * 2;
-    ttf_cache_entry_t * te = (ttf_cache_entry_t *)TTF_CACHE_REALLOC(bucket->entries, sizeof(ttf_cache_entry_t) * newcap);
-    if(te == NULL) {
-        return NULL;
-    }
-    bucket->entries = te;
-    for(int i = bucket->capacity; i < newcap; ++i) {
-        bucket->entries[i].age = 0;
-        bucket->entries[i].data = NULL;
-        bucket->entries[i].size = 0;
-    }
-    void * result = TTF_CACHE_MALLOC(size);
-    bucket->entries[bucket->capacity].data = result;
-    if(result == NULL) {
+    cache->miss_cnt++;
+    return NULL;
+}
+// add an entry without bitmap. the caller fills its metrics.
+static ttf_cache_entry_t * ttf_cache_add(ttf_cache_t * cache, uint32_t letter, lv_coord_t line_height)
+{
+    ttf_cache_entry_t * entry = (ttf_cache_entry_t *)TTF_CACHE_MALLOC(sizeof(ttf_cache_entry_t));
+    if(entry == NULL) {
         return NULL;
     }
-    bucket->entries[bucket->capacity].size = size;
-    bucket->entries[bucket->capacity].age = cache->age;
-    bucket->entries[bucket->capacity].key = key;
-    bucket->capacity = newcap;
-    return result;
-}
+    lv_memzero(entry, sizeof(ttf_cache_entry_t));
+    entry->letter = letter;
+    entry->line_height = line_height;
 
-static void ttf_cache_clear(ttf_cache_handle_t handle)
+    ttf_cache_entry_t ** bucket = ttf_cache_get_bucket(cache, letter, line_height);
+    entry->hash_next = *bucket;
+    *bucket = entry;
+    ttf_cache_lru_push(cache, entry);
+    cache->entry_cnt++;
+    cache->total_size += sizeof(ttf_cache_entry_t);
+    ttf_cache_shrink(cache, entry);
+    return entry;
+}
+static uint8_t * ttf_cache_alloc_bitmap(ttf_cache_t * cache, ttf_cache_entry_t * entry)
 {
-    if(handle == NULL) {
-        return;
-    }
-    ttf_cache_t * cache = (ttf_cache_t *)handle;
-    for(int i = 0; i < cache->bucket_size; ++i) {
-        ttf_cache_bucket_t * bucket = &cache->buckets[i];
-        if(bucket->entries != NULL) {
-            for(int j = 0; j < bucket->capacity; ++j) {
-                ttf_cache_entry_t * entry = &bucket->entries[j];
-                if(entry->age != 0 && entry->data != NULL) {
-                    TTF_CACHE_FREE(entry->data);
-                }
-            }
-            TTF_CACHE_FREE(cache->buckets[i].entries);
-        }
+    size_t size = entry->box_w * entry->box_h;
+    entry->bitmap = (uint8_t *)TTF_CACHE_MALLOC(size);
+    if(entry->bitmap == NULL) {
+        return NULL;
     }
+    cache->total_size += size;
+    ttf_cache_shrink(cache, entry);
+    return entry->bitmap;
 }
-static void ttf_cache_destroy(ttf_cache_handle_t handle)
+static void ttf_cache_destroy(ttf_cache_t * cache)
 {
-    ttf_cache_clear(handle);
-    TTF_CACHE_FREE((ttf_cache_t *)handle);
+    while(cache->lru_tail != NULL) {
+        ttf_cache_remove(cache, cache->lru_tail);
+    }
+    TTF_CACHE_FREE(cache->buckets);
+    TTF_CACHE_FREE(cache);
 }
 #if LV_TINY_TTF_FILE_SUPPORT !=0
 // a hydra stream that can be in memory or from a file
@@ -261,7 +220,8 @@ static void ttf_cb_stream_seek(ttf_cb_stream_t * stream, size_t position)
 #include "stb_rect_pack.h"
 #include "stb_truetype_htcw.h"
 
-typedef struct ttf_font_desc {
+// the parsed font file. shared by the fonts of different sizes created from it.
+typedef struct ttf_face {
     lv_fs_file_t file;
 #if LV_TINY_TTF_FILE_SUPPORT !=0
     ttf_cb_stream_t stream;
@@ -269,12 +229,42 @@ typedef struct ttf_font_desc {
     const uint8_t * stream;
 #endif
     stbtt_fontinfo info;
-    ttf_cache_handle_t cache;
-    float scale;
+    ttf_cache_t * cache;
     int ascent;
     int descent;
+    uint32_t ref_cnt;
+} ttf_face_t;
+
+typedef struct ttf_font_desc {
+    ttf_face_t * face;
+    float scale;
 } ttf_font_desc_t;
 
+// get the cache entry of a letter with the current size of the font. measure the glyph if it's not cached.
+static ttf_cache_entry_t * ttf_get_glyph(const lv_font_t * font, uint32_t unicode_letter)
+{
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
+    ttf_face_t * face = dsc->face;
+    ttf_cache_entry_t * entry = ttf_cache_get(face->cache, unicode_letter, font->line_height);
+    if(entry != NULL) {
+        return entry;
+    }
+
+    entry = ttf_cache_add(face->cache, unicode_letter, font->line_height);
+    if(entry == NULL) {
+        return NULL;
+    }
+    int x1, y1, x2, y2, lsb;
+    entry->glyph_index = stbtt_FindGlyphIndex(&face->info, (int)unicode_letter);
+    stbtt_GetGlyphBitmapBox(&face->info, entry->glyph_index, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
+    stbtt_GetGlyphHMetrics(&face->info, entry->glyph_index, &entry->adv_w, &lsb);
+    entry->box_w = (lv_coord_t)(x2 - x1 + 1);
+    entry->box_h = (lv_coord_t)(y2 - y1 + 1);
+    entry->ofs_x = (lv_coord_t)x1;
+    entry->ofs_y = (lv_coord_t)(-y2);
+    return entry;
+}
+
 static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                  uint32_t unicode_letter_next)
 {
@@ -291,52 +281,93 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
         return true;
     }
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    int g1 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter);
-    int x1, y1, x2, y2;
-
-    stbtt_GetGlyphBitmapBox(&dsc->info, g1, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
-    int g2 = 0;
-    if(unicode_letter_next != 0) {
-        g2 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter_next);
-    }
-    int advw, lsb;
-    stbtt_GetGlyphHMetrics(&dsc->info, g1, &advw, &lsb);
-    int k = stbtt_GetGlyphKernAdvance(&dsc->info, g1, g2);
-    dsc_out->adv_w = (uint16_t)floor((((float)advw + (float)k) * dsc->scale) +
-                                     0.5f); /*Horizontal space required by the glyph in [px]*/
+    const stbtt_fontinfo * info = &dsc->face->info;
+    ttf_cache_entry_t * entry = ttf_get_glyph(font, unicode_letter);
+    if(entry == NULL) {
+        return false;
+    }
+    int g1 = entry->glyph_index;
+    int advw = entry->adv_w;
+    dsc_out->box_w = entry->box_w;                                /*width of the bitmap in [px]*/
+    dsc_out->box_h = entry->box_h;                                /*height of the bitmap in [px]*/
+    dsc_out->ofs_x = entry->ofs_x;                                /*X offset of the bitmap in [pf]*/
+    dsc_out->ofs_y = entry->ofs_y; /*Y offset of the bitmap measured from the as line*/
+    dsc_out->bpp = 8;     /*Bits per pixel: 1/2/4/8*/
+    dsc_out->is_placeholder = false;
 
+    // `entry` might be removed from the cache when the next glyph is added
+    int k = 0;
+    if(info->kern || info->gpos) {
+        int g2 = 0;
+        if(unicode_letter_next != 0) {
+            ttf_cache_entry_t * entry_next = ttf_get_glyph(font, unicode_letter_next);
+            g2 = entry_next ? entry_next->glyph_index : stbtt_FindGlyphIndex(info, (int)unicode_letter_next);
+        }
+        k = stbtt_GetGlyphKernAdvance(info, g1, g2);
+    }
     dsc_out->adv_w = (uint16_t)floor((((float)advw + (float)k) * dsc->scale) +
                                      0.5f); /*Horizontal space required by the glyph in [px]*/
-    dsc_out->box_w = (x2 - x1 + 1);                                /*width of the bitmap in [px]*/
-    dsc_out->box_h = (y2 - y1 + 1);                                /*height of the bitmap in [px]*/
-    dsc_out->ofs_x = x1;                                           /*X offset of the bitmap in [pf]*/
-    dsc_out->ofs_y = -y2; /*Y offset of the bitmap measured from the as line*/
-    dsc_out->bpp = 8;     /*Bits per pixel: 1/2/4/8*/
-    dsc_out->is_placeholder = false;
     return true;          /*true: glyph found; false: glyph was not found*/
 }
 
 static const uint8_t * ttf_get_glyph_bitmap_cb(const lv_font_t * font, uint32_t unicode_letter)
 {
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    const stbtt_fontinfo * info = (const stbtt_fontinfo *)&dsc->info;
-    uint8_t * buffer = (uint8_t *)ttf_cache_get(dsc->cache, unicode_letter);
-    if(buffer == NULL) {
-        int g1 = stbtt_FindGlyphIndex(info, (int)unicode_letter);
-        int x1, y1, x2, y2;
-        stbtt_GetGlyphBitmapBox(info, g1, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
-        int w, h;
-        w = x2 - x1 + 1;
-        h = y2 - y1 + 1;
-        int buffer_size = w * h;
-        buffer = ttf_cache_add(dsc->cache, unicode_letter, buffer_size);
+    ttf_face_t * face = dsc->face;
+    ttf_cache_entry_t * entry = ttf_get_glyph(font, unicode_letter);
+    if(entry == NULL) {
+        return NULL;
+    }
+    if(entry->bitmap == NULL) {
+        uint8_t * buffer = ttf_cache_alloc_bitmap(face->cache, entry);
         if(buffer == NULL) {
             return NULL;
         }
-        memset(buffer, 0, buffer_size);
-        stbtt_MakeGlyphBitmap(info, buffer, w, h, w, dsc->scale, dsc->scale, g1);
+        memset(buffer, 0, entry->box_w * entry->box_h);
+        stbtt_MakeGlyphBitmap(&face->info, buffer, entry->box_w, entry->box_h, entry->box_w, dsc->scale, dsc->scale,
+                              entry->glyph_index);
+    }
+    return entry->bitmap; /*Or NULL if not found*/
+}
+
+static void ttf_face_release(ttf_face_t * face)
+{
+    face->ref_cnt--;
+    if(face->ref_cnt > 0) {
+        return;
+    }
+    ttf_cache_destroy(face->cache);
+#if LV_TINY_TTF_FILE_SUPPORT !=0
+    if(face->stream.file != NULL) {
+        lv_fs_close(&face->file);
     }
-    return buffer; /*Or NULL if not found*/
+#endif
+    TTF_FREE(face);
+}
+
+static lv_font_t * ttf_font_create(ttf_face_t * face, lv_coord_t line_height)
+{
+    lv_font_t * out_font = (lv_font_t *)TTF_MALLOC(sizeof(lv_font_t));
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)TTF_MALLOC(sizeof(ttf_font_desc_t));
+    if(out_font == NULL || dsc == NULL) {
+        TTF_FREE(out_font);
+        TTF_FREE(dsc);
+        LV_LOG_ERROR("tiny_ttf: out of memory\n");
+        return NULL;
+    }
+    face->ref_cnt++;
+    dsc->face = face;
+    dsc->scale = stbtt_ScaleForPixelHeight(&face->info, line_height);
+    out_font->line_height = line_height;
+    out_font->fallback = NULL;
+    out_font->dsc = dsc;
+    out_font->base_line = line_height - (lv_coord_t)(face->ascent * dsc->scale);
+    out_font->underline_position = (uint8_t)line_height - face->descent;
+    out_font->underline_thickness = 0;
+    out_font->subpx = 0;
+    out_font->get_glyph_dsc = ttf_get_glyph_dsc_cb;
+    out_font->get_glyph_bitmap = ttf_get_glyph_bitmap_cb;
+    return out_font;
 }
 
 static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size_t data_size,  lv_coord_t line_height,
@@ -350,72 +381,61 @@ static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size
     if(cache_size < 1) {
         cache_size = LV_TINY_TTF_DEFAULT_CACHE_SIZE;
     }
-    ttf_font_desc_t * dsc = (ttf_font_desc_t *)TTF_MALLOC(sizeof(ttf_font_desc_t));
-    if(dsc == NULL) {
+    ttf_face_t * face = (ttf_face_t *)TTF_MALLOC(sizeof(ttf_face_t));
+    if(face == NULL) {
         LV_LOG_ERROR("tiny_ttf: out of memory\n");
         return NULL;
     }
-    dsc->cache = ttf_cache_create(cache_size, LV_TINY_TTF_CACHE_BUCKETS);
-    if(dsc->cache == NULL) {
+    lv_memzero(face, sizeof(ttf_face_t));
+    face->cache = ttf_cache_create(cache_size);
+    if(face->cache == NULL) {
         LV_LOG_ERROR("tiny_ttf: out of memory\n");
-        TTF_FREE(dsc);
+        TTF_FREE(face);
         return NULL;
     }
 #if LV_TINY_TTF_FILE_SUPPORT !=0
     if(path != NULL) {
-        if(LV_FS_RES_OK != lv_fs_open(&dsc->file, path, LV_FS_MODE_RD)) {
-            ttf_cache_destroy(dsc->cache);
-            TTF_FREE(dsc);
+        if(LV_FS_RES_OK != lv_fs_open(&face->file, path, LV_FS_MODE_RD)) {
+            ttf_cache_destroy(face->cache);
+            TTF_FREE(face);
             LV_LOG_ERROR("tiny_ttf: unable to open %s\n", path);
             return NULL;
         }
-        dsc->stream.file = &dsc->file;
+        face->stream.file = &face->file;
     }
     else {
-        dsc->stream.file = NULL;
-        dsc->stream.data = (const uint8_t *)data;
-        dsc->stream.size = data_size;
-        dsc->stream.position = 0;
-    }
-    if(0 == stbtt_InitFont(&dsc->info, &dsc->stream, stbtt_GetFontOffsetForIndex(&dsc->stream, 0))) {
-        ttf_cache_destroy(dsc->cache);
-        TTF_FREE(dsc);
-
+        face->stream.file = NULL;
+        face->stream.data = (const uint8_t *)data;
+        face->stream.size = data_size;
+        face->stream.position = 0;
+    }
+    if(0 == stbtt_InitFont(&face->info, &face->stream, stbtt_GetFontOffsetForIndex(&face->stream, 0))) {
+        face->ref_cnt = 1;
+        ttf_face_release(face);
         LV_LOG_ERROR("tiny_ttf: init failed\n");
         return NULL;
     }
 
 #else
-    dsc->stream = (const uint8_t *)data;
-    if(0 == stbtt_InitFont(&dsc->info, dsc->stream, stbtt_GetFontOffsetForIndex(dsc->stream, 0))) {
-        ttf_cache_destroy(dsc->cache);
-        TTF_FREE(dsc);
+    face->stream = (const uint8_t *)data;
+    if(0 == stbtt_InitFont(&face->info, face->stream, stbtt_GetFontOffsetForIndex(face->stream, 0))) {
+        ttf_cache_destroy(face->cache);
+        TTF_FREE(face);
         LV_LOG_ERROR("tiny_ttf: init failed\n");
         return NULL;
     }
 
 #endif
 
-    float scale = stbtt_ScaleForPixelHeight(&dsc->info, line_height);
-    lv_font_t * out_font = (lv_font_t *)TTF_MALLOC(sizeof(lv_font_t));
+    int line_gap;
+    stbtt_GetFontVMetrics(&face->info, &face->ascent, &face->descent, &line_gap);
+
+    lv_font_t * out_font = ttf_font_create(face, line_height);
     if(out_font == NULL) {
-        ttf_cache_destroy(dsc->cache);
-        TTF_FREE(dsc);
-        LV_LOG_ERROR("tiny_ttf: out of memory\n");
+        face->ref_cnt = 1;
+        ttf_face_release(face);
         return NULL;
     }
-    out_font->line_height = line_height;
-    out_font->fallback = NULL;
-    out_font->dsc = dsc;
-    int line_gap;
-    stbtt_GetFontVMetrics(&dsc->info, &dsc->ascent, &dsc->descent, &line_gap);
-    dsc->scale = scale;
-    out_font->base_line = line_height - (lv_coord_t)(dsc->ascent * scale);
-    out_font->underline_position = (uint8_t)line_height - dsc->descent;
-    out_font->underline_thickness = 0;
-    out_font->subpx = 0;
-    out_font->get_glyph_dsc = ttf_get_glyph_dsc_cb;
-    out_font->get_glyph_bitmap = ttf_get_glyph_bitmap_cb;
     return out_font;
 }
 #if LV_TINY_TTF_FILE_SUPPORT !=0
@@ -436,29 +456,42 @@ lv_font_t * lv_tiny_ttf_create_data(const void * data, size_t data_size, lv_coor
 {
     return lv_tiny_ttf_create(NULL, data, data_size, line_height, 0);
 }
+lv_font_t * lv_tiny_ttf_create_shared(const lv_font_t * font, lv_coord_t line_height)
+{
+    if(font == NULL || font->dsc == NULL || 0 >= line_height) {
+        LV_LOG_ERROR("tiny_ttf: invalid argument\n");
+        return NULL;
+    }
+    return ttf_font_create(((ttf_font_desc_t *)font->dsc)->face, line_height);
+}
 void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t line_height)
 {
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
     if(line_height > 0) {
+        // the cached glyphs of the old size are kept as other fonts of the face might use them
         font->line_height = line_height;
-        dsc->scale = stbtt_ScaleForPixelHeight(&dsc->info, line_height);
-        font->base_line = line_height - (lv_coord_t)(dsc->ascent * dsc->scale);
-        font->underline_position = (uint8_t)line_height - dsc->descent;
-        ttf_cache_clear(dsc->cache);
+        dsc->scale = stbtt_ScaleForPixelHeight(&dsc->face->info, line_height);
+        font->base_line = line_height - (lv_coord_t)(dsc->face->ascent * dsc->scale);
+        font->underline_position = (uint8_t)line_height - dsc->face->descent;
+        lv_txt_size_cache_invalidate();
     }
 }
+void lv_tiny_ttf_get_cache_stat(const lv_font_t * font, lv_tiny_ttf_cache_stat_t * stat)
+{
+    const ttf_cache_t * cache = ((ttf_font_desc_t *)font->dsc)->face->cache;
+    stat->hit_cnt = cache->hit_cnt;
+    stat->miss_cnt = cache->miss_cnt;
+    stat->entry_cnt = cache->entry_cnt;
+    stat->size = cache->total_size;
+}
 void lv_tiny_ttf_destroy(lv_font_t * font)
 {
     if(font != NULL) {
+        lv_txt_size_cache_invalidate();
         if(font->dsc != NULL) {
-            ttf_font_desc_t * ttf = (ttf_font_desc_t *)font->dsc;
-            ttf_cache_destroy(ttf->cache);
-#if LV_TINY_TTF_FILE_SUPPORT !=0
-            if(ttf->stream.file != NULL) {
-                lv_fs_close(&ttf->file);
-            }
-#endif
-            TTF_FREE(ttf);
+            ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
+            ttf_face_release(dsc->face);
+            TTF_FREE(dsc);
         }
         TTF_FREE(font);
     }
@@ -25,6 +25,13 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    uint32_t hit_cnt;       /*Number of glyph lookups found in the cache*/
+    uint32_t miss_cnt;      /*Number of glyph lookups not found in the cache*/
+    uint32_t entry_cnt;     /*Number of cached glyphs*/
+    size_t size;            /*Current size of the cache in bytes*/
+} lv_tiny_ttf_cache_stat_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -42,9 +49,15 @@ lv_font_t * lv_tiny_ttf_create_data(const void * data, size_t data_size, lv_coor
 // create a font from the specified data pointer with the specified line height and the specified cache size.
 lv_font_t * lv_tiny_ttf_create_data_ex(const void * data, size_t data_size, lv_coord_t line_height, size_t cache_size);
 
+// create a font with an other line height which shares the parsed font data and the glyph cache with `font`.
+lv_font_t * lv_tiny_ttf_create_shared(const lv_font_t * font, lv_coord_t line_height);
+
 // set the size of the font to a new line_height
 void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t line_height);
 
+// get the statistics of the glyph cache of the font. it's shared by the fonts created with lv_tiny_ttf_create_shared().
+void lv_tiny_ttf_get_cache_stat(const lv_font_t * font, lv_tiny_ttf_cache_stat_t * stat);
+
 // destroy a font previously created with lv_tiny_ttf_create_xxxx()
 void lv_tiny_ttf_destroy(lv_font_t * font);
 
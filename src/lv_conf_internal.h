@@ -366,6 +366,29 @@
     #endif
 #endif
 
+/*Keep the buffers of the destroyed layers (for `style_opa < 255`, transformations, etc)
+ *to reuse them for the next layers instead of allocating new ones.
+ *The software renderer takes the mask buffers of the letters from here too.
+ *It's the default budget of each display, see `lv_draw_layer_buf_pool_set_size()`. 0: to disable keeping buffers*/
+#ifndef LV_DRAW_LAYER_BUF_POOL_SIZE
+    #ifdef CONFIG_LV_DRAW_LAYER_BUF_POOL_SIZE
+        #define LV_DRAW_LAYER_BUF_POOL_SIZE CONFIG_LV_DRAW_LAYER_BUF_POOL_SIZE
+    #else
+        #define LV_DRAW_LAYER_BUF_POOL_SIZE 0     /*[bytes]*/
+    #endif
+#endif
+
+/*Memory budget in bytes for the objects with `LV_OBJ_FLAG_CACHE_LAYER`.
+ *Such objects are rendered with their children into a layer only once,
+ *and it's blended again until something changes in them. 0: to disable caching*/
+#ifndef LV_OBJ_LAYER_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_LAYER_CACHE_SIZE
+        #define LV_OBJ_LAYER_CACHE_SIZE CONFIG_LV_OBJ_LAYER_CACHE_SIZE
+    #else
+        #define LV_OBJ_LAYER_CACHE_SIZE 0
+    #endif
+#endif
+
 #ifndef LV_USE_DRAW_SW
     #ifdef _LV_KCONFIG_PRESENT
         #ifdef CONFIG_LV_USE_DRAW_SW
@@ -416,6 +439,17 @@
         #endif
     #endif
 
+    /*Store the colors multiplied by the alpha in layers, ARGB draw buffers and decoded PNG images.
+     *Blending onto such buffers needs no division per pixel and premultiplied images can be blended directly.
+     *The buffers are converted back to straight alpha when flushed or transformed.*/
+    #ifndef LV_DRAW_SW_PREMULTIPLIED_ALPHA
+        #ifdef CONFIG_LV_DRAW_SW_PREMULTIPLIED_ALPHA
+            #define LV_DRAW_SW_PREMULTIPLIED_ALPHA CONFIG_LV_DRAW_SW_PREMULTIPLIED_ALPHA
+        #else
+            #define LV_DRAW_SW_PREMULTIPLIED_ALPHA 0
+        #endif
+    #endif
+
     /*Allow buffering some shadow calculation.
     *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
     *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
@@ -439,6 +473,18 @@
         #endif
     #endif
 
+    /*Allow buffering the coverage of some rings to draw arcs with the same radius and width faster.
+    * The rings are kept between the refreshes and the least used one is replaced by a new ring.
+    * A few hundred bytes are used per ring, e.g. ~1.5 kB for 50 px radius
+    * 0: to disable caching */
+    #ifndef LV_DRAW_SW_ARC_CACHE_SIZE
+        #ifdef CONFIG_LV_DRAW_SW_ARC_CACHE_SIZE
+            #define LV_DRAW_SW_ARC_CACHE_SIZE CONFIG_LV_DRAW_SW_ARC_CACHE_SIZE
+        #else
+            #define LV_DRAW_SW_ARC_CACHE_SIZE 4
+        #endif
+    #endif
+
     /*Default gradient buffer size.
      *When LVGL calculates the gradient "maps" it can save them into a cache to avoid calculating them again.
      *LV_DRAW_SW_GRADIENT_CACHE_DEF_SIZE sets the size of this cache in bytes.
@@ -454,7 +500,8 @@
 
     /*Allow dithering the gradients (to achieve visual smooth color gradients on limited color depth display)
      *LV_DRAW_SW_GRADIENT_DITHER implies allocating one or two more lines of the object's rendering surface
-     *The increase in memory consumption is (32 bits * object width) plus 24 bits * object width if using error diffusion */
+     *The increase in memory consumption is (32 bits * object width) plus 24 bits * object width if using error diffusion.
+     *The 8 rows of the ordered dithering pattern of horizontal gradients are also cached (8 * object width pixels)*/
     #ifndef LV_DRAW_SW_GRADIENT_DITHER
         #ifdef CONFIG_LV_DRAW_SW_GRADIENT_DITHER
             #define LV_DRAW_SW_GRADIENT_DITHER CONFIG_LV_DRAW_SW_GRADIENT_DITHER
@@ -493,6 +540,37 @@
             #endif
         #endif
     #endif
+
+    /*Convert the 1, 2 and 4 bpp glyphs to opacity a byte at a time with lookup tables instead of pixel by pixel.
+     *Needs 3.5 kB RAM for the tables. They are created on first use.*/
+    #ifndef LV_DRAW_SW_GLYPH_LUT
+        #ifdef CONFIG_LV_DRAW_SW_GLYPH_LUT
+            #define LV_DRAW_SW_GLYPH_LUT CONFIG_LV_DRAW_SW_GLYPH_LUT
+        #else
+            #define LV_DRAW_SW_GLYPH_LUT 0
+        #endif
+    #endif
+
+    /*Cache the glyphs of the `lv_font_fmt_txt` fonts (built-in, converted and loaded fonts) converted to 8 bpp.
+     *It saves the conversion and the decompression of the compressed fonts when the same letters are drawn again.
+     *Size of the cache in bytes. 0: disable*/
+    #ifndef LV_DRAW_SW_GLYPH_CACHE_SIZE
+        #ifdef CONFIG_LV_DRAW_SW_GLYPH_CACHE_SIZE
+            #define LV_DRAW_SW_GLYPH_CACHE_SIZE CONFIG_LV_DRAW_SW_GLYPH_CACHE_SIZE
+        #else
+            #define LV_DRAW_SW_GLYPH_CACHE_SIZE 0
+        #endif
+    #endif
+
+    /*Use the vector extensions of GCC and Clang in some hot loops (e.g. image transformation).
+     *The same code is compiled to SSE2, NEON, etc. depending on the target. Requires GCC or Clang.*/
+    #ifndef LV_USE_DRAW_SW_SIMD
+        #ifdef CONFIG_LV_USE_DRAW_SW_SIMD
+            #define LV_USE_DRAW_SW_SIMD CONFIG_LV_USE_DRAW_SW_SIMD
+        #else
+            #define LV_USE_DRAW_SW_SIMD 0
+        #endif
+    #endif
 #endif
 
 /*Use SDL renderer API*/
@@ -914,7 +992,8 @@
 #endif
 
 /*Maximum buffer size to allocate for rotation.
- *Only used if software rotation is enabled in the display driver.*/
+ *Only used if software rotation is enabled in the display driver.
+ *The rotated areas are flushed in chunks of this size so a larger buffer means less flushes.*/
 #ifndef LV_DISP_ROT_MAX_BUF
     #ifdef CONFIG_LV_DISP_ROT_MAX_BUF
         #define LV_DISP_ROT_MAX_BUF CONFIG_LV_DISP_ROT_MAX_BUF
@@ -955,6 +1034,27 @@
     #endif
 #endif
 
+/*Memory budget in bytes to cache the result of image rotation and zooming.
+ *A static rotated or zoomed image needs to be transformed only once this way.
+ *0: to disable caching*/
+#ifndef LV_IMG_TRANSFORM_CACHE_SIZE
+    #ifdef CONFIG_LV_IMG_TRANSFORM_CACHE_SIZE
+        #define LV_IMG_TRANSFORM_CACHE_SIZE CONFIG_LV_IMG_TRANSFORM_CACHE_SIZE
+    #else
+        #define LV_IMG_TRANSFORM_CACHE_SIZE 0
+    #endif
+#endif
+
+/*1: Draw the images zoomed out below 50% from downscaled copies (mipmaps).
+ *It's faster and less aliased. The mipmaps are stored in the transformed image cache,
+ *so LV_IMG_TRANSFORM_CACHE_SIZE needs to be > 0*/
+#ifndef LV_USE_IMG_MIPMAP
+    #ifdef CONFIG_LV_USE_IMG_MIPMAP
+        #define LV_USE_IMG_MIPMAP CONFIG_LV_USE_IMG_MIPMAP
+    #else
+        #define LV_USE_IMG_MIPMAP 0
+    #endif
+#endif
 
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
@@ -1330,6 +1430,38 @@
     #endif
 #endif
 
+/*Map the letters to glyphs with lookup tables built on the first use of a font
+ *instead of searching in the character maps. Uses 512 bytes + ~12 bytes/glyph RAM per used font.
+ *Loaded fonts build the tables when they are created and free them in `lv_font_free()`.
+ *The tables of the other fonts are kept until `lv_deinit()`.*/
+#ifndef LV_FONT_FMT_TXT_GLYPH_ID_LUT
+    #ifdef CONFIG_LV_FONT_FMT_TXT_GLYPH_ID_LUT
+        #define LV_FONT_FMT_TXT_GLYPH_ID_LUT CONFIG_LV_FONT_FMT_TXT_GLYPH_ID_LUT
+    #else
+        #define LV_FONT_FMT_TXT_GLYPH_ID_LUT 0
+    #endif
+#endif
+
+/*Cache the kerning values of this many glyph pairs (power of 2) per font to avoid
+ *searching in the kerning pairs again and again. Not used by class based kerning. 0: disable*/
+#ifndef LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_KERN_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_KERN_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_KERN_CACHE_SIZE 0
+    #endif
+#endif
+
+/*Convert the pair based kerning of the fonts loaded by `lv_font_load()` to class based kerning
+ *if the class matrix is not larger than this many bytes. The lookup is faster but might use more RAM. 0: disable*/
+#ifndef LV_FONT_LOADER_KERN_CLASSES_MAX_SIZE
+    #ifdef CONFIG_LV_FONT_LOADER_KERN_CLASSES_MAX_SIZE
+        #define LV_FONT_LOADER_KERN_CLASSES_MAX_SIZE CONFIG_LV_FONT_LOADER_KERN_CLASSES_MAX_SIZE
+    #else
+        #define LV_FONT_LOADER_KERN_CLASSES_MAX_SIZE 0
+    #endif
+#endif
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #ifndef LV_USE_FONT_PLACEHOLDER
     #ifdef _LV_KCONFIG_PRESENT
@@ -1409,6 +1541,26 @@
     #endif
 #endif
 
+/*Number of text sizes to cache. Widgets measure the same texts again and again (e.g. table cells, labels).
+ *Needs ~40 bytes + LV_TXT_SIZE_CACHE_TXT_LEN of RAM per entry. 0: disable*/
+#ifndef LV_TXT_SIZE_CACHE_CNT
+    #ifdef CONFIG_LV_TXT_SIZE_CACHE_CNT
+        #define LV_TXT_SIZE_CACHE_CNT CONFIG_LV_TXT_SIZE_CACHE_CNT
+    #else
+        #define LV_TXT_SIZE_CACHE_CNT 0
+    #endif
+#endif
+#if LV_TXT_SIZE_CACHE_CNT
+    /*Longest text (in bytes) to cache. The texts are stored to compare them when looked up.*/
+    #ifndef LV_TXT_SIZE_CACHE_TXT_LEN
+        #ifdef CONFIG_LV_TXT_SIZE_CACHE_TXT_LEN
+            #define LV_TXT_SIZE_CACHE_TXT_LEN CONFIG_LV_TXT_SIZE_CACHE_TXT_LEN
+        #else
+            #define LV_TXT_SIZE_CACHE_TXT_LEN 32
+        #endif
+    #endif
+#endif
+
 /*Support bidirectional texts. Allows mixing Left-to-Right and Right-to-Left texts.
  *The direction will be processed according to the Unicode Bidirectional Algorithm:
  *https://www.w3.org/International/articles/inline-bidi-markup/uba-basics*/
@@ -1707,6 +1859,17 @@
             #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
         #endif
     #endif
+    #ifndef LV_LABEL_BIDI_CACHE
+        #ifdef _LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_LABEL_BIDI_CACHE
+                #define LV_LABEL_BIDI_CACHE CONFIG_LV_LABEL_BIDI_CACHE
+            #else
+                #define LV_LABEL_BIDI_CACHE 0
+            #endif
+        #else
+            #define LV_LABEL_BIDI_CACHE 1     /*Store the bidi processed lines to not process them on every redraw (with LV_USE_BIDI)*/
+        #endif
+    #endif
 #endif
 
 #ifndef LV_USE_LED
@@ -97,6 +97,24 @@ uint16_t _lv_bidi_get_logical_pos(const char * str_in, char ** bidi_txt, uint32_
 uint16_t _lv_bidi_get_visual_pos(const char * str_in, char ** bidi_txt, uint16_t len, lv_base_dir_t base_dir,
                                  uint32_t logical_pos, bool * is_rtl);
 
+/**
+ * Tell whether a text has any RTL characters
+ * @param txt   the text to check
+ * @return      true: there is at least one RTL character
+ */
+bool _lv_bidi_has_rtl_letter(const char * txt);
+
+/**
+ * Get the logical position of all characters of a line at once
+ * @param str_in the input string. Can be only one line.
+ * @param len length of the line in bytes
+ * @param base_dir base direction of the text: `LV_BASE_DIR_LTR` or `LV_BASE_DIR_RTL`
+ * @param pos_out store the logical character positions here in visual order
+ * @param pos_len length of `pos_out` in element count. Should be the number of characters in the line.
+ */
+void _lv_bidi_get_logical_pos_table(const char * str_in, uint32_t len, lv_base_dir_t base_dir,
+                                    uint16_t * pos_out, uint16_t pos_len);
+
 /**
  * Bidi process a paragraph of text
  * @param str_in the string to process
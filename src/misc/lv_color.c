@@ -8,11 +8,18 @@
  *********************/
 #include "lv_color.h"
 #include "lv_log.h"
+#include "../draw/sw/lv_draw_sw_simd.h"
 #include LV_COLOR_EXTERN_INCLUDE
 
 /*********************
  *      DEFINES
  *********************/
+/*The vector kernels assume the little endian byte order of the pixels*/
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_SIMD && LV_BIG_ENDIAN_SYSTEM == 0 && LV_COLOR_DEPTH >= 16
+    #define COLOR_CONVERT_SIMD  1
+#else
+    #define COLOR_CONVERT_SIMD  0
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -21,6 +28,19 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if COLOR_CONVERT_SIMD
+    static uint32_t xrgb8888_to_rgb565_simd(const uint8_t * src, uint8_t * dest, uint32_t px_cnt);
+    static uint32_t argb8888_get_alpha_simd(const uint8_t * src, uint8_t * dest, uint32_t px_cnt);
+    #if LV_COLOR_DEPTH == 16 || LV_COLOR_DEPTH == 24
+        static uint32_t rgb888_to_rgb565_simd(const uint8_t * src, uint8_t * dest, uint32_t px_cnt);
+    #endif
+    #if LV_COLOR_DEPTH == 32
+        static uint32_t rgb565_to_xrgb8888_simd(const uint8_t * src, uint8_t * dest, uint32_t px_cnt);
+        static uint32_t rgb888_to_xrgb8888_simd(const uint8_t * src, uint8_t * dest, uint32_t px_cnt);
+        static uint32_t xrgb8888_set_alpha_simd(const uint8_t * src, uint8_t * dest, uint32_t px_cnt);
+    #endif
+#endif
+static inline lv_color_t color_unpremultiply(lv_color_t c, lv_opa_t a);
 
 /**********************
  *  STATIC VARIABLES
@@ -131,6 +151,7 @@ uint8_t lv_color_format_get_size(lv_color_format_t cf)
         case LV_COLOR_FORMAT_NATIVE_REVERSED:
             return LV_COLOR_DEPTH / 8;
         case LV_COLOR_FORMAT_NATIVE_ALPHA_REVERSED:
+        case LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED:
             return LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
         case LV_COLOR_FORMAT_L8:
         case LV_COLOR_FORMAT_A8:
@@ -160,6 +181,7 @@ bool lv_color_format_has_alpha(lv_color_format_t cf)
 {
     switch(cf) {
         case LV_COLOR_FORMAT_NATIVE_ALPHA_REVERSED:
+        case LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED:
         case LV_COLOR_FORMAT_A8:
         case LV_COLOR_FORMAT_I8:
         case LV_COLOR_FORMAT_ARGB2222:
@@ -200,7 +222,7 @@ static uint8_t bit_5_to_8[32] = {0,   8,   16,  25,  33,  41,  49,  58,
 void lv_color_to_native(const uint8_t * src_buf, lv_color_format_t src_cf, lv_color_t * c_out, lv_opa_t * a_out,
                         lv_color_t alpha_color, uint32_t px_cnt)
 {
-    uint32_t i;
+    uint32_t i = 0;
     uint32_t tmp;
     lv_color_t c;
     switch(src_cf) {
@@ -240,9 +262,14 @@ void lv_color_to_native(const uint8_t * src_buf, lv_color_format_t src_cf, lv_co
             lv_memcpy(c_out, src_buf, px_cnt * 2);
             lv_memset(a_out, 0xff, px_cnt);
 #else
-            for(i = 0; i < px_cnt; i++) {
+            lv_memset(a_out, 0xff, px_cnt);
+#if COLOR_CONVERT_SIMD && LV_COLOR_DEPTH == 32
+            i = rgb565_to_xrgb8888_simd(src_buf, (uint8_t *)c_out, px_cnt);
+            src_buf += i * 2;
+#endif
+            for(; i < px_cnt; i++) {
                 tmp = src_buf[0] + (src_buf[1] << 8);
-                *c_out = lv_color_make(bit_5_to_8[tmp >> 11], bit_6_to_8[(tmp & 0x07E0) >> 5], bit_5_to_8[tmp & 0x001F]);
+                c_out[i] = lv_color_make(bit_5_to_8[tmp >> 11], bit_6_to_8[(tmp & 0x07E0) >> 5], bit_5_to_8[tmp & 0x001F]);
                 src_buf += 2;
             }
 #endif
@@ -278,14 +305,31 @@ void lv_color_to_native(const uint8_t * src_buf, lv_color_format_t src_cf, lv_co
         case LV_COLOR_FORMAT_XRGB8888:
         case LV_COLOR_FORMAT_RGB888:
             lv_memset(a_out, 0xFF, px_cnt);
-            tmp = LV_COLOR_FORMAT_RGB888 ? 3 : 4;
-            for(i = 0; i < px_cnt; i++) {
+            tmp = src_cf == LV_COLOR_FORMAT_RGB888 ? 3 : 4;
+#if COLOR_CONVERT_SIMD && LV_COLOR_DEPTH == 16
+            if(tmp == 3) i = rgb888_to_rgb565_simd(src_buf, (uint8_t *)c_out, px_cnt);
+            else i = xrgb8888_to_rgb565_simd(src_buf, (uint8_t *)c_out, px_cnt);
+#elif COLOR_CONVERT_SIMD && LV_COLOR_DEPTH == 32
+            if(tmp == 3) i = rgb888_to_xrgb8888_simd(src_buf, (uint8_t *)c_out, px_cnt);
+            else i = xrgb8888_set_alpha_simd(src_buf, (uint8_t *)c_out, px_cnt);
+#endif
+            src_buf += i * tmp;
+            for(; i < px_cnt; i++) {
                 c_out[i] = lv_color_make(src_buf[2], src_buf[1], src_buf[0]);
                 src_buf += tmp;
             }
             break;
         case LV_COLOR_FORMAT_ARGB8888:
-            for(i = 0; i < px_cnt; i++) {
+#if COLOR_CONVERT_SIMD && (LV_COLOR_DEPTH == 16 || LV_COLOR_DEPTH == 32)
+            i = argb8888_get_alpha_simd(src_buf, a_out, px_cnt);
+#if LV_COLOR_DEPTH == 16
+            xrgb8888_to_rgb565_simd(src_buf, (uint8_t *)c_out, i);
+#else
+            xrgb8888_set_alpha_simd(src_buf, (uint8_t *)c_out, i);
+#endif
+            src_buf += i * 4;
+#endif
+            for(; i < px_cnt; i++) {
                 c_out[i] = lv_color_make(src_buf[2], src_buf[1], src_buf[0]);
                 a_out[i] = src_buf[3];
                 src_buf += 4;
@@ -304,7 +348,7 @@ void lv_color_to_native(const uint8_t * src_buf, lv_color_format_t src_cf, lv_co
 
 void lv_color_from_native(const lv_color_t * src_buf, uint8_t * dest_buf, lv_color_format_t dest_cf, uint32_t px_cnt)
 {
-    uint32_t i;
+    uint32_t i = 0;
     switch(dest_cf) {
         case LV_COLOR_FORMAT_L8:
             for(i = 0; i < px_cnt; i++) {
@@ -338,7 +382,14 @@ void lv_color_from_native(const lv_color_t * src_buf, uint8_t * dest_buf, lv_col
 #if LV_COLOR_DEPTH == 16
             lv_memcpy(dest_buf, src_buf, px_cnt * 2);
 #else
-            for(i = 0; i < px_cnt; i++) {
+#if COLOR_CONVERT_SIMD && LV_COLOR_DEPTH == 32
+            i = xrgb8888_to_rgb565_simd((const uint8_t *)src_buf, dest_buf, px_cnt);
+            dest_buf += i * 2;
+#elif COLOR_CONVERT_SIMD && LV_COLOR_DEPTH == 24
+            i = rgb888_to_rgb565_simd((const uint8_t *)src_buf, dest_buf, px_cnt);
+            dest_buf += i * 2;
+#endif
+            for(; i < px_cnt; i++) {
                 *((lv_color16_t *)dest_buf) = lv_color_to16(src_buf[i]);
                 dest_buf += 2;
             }
@@ -400,7 +451,7 @@ void lv_color_from_native(const lv_color_t * src_buf, uint8_t * dest_buf, lv_col
 
 void lv_color_from_native_alpha(const uint8_t * src_buf, uint8_t * dest_buf, lv_color_format_t dest_cf, uint32_t px_cnt)
 {
-    uint32_t i;
+    uint32_t i = 0;
     switch(dest_cf) {
         case LV_COLOR_FORMAT_L8:
             for(i = 0; i < px_cnt; i++) {
@@ -410,7 +461,11 @@ void lv_color_from_native_alpha(const uint8_t * src_buf, uint8_t * dest_buf, lv_
             }
             break;
         case LV_COLOR_FORMAT_A8:
-            for(i = 0; i < px_cnt; i++) {
+#if COLOR_CONVERT_SIMD && LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE == 4
+            i = argb8888_get_alpha_simd(src_buf, dest_buf, px_cnt);
+            src_buf += i * 4;
+#endif
+            for(; i < px_cnt; i++) {
                 dest_buf[i] = src_buf[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS];
                 src_buf += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
             }
@@ -444,7 +499,12 @@ void lv_color_from_native_alpha(const uint8_t * src_buf, uint8_t * dest_buf, lv_
             }
             break;
         case LV_COLOR_FORMAT_RGB565:
-            for(i = 0; i < px_cnt; i++) {
+#if COLOR_CONVERT_SIMD && LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE == 4
+            i = xrgb8888_to_rgb565_simd(src_buf, dest_buf, px_cnt);
+            src_buf += i * 4;
+            dest_buf += i * 2;
+#endif
+            for(; i < px_cnt; i++) {
                 lv_color_t color = lv_color_from_buf(src_buf);
                 lv_color16_t c16 = lv_color_to16(color);
                 *((uint16_t *) dest_buf) = lv_color16_to_int(c16);
@@ -526,7 +586,47 @@ void lv_color_from_native_alpha(const uint8_t * src_buf, uint8_t * dest_buf, lv_
     }
 }
 
+void lv_color_premultiply(uint8_t * buf, uint32_t px_cnt)
+{
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        lv_opa_t a = buf[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS];
+        if(a != LV_OPA_COVER) {
+            lv_color_t c = lv_color_from_buf(buf);
+#if LV_COLOR_DEPTH == 8
+            c.level = LV_UDIV255(c.level * a + 128);
+#else
+            c.red = LV_UDIV255(c.red * a + 128);
+            c.green = LV_UDIV255(c.green * a + 128);
+            c.blue = LV_UDIV255(c.blue * a + 128);
+#endif
+            /*The alpha byte is after the color so it remains unchanged*/
+            lv_memcpy(buf, &c, sizeof(lv_color_t));
+        }
+        buf += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+    }
+}
 
+void lv_color_unpremultiply(uint8_t * buf, uint32_t px_cnt)
+{
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        lv_opa_t a = buf[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS];
+        if(a != LV_OPA_COVER) {
+            lv_color_t c = color_unpremultiply(lv_color_from_buf(buf), a);
+            lv_memcpy(buf, &c, sizeof(lv_color_t));
+        }
+        buf += LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+    }
+}
+
+void lv_color_unpremultiply_split(lv_color_t * c_buf, const lv_opa_t * a_buf, uint32_t px_cnt)
+{
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        if(a_buf[i] != LV_OPA_COVER) c_buf[i] = color_unpremultiply(c_buf[i], a_buf[i]);
+    }
+}
 
 lv_color_t lv_color_lighten(lv_color_t c, lv_opa_t lvl)
 {
@@ -773,3 +873,170 @@ lv_color_t lv_palette_darken(lv_palette_t p, uint8_t lvl)
 
     return colors[p][lvl];
 }
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static inline lv_color_t color_unpremultiply(lv_color_t c, lv_opa_t a)
+{
+    /*The pixels of an image usually have only a few different alpha values
+     *so save the last reciprocal instead of dividing for every pixel*/
+    static lv_opa_t last_a = LV_OPA_COVER;
+    static uint32_t last_recip = 1 << 16;
+
+    /*Fully transparent pixels become black*/
+    if(a != last_a) {
+        last_a = a;
+        last_recip = a ? (255U << 16) / a : 0;
+    }
+
+    /*c <= 255 and recip <= 255 * 65536 / a, so it can't overflow*/
+    uint32_t recip = last_recip;
+#if LV_COLOR_DEPTH == 8
+    c.level = LV_MIN((c.level * recip + 0x8000) >> 16, 0xFF);
+#elif LV_COLOR_DEPTH == 16
+    c.red = LV_MIN((c.red * recip + 0x8000) >> 16, 0x1F);
+    c.green = LV_MIN((c.green * recip + 0x8000) >> 16, 0x3F);
+    c.blue = LV_MIN((c.blue * recip + 0x8000) >> 16, 0x1F);
+#else
+    c.red = LV_MIN((c.red * recip + 0x8000) >> 16, 0xFF);
+    c.green = LV_MIN((c.green * recip + 0x8000) >> 16, 0xFF);
+    c.blue = LV_MIN((c.blue * recip + 0x8000) >> 16, 0xFF);
+#endif
+    return c;
+}
+
+#if COLOR_CONVERT_SIMD
+
+/**
+ * Convert 4 XRGB8888 pixels to RGB565 in the lower 16 bits of the lanes
+ */
+static inline lv_simd_u32_t xrgb8888_pack_rgb565(lv_simd_u32_t c)
+{
+    return ((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F);
+}
+
+/**
+ * Load 4 RGB888 pixels as XRGB8888. 16 bytes are read from `src`.
+ */
+static inline lv_simd_u32_t rgb888_load(const uint8_t * src)
+{
+    lv_simd_u8_t v = (lv_simd_u8_t)lv_simd_load_u32(src);
+    lv_simd_u8_t ff = (lv_simd_u8_t)LV_SIMD_U32(0xFFFFFFFF);
+    return (lv_simd_u32_t)LV_SIMD_SHUFFLE(lv_simd_u8_t, v, ff, 0, 1, 2, 16, 3, 4, 5, 16, 6, 7, 8, 16, 9, 10, 11, 16);
+}
+
+/**
+ * Store the lower 16 bits of the lanes of 2 vectors as 8 RGB565 pixels
+ */
+static inline void rgb565_store(uint8_t * dest, lv_simd_u32_t c0, lv_simd_u32_t c1)
+{
+    lv_simd_u16_t c16 = LV_SIMD_SHUFFLE(lv_simd_u16_t, (lv_simd_u16_t)c0, (lv_simd_u16_t)c1, 0, 2, 4, 6, 8, 10, 12, 14);
+    lv_simd_store_u32(dest, (lv_simd_u32_t)c16);
+}
+
+/*The kernels below convert the pixels in groups and return the number of converted pixels.
+ *The rest should be converted by the caller. Converting to a smaller pixel size works in place too.*/
+
+static uint32_t xrgb8888_to_rgb565_simd(const uint8_t * src, uint8_t * dest, uint32_t px_cnt)
+{
+    uint32_t i;
+    for(i = 0; i + 8 <= px_cnt; i += 8) {
+        lv_simd_u32_t c0 = xrgb8888_pack_rgb565(lv_simd_load_u32(src));
+        lv_simd_u32_t c1 = xrgb8888_pack_rgb565(lv_simd_load_u32(src + 16));
+        rgb565_store(dest, c0, c1);
+        src += 32;
+        dest += 16;
+    }
+    return i;
+}
+
+#if LV_COLOR_DEPTH == 16 || LV_COLOR_DEPTH == 24
+static uint32_t rgb888_to_rgb565_simd(const uint8_t * src, uint8_t * dest, uint32_t px_cnt)
+{
+    uint32_t i;
+    /*The second load reads 4 bytes more than the 8 pixels*/
+    for(i = 0; i + 10 <= px_cnt; i += 8) {
+        lv_simd_u32_t c0 = xrgb8888_pack_rgb565(rgb888_load(src));
+        lv_simd_u32_t c1 = xrgb8888_pack_rgb565(rgb888_load(src + 12));
+        rgb565_store(dest, c0, c1);
+        src += 24;
+        dest += 16;
+    }
+    return i;
+}
+#endif
+
+#if LV_COLOR_DEPTH == 32
+static uint32_t rgb565_to_xrgb8888_simd(const uint8_t * src, uint8_t * dest, uint32_t px_cnt)
+{
+    lv_simd_u16_t zero = {0};
+    uint32_t i;
+    for(i = 0; i + 8 <= px_cnt; i += 8) {
+        lv_simd_u16_t c16 = (lv_simd_u16_t)lv_simd_load_u32(src);
+        lv_simd_u32_t c[2];
+        c[0] = (lv_simd_u32_t)LV_SIMD_SHUFFLE(lv_simd_u16_t, c16, zero, 0, 8, 1, 8, 2, 8, 3, 8);
+        c[1] = (lv_simd_u32_t)LV_SIMD_SHUFFLE(lv_simd_u16_t, c16, zero, 4, 8, 5, 8, 6, 8, 7, 8);
+
+        uint32_t j;
+        for(j = 0; j < 2; j++) {
+            /*Same as the `bit_5_to_8` and `bit_6_to_8` tables*/
+            lv_simd_u32_t r = (((c[j] >> 11) * 527 + 23) >> 6);
+            lv_simd_u32_t g = ((((c[j] >> 5) & 0x3F) * 259 + 33) >> 6);
+            lv_simd_u32_t b = (((c[j] & 0x1F) * 527 + 23) >> 6);
+            lv_simd_store_u32(dest + j * 16, (r << 16) | (g << 8) | b | 0xFF000000);
+        }
+
+        src += 16;
+        dest += 32;
+    }
+    return i;
+}
+
+static uint32_t rgb888_to_xrgb8888_simd(const uint8_t * src, uint8_t * dest, uint32_t px_cnt)
+{
+    uint32_t i;
+    /*A load reads 4 bytes more than the 4 pixels*/
+    for(i = 0; i + 6 <= px_cnt; i += 4) {
+        lv_simd_store_u32(dest, rgb888_load(src));
+        src += 12;
+        dest += 16;
+    }
+    return i;
+}
+
+static uint32_t xrgb8888_set_alpha_simd(const uint8_t * src, uint8_t * dest, uint32_t px_cnt)
+{
+    uint32_t i;
+    for(i = 0; i + 4 <= px_cnt; i += 4) {
+        lv_simd_store_u32(dest, lv_simd_load_u32(src) | 0xFF000000);
+        src += 16;
+        dest += 16;
+    }
+    return i;
+}
+#endif
+
+static uint32_t argb8888_get_alpha_simd(const uint8_t * src, uint8_t * dest, uint32_t px_cnt)
+{
+    uint32_t i;
+    for(i = 0; i + 16 <= px_cnt; i += 16) {
+        lv_simd_u16_t a01 = LV_SIMD_SHUFFLE(lv_simd_u16_t,
+                                            (lv_simd_u16_t)(lv_simd_load_u32(src) >> 24),
+                                            (lv_simd_u16_t)(lv_simd_load_u32(src + 16) >> 24),
+                                            0, 2, 4, 6, 8, 10, 12, 14);
+        lv_simd_u16_t a23 = LV_SIMD_SHUFFLE(lv_simd_u16_t,
+                                            (lv_simd_u16_t)(lv_simd_load_u32(src + 32) >> 24),
+                                            (lv_simd_u16_t)(lv_simd_load_u32(src + 48) >> 24),
+                                            0, 2, 4, 6, 8, 10, 12, 14);
+        lv_simd_u8_t a = LV_SIMD_SHUFFLE(lv_simd_u8_t, (lv_simd_u8_t)a01, (lv_simd_u8_t)a23,
+                                         0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+        lv_simd_store_u32(dest, (lv_simd_u32_t)a);
+        src += 64;
+        dest += 16;
+    }
+    return i;
+}
+
+#endif /*COLOR_CONVERT_SIMD*/
@@ -285,6 +285,9 @@ typedef enum {
 
     LV_COLOR_FORMAT_RAW,
     LV_COLOR_FORMAT_RAW_ALPHA,
+
+    /*Same layout as `LV_COLOR_FORMAT_NATIVE_ALPHA` but the color channels are multiplied by the alpha*/
+    LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED,
 } lv_color_format_t;
 
 void lv_color_to_native(const uint8_t * src_buf, lv_color_format_t src_cf, lv_color_t * c_out, lv_opa_t * a_out,
@@ -293,6 +296,30 @@ void lv_color_to_native(const uint8_t * src_buf, lv_color_format_t src_cf, lv_co
 void lv_color_from_native(const lv_color_t * src_buf, uint8_t * dest_buf, lv_color_format_t dest_cf, uint32_t px_cnt);
 void lv_color_from_native_alpha(const uint8_t * src_buf, uint8_t * dest_buf, lv_color_format_t dest_cf,
                                 uint32_t px_cnt);
+
+/**
+ * Multiply the color channels of `LV_COLOR_FORMAT_NATIVE_ALPHA` pixels by their alpha in place.
+ * The result is `LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED`.
+ * @param buf       buffer of `LV_COLOR_FORMAT_NATIVE_ALPHA` pixels
+ * @param px_cnt    number of pixels
+ */
+void lv_color_premultiply(uint8_t * buf, uint32_t px_cnt);
+
+/**
+ * Convert `LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED` pixels back to `LV_COLOR_FORMAT_NATIVE_ALPHA` in place
+ * @param buf       buffer of `LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED` pixels
+ * @param px_cnt    number of pixels
+ */
+void lv_color_unpremultiply(uint8_t * buf, uint32_t px_cnt);
+
+/**
+ * Same as `lv_color_unpremultiply` but the colors and the alpha values are in separate arrays
+ * @param c_buf     array of premultiplied colors
+ * @param a_buf     array of the alpha values
+ * @param px_cnt    number of pixels
+ */
+void lv_color_unpremultiply_split(lv_color_t * c_buf, const lv_opa_t * a_buf, uint32_t px_cnt);
+
 /**
  * Get the pixel size of a color format in bits
  * @param src_cf a color format (`LV_IMG_CF_...`)
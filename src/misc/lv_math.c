@@ -123,6 +123,31 @@ LV_ATTRIBUTE_FAST_MEM void lv_sqrt(uint32_t x, lv_sqrt_res_t * q, uint32_t mask)
     q->f = (root & 0xf) << 4;
 }
 
+/**
+ * Get the integer square root of a 64 bit number
+ * @param x     the number
+ * @return      the square root of `x` rounded down
+ */
+uint32_t lv_sqrt64(uint64_t x)
+{
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while(bit > x) bit >>= 2;
+
+    while(bit) {
+        if(x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t)res;
+}
+
 /**
  * Calculate the atan2 of a vector.
  * @param x
@@ -88,6 +88,13 @@ LV_ATTRIBUTE_FAST_MEM void lv_sqrt(uint32_t x, lv_sqrt_res_t * q, uint32_t mask)
 
 //! @endcond
 
+/**
+ * Get the integer square root of a 64 bit number
+ * @param x     the number
+ * @return      the square root of `x` rounded down
+ */
+uint32_t lv_sqrt64(uint64_t x);
+
 /**
  * Calculate the integer exponents.
  * @param base
@@ -247,6 +247,43 @@ static size_t _ntoa_format(out_fct_type out, char * buffer, size_t idx, size_t m
     return _out_rev(out, buffer, idx, maxlen, buf, len, width, flags);
 }
 
+// internal conversion of an unsigned number to digits in reverse order, appended to 'buf' of 'size' bytes from 'len'
+// the decimal digits are converted in pairs and the other bases by shifting to need less divisions
+static size_t _utoa_rev(char * buf, size_t len, size_t size, unsigned long value, unsigned int base,
+                        unsigned int flags)
+{
+    static const char dec_pairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    if(base == 10U) {
+        while((value >= 100U) && (len + 2U <= size)) {
+            const unsigned int pair = (unsigned int)(value % 100U) * 2U;
+            value /= 100U;
+            buf[len++] = dec_pairs[pair + 1U];
+            buf[len++] = dec_pairs[pair];
+        }
+        while(len < size) {
+            buf[len++] = (char)('0' + value % 10U);
+            value /= 10U;
+            if(!value) break;
+        }
+    }
+    else {
+        const unsigned int shift = base == 16U ? 4U : base == 8U ? 3U : 1U;
+        const char letter = flags & FLAGS_UPPERCASE ? 'A' : 'a';
+        while(len < size) {
+            const char digit = (char)(value & (base - 1U));
+            buf[len++] = digit < 10 ? '0' + digit : letter + digit - 10;
+            value >>= shift;
+            if(!value) break;
+        }
+    }
+
+    return len;
+}
+
 // internal itoa for 'long' type
 static size_t _ntoa_long(out_fct_type out, char * buffer, size_t idx, size_t maxlen, unsigned long value, bool negative,
                          unsigned long base, unsigned int prec, unsigned int width, unsigned int flags)
@@ -261,11 +298,7 @@ static size_t _ntoa_long(out_fct_type out, char * buffer, size_t idx, size_t max
 
     // write if precision != 0 and value is != 0
     if(!(flags & FLAGS_PRECISION) || value) {
-        do {
-            const char digit = (char)(value % base);
-            buf[len++] = digit < 10 ? '0' + digit : (flags & FLAGS_UPPERCASE ? 'A' : 'a') + digit - 10;
-            value /= base;
-        } while(value && (len < PRINTF_NTOA_BUFFER_SIZE));
+        len = _utoa_rev(buf, len, PRINTF_NTOA_BUFFER_SIZE, value, (unsigned int)base, flags);
     }
 
     return _ntoa_format(out, buffer, idx, maxlen, buf, len, negative, (unsigned int)base, prec, width, flags);
@@ -276,6 +309,11 @@ static size_t _ntoa_long(out_fct_type out, char * buffer, size_t idx, size_t max
 static size_t _ntoa_long_long(out_fct_type out, char * buffer, size_t idx, size_t maxlen, unsigned long long value,
                               bool negative, unsigned long long base, unsigned int prec, unsigned int width, unsigned int flags)
 {
+    // the 'long' division is much faster where 'long long' is emulated
+    if(value <= (unsigned long) -1) {
+        return _ntoa_long(out, buffer, idx, maxlen, (unsigned long)value, negative, (unsigned long)base, prec, width, flags);
+    }
+
     char buf[PRINTF_NTOA_BUFFER_SIZE];
     size_t len = 0U;
 
@@ -381,17 +419,11 @@ static size_t _ftoa(out_fct_type out, char * buffer, size_t idx, size_t maxlen,
         }
     }
     else {
-        unsigned int count = prec;
         // now do fractional part, as an unsigned number
-        while(len < PRINTF_FTOA_BUFFER_SIZE) {
-            --count;
-            buf[len++] = (char)(48U + (frac % 10U));
-            if(!(frac /= 10U)) {
-                break;
-            }
-        }
+        const size_t frac_start = len;
+        len = _utoa_rev(buf, len, PRINTF_FTOA_BUFFER_SIZE, frac, 10U, 0U);
         // add extra 0s
-        while((len < PRINTF_FTOA_BUFFER_SIZE) && (count-- > 0U)) {
+        while((len < PRINTF_FTOA_BUFFER_SIZE) && (len - frac_start < prec)) {
             buf[len++] = '0';
         }
         if(len < PRINTF_FTOA_BUFFER_SIZE) {
@@ -401,12 +433,7 @@ static size_t _ftoa(out_fct_type out, char * buffer, size_t idx, size_t maxlen,
     }
 
     // do whole part, number is reversed
-    while(len < PRINTF_FTOA_BUFFER_SIZE) {
-        buf[len++] = (char)(48 + (whole % 10));
-        if(!(whole /= 10)) {
-            break;
-        }
-    }
+    len = _utoa_rev(buf, len, PRINTF_FTOA_BUFFER_SIZE, (unsigned long)whole, 10U, 0U);
 
     // pad leading zeros
     if(!(flags & FLAGS_LEFT) && (flags & FLAGS_ZEROPAD)) {
@@ -560,9 +587,18 @@ static int _lv_vsnprintf(out_fct_type out, char * buffer, const size_t maxlen, c
     while(*format) {
         // format specifier?  %[flags][width][.precision][length]
         if(*format != '%') {
-            // no
-            out(*format, buffer, idx++, maxlen);
-            format++;
+            // no, copy the characters until the next specifier
+            if(out == _out_buffer) {
+                do {
+                    if(idx < maxlen) buffer[idx] = *format;
+                    idx++;
+                    format++;
+                } while(*format && *format != '%');
+            }
+            else {
+                out(*format, buffer, idx++, maxlen);
+                format++;
+            }
             continue;
         }
         else {
@@ -7,25 +7,62 @@
  *      INCLUDES
  *********************/
 #include <stdarg.h>
+#include <string.h>
 #include "lv_txt.h"
 #include "lv_txt_ap.h"
 #include "lv_math.h"
 #include "lv_log.h"
 #include "lv_mem.h"
 #include "lv_assert.h"
+#include "../font/lv_font_fmt_txt.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define NO_BREAK_FOUND UINT32_MAX
 
+/*The formatted texts shorter than this are formatted in one pass*/
+#define LV_TXT_FMT_BUF_SIZE 64
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_TXT_SIZE_CACHE_CNT
+/*The parameters a text is measured with*/
+typedef struct {
+    const lv_font_t * font;
+    uint32_t font_hash;         /*The fallbacks, line heights and kerning of the font*/
+    uint32_t txt_hash;
+    uint32_t txt_len;
+    lv_coord_t letter_space;
+    lv_coord_t line_space;
+    lv_coord_t max_width;
+    lv_text_flag_t flag;
+} txt_size_cache_key_t;
+
+/*The measured size of a text. A copy of the text is kept to tell apart the texts with the same hash*/
+typedef struct {
+    txt_size_cache_key_t key;
+    uint32_t last_used;
+    lv_point_t size;
+    char txt[LV_TXT_SIZE_CACHE_TXT_LEN];
+} txt_size_cache_entry_t;
+
+typedef struct {
+    txt_size_cache_entry_t entries[LV_TXT_SIZE_CACHE_CNT];
+    uint32_t use_cnt;
+} txt_size_cache_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t * font, lv_coord_t letter_space,
+                         lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag);
+#if LV_TXT_SIZE_CACHE_CNT
+    static uint32_t txt_size_cache_font_hash(const lv_font_t * font);
+    static txt_size_cache_entry_t * txt_size_cache_find(const txt_size_cache_key_t * key, const char * text, bool * hit);
+#endif
 
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
     static uint8_t lv_txt_utf8_size(const char * str);
@@ -49,6 +86,9 @@
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_TXT_SIZE_CACHE_CNT
+    static txt_size_cache_t txt_size_cache;
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -99,6 +139,64 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
 
     if(flag & LV_TEXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
 
+#if LV_TXT_SIZE_CACHE_CNT
+    /*FNV-1a hash of the text. The longer texts are not cached*/
+    uint32_t txt_hash = 2166136261u;
+    uint32_t txt_len;
+    for(txt_len = 0; text[txt_len] != '\0' && txt_len <= LV_TXT_SIZE_CACHE_TXT_LEN; txt_len++) {
+        txt_hash = (txt_hash ^ (uint8_t)text[txt_len]) * 16777619u;
+    }
+
+    if(txt_len <= LV_TXT_SIZE_CACHE_TXT_LEN) {
+        txt_size_cache_key_t key;
+        key.font = font;
+        key.font_hash = txt_size_cache_font_hash(font);
+        key.txt_hash = txt_hash;
+        key.txt_len = txt_len;
+        key.letter_space = letter_space;
+        key.line_space = line_space;
+        key.max_width = max_width;
+        key.flag = flag;
+
+        bool hit;
+        txt_size_cache_entry_t * entry = txt_size_cache_find(&key, text, &hit);
+        txt_size_cache.use_cnt++;
+        entry->last_used = txt_size_cache.use_cnt;
+        if(hit) {
+            *size_res = entry->size;
+            return;
+        }
+
+        txt_get_size(size_res, text, font, letter_space, line_space, max_width, flag);
+
+        /*Replace the least recently used entry*/
+        entry->key = key;
+        entry->size = *size_res;
+        lv_memcpy(entry->txt, text, txt_len);
+        return;
+    }
+#endif
+
+    txt_get_size(size_res, text, font, letter_space, line_space, max_width, flag);
+}
+
+/**
+ * Forget the cached text sizes.
+ */
+void lv_txt_size_cache_invalidate(void)
+{
+#if LV_TXT_SIZE_CACHE_CNT
+    lv_memzero(&txt_size_cache, sizeof(txt_size_cache));
+#endif
+}
+
+/**
+ * Measure a text without the cache
+ */
+static void txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t * font, lv_coord_t letter_space,
+                         lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag)
+{
+
     uint32_t line_start     = 0;
     uint32_t new_line_start = 0;
     uint16_t letter_height = lv_font_get_line_height(font);
@@ -136,6 +234,63 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
         size_res->y -= line_space;
 }
 
+#if LV_TXT_SIZE_CACHE_CNT
+/**
+ * Hash the font parameters which affect the size of a text but can change without changing the font's address
+ * @param font  pointer to a font
+ * @return      hash of the fallback fonts, the line heights and the kerning
+ */
+static uint32_t txt_size_cache_font_hash(const lv_font_t * font)
+{
+    uint32_t hash = 2166136261u;
+    while(font) {
+        uint64_t v[4] = {(uintptr_t)font, (uint64_t)font->line_height, 0, 0};
+        if(font->get_glyph_dsc == lv_font_get_glyph_dsc_fmt_txt) {
+            const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+            v[2] = (uintptr_t)fdsc->kern_dsc;
+            v[3] = ((uint64_t)fdsc->kern_scale << 1) | fdsc->kern_classes;
+        }
+
+        const uint8_t * p = (const uint8_t *)v;
+        uint32_t i;
+        for(i = 0; i < sizeof(v); i++) hash = (hash ^ p[i]) * 16777619u;
+
+        font = font->fallback;
+    }
+
+    return hash;
+}
+
+/**
+ * Find the cached size of a text
+ * @param key   the text's parameters to look for
+ * @param text  the text to compare with the entries whose key matches
+ * @param hit   set to true if the text was found in the cache
+ * @return      the matching entry, or the least recently used (or an empty) entry if the text is not cached
+ */
+static txt_size_cache_entry_t * txt_size_cache_find(const txt_size_cache_key_t * key, const char * text, bool * hit)
+{
+    txt_size_cache_entry_t * lru = &txt_size_cache.entries[0];
+    uint32_t i;
+    for(i = 0; i < LV_TXT_SIZE_CACHE_CNT; i++) {
+        txt_size_cache_entry_t * entry = &txt_size_cache.entries[i];
+        const txt_size_cache_key_t * k = &entry->key;
+        if(k->font == key->font && k->font_hash == key->font_hash && k->txt_hash == key->txt_hash &&
+           k->txt_len == key->txt_len && k->letter_space == key->letter_space &&
+           k->line_space == key->line_space && k->max_width == key->max_width && k->flag == key->flag &&
+           memcmp(entry->txt, text, key->txt_len) == 0) {
+            *hit = true;
+            return entry;
+        }
+
+        if(entry->last_used < lru->last_used) lru = entry;
+    }
+
+    *hit = false;
+    return lru;
+}
+#endif
+
 /**
  * Get the next word of text. A word is delimited by break characters.
  *
@@ -455,42 +610,66 @@ void _lv_txt_cut(char * txt, uint32_t pos, uint32_t len)
 
 char * _lv_txt_set_text_vfmt(const char * fmt, va_list ap)
 {
-    /*Allocate space for the new text by using trick from C99 standard section 7.19.6.12*/
+    return _lv_txt_realloc_text_vfmt(NULL, fmt, ap);
+}
+
+char * _lv_txt_realloc_text_vfmt(char * text, const char * fmt, va_list ap)
+{
+    /*Short texts are formatted only once, into a local buffer. The longer ones are measured first
+     *by using trick from C99 standard section 7.19.6.12*/
+    char buf[LV_TXT_FMT_BUF_SIZE];
     va_list ap_copy;
     va_copy(ap_copy, ap);
-    uint32_t len = lv_vsnprintf(NULL, 0, fmt, ap_copy);
+    int res = lv_vsnprintf(buf, sizeof(buf), fmt, ap_copy);
     va_end(ap_copy);
+    if(res < 0) return NULL;
+    uint32_t len = (uint32_t)res;
 
-    char * text = 0;
 #if LV_USE_ARABIC_PERSIAN_CHARS
     /*Put together the text according to the format string*/
-    char * raw_txt = lv_malloc(len + 1);
-    LV_ASSERT_MALLOC(raw_txt);
-    if(raw_txt == NULL) {
-        return NULL;
-    }
+    char * raw_txt = buf;
+    if(len >= sizeof(buf)) {
+        raw_txt = lv_malloc(len + 1);
+        LV_ASSERT_MALLOC(raw_txt);
+        if(raw_txt == NULL) {
+            return NULL;
+        }
 
-    lv_vsnprintf(raw_txt, len + 1, fmt, ap);
+        lv_vsnprintf(raw_txt, len + 1, fmt, ap);
+    }
 
     /*Get the size of the Arabic text and process it*/
     size_t len_ap = _lv_txt_ap_calc_bytes_cnt(raw_txt);
-    text = lv_malloc(len_ap + 1);
+    text = text ? lv_realloc(text, len_ap + 1) : lv_malloc(len_ap + 1);
     LV_ASSERT_MALLOC(text);
-    if(text == NULL) {
-        return NULL;
+    if(text != NULL) {
+        _lv_txt_ap_proc(raw_txt, text);
     }
-    _lv_txt_ap_proc(raw_txt, text);
 
-    lv_free(raw_txt);
+    if(raw_txt != buf) lv_free(raw_txt);
 #else
-    text = lv_malloc(len + 1);
-    LV_ASSERT_MALLOC(text);
-    if(text == NULL) {
-        return NULL;
+    if(len < sizeof(buf)) {
+        text = text ? lv_realloc(text, len + 1) : lv_malloc(len + 1);
+        LV_ASSERT_MALLOC(text);
+        if(text == NULL) {
+            return NULL;
+        }
+
+        lv_memcpy(text, buf, len + 1);
     }
-    text[len] = 0; /*Ensure NULL termination*/
+    else {
+        /*The items might refer to the old text so free it only after formatting*/
+        char * new_text = lv_malloc(len + 1);
+        LV_ASSERT_MALLOC(new_text);
+        if(new_text == NULL) {
+            return NULL;
+        }
+        new_text[len] = 0; /*Ensure NULL termination*/
 
-    lv_vsnprintf(text, len + 1, fmt, ap);
+        lv_vsnprintf(new_text, len + 1, fmt, ap);
+        lv_free(text);
+        text = new_text;
+    }
 #endif
 
     return text;
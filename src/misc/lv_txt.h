@@ -103,6 +103,15 @@ typedef uint8_t lv_text_align_t;
 void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t * font, lv_coord_t letter_space,
                      lv_coord_t line_space, lv_coord_t max_width, lv_text_flag_t flag);
 
+/**
+ * Forget the text sizes cached by `lv_txt_get_size`.
+ * The texts are identified by their content so changing a text needs no invalidation.
+ * Changing a font's fallback, line height or (for built-in fonts) kerning is detected too,
+ * but it needs to be called if a font's glyphs are changed or a font is deleted.
+ * Has no effect if `LV_TXT_SIZE_CACHE_CNT` is 0.
+ */
+void lv_txt_size_cache_invalidate(void);
+
 /**
  * Get the next line of text. Check line length and break chars too.
  * @param txt a '\0' terminated string
@@ -168,6 +177,16 @@ void _lv_txt_cut(char * txt, uint32_t pos, uint32_t len);
  */
 char * _lv_txt_set_text_vfmt(const char * fmt, va_list ap) LV_FORMAT_ATTRIBUTE(1, 0);
 
+/**
+ * Format a text into an existing buffer which is reallocated to the size of the new text.
+ * Short texts are formatted in one pass and their buffer is usually resized in place.
+ * @param text  a text allocated with `lv_malloc` to reuse or NULL to allocate a new one
+ * @param fmt   `printf`-like format
+ * @param ap    items to print
+ * @return      pointer to the reallocated text string or NULL on error (`text` is not freed then)
+ */
+char * _lv_txt_realloc_text_vfmt(char * text, const char * fmt, va_list ap) LV_FORMAT_ATTRIBUTE(2, 0);
+
 /**
  * Decode two encoded character from a string.
  * @param txt pointer to '\0' terminated string
@@ -255,6 +255,12 @@ void _lv_txt_ap_proc(const char * txt, char * txt_out)
 
 static uint32_t lv_ap_get_char_index(uint16_t c)
 {
+    /*All the characters and their forms are in the Arabic and Arabic Presentation Forms blocks.
+     *Skip the table scan for the others (e.g. ASCII)*/
+    if(c < LV_AP_ALPHABET_BASE_CODE || (c > 0x06FF && c < 0xFB50) || c > 0xFEFF) {
+        return LV_UNDEF_ARABIC_PERSIAN_CHARS;
+    }
+
     for(uint8_t i = 0; ap_chars_map[i].char_end_form; i++) {
         if(c == (ap_chars_map[i].char_offset + LV_AP_ALPHABET_BASE_CODE))
             return i;
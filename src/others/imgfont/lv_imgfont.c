@@ -77,6 +77,7 @@ void lv_imgfont_destroy(lv_font_t * font)
 {
     LV_ASSERT_NULL(font);
 
+    lv_txt_size_cache_invalidate();
     imgfont_dsc_t * dsc = (imgfont_dsc_t *)font->dsc;
     lv_free(dsc);
 }
@@ -103,6 +103,7 @@ void lv_canvas_set_px(lv_obj_t * obj, lv_coord_t x, lv_coord_t y, lv_color_t col
         native_color += opa << (LV_COLOR_FORMAT_NATIVE_ALPHA_OFS * 8);
         lv_color_from_native_alpha((uint8_t *)&native_color, (uint8_t *)canvas->dsc.data + px, canvas->dsc.header.cf, 1);
     }
+    lv_img_transform_cache_invalidate_src(&canvas->dsc);
     lv_obj_invalidate(obj);
 }
 
@@ -113,6 +114,7 @@ void lv_canvas_set_palette(lv_obj_t * obj, uint8_t id, lv_color32_t c)
     lv_canvas_t * canvas = (lv_canvas_t *)obj;
 
     lv_img_buf_set_palette(&canvas->dsc, id, c);
+    lv_img_transform_cache_invalidate_src(&canvas->dsc);
     lv_obj_invalidate(obj);
 }
 
@@ -164,6 +166,7 @@ void lv_canvas_copy_buf(lv_obj_t * obj, const void * to_copy, lv_coord_t x, lv_c
         px += canvas->dsc.header.w * px_size;
         to_copy8 += w * px_size;
     }
+    lv_img_transform_cache_invalidate_src(&canvas->dsc);
 }
 
 void lv_canvas_transform(lv_obj_t * obj, lv_img_dsc_t * src_img, int16_t angle, uint16_t zoom, lv_coord_t offset_x,
@@ -712,9 +715,11 @@ static lv_draw_ctx_t * init_fake_disp(lv_obj_t * canvas, lv_area_t * clip_area)
 
 static void deinit_fake_disp(lv_obj_t * canvas, lv_draw_ctx_t * draw_ctx)
 {
-    LV_UNUSED(canvas);
     lv_draw_sw_deinit_ctx(NULL, draw_ctx);
     lv_free(draw_ctx);
+
+    /*The content has changed so the cached transformations are outdated*/
+    lv_img_transform_cache_invalidate_src(lv_canvas_get_img(canvas));
 }
 
 
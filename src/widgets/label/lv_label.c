@@ -146,15 +146,16 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
         return;
     }
 
-    if(label->text != NULL && label->static_txt == 0) {
-        lv_free(label->text);
-        label->text = NULL;
-    }
+    /*Reuse the buffer of the old text. Frequently updated values usually fit into it.*/
+    char * old_text = label->static_txt == 0 ? label->text : NULL;
 
     va_list args;
     va_start(args, fmt);
-    label->text = _lv_txt_set_text_vfmt(fmt, args);
+    char * text = _lv_txt_realloc_text_vfmt(old_text, fmt, args);
     va_end(args);
+    if(text == NULL) return;
+
+    label->text = text;
     label->static_txt = 0; /*Now the text is dynamically allocated*/
 
     lv_label_refr_text(obj);
@@ -669,6 +670,10 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->hint.y          = 0;
 #endif
 
+#if LV_USE_BIDI && LV_LABEL_BIDI_CACHE
+    lv_memzero(&label->bidi_cache, sizeof(label->bidi_cache));
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     label->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     label->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -692,6 +697,10 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
     if(!label->static_txt) lv_free(label->text);
     label->text = NULL;
+
+#if LV_USE_BIDI && LV_LABEL_BIDI_CACHE
+    lv_draw_label_bidi_cache_free(&label->bidi_cache);
+#endif
 }
 
 static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -771,6 +780,10 @@ static void draw_main(lv_event_t * e)
     lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_draw_dsc);
     lv_bidi_calculate_align(&label_draw_dsc.align, &label_draw_dsc.bidi_dir, label->text);
 
+#if LV_USE_BIDI && LV_LABEL_BIDI_CACHE
+    label_draw_dsc.bidi_cache = &label->bidi_cache;
+#endif
+
     label_draw_dsc.sel_start = lv_label_get_text_selection_start(obj);
     label_draw_dsc.sel_end = lv_label_get_text_selection_end(obj);
     if(label_draw_dsc.sel_start != LV_DRAW_LABEL_NO_TXT_SEL && label_draw_dsc.sel_end != LV_DRAW_LABEL_NO_TXT_SEL) {
@@ -882,6 +895,9 @@ static void lv_label_refr_text(lv_obj_t * obj)
     if(label->text == NULL) return;
 #if LV_LABEL_LONG_TXT_HINT
     label->hint.line_start = -1; /*The hint is invalid if the text changes*/
+#endif
+#if LV_USE_BIDI && LV_LABEL_BIDI_CACHE
+    lv_draw_label_bidi_cache_free(&label->bidi_cache); /*The text might be changed in place, e.g. by the dots*/
 #endif
     label->invalid_size_cache = true;
 
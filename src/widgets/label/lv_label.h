@@ -70,6 +70,10 @@ typedef struct {
     lv_draw_label_hint_t hint;
 #endif
 
+#if LV_USE_BIDI && LV_LABEL_BIDI_CACHE
+    lv_draw_label_bidi_cache_t bidi_cache;
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     uint32_t sel_start;
     uint32_t sel_end;
@@ -21,6 +21,7 @@ build_only_options = {
 test_options = {
     'OPTIONS_TEST_SYSHEAP': 'Test config, system heap, 32 bit color depth',
     'OPTIONS_TEST_DEFHEAP': 'Test config, LVGL heap, 32 bit color depth',
+    'OPTIONS_TEST_16BIT': 'Test config, LVGL heap, 16 bit color depth',
 }
 
 
@@ -1,12 +1,21 @@
 #define LV_MEM_SIZE         8388608
 #define LV_USE_DRAW_MASKS       1
+#define LV_DRAW_SW_GRADIENT_DITHER  1
+#define LV_DRAW_SW_GRADIENT_DITHER_ERROR_DIFFUSION  1
+#define LV_DRAW_SW_PREMULTIPLIED_ALPHA  1
 #define LV_SHADOW_CACHE_SIZE    10240
 #define LV_IMG_CACHE_DEF_SIZE   32
+#define LV_USE_IMG_MIPMAP       1
 #define LV_USE_LOG              1
 #define LV_LOG_LEVEL            LV_LOG_LEVEL_TRACE
 #define LV_LOG_PRINTF           1
 #define LV_USE_FONT_SUBPX       1
 #define LV_FONT_SUBPX_BGR       1
+#define LV_FONT_FMT_TXT_GLYPH_ID_LUT    1
+#define LV_FONT_FMT_TXT_KERN_CACHE_SIZE 32
+#define LV_FONT_LOADER_KERN_CLASSES_MAX_SIZE    4096
+#define LV_TXT_SIZE_CACHE_CNT   32
+#define LV_SPRINTF_USE_FLOAT    1
 #define LV_USE_ASSERT_NULL      1
 #define LV_USE_ASSERT_MALLOC    1
 #define LV_USE_ASSERT_MEM_INTEGRITY     1
@@ -73,6 +82,10 @@
 #define LV_USE_TINY_TTF 1
 #define LV_USE_SYSMON   1
 
+#define LV_USE_DRAW_SW_SIMD 1
+#define LV_DRAW_SW_GLYPH_LUT 1
+#define LV_DRAW_SW_GLYPH_CACHE_SIZE (4 * 1024)
+
 #define LV_BUILD_EXAMPLES       1
 #define LV_USE_DEMO_WIDGETS     1
 #define LV_USE_DEMO_STRESS      1
@@ -0,0 +1,177 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+/*All the RGB565 colors*/
+#define PX_CNT  (256 * 256)
+
+static uint8_t src_buf[PX_CNT * 4 + 16];
+static uint8_t dest_buf[PX_CNT * 4 + 16];
+static uint8_t ref_buf[PX_CNT * 4 + 16];
+static lv_color_t c_out[PX_CNT];
+static lv_color_t c_ref[PX_CNT];
+static lv_opa_t a_out[PX_CNT];
+static lv_opa_t a_ref[PX_CNT];
+
+/*Odd lengths and offsets to test the unaligned parts and the remaining pixels too*/
+static const uint32_t lengths[] = {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 31, 33, 100, 1021, PX_CNT - 3};
+static const uint32_t offsets[] = {0, 1, 2, 3};
+
+/*Fill with all the possible values of the channels*/
+static void src_fill(uint32_t px_size)
+{
+    uint32_t i;
+    uint32_t rnd = 0x1234567;
+    for(i = 0; i < PX_CNT * px_size; i++) {
+        rnd = rnd * 1103515245 + 12345;
+        src_buf[i] = (uint8_t)(rnd >> 16);
+    }
+
+    for(i = 0; i < PX_CNT; i++) {
+        src_buf[i * px_size + 0] = i & 0xFF;
+        src_buf[i * px_size + 1] = i >> 8;
+    }
+}
+
+/*Converting pixels one by one uses the reference scalar code*/
+static void to_native_test(lv_color_format_t cf, uint32_t px_size)
+{
+    src_fill(px_size);
+
+    uint32_t i;
+    for(i = 0; i < PX_CNT; i++) {
+        lv_color_to_native(&src_buf[i * px_size], cf, &c_ref[i], &a_ref[i], lv_color_black(), 1);
+    }
+
+    uint32_t l;
+    uint32_t o;
+    for(l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        for(o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+            uint32_t ofs = offsets[o];
+            uint32_t len = lengths[l];
+            lv_memzero(c_out, sizeof(c_out));
+            lv_memzero(a_out, sizeof(a_out));
+            lv_color_to_native(&src_buf[ofs * px_size], cf, &c_out[ofs], &a_out[ofs], lv_color_black(), len);
+            if(len == 0) continue;
+            TEST_ASSERT_EQUAL_MEMORY(&c_ref[ofs], &c_out[ofs], len * sizeof(lv_color_t));
+            TEST_ASSERT_EQUAL_MEMORY(&a_ref[ofs], &a_out[ofs], len);
+        }
+    }
+}
+
+static void from_native_test(lv_color_format_t cf, bool has_alpha)
+{
+    uint32_t px_size_in = has_alpha ? LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE : sizeof(lv_color_t);
+    uint32_t px_size_out = lv_color_format_get_size(cf);
+    src_fill(px_size_in);
+
+    uint32_t i;
+    for(i = 0; i < PX_CNT; i++) {
+        if(has_alpha) lv_color_from_native_alpha(&src_buf[i * px_size_in], &ref_buf[i * px_size_out], cf, 1);
+        else lv_color_from_native((lv_color_t *)&src_buf[i * px_size_in], &ref_buf[i * px_size_out], cf, 1);
+    }
+
+    uint32_t l;
+    uint32_t o;
+    for(l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        for(o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+            uint32_t ofs = offsets[o];
+            uint32_t len = lengths[l];
+            lv_memzero(dest_buf, sizeof(dest_buf));
+            if(has_alpha) lv_color_from_native_alpha(&src_buf[ofs * px_size_in], &dest_buf[ofs * px_size_out], cf, len);
+            else lv_color_from_native((lv_color_t *)&src_buf[ofs * px_size_in], &dest_buf[ofs * px_size_out], cf, len);
+            if(len == 0) continue;
+            TEST_ASSERT_EQUAL_MEMORY(&ref_buf[ofs * px_size_out], &dest_buf[ofs * px_size_out], len * px_size_out);
+        }
+    }
+
+    /*The rendered buffer is converted in place*/
+    if(px_size_out <= px_size_in) {
+        if(has_alpha) lv_color_from_native_alpha(src_buf, src_buf, cf, PX_CNT);
+        else lv_color_from_native((lv_color_t *)src_buf, src_buf, cf, PX_CNT);
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf, src_buf, PX_CNT * px_size_out);
+    }
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_color_to_native_rgb565(void)
+{
+    to_native_test(LV_COLOR_FORMAT_RGB565, 2);
+}
+
+void test_color_to_native_rgb888(void)
+{
+    to_native_test(LV_COLOR_FORMAT_RGB888, 3);
+}
+
+void test_color_to_native_xrgb8888(void)
+{
+    to_native_test(LV_COLOR_FORMAT_XRGB8888, 4);
+
+    /*The pixels are 4 bytes*/
+    lv_color_t c;
+    lv_opa_t a;
+    const uint8_t px[8] = {0x10, 0x20, 0x30, 0x00, 0x40, 0x50, 0x60, 0x00};
+    lv_color_to_native(&px[4], LV_COLOR_FORMAT_XRGB8888, &c, &a, lv_color_black(), 1);
+    lv_color_to_native(px, LV_COLOR_FORMAT_XRGB8888, c_out, a_out, lv_color_black(), 2);
+    TEST_ASSERT_EQUAL_MEMORY(&c, &c_out[1], sizeof(lv_color_t));
+}
+
+void test_color_to_native_argb8888(void)
+{
+    to_native_test(LV_COLOR_FORMAT_ARGB8888, 4);
+}
+
+void test_color_from_native_rgb565(void)
+{
+    from_native_test(LV_COLOR_FORMAT_RGB565, false);
+}
+
+void test_color_from_native_alpha_rgb565(void)
+{
+    from_native_test(LV_COLOR_FORMAT_RGB565, true);
+}
+
+void test_color_from_native_alpha_a8(void)
+{
+    from_native_test(LV_COLOR_FORMAT_A8, true);
+}
+
+#if LV_USE_DRAW_SW
+void test_color_rgb565_swap(void)
+{
+    uint16_t * src16 = (uint16_t *)src_buf;
+    uint16_t * dest16 = (uint16_t *)dest_buf;
+    uint32_t i;
+    for(i = 0; i < PX_CNT; i++) src16[i] = i;
+
+    uint32_t l;
+    uint32_t o;
+    for(l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        for(o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+            uint32_t ofs = offsets[o];
+            uint32_t len = lengths[l];
+            lv_memcpy(dest16, src16, sizeof(uint16_t) * PX_CNT);
+            lv_draw_sw_rgb565_swap(&dest16[ofs], len);
+            for(i = 0; i < PX_CNT; i++) {
+                uint16_t expected = src16[i];
+                if(i >= ofs && i < ofs + len) expected = (uint16_t)((expected >> 8) | (expected << 8));
+                TEST_ASSERT_EQUAL_HEX16(expected, dest16[i]);
+            }
+        }
+    }
+}
+#endif
+
+#endif
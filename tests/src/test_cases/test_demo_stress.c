@@ -1,6 +1,7 @@
 #if LV_BUILD_TEST
 #include "../lvgl.h"
 #include "../demos/lv_demos.h"
+#include "../src/draw/sw/lv_draw_sw.h"
 
 #include "unity/unity.h"
 
@@ -12,6 +13,11 @@ static void loop_through_stress_test(void)
 #if LV_USE_DEMO_STRESS
     lv_test_indev_wait(LV_DEMO_STRESS_TIME_STEP * 33); /* FIXME: remove magic number of states */
 #endif
+
+    /*The cached arc rings are kept between the refreshes. Free them to start every loop from the same heap.*/
+#if LV_USE_DRAW_SW
+    _lv_draw_sw_arc_cache_cleanup();
+#endif
 }
 void test_demo_stress(void)
 {
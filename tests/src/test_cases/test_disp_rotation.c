@@ -0,0 +1,154 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define HOR_RES 800
+#define VER_RES 480
+
+extern lv_color_t test_fb[];
+
+/*The physical frame buffer of the rotated display*/
+static lv_color_t rot_fb[HOR_RES * VER_RES];
+static lv_color_t rot_draw_buf[HOR_RES * 40];
+static lv_coord_t rot_fb_w;
+static lv_disp_t * rot_disp;
+static lv_obj_t * ref_tall;
+static lv_obj_t * rot_tall;
+
+static void rot_flush_cb(lv_disp_t * disp, const lv_area_t * area, lv_color_t * color_p)
+{
+    for(int y = area->y1; y <= area->y2; y++) {
+        for(int x = area->x1; x <= area->x2; x++) {
+            rot_fb[y * rot_fb_w + x] = *color_p;
+            color_p++;
+        }
+    }
+
+    lv_disp_flush_ready(disp);
+}
+
+/*Add a few asymmetric objects to see if anything is mirrored.
+ *The tall and narrow object is refreshed in square parts when rotated.*/
+static lv_obj_t * content_create(lv_obj_t * scr)
+{
+    lv_obj_t * obj = lv_obj_create(scr);
+    lv_obj_set_size(obj, 333, 171);
+    lv_obj_set_pos(obj, 17, 23);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_RED), 0);
+
+    lv_obj_t * label = lv_label_create(obj);
+    lv_obj_set_width(label, lv_pct(100));
+    lv_label_set_text(label, "Lorem ipsum dolor sit amet, consectetur adipiscing elit, "
+                      "sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. "
+                      "Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris.");
+
+    obj = lv_obj_create(scr);
+    lv_obj_set_size(obj, 207, 95);
+    lv_obj_align(obj, LV_ALIGN_BOTTOM_RIGHT, -31, -7);
+    lv_obj_set_style_bg_grad_color(obj, lv_palette_main(LV_PALETTE_GREEN), 0);
+    lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_HOR, 0);
+
+    obj = lv_obj_create(scr);
+    lv_obj_set_size(obj, 29, 435);
+    lv_obj_set_pos(obj, 501, 11);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_style_bg_grad_color(obj, lv_palette_main(LV_PALETTE_YELLOW), 0);
+    lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_VER, 0);
+    lv_obj_set_style_radius(obj, 0, 0);
+    lv_obj_set_style_border_side(obj, LV_BORDER_SIDE_LEFT, 0);
+
+    return obj;
+}
+
+/*Map the logical coordinates of the rotated display to its physical frame buffer*/
+static void assert_rotated_fb_eq_ref(lv_disp_rotation_t rotation)
+{
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < VER_RES; y++) {
+        for(x = 0; x < HOR_RES; x++) {
+            uint32_t i;
+            switch(rotation) {
+                case LV_DISP_ROTATION_90:
+                    i = (HOR_RES - 1 - x) * VER_RES + y;
+                    break;
+                case LV_DISP_ROTATION_180:
+                    i = (VER_RES - 1 - y) * HOR_RES + HOR_RES - 1 - x;
+                    break;
+                case LV_DISP_ROTATION_270:
+                    i = x * VER_RES + VER_RES - 1 - y;
+                    break;
+                default:
+                    i = y * HOR_RES + x;
+                    break;
+            }
+
+            if(memcmp(&rot_fb[i], &test_fb[y * HOR_RES + x], sizeof(lv_color_t))) {
+                char buf[64];
+                lv_snprintf(buf, sizeof(buf), "Pixel mismatch at %d;%d", (int)x, (int)y);
+                TEST_FAIL_MESSAGE(buf);
+            }
+        }
+    }
+}
+
+static void test_rotation(lv_disp_rotation_t rotation)
+{
+    lv_disp_t * ref_disp = lv_disp_get_default();
+
+    bool swap = rotation == LV_DISP_ROTATION_90 || rotation == LV_DISP_ROTATION_270;
+    rot_fb_w = swap ? VER_RES : HOR_RES;
+    rot_disp = lv_disp_create(rot_fb_w, swap ? HOR_RES : VER_RES);
+    lv_disp_set_draw_buffers(rot_disp, rot_draw_buf, NULL, sizeof(rot_draw_buf), LV_DISP_RENDER_MODE_PARTIAL);
+    lv_disp_set_flush_cb(rot_disp, rot_flush_cb);
+    lv_disp_set_rotation(rot_disp, rotation, true);
+    TEST_ASSERT_EQUAL(HOR_RES, lv_disp_get_hor_res(rot_disp));
+    TEST_ASSERT_EQUAL(VER_RES, lv_disp_get_ver_res(rot_disp));
+
+    ref_tall = content_create(lv_disp_get_scr_act(ref_disp));
+    rot_tall = content_create(lv_disp_get_scr_act(rot_disp));
+
+    lv_obj_invalidate(lv_disp_get_scr_act(ref_disp));
+    lv_refr_now(ref_disp);
+    lv_refr_now(rot_disp);
+    assert_rotated_fb_eq_ref(rotation);
+
+    /*Refresh only a tall and narrow area*/
+    lv_obj_set_style_bg_grad_color(ref_tall, lv_palette_main(LV_PALETTE_ORANGE), 0);
+    lv_obj_set_style_bg_grad_color(rot_tall, lv_palette_main(LV_PALETTE_ORANGE), 0);
+    lv_refr_now(ref_disp);
+    lv_refr_now(rot_disp);
+    assert_rotated_fb_eq_ref(rotation);
+}
+
+void setUp(void)
+{
+    lv_memzero(rot_fb, sizeof(rot_fb));
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    if(rot_disp) {
+        lv_disp_remove(rot_disp);
+        rot_disp = NULL;
+    }
+}
+
+void test_disp_rotation_90(void)
+{
+    test_rotation(LV_DISP_ROTATION_90);
+}
+
+void test_disp_rotation_180(void)
+{
+    test_rotation(LV_DISP_ROTATION_180);
+}
+
+void test_disp_rotation_270(void)
+{
+    test_rotation(LV_DISP_ROTATION_270);
+}
+
+#endif
@@ -0,0 +1,101 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define HOR_RES 64
+#define VER_RES 48
+#define PX_SIZE LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE
+
+static uint8_t transp_buf[HOR_RES * VER_RES * PX_SIZE];
+static lv_disp_t * transp_disp;
+static lv_area_t flushed_area;
+static uint32_t flush_cnt;
+
+static void transp_flush_cb(lv_disp_t * disp, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(color_p);
+    flushed_area = *area;
+    flush_cnt++;
+    lv_disp_flush_ready(disp);
+}
+
+/*Refresh only `area` on a buffer filled with a `0x55` pattern.
+ *Return the number of pixels in the buffer which were touched.
+ *The flushed area might be a little larger than `area`.*/
+static uint32_t refr_area(lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_memset(transp_buf, 0x55, sizeof(transp_buf));
+    flush_cnt = 0;
+    lv_obj_invalidate_area(obj, area);
+    lv_refr_now(transp_disp);
+    TEST_ASSERT_EQUAL_UINT32(1, flush_cnt);
+    TEST_ASSERT_TRUE(_lv_area_is_in(area, &flushed_area, 0));
+
+    uint32_t i;
+    for(i = 0; i < sizeof(transp_buf) / PX_SIZE; i++) {
+        uint32_t j;
+        for(j = 0; j < PX_SIZE; j++) {
+            if(transp_buf[i * PX_SIZE + j] != 0x55) break;
+        }
+        if(j < PX_SIZE) continue;
+        /*All the pixels after the first untouched one has to be untouched too*/
+        for(j = i * PX_SIZE; j < sizeof(transp_buf); j++) {
+            TEST_ASSERT_EQUAL_HEX8(0x55, transp_buf[j]);
+        }
+        break;
+    }
+    return i;
+}
+
+void setUp(void)
+{
+    transp_disp = lv_disp_create(HOR_RES, VER_RES);
+    lv_disp_set_draw_buffers(transp_disp, transp_buf, NULL, sizeof(transp_buf), LV_DISP_RENDER_MODE_PARTIAL);
+    lv_disp_set_flush_cb(transp_disp, transp_flush_cb);
+    lv_disp_set_color_format(transp_disp, LV_COLOR_FORMAT_NATIVE_ALPHA);
+    lv_obj_set_style_bg_opa(lv_disp_get_scr_act(transp_disp), LV_OPA_TRANSP, 0);
+    lv_refr_now(transp_disp);
+}
+
+void tearDown(void)
+{
+    lv_disp_remove(transp_disp);
+    transp_disp = NULL;
+}
+
+void test_disp_transp_clear_invalidated_area(void)
+{
+    lv_area_t area = {5, 7, 20, 11};
+    uint32_t px_cnt = refr_area(lv_disp_get_scr_act(transp_disp), &area);
+
+    /*Only the pixels of the refreshed area are cleared*/
+    TEST_ASSERT_EQUAL_UINT32(lv_area_get_size(&flushed_area), px_cnt);
+    uint32_t i;
+    for(i = 0; i < px_cnt * PX_SIZE; i++) {
+        TEST_ASSERT_EQUAL_HEX8(0x00, transp_buf[i]);
+    }
+}
+
+void test_disp_transp_covered_area(void)
+{
+    /*An opaque object covers the invalidated area so it's not cleared but drawn directly*/
+    lv_obj_t * obj = lv_obj_create(lv_disp_get_scr_act(transp_disp));
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x102030), 0);
+    lv_obj_set_pos(obj, 5, 5);
+    lv_obj_set_size(obj, 40, 30);
+    lv_refr_now(transp_disp);
+
+    lv_area_t area = {15, 15, 20, 18};
+    uint32_t px_cnt = refr_area(obj, &area);
+
+    TEST_ASSERT_EQUAL_UINT32(lv_area_get_size(&flushed_area), px_cnt);
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        TEST_ASSERT_EQUAL_HEX8(LV_OPA_COVER, transp_buf[i * PX_SIZE + PX_SIZE - 1]);
+    }
+}
+
+#endif
@@ -0,0 +1,271 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw_gradient.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW && _DITHER_GRADIENT
+
+/*Odd sizes to test the remaining pixels of the vector code too*/
+#define GRAD_W  203
+#define GRAD_H  97
+
+static lv_grad_dsc_t dsc;
+static lv_color_t ref_map[GRAD_W > GRAD_H ? GRAD_W : GRAD_H];
+static lv_scolor24_t ref_acc[GRAD_W];
+
+static const uint8_t ref_matrix[8 * 8] = {
+    0,  48, 12, 60,  3, 51, 15, 63,
+    32, 16, 44, 28, 35, 19, 47, 31,
+    8,  56,  4, 52, 11, 59,  7, 55,
+    40, 24, 36, 20, 43, 27, 39, 23,
+    2,  50, 14, 62,  1, 49, 13, 61,
+    34, 18, 46, 30, 33, 17, 45, 29,
+    10, 58,  6, 54,  9, 57,  5, 53,
+    42, 26, 38, 22, 41, 25, 37, 21
+};
+
+/*The reference, pixel by pixel implementations*/
+static lv_color_t ref_ordered_px(lv_color32_t c, int32_t factor)
+{
+    return lv_color_make(LV_CLAMP(0, c.red + factor, 255), LV_CLAMP(0, c.green + factor, 255),
+                         LV_CLAMP(0, c.blue + factor, 255));
+}
+
+static void ref_ordered_hor(lv_grad_t * grad, lv_coord_t y, lv_coord_t w)
+{
+    for(lv_coord_t j = 0; j < w; j++) {
+        int32_t factor = ref_matrix[(y & 7) * 8 + (j & 7)] - 32;
+        ref_map[j] = ref_ordered_px(grad->hmap[LV_CLAMP(0, j - 4, grad->size)], factor);
+    }
+}
+
+static void ref_ordered_ver(lv_grad_t * grad, lv_coord_t x, lv_coord_t y, lv_coord_t w)
+{
+    lv_color32_t c = grad->hmap[LV_CLAMP(0, y - 4, grad->size)];
+    for(lv_coord_t j = 0; j < w; j++) {
+        int32_t factor = ref_matrix[(y & 7) * 8 + ((j + x) & 7)] - 32;
+        ref_map[j] = ref_ordered_px(c, factor);
+    }
+}
+
+static lv_scolor24_t ref_quant_error(lv_color32_t t, lv_color_t q)
+{
+    lv_color32_t u = lv_color_to32(q);
+    lv_scolor24_t e;
+    e.r = (int8_t)(t.red - u.red);
+    e.g = (int8_t)(t.green - u.green);
+    e.b = (int8_t)(t.blue - u.blue);
+    return e;
+}
+
+static void ref_err_diff_hor(lv_grad_t * grad)
+{
+    lv_scolor24_t next_px_err = {0, 0, 0};
+    lv_scolor24_t next_l = {0, 0, 0};
+    ref_map[0] = lv_color_make(grad->hmap[0].red, grad->hmap[0].green, grad->hmap[0].blue);
+    for(lv_coord_t x = 1; x < grad->size - 1; x++) {
+        lv_color32_t t = grad->hmap[x];
+        t.red = LV_CLAMP(0, t.red + next_px_err.r + next_l.r, 255);
+        t.green = LV_CLAMP(0, t.green + next_px_err.g + next_l.g, 255);
+        t.blue = LV_CLAMP(0, t.blue + next_px_err.b + next_l.b, 255);
+        next_l = ref_acc[x + 1];
+
+        lv_color_t q = lv_color_make(t.red, t.green, t.blue);
+        lv_scolor24_t e = ref_quant_error(t, q);
+        next_px_err.r = (e.r * 7) >> 4;
+        next_px_err.g = (e.g * 7) >> 4;
+        next_px_err.b = (e.b * 7) >> 4;
+        ref_acc[x - 1].r += (e.r * 3) >> 4;
+        ref_acc[x - 1].g += (e.g * 3) >> 4;
+        ref_acc[x - 1].b += (e.b * 3) >> 4;
+        ref_acc[x].r += (e.r * 5) >> 4;
+        ref_acc[x].g += (e.g * 5) >> 4;
+        ref_acc[x].b += (e.b * 5) >> 4;
+        ref_acc[x + 1].r = e.r >> 4;
+        ref_acc[x + 1].g = e.g >> 4;
+        ref_acc[x + 1].b = e.b >> 4;
+        ref_map[x] = q;
+    }
+    lv_color32_t last = grad->hmap[grad->size - 1];
+    ref_map[grad->size - 1] = lv_color_make(last.red, last.green, last.blue);
+}
+
+static lv_color32_t ref_add_err(lv_color32_t t, lv_scolor24_t px, lv_scolor24_t prev, lv_scolor24_t acc)
+{
+    t.red = LV_CLAMP(0, t.red + ((px.r * 6 + prev.r + acc.r * 9) >> 4), 255);
+    t.green = LV_CLAMP(0, t.green + ((px.g * 6 + prev.g + acc.g * 9) >> 4), 255);
+    t.blue = LV_CLAMP(0, t.blue + ((px.b * 6 + prev.b + acc.b * 9) >> 4), 255);
+    return t;
+}
+
+static void ref_err_diff_ver(lv_grad_t * grad, lv_coord_t xs, lv_coord_t y, lv_coord_t w)
+{
+    lv_color32_t c = grad->hmap[y];
+    lv_scolor24_t prev_l = ref_acc[0];
+    ref_map[0] = lv_color_make(c.red, c.green, c.blue);
+    lv_scolor24_t next_px_err = ref_quant_error(c, ref_map[0]);
+    if(xs != 0) {
+        lv_color32_t t = ref_add_err(c, next_px_err, prev_l, ref_acc[0]);
+        ref_map[0] = lv_color_make(t.red, t.green, t.blue);
+    }
+
+    for(lv_coord_t x = 1; x < w; x++) {
+        lv_color32_t t = ref_add_err(c, next_px_err, prev_l, ref_acc[x]);
+        prev_l = ref_acc[x];
+        lv_color_t q = lv_color_make(t.red, t.green, t.blue);
+        next_px_err = ref_quant_error(t, q);
+        ref_acc[x] = next_px_err;
+        ref_map[x] = q;
+    }
+}
+
+static lv_grad_t * grad_get(lv_grad_dir_t dir, lv_dither_mode_t dither)
+{
+    dsc.dir = dir;
+    dsc.dither = dither;
+    lv_grad_t * grad = lv_gradient_get(&dsc, GRAD_W, GRAD_H);
+    TEST_ASSERT_NOT_NULL(grad);
+    lv_memzero(ref_acc, sizeof(ref_acc));
+    return grad;
+}
+
+void setUp(void)
+{
+    dsc.stops_count = 2;
+    dsc.stops[0].color = lv_color_hex(0x102030);
+    dsc.stops[0].frac = 0;
+    dsc.stops[1].color = lv_color_hex(0xf0e0a0);
+    dsc.stops[1].frac = 255;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_dither_ordered_hor(void)
+{
+    lv_grad_t * grad = grad_get(LV_GRAD_DIR_HOR, LV_DITHER_ORDERED);
+
+    /*The second round uses the cached rows*/
+    lv_coord_t y;
+    for(y = 0; y < 2 * GRAD_H; y++) {
+        lv_dither_ordered_hor(grad, 0, y, GRAD_W);
+        ref_ordered_hor(grad, y, GRAD_W);
+        TEST_ASSERT_EQUAL_MEMORY(ref_map, grad->map, GRAD_W * sizeof(lv_color_t));
+    }
+    lv_gradient_cleanup(grad);
+
+    /*Without cached rows*/
+    grad = grad_get(LV_GRAD_DIR_HOR, LV_DITHER_NONE);
+    TEST_ASSERT_NULL(grad->dither_rows);
+    for(y = 0; y < 8; y++) {
+        lv_dither_ordered_hor(grad, 0, y, GRAD_W);
+        ref_ordered_hor(grad, y, GRAD_W);
+        TEST_ASSERT_EQUAL_MEMORY(ref_map, grad->map, GRAD_W * sizeof(lv_color_t));
+    }
+    lv_gradient_cleanup(grad);
+}
+
+void test_dither_ordered_ver(void)
+{
+    lv_grad_t * grad = grad_get(LV_GRAD_DIR_VER, LV_DITHER_ORDERED);
+    static const lv_coord_t xs[] = {0, 3, 13};
+    static const lv_coord_t ws[] = {1, 7, 8, 9, 17, 64, GRAD_W};
+    for(uint32_t i = 0; i < sizeof(xs) / sizeof(xs[0]); i++) {
+        for(uint32_t j = 0; j < sizeof(ws) / sizeof(ws[0]); j++) {
+            for(lv_coord_t y = 0; y < GRAD_H; y++) {
+                lv_dither_ordered_ver(grad, xs[i], y, ws[j]);
+                ref_ordered_ver(grad, xs[i], y, ws[j]);
+                TEST_ASSERT_EQUAL_MEMORY(ref_map, grad->map, ws[j] * sizeof(lv_color_t));
+            }
+        }
+    }
+    lv_gradient_cleanup(grad);
+}
+
+#if LV_DRAW_SW_GRADIENT_DITHER_ERROR_DIFFUSION
+void test_dither_err_diff_hor(void)
+{
+    lv_grad_t * grad = grad_get(LV_GRAD_DIR_HOR, LV_DITHER_ERR_DIFF);
+    for(lv_coord_t y = 0; y < GRAD_H; y++) {
+        lv_dither_err_diff_hor(grad, 0, y, GRAD_W);
+        ref_err_diff_hor(grad);
+        TEST_ASSERT_EQUAL_MEMORY(ref_map, grad->map, GRAD_W * sizeof(lv_color_t));
+        TEST_ASSERT_EQUAL_MEMORY(ref_acc, grad->error_acc, sizeof(ref_acc));
+    }
+    lv_gradient_cleanup(grad);
+}
+
+void test_dither_err_diff_ver(void)
+{
+    lv_grad_t * grad = grad_get(LV_GRAD_DIR_VER, LV_DITHER_ERR_DIFF);
+    for(lv_coord_t y = 0; y < GRAD_H; y++) {
+        lv_coord_t x = y < GRAD_H / 2 ? 0 : 5;
+        lv_dither_err_diff_ver(grad, x, y, GRAD_W);
+        ref_err_diff_ver(grad, x, y, GRAD_W);
+        TEST_ASSERT_EQUAL_MEMORY(ref_map, grad->map, GRAD_W * sizeof(lv_color_t));
+        TEST_ASSERT_EQUAL_MEMORY(ref_acc, grad->error_acc, sizeof(ref_acc));
+    }
+    lv_gradient_cleanup(grad);
+}
+#else
+void test_dither_err_diff_hor(void)
+{
+}
+
+void test_dither_err_diff_ver(void)
+{
+}
+#endif
+
+/*Draw the dithered gradients too to see if the rows are used correctly*/
+void test_dither_draw(void)
+{
+    static const lv_dither_mode_t modes[] = {LV_DITHER_NONE, LV_DITHER_ORDERED, LV_DITHER_ERR_DIFF};
+    for(uint32_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+        lv_obj_t * obj = lv_obj_create(lv_scr_act());
+        lv_obj_set_size(obj, 301, 155);
+        lv_obj_set_pos(obj, 10 + i * 200, 10 + i * 150);
+        lv_obj_set_style_bg_grad_color(obj, lv_color_hex(0x00ff00), 0);
+        lv_obj_set_style_bg_grad_dir(obj, i == 1 ? LV_GRAD_DIR_HOR : LV_GRAD_DIR_VER, 0);
+        lv_obj_set_style_bg_dither_mode(obj, modes[i], 0);
+    }
+    lv_refr_now(NULL);
+    lv_obj_clean(lv_scr_act());
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_dither_ordered_hor(void)
+{
+}
+
+void test_dither_ordered_ver(void)
+{
+}
+
+void test_dither_err_diff_hor(void)
+{
+}
+
+void test_dither_err_diff_ver(void)
+{
+}
+
+void test_dither_draw(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,192 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define BUF_SIZE    (800 * 480 * sizeof(lv_color_t))
+
+#if LV_USE_BIDI
+
+static uint8_t buf_ref[BUF_SIZE];
+static lv_draw_label_bidi_cache_t bidi_cache;
+static bool use_cache;
+static lv_base_dir_t base_dir;
+static uint32_t sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
+static uint32_t sel_end = LV_DRAW_LABEL_NO_TXT_SEL;
+static char * txt;
+
+/*Mixed LTR and RTL runs. RLO makes the latin letters RTL too to see the reordering*/
+static const char * txt_part = "Left (to) right "LV_BIDI_RLO"right to left [123] "LV_BIDI_LRO"back 456 "
+                               LV_BIDI_RLO"again, <abc> "LV_BIDI_LRO"end.\n";
+
+static void draw_event_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.font = &lv_font_montserrat_14;
+    dsc.bidi_dir = base_dir;
+    dsc.align = LV_TEXT_ALIGN_RIGHT;
+    dsc.sel_start = sel_start;
+    dsc.sel_end = sel_end;
+    dsc.sel_color = lv_color_white();
+    dsc.bidi_cache = use_cache ? &bidi_cache : NULL;
+
+    lv_draw_label(draw_ctx, &dsc, &obj->coords, txt, NULL);
+}
+
+/*Compare the screen drawn with and without the cache*/
+static void compare_with_uncached(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+
+    use_cache = false;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+    lv_memcpy(buf_ref, disp->draw_buf_act, BUF_SIZE);
+
+    /*The first draw fills the cache and the second uses it*/
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        use_cache = true;
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(disp);
+        TEST_ASSERT_TRUE(bidi_cache.bidi_txt != NULL || bidi_cache.no_rtl);
+        TEST_ASSERT_EQUAL_MEMORY(buf_ref, disp->draw_buf_act, BUF_SIZE);
+    }
+}
+
+static lv_obj_t * obj_create(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, 300, 460);
+    lv_obj_add_event(obj, draw_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+    return obj;
+}
+
+void setUp(void)
+{
+    /*A long RTL text*/
+    uint32_t part_len = lv_strlen(txt_part);
+    uint32_t part_cnt = 20;
+    txt = lv_malloc(part_len * part_cnt + 1);
+    uint32_t i;
+    for(i = 0; i < part_cnt; i++) {
+        lv_memcpy(&txt[i * part_len], txt_part, part_len);
+    }
+    txt[part_len * part_cnt] = '\0';
+
+    lv_memzero(&bidi_cache, sizeof(bidi_cache));
+    base_dir = LV_BASE_DIR_RTL;
+    sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
+    sel_end = LV_DRAW_LABEL_NO_TXT_SEL;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_draw_label_bidi_cache_free(&bidi_cache);
+    lv_free(txt);
+}
+
+void test_draw_label_bidi_cache(void)
+{
+    obj_create();
+    compare_with_uncached();
+}
+
+void test_draw_label_bidi_cache_sel(void)
+{
+    obj_create();
+    compare_with_uncached();
+    TEST_ASSERT_NULL(bidi_cache.logical_pos);
+
+    /*The selection needs the logical positions too*/
+    sel_start = 30;
+    sel_end = 300;
+    compare_with_uncached();
+    TEST_ASSERT_NOT_NULL(bidi_cache.logical_pos);
+}
+
+void test_draw_label_bidi_cache_width(void)
+{
+    lv_obj_t * obj = obj_create();
+    compare_with_uncached();
+
+    /*The lines break at other places*/
+    lv_obj_set_width(obj, 180);
+    compare_with_uncached();
+    TEST_ASSERT_EQUAL(180, bidi_cache.w);
+}
+
+void test_draw_label_bidi_cache_ltr(void)
+{
+    /*LTR texts without RTL characters are drawn without processing*/
+    lv_snprintf(txt, lv_strlen(txt) + 1, "%s", "Left to right (123) [only]. Lorem ipsum dolor sit amet, consectetur "
+                "adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.");
+    base_dir = LV_BASE_DIR_LTR;
+    sel_start = 10;
+    sel_end = 40;
+    obj_create();
+    compare_with_uncached();
+    TEST_ASSERT_TRUE(bidi_cache.no_rtl);
+    TEST_ASSERT_NULL(bidi_cache.bidi_txt);
+}
+
+void test_draw_label_bidi_cache_label(void)
+{
+#if LV_LABEL_BIDI_CACHE
+    /*The label owns a cache which is updated with the text*/
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 300);
+    lv_obj_set_style_base_dir(label, LV_BASE_DIR_RTL, 0);
+    lv_label_set_text(label, txt);
+    lv_refr_now(NULL);
+
+    lv_label_t * l = (lv_label_t *)label;
+    TEST_ASSERT_EQUAL_PTR(l->text, l->bidi_cache.txt);
+    TEST_ASSERT_NOT_NULL(l->bidi_cache.bidi_txt);
+
+    lv_label_set_text(label, "abc "LV_BIDI_RLO"def");
+    TEST_ASSERT_NULL(l->bidi_cache.bidi_txt);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_STRING("abc "LV_BIDI_RLO"def", l->bidi_cache.txt);
+#endif
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_label_bidi_cache(void)
+{
+}
+
+void test_draw_label_bidi_cache_sel(void)
+{
+}
+
+void test_draw_label_bidi_cache_width(void)
+{
+}
+
+void test_draw_label_bidi_cache_ltr(void)
+{
+}
+
+void test_draw_label_bidi_cache_label(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,108 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define FB_SIZE (800 * 480)
+
+extern lv_color_t test_fb[];
+
+static lv_color_t fb_ref[FB_SIZE];
+static lv_obj_t * obj;
+
+static void render(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void setUp(void)
+{
+    /*Start with an empty pool*/
+    lv_draw_layer_buf_pool_set_size(NULL, 0);
+    lv_draw_layer_buf_pool_set_size(NULL, 200 * 1024);
+
+    obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 150, 100);
+    lv_obj_center(obj);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_style_opa(obj, LV_OPA_50, 0);
+}
+
+void tearDown(void)
+{
+    lv_draw_layer_buf_pool_set_size(NULL, LV_DRAW_LAYER_BUF_POOL_SIZE);
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_draw_layer_buf_pool_reuse(void)
+{
+    lv_draw_layer_buf_pool_stats_t stats;
+
+    render();
+    lv_draw_layer_buf_pool_get_stats(NULL, &stats);
+    uint32_t alloc_cnt = stats.alloc_cnt;
+    TEST_ASSERT_GREATER_THAN_UINT32(0, alloc_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.buf_cnt);
+    lv_memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    /*The buffers of the first frame are used again*/
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        render();
+        TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+    }
+
+    lv_draw_layer_buf_pool_get_stats(NULL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(alloc_cnt, stats.alloc_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(5, stats.reuse_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(stats.max_size, stats.used_size);
+}
+
+void test_draw_layer_buf_pool_transformed(void)
+{
+    lv_obj_set_style_transform_angle(obj, 150, 0);
+    lv_draw_layer_buf_pool_stats_t stats;
+
+    render();
+    lv_draw_layer_buf_pool_get_stats(NULL, &stats);
+    uint32_t alloc_cnt = stats.alloc_cnt;
+    lv_memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    render();
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+    lv_draw_layer_buf_pool_get_stats(NULL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(alloc_cnt, stats.alloc_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.reuse_cnt);
+}
+
+void test_draw_layer_buf_pool_budget(void)
+{
+    lv_draw_layer_buf_pool_stats_t stats;
+
+    /*Nothing is kept, all the buffers are allocated*/
+    lv_draw_layer_buf_pool_set_size(NULL, 0);
+    lv_draw_layer_buf_pool_stats_t stats_start;
+    lv_draw_layer_buf_pool_get_stats(NULL, &stats_start);
+    render();
+    render();
+    lv_draw_layer_buf_pool_get_stats(NULL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(stats_start.reuse_cnt, stats.reuse_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.buf_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.used_size);
+    TEST_ASSERT_GREATER_THAN_UINT32(stats_start.alloc_cnt, stats.alloc_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats.alloc_cnt - stats_start.alloc_cnt, stats.drop_cnt - stats_start.drop_cnt);
+
+    /*Shrinking the pool frees the kept buffers*/
+    lv_draw_layer_buf_pool_set_size(NULL, 200 * 1024);
+    render();
+    lv_draw_layer_buf_pool_get_stats(NULL, &stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.used_size);
+
+    lv_draw_layer_buf_pool_set_size(NULL, 0);
+    lv_draw_layer_buf_pool_get_stats(NULL, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.buf_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.used_size);
+}
+
+#endif
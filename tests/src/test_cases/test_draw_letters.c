@@ -0,0 +1,105 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define BUF_SIZE    (800 * 480 * sizeof(lv_color_t))
+
+static uint8_t buf_ref[BUF_SIZE];
+
+static lv_obj_t * label_create(lv_obj_t * parent, const lv_font_t * font, lv_opa_t opa, lv_coord_t letter_space)
+{
+    lv_obj_t * label = lv_label_create(parent);
+    lv_label_set_recolor(label, true);
+    lv_label_set_text(label, "Quick brown fox #ff0000 jumps# over\nthe lazy dog. AVAWATo 0123456789 {[(#&@)]}");
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_obj_set_style_text_opa(label, opa, 0);
+    lv_obj_set_style_text_letter_space(label, letter_space, 0);
+    return label;
+}
+
+/*Compare the screen drawn with `draw_letters` and letter by letter*/
+static void compare_with_letters(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_draw_ctx_t * draw_ctx = disp->draw_ctx;
+    TEST_ASSERT_NOT_NULL(draw_ctx->draw_letters);
+
+    void (*draw_letters)(lv_draw_ctx_t *, const lv_draw_label_dsc_t *, const lv_point_t *, const uint32_t *,
+                         uint32_t) = draw_ctx->draw_letters;
+
+    draw_ctx->draw_letters = NULL;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+    lv_memcpy(buf_ref, disp->draw_buf_act, BUF_SIZE);
+
+    draw_ctx->draw_letters = draw_letters;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL_MEMORY(buf_ref, disp->draw_buf_act, BUF_SIZE);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_draw_letters_normal(void)
+{
+    label_create(lv_scr_act(), &lv_font_montserrat_14, LV_OPA_COVER, 0);
+    compare_with_letters();
+}
+
+void test_draw_letters_opa(void)
+{
+    label_create(lv_scr_act(), &lv_font_montserrat_28, LV_OPA_50, 0);
+    compare_with_letters();
+}
+
+void test_draw_letters_overlap(void)
+{
+    label_create(lv_scr_act(), &lv_font_montserrat_20, LV_OPA_COVER, -6);
+    compare_with_letters();
+}
+
+void test_draw_letters_overlap_opa(void)
+{
+    label_create(lv_scr_act(), &lv_font_montserrat_20, LV_OPA_70, -6);
+    compare_with_letters();
+}
+
+void test_draw_letters_1bpp(void)
+{
+    label_create(lv_scr_act(), &lv_font_unscii_8, LV_OPA_COVER, -2);
+    compare_with_letters();
+}
+
+#if LV_USE_FONT_COMPRESSED
+void test_draw_letters_compressed(void)
+{
+    label_create(lv_scr_act(), &lv_font_montserrat_28_compressed, LV_OPA_COVER, -3);
+    compare_with_letters();
+}
+#endif
+
+void test_draw_letters_clip_corner(void)
+{
+    /*Masks and clipping by the parent*/
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 300, 80);
+    lv_obj_set_style_radius(cont, 40, 0);
+    lv_obj_set_style_clip_corner(cont, true, 0);
+    lv_obj_set_style_pad_all(cont, 0, 0);
+
+    lv_obj_t * label = label_create(cont, &lv_font_montserrat_28, LV_OPA_COVER, 0);
+    lv_obj_set_pos(label, -20, -10);
+
+    compare_with_letters();
+}
+
+#endif
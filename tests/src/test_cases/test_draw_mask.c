@@ -0,0 +1,140 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+/*All the combinations of two mask values*/
+#define MAP_W   256
+#define MAP_H   256
+
+static lv_opa_t map[MAP_W * MAP_H];
+static lv_opa_t mask_buf[MAP_W + 16];
+
+static lv_opa_t ref_mix(lv_opa_t mask_act, lv_opa_t mask_new)
+{
+    if(mask_new >= LV_OPA_MAX) return mask_act;
+    if(mask_new <= LV_OPA_MIN) return 0;
+    return (uint32_t)mask_act * mask_new / 255;
+}
+
+void setUp(void)
+{
+    uint32_t i;
+    for(i = 0; i < MAP_W * MAP_H; i++) map[i] = i / MAP_W;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_draw_mask_get_span(void)
+{
+    lv_coord_t span;
+    uint32_t ofs;
+    /*Different offsets to test the unaligned parts too*/
+    for(ofs = 0; ofs < 4; ofs++) {
+        lv_opa_t * buf = &mask_buf[ofs];
+        lv_memset(buf, 0x00, 37);
+        lv_memset(&buf[37], 0xff, 40);
+        buf[77] = 0x80;
+        buf[78] = 0x01;
+        buf[79] = 0x00;
+        buf[80] = 0xfe;
+
+        TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_TRANSP, lv_draw_mask_get_span(buf, 81, &span));
+        TEST_ASSERT_EQUAL(37, span);
+        TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_FULL_COVER, lv_draw_mask_get_span(&buf[37], 44, &span));
+        TEST_ASSERT_EQUAL(40, span);
+        TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_CHANGED, lv_draw_mask_get_span(&buf[77], 4, &span));
+        TEST_ASSERT_EQUAL(2, span);
+        TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_TRANSP, lv_draw_mask_get_span(&buf[79], 2, &span));
+        TEST_ASSERT_EQUAL(1, span);
+        TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_CHANGED, lv_draw_mask_get_span(&buf[80], 1, &span));
+        TEST_ASSERT_EQUAL(1, span);
+
+        /*Don't read after the end*/
+        TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_FULL_COVER, lv_draw_mask_get_span(&buf[37], 7, &span));
+        TEST_ASSERT_EQUAL(7, span);
+    }
+}
+
+#if LV_USE_DRAW_MASKS
+
+void test_draw_mask_map(void)
+{
+    lv_area_t coords = {0, 0, MAP_W - 1, MAP_H - 1};
+    lv_draw_mask_map_param_t mp;
+    lv_draw_mask_map_init(&mp, &coords, map);
+    int16_t id = lv_draw_mask_add(&mp, NULL);
+
+    lv_coord_t y;
+    uint32_t x;
+    uint32_t ofs;
+    for(ofs = 0; ofs < 4; ofs++) {
+        lv_opa_t * buf = &mask_buf[ofs];
+        for(y = 0; y < MAP_H; y++) {
+            /*The current mask value is the x coordinate*/
+            for(x = 0; x < MAP_W; x++) buf[x] = x;
+            lv_draw_mask_res_t res = lv_draw_mask_apply(buf, 0, y, MAP_W);
+            if(y <= LV_OPA_MIN) {
+                TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_TRANSP, res);
+                continue;
+            }
+
+            TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_CHANGED, res);
+            for(x = 0; x < MAP_W; x++) {
+                TEST_ASSERT_EQUAL_UINT8(ref_mix(x, y), buf[x]);
+            }
+        }
+    }
+
+    /*An opaque row on an opaque mask is fully covered*/
+    lv_memset(mask_buf, 0xff, MAP_W);
+    TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_FULL_COVER, lv_draw_mask_apply(mask_buf, 0, MAP_H - 1, MAP_W));
+
+    lv_draw_mask_remove_id(id);
+}
+
+void test_draw_mask_fade(void)
+{
+    lv_area_t coords = {0, 0, MAP_W - 1, MAP_H - 1};
+    lv_draw_mask_fade_param_t mp;
+    lv_draw_mask_fade_init(&mp, &coords, LV_OPA_COVER, 0, LV_OPA_TRANSP, MAP_H - 1);
+    int16_t id = lv_draw_mask_add(&mp, NULL);
+
+    lv_coord_t y;
+    uint32_t x;
+    for(y = 0; y < MAP_H; y++) {
+        for(x = 0; x < MAP_W; x++) mask_buf[x + 1] = x;
+        lv_draw_mask_apply(&mask_buf[1], 0, y, MAP_W);
+
+        lv_opa_t opa;
+        if(y == 0) opa = LV_OPA_COVER;
+        else if(y == MAP_H - 1) opa = LV_OPA_TRANSP;
+        else opa = (lv_opa_t)(((int32_t)y * -255) / MAP_H + 255);
+        for(x = 0; x < MAP_W; x++) {
+            TEST_ASSERT_EQUAL_UINT8(ref_mix(x, opa), mask_buf[x + 1]);
+        }
+    }
+
+    /*The fully transparent part is reported as transparent*/
+    lv_memset(mask_buf, 0xff, MAP_W);
+    TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_TRANSP, lv_draw_mask_apply(mask_buf, 0, MAP_H - 1, MAP_W));
+
+    lv_draw_mask_remove_id(id);
+}
+
+#else
+
+void test_draw_mask_map(void)
+{
+}
+
+void test_draw_mask_fade(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,194 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define ROW_LEN     128
+#define CANVAS_W    64
+
+static lv_opa_t mask_buf[ROW_LEN];
+#if LV_COLOR_DEPTH == 32
+static lv_color_t canvas_buf[CANVAS_W * CANVAS_W];
+#endif
+
+/*Get the mask of a row starting from x = 0*/
+static lv_draw_mask_res_t get_row(lv_draw_mask_polygon_param_t * mp, lv_coord_t y)
+{
+    lv_memset(mask_buf, 0xff, sizeof(mask_buf));
+    lv_draw_mask_res_t res = mp->dsc.cb(mask_buf, 0, y, ROW_LEN, mp);
+    if(res == LV_DRAW_MASK_RES_TRANSP) lv_memzero(mask_buf, sizeof(mask_buf));
+    return res;
+}
+
+/*Sum of the opacity of all the pixels in units of full pixels*/
+static uint32_t get_area(lv_draw_mask_polygon_param_t * mp)
+{
+    uint32_t sum = 0;
+    lv_coord_t y;
+    for(y = 0; y < ROW_LEN; y++) {
+        get_row(mp, y);
+        uint32_t x;
+        for(x = 0; x < ROW_LEN; x++) sum += mask_buf[x];
+    }
+    return (sum + 127) / 255;
+}
+
+static void init_star(lv_point_t * points)
+{
+    /*Pentagram drawn with one continuous line, the center is surrounded twice*/
+    lv_point_t star[] = {{50, 10}, {74, 85}, {11, 38}, {89, 38}, {26, 85}};
+    lv_memcpy(points, star, sizeof(star));
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_draw_polygon_square(void)
+{
+    lv_point_t points[] = {{10, 10}, {20, 10}, {20, 20}, {10, 20}};
+    lv_draw_mask_polygon_param_t mp;
+    lv_draw_mask_polygon_init(&mp, points, 4);
+
+    TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_TRANSP, get_row(&mp, 9));
+    TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_CHANGED, get_row(&mp, 15));
+
+    /*The points are in the middle of the pixels so the edges are half covered*/
+    TEST_ASSERT_EQUAL_UINT8(0, mask_buf[9]);
+    TEST_ASSERT_UINT8_WITHIN(1, 128, mask_buf[10]);
+    TEST_ASSERT_EQUAL_UINT8(255, mask_buf[11]);
+    TEST_ASSERT_EQUAL_UINT8(255, mask_buf[19]);
+    TEST_ASSERT_UINT8_WITHIN(1, 128, mask_buf[20]);
+    TEST_ASSERT_EQUAL_UINT8(0, mask_buf[21]);
+
+    /*The corners are quarter covered*/
+    get_row(&mp, 10);
+    TEST_ASSERT_UINT8_WITHIN(1, 64, mask_buf[10]);
+    TEST_ASSERT_UINT8_WITHIN(1, 128, mask_buf[15]);
+
+    TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_TRANSP, get_row(&mp, 21));
+    TEST_ASSERT_EQUAL_UINT32(100, get_area(&mp));
+
+    /*Fully covered if the whole row is inside*/
+    lv_memset(mask_buf, 0xff, sizeof(mask_buf));
+    TEST_ASSERT_EQUAL(LV_DRAW_MASK_RES_FULL_COVER, mp.dsc.cb(mask_buf, 12, 15, 5, &mp));
+
+    lv_draw_mask_free_param(&mp);
+}
+
+void test_draw_polygon_concave(void)
+{
+    /*A "C" shape*/
+    lv_point_t points[] = {{0, 0}, {30, 0}, {30, 10}, {10, 10}, {10, 20}, {30, 20}, {30, 30}, {0, 30}};
+    lv_draw_mask_polygon_param_t mp;
+    lv_draw_mask_polygon_init(&mp, points, 8);
+
+    get_row(&mp, 15);
+    TEST_ASSERT_EQUAL_UINT8(255, mask_buf[5]);
+    TEST_ASSERT_UINT8_WITHIN(1, 128, mask_buf[10]);
+    TEST_ASSERT_EQUAL_UINT8(0, mask_buf[11]);
+    TEST_ASSERT_EQUAL_UINT8(0, mask_buf[25]);
+
+    get_row(&mp, 5);
+    TEST_ASSERT_EQUAL_UINT8(255, mask_buf[5]);
+    TEST_ASSERT_EQUAL_UINT8(255, mask_buf[25]);
+
+    TEST_ASSERT_EQUAL_UINT32(30 * 30 - 20 * 10, get_area(&mp));
+
+    lv_draw_mask_free_param(&mp);
+}
+
+void test_draw_polygon_fill_rule(void)
+{
+    lv_point_t points[5];
+    init_star(points);
+
+    lv_draw_mask_polygon_param_t mp;
+    lv_draw_mask_polygon_init(&mp, points, 5);
+    get_row(&mp, 50);
+    TEST_ASSERT_EQUAL_UINT8(255, mask_buf[50]);
+    uint32_t area_non_zero = get_area(&mp);
+
+    mp.cfg.fill_rule = LV_DRAW_POLYGON_FILL_EVEN_ODD;
+    get_row(&mp, 50);
+    TEST_ASSERT_EQUAL_UINT8(0, mask_buf[50]);
+    /*The arms are still filled*/
+    TEST_ASSERT_EQUAL_UINT8(255, mask_buf[30]);
+    TEST_ASSERT_LESS_THAN_UINT32(area_non_zero, get_area(&mp));
+
+    lv_draw_mask_free_param(&mp);
+}
+
+void test_draw_polygon_many_points(void)
+{
+    /*A circle with 500 points. Also check the rows in random order to test rebuilding the active edges.*/
+    static lv_point_t points[500];
+    uint32_t i;
+    for(i = 0; i < 500; i++) {
+        int32_t angle = (i * 360) / 500;
+        points[i].x = 64 + ((lv_trigo_cos(angle) * 60) >> LV_TRIGO_SHIFT);
+        points[i].y = 64 + ((lv_trigo_sin(angle) * 60) >> LV_TRIGO_SHIFT);
+    }
+
+    lv_draw_mask_polygon_param_t mp;
+    lv_draw_mask_polygon_init(&mp, points, 500);
+
+    /*Around 60 * 60 * 3.14*/
+    TEST_ASSERT_UINT32_WITHIN(200, 11310, get_area(&mp));
+
+    static lv_opa_t rows_ref[ROW_LEN][ROW_LEN];
+    lv_coord_t y;
+    for(y = 0; y < ROW_LEN; y++) {
+        get_row(&mp, y);
+        lv_memcpy(rows_ref[y], mask_buf, ROW_LEN);
+    }
+
+    for(i = 0; i < 200; i++) {
+        y = (i * 37) % ROW_LEN;
+        get_row(&mp, y);
+        TEST_ASSERT_EQUAL_MEMORY(rows_ref[y], mask_buf, ROW_LEN);
+    }
+
+    lv_draw_mask_free_param(&mp);
+}
+
+#if LV_COLOR_DEPTH == 32
+void test_draw_polygon_canvas(void)
+{
+    lv_obj_t * canvas = lv_canvas_create(lv_scr_act());
+    lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_W, LV_COLOR_FORMAT_NATIVE);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    lv_point_t points[5];
+    init_star(points);
+    for(uint32_t i = 0; i < 5; i++) {
+        points[i].x = points[i].x / 2;
+        points[i].y = points[i].y / 2;
+    }
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_make(0xff, 0, 0);
+    dsc.fill_rule = LV_DRAW_POLYGON_FILL_EVEN_ODD;
+    lv_canvas_draw_polygon(canvas, points, 5, &dsc);
+
+    /*The center is empty with even-odd but the arms are filled*/
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to_int(lv_color_white()), lv_color_to_int(canvas_buf[25 * CANVAS_W + 25]));
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to_int(dsc.bg_color), lv_color_to_int(canvas_buf[25 * CANVAS_W + 16]));
+
+    dsc.fill_rule = LV_DRAW_POLYGON_FILL_NON_ZERO;
+    lv_canvas_draw_polygon(canvas, points, 5, &dsc);
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to_int(dsc.bg_color), lv_color_to_int(canvas_buf[25 * CANVAS_W + 25]));
+}
+#else
+void test_draw_polygon_canvas(void)
+{
+}
+#endif
+
+#endif
@@ -0,0 +1,257 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+#include "../src/misc/lv_gc.h"
+
+#include "unity/unity.h"
+
+#if LV_COLOR_DEPTH == 32
+
+#define CANVAS_W    100
+
+static lv_color_t canvas_buf[CANVAS_W * CANVAS_W];
+static lv_color_t canvas_buf_ref[CANVAS_W * CANVAS_W];
+static lv_obj_t * canvas;
+static lv_draw_arc_dsc_t dsc;
+
+static void draw_arc(lv_coord_t radius, int32_t start_angle, int32_t end_angle)
+{
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+    lv_canvas_draw_arc(canvas, CANVAS_W / 2, CANVAS_W / 2, radius, start_angle, end_angle, &dsc);
+}
+
+#if LV_USE_DRAW_MASKS
+/*Draw the arc into `canvas_buf_ref` by masking a circle as the arcs were drawn earlier*/
+static void draw_arc_with_masks(lv_coord_t radius, int32_t start_angle, int32_t end_angle)
+{
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    lv_area_t area_out;
+    lv_area_set(&area_out, CANVAS_W / 2 - radius, CANVAS_W / 2 - radius, CANVAS_W / 2 + radius - 1,
+                CANVAS_W / 2 + radius - 1);
+    lv_area_t area_in = area_out;
+    lv_area_increase(&area_in, -dsc.width, -dsc.width);
+
+    lv_draw_mask_radius_param_t mask_out;
+    lv_draw_mask_radius_param_t mask_in;
+    lv_draw_mask_angle_param_t mask_angle;
+    lv_draw_mask_radius_init(&mask_out, &area_out, LV_RADIUS_CIRCLE, false);
+    lv_draw_mask_radius_init(&mask_in, &area_in, LV_RADIUS_CIRCLE, true);
+    lv_draw_mask_angle_init(&mask_angle, CANVAS_W / 2, CANVAS_W / 2, start_angle, end_angle);
+    int16_t id_out = lv_draw_mask_add(&mask_out, NULL);
+    int16_t id_in = lv_draw_mask_add(&mask_in, NULL);
+    int16_t id_angle = LV_MASK_ID_INV;
+    if(end_angle - start_angle != 360) id_angle = lv_draw_mask_add(&mask_angle, NULL);
+
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = dsc.color;
+    lv_canvas_draw_rect(canvas, area_out.x1, area_out.y1, lv_area_get_width(&area_out), lv_area_get_height(&area_out),
+                        &rect_dsc);
+
+    if(id_angle != LV_MASK_ID_INV) lv_draw_mask_remove_id(id_angle);
+    lv_draw_mask_remove_id(id_in);
+    lv_draw_mask_remove_id(id_out);
+    lv_draw_mask_free_param(&mask_angle);
+    lv_draw_mask_free_param(&mask_in);
+    lv_draw_mask_free_param(&mask_out);
+
+    lv_memcpy(canvas_buf_ref, canvas_buf, sizeof(canvas_buf));
+}
+#endif
+
+/*Sum of the coverage of the black arc on white background in units of full pixels*/
+static uint32_t get_area(void)
+{
+    uint32_t sum = 0;
+    uint32_t i;
+    for(i = 0; i < CANVAS_W * CANVAS_W; i++) sum += 255 - canvas_buf[i].red;
+    return (sum + 127) / 255;
+}
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_scr_act());
+    lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_W, LV_COLOR_FORMAT_NATIVE);
+
+    lv_draw_arc_dsc_init(&dsc);
+    dsc.color = lv_color_black();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_draw_sw_arc_area(void)
+{
+    /*Full ring: 3.14 * (40 * 40 - 30 * 30)*/
+    dsc.width = 10;
+    draw_arc(40, 0, 360);
+    TEST_ASSERT_UINT32_WITHIN(10, 2199, get_area());
+
+    /*The pixels on the middle of the ring are fully covered, the center is empty*/
+    TEST_ASSERT_EQUAL_UINT8(0, canvas_buf[(CANVAS_W / 2) * CANVAS_W + CANVAS_W / 2 + 35].red);
+    TEST_ASSERT_EQUAL_UINT8(255, canvas_buf[(CANVAS_W / 2) * CANVAS_W + CANVAS_W / 2].red);
+
+    /*Quarter and three quarters*/
+    draw_arc(40, 0, 90);
+    TEST_ASSERT_UINT32_WITHIN(5, 550, get_area());
+    draw_arc(40, 90, 360);
+    TEST_ASSERT_UINT32_WITHIN(5, 1649, get_area());
+
+    /*Pie with too large width*/
+    dsc.width = 100;
+    draw_arc(20, 0, 360);
+    TEST_ASSERT_UINT32_WITHIN(5, 1257, get_area());
+}
+
+void test_draw_sw_arc_rounded(void)
+{
+    dsc.width = 10;
+    draw_arc(40, 30, 150);
+    uint32_t area_flat = get_area();
+
+    /*Two half circles are added on the ends: 3.14 * 5 * 5*/
+    dsc.rounded = 1;
+    draw_arc(40, 30, 150);
+    TEST_ASSERT_UINT32_WITHIN(5, area_flat + 79, get_area());
+}
+
+#if LV_USE_DRAW_MASKS
+void test_draw_sw_arc_same_as_masks(void)
+{
+    static const int32_t arcs[][4] = {
+        /*radius, width, start angle, end angle*/
+        {45, 10, 0, 360},
+        {30, 1, 0, 360},
+        {40, 40, 0, 360},
+        {45, 8, 20, 110},
+        {45, 8, 300, 45},
+        {25, 12, 135, 45},
+        {48, 3, 181, 359},
+    };
+
+    uint32_t i;
+    for(i = 0; i < sizeof(arcs) / sizeof(arcs[0]); i++) {
+        dsc.width = arcs[i][1];
+        draw_arc_with_masks(arcs[i][0], arcs[i][2], arcs[i][3]);
+        draw_arc(arcs[i][0], arcs[i][2], arcs[i][3]);
+
+        /*Only the anti-aliasing can be slightly different*/
+        uint32_t diff_sum = 0;
+        uint32_t p;
+        for(p = 0; p < CANVAS_W * CANVAS_W; p++) {
+            int32_t diff = LV_ABS(canvas_buf[p].red - canvas_buf_ref[p].red);
+            TEST_ASSERT_LESS_THAN_INT32(96, diff);
+            diff_sum += diff;
+        }
+        TEST_ASSERT_LESS_THAN_UINT32(CANVAS_W * 255, diff_sum);
+    }
+}
+#else
+void test_draw_sw_arc_same_as_masks(void)
+{
+}
+#endif
+
+void test_draw_sw_arc_img(void)
+{
+    /*The arc is filled with a black image*/
+    static lv_color_t img_map[60 * 60];
+    uint32_t i;
+    for(i = 0; i < 60 * 60; i++) img_map[i] = lv_color_black();
+    lv_img_dsc_t img_dsc;
+    lv_memzero(&img_dsc, sizeof(img_dsc));
+    img_dsc.header.cf = LV_COLOR_FORMAT_NATIVE;
+    img_dsc.header.w = 60;
+    img_dsc.header.h = 60;
+    img_dsc.data_size = sizeof(img_map);
+    img_dsc.data = (const uint8_t *)img_map;
+
+    dsc.width = 8;
+    dsc.rounded = 1;
+    draw_arc(30, 10, 250);
+    lv_memcpy(canvas_buf_ref, canvas_buf, sizeof(canvas_buf));
+
+    /*The coverage is applied as a mask map so there can be small rounding differences*/
+    dsc.img_src = &img_dsc;
+    draw_arc(30, 10, 250);
+    for(i = 0; i < CANVAS_W * CANVAS_W; i++) {
+        TEST_ASSERT_UINT8_WITHIN(3, canvas_buf_ref[i].red, canvas_buf[i].red);
+    }
+}
+
+void test_draw_sw_arc_cache(void)
+{
+    dsc.width = 12;
+    dsc.rounded = 1;
+    draw_arc(35, 200, 20);
+    lv_memcpy(canvas_buf_ref, canvas_buf, sizeof(canvas_buf));
+
+    /*Drawn again from the cache*/
+    draw_arc(35, 200, 20);
+    TEST_ASSERT_EQUAL_MEMORY(canvas_buf_ref, canvas_buf, sizeof(canvas_buf));
+
+    /*Evicted from the cache and created again*/
+    lv_coord_t r;
+    for(r = 10; r < 30; r++) draw_arc(r, 0, 90);
+    draw_arc(35, 200, 20);
+    TEST_ASSERT_EQUAL_MEMORY(canvas_buf_ref, canvas_buf, sizeof(canvas_buf));
+}
+
+void test_draw_sw_arc_cache_kept(void)
+{
+#if LV_DRAW_SW_ARC_CACHE_SIZE
+    _lv_draw_sw_arc_cache_cleanup();
+    lv_obj_t * arc = lv_arc_create(lv_scr_act());
+    lv_refr_now(NULL);
+
+    /*The rings are kept between the refreshes to draw e.g. spinners and meters faster*/
+    TEST_ASSERT_NOT_NULL(LV_GC_ROOT(_lv_draw_sw_arc_cache));
+    lv_obj_del(arc);
+    lv_refr_now(NULL);
+    TEST_ASSERT_NOT_NULL(LV_GC_ROOT(_lv_draw_sw_arc_cache));
+
+    _lv_draw_sw_arc_cache_cleanup();
+    TEST_ASSERT_NULL(LV_GC_ROOT(_lv_draw_sw_arc_cache));
+#endif
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_sw_arc_area(void)
+{
+}
+
+void test_draw_sw_arc_rounded(void)
+{
+}
+
+void test_draw_sw_arc_same_as_masks(void)
+{
+}
+
+void test_draw_sw_arc_img(void)
+{
+}
+
+void test_draw_sw_arc_cache(void)
+{
+}
+
+void test_draw_sw_arc_cache_kept(void)
+{
+}
+
+#endif
+
+#endif
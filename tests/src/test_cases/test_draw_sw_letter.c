@@ -0,0 +1,225 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+#define BUF_SIZE    (800 * 480 * sizeof(lv_color_t))
+
+/*Re-encodes the glyphs of a 4 bpp font with an other bpp*/
+typedef struct {
+    const lv_font_t * base;
+    uint8_t level_bpp;      /*Keep `2^level_bpp` opacity levels of the base font*/
+    uint8_t bpp;            /*Encode the glyphs with this bpp*/
+} test_font_dsc_t;
+
+static uint8_t buf_ref[BUF_SIZE];
+static uint8_t glyph_bitmap[64 * 64];
+static test_font_dsc_t font_dsc;
+static lv_font_t font;
+
+static bool get_glyph_dsc_cb(const lv_font_t * f, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                             uint32_t letter_next)
+{
+    const test_font_dsc_t * dsc = f->dsc;
+    if(!dsc->base->get_glyph_dsc(dsc->base, dsc_out, letter, letter_next)) return false;
+    dsc_out->bpp = dsc->bpp;
+    return true;
+}
+
+static const uint8_t * get_glyph_bitmap_cb(const lv_font_t * f, uint32_t letter)
+{
+    const test_font_dsc_t * dsc = f->dsc;
+    lv_font_glyph_dsc_t g;
+    if(!dsc->base->get_glyph_dsc(dsc->base, &g, letter, '\0')) return NULL;
+    const uint8_t * src = dsc->base->get_glyph_bitmap(dsc->base, letter);
+    if(src == NULL) return NULL;
+
+    uint32_t px_cnt = g.box_w * g.box_h;
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(glyph_bitmap), px_cnt);
+    lv_memzero(glyph_bitmap, sizeof(glyph_bitmap));
+
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        uint32_t px = (src[i >> 1] >> (i & 1 ? 0 : 4)) & 0xF;
+        px = px >> (4 - dsc->level_bpp);
+        if(dsc->bpp == 8) {
+            /*The same opacity the `dsc->level_bpp` bpp glyph would have*/
+            glyph_bitmap[i] = px * 255 / ((1 << dsc->level_bpp) - 1);
+        }
+        else {
+            uint32_t bit_ofs = i * dsc->bpp;
+            glyph_bitmap[bit_ofs >> 3] |= px << (8 - dsc->bpp - (bit_ofs & 0x7));
+        }
+    }
+
+    return glyph_bitmap;
+}
+
+static void font_init(const lv_font_t * base, uint8_t level_bpp, uint8_t bpp)
+{
+    font_dsc.base = base;
+    font_dsc.level_bpp = level_bpp;
+    font_dsc.bpp = bpp;
+
+    font = *base;
+    font.get_glyph_dsc = get_glyph_dsc_cb;
+    font.get_glyph_bitmap = get_glyph_bitmap_cb;
+    font.dsc = &font_dsc;
+    font.fallback = NULL;
+}
+
+/*Labels in a container which clips them at different columns of the glyphs*/
+static void scene_create(const lv_font_t * f, lv_opa_t opa, lv_coord_t letter_space)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, 780, 460);
+    lv_obj_set_pos(cont, 10, 10);
+
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        lv_obj_t * label = lv_label_create(cont);
+        lv_label_set_text(label, "WMAVQ@#%& 0123456789 quick brown fox");
+        lv_obj_set_style_text_font(label, f, 0);
+        lv_obj_set_style_text_opa(label, opa, 0);
+        lv_obj_set_style_text_letter_space(label, letter_space, 0);
+        lv_obj_set_pos(label, -(lv_coord_t)i * 3, i * (lv_font_get_line_height(f) + 3) - 5);
+    }
+}
+
+static void refr_now(bool use_draw_letters)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_draw_ctx_t * draw_ctx = disp->draw_ctx;
+
+    void (*draw_letters)(lv_draw_ctx_t *, const lv_draw_label_dsc_t *, const lv_point_t *, const uint32_t *,
+                         uint32_t) = draw_ctx->draw_letters;
+    if(!use_draw_letters) draw_ctx->draw_letters = NULL;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+    draw_ctx->draw_letters = draw_letters;
+}
+
+/*Compare the `bpp` glyphs with the same glyphs encoded with 8 bpp*/
+static void compare_with_8bpp(const lv_font_t * base, uint8_t bpp, lv_opa_t opa, lv_coord_t letter_space)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        bool use_draw_letters = i == 0;
+        font_init(base, bpp == 1 || bpp == 2 ? bpp : 4, 8);
+        scene_create(&font, opa, letter_space);
+        refr_now(use_draw_letters);
+        lv_memcpy(buf_ref, disp->draw_buf_act, BUF_SIZE);
+
+        font_init(base, bpp == 1 || bpp == 2 ? bpp : 4, bpp);
+        scene_create(&font, opa, letter_space);
+        refr_now(use_draw_letters);
+        TEST_ASSERT_EQUAL_MEMORY(buf_ref, disp->draw_buf_act, BUF_SIZE);
+    }
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_draw_sw_letter_1bpp(void)
+{
+    compare_with_8bpp(&lv_font_montserrat_28, 1, LV_OPA_COVER, 0);
+    compare_with_8bpp(&lv_font_montserrat_28, 1, LV_OPA_60, 0);
+    compare_with_8bpp(&lv_font_montserrat_28, 1, LV_OPA_COVER, -5);
+}
+
+void test_draw_sw_letter_2bpp(void)
+{
+    compare_with_8bpp(&lv_font_montserrat_28, 2, LV_OPA_COVER, 0);
+    compare_with_8bpp(&lv_font_montserrat_28, 2, LV_OPA_60, 0);
+    compare_with_8bpp(&lv_font_montserrat_28, 2, LV_OPA_COVER, -5);
+}
+
+void test_draw_sw_letter_4bpp(void)
+{
+    /*The large glyphs have enough pixels for the SIMD conversion too*/
+    compare_with_8bpp(&lv_font_montserrat_48, 4, LV_OPA_COVER, 0);
+    compare_with_8bpp(&lv_font_montserrat_48, 4, LV_OPA_60, 0);
+    compare_with_8bpp(&lv_font_montserrat_14, 4, LV_OPA_COVER, -3);
+}
+
+void test_draw_sw_letter_opa_change(void)
+{
+    /*The lookup tables are the same for every opacity*/
+    const lv_opa_t opas[] = {LV_OPA_10, LV_OPA_50, LV_OPA_COVER, LV_OPA_90};
+    uint32_t i;
+    for(i = 0; i < sizeof(opas) / sizeof(opas[0]); i++) {
+        compare_with_8bpp(&lv_font_montserrat_28, 1, opas[i], 0);
+        compare_with_8bpp(&lv_font_montserrat_28, 2, opas[i], 0);
+        compare_with_8bpp(&lv_font_montserrat_28, 4, opas[i], 0);
+    }
+}
+
+void test_draw_sw_letter_run_overlap(void)
+{
+    /*The overlapping letters end the runs. The result has to be the same as drawing the letters one by one.*/
+    lv_disp_t * disp = lv_disp_get_default();
+    const lv_coord_t letter_spaces[] = {-12, -5, 0};
+    uint32_t i;
+    for(i = 0; i < sizeof(letter_spaces) / sizeof(letter_spaces[0]); i++) {
+        scene_create(&lv_font_montserrat_28, LV_OPA_60, letter_spaces[i]);
+        refr_now(false);
+        lv_memcpy(buf_ref, disp->draw_buf_act, BUF_SIZE);
+
+        refr_now(true);
+        TEST_ASSERT_EQUAL_MEMORY(buf_ref, disp->draw_buf_act, BUF_SIZE);
+    }
+}
+
+void test_draw_sw_letter_run_buf_pool(void)
+{
+    /*The mask buffers of the letter runs are taken from the layer buffer pool*/
+    lv_draw_layer_buf_pool_set_size(NULL, 64 * 1024);
+    scene_create(&lv_font_montserrat_28, LV_OPA_COVER, 0);
+    refr_now(true);
+
+    lv_draw_layer_buf_pool_stats_t stats;
+    lv_draw_layer_buf_pool_get_stats(NULL, &stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.reuse_cnt);
+    TEST_ASSERT_GREATER_THAN(0, stats.buf_cnt);
+
+    lv_draw_layer_buf_pool_set_size(NULL, LV_DRAW_LAYER_BUF_POOL_SIZE);
+}
+
+void test_draw_sw_letter_glyph_cache(void)
+{
+#if LV_DRAW_SW_GLYPH_CACHE_SIZE
+    /*The glyphs of the test font are not cached. Compare them with the same glyphs from the cache.*/
+    lv_disp_t * disp = lv_disp_get_default();
+    const lv_font_t * fonts[] = {&lv_font_montserrat_14, &lv_font_montserrat_28, &lv_font_montserrat_28_compressed};
+    uint32_t i;
+    for(i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+        font_init(fonts[i], 4, 4);
+        scene_create(&font, LV_OPA_COVER, 0);
+        refr_now(true);
+        lv_memcpy(buf_ref, disp->draw_buf_act, BUF_SIZE);
+
+        /*The larger glyphs don't fit into the cache at once so the old ones are overwritten during the refresh*/
+        lv_draw_sw_glyph_cache_invalidate();
+        scene_create(fonts[i], LV_OPA_COVER, 0);
+        uint32_t j;
+        for(j = 0; j < 2; j++) {
+            refr_now(j == 0);
+            TEST_ASSERT_EQUAL_MEMORY(buf_ref, disp->draw_buf_act, BUF_SIZE);
+        }
+    }
+#endif
+}
+
+#endif
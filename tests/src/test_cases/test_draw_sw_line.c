@@ -0,0 +1,144 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_COLOR_DEPTH == 32
+
+#define CANVAS_W    80
+
+static lv_color_t canvas_buf[CANVAS_W * CANVAS_W];
+static lv_color_t canvas_buf_ref[CANVAS_W * CANVAS_W];
+static lv_obj_t * canvas;
+static lv_draw_line_dsc_t dsc;
+
+static void draw_line(lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2)
+{
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+    lv_point_t points[2] = {{x1, y1}, {x2, y2}};
+    lv_canvas_draw_line(canvas, points, 2, &dsc);
+}
+
+/*Sum of the coverage of the black line on white background in units of full pixels*/
+static uint32_t get_area(void)
+{
+    uint32_t sum = 0;
+    uint32_t i;
+    for(i = 0; i < CANVAS_W * CANVAS_W; i++) sum += 255 - canvas_buf[i].red;
+    return (sum + 127) / 255;
+}
+
+void setUp(void)
+{
+    canvas = lv_canvas_create(lv_scr_act());
+    lv_canvas_set_buffer(canvas, canvas_buf, CANVAS_W, CANVAS_W, LV_COLOR_FORMAT_NATIVE);
+
+    lv_draw_line_dsc_init(&dsc);
+    dsc.color = lv_color_black();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_draw_sw_line_area(void)
+{
+    /*The length of the line is 50*/
+    dsc.width = 5;
+    draw_line(10, 10, 50, 40);
+    TEST_ASSERT_UINT32_WITHIN(5, 5 * 50, get_area());
+
+    /*The pixels on the center line are fully covered, the end points are half covered*/
+    TEST_ASSERT_EQUAL_UINT8(0, canvas_buf[25 * CANVAS_W + 30].red);
+    TEST_ASSERT_UINT8_WITHIN(2, 128, canvas_buf[40 * CANVAS_W + 50].red);
+
+    /*Thin line*/
+    dsc.width = 1;
+    draw_line(10, 10, 50, 40);
+    TEST_ASSERT_UINT32_WITHIN(3, 50, get_area());
+
+    /*Almost horizontal line*/
+    draw_line(5, 20, 75, 23);
+    TEST_ASSERT_UINT32_WITHIN(3, 70, get_area());
+}
+
+void test_draw_sw_line_direction(void)
+{
+    dsc.width = 4;
+    dsc.round_start = 1;
+    draw_line(7, 60, 66, 13);
+    lv_memcpy(canvas_buf_ref, canvas_buf, sizeof(canvas_buf));
+
+    dsc.round_start = 0;
+    dsc.round_end = 1;
+    draw_line(66, 13, 7, 60);
+    TEST_ASSERT_EQUAL_MEMORY(canvas_buf_ref, canvas_buf, sizeof(canvas_buf));
+}
+
+void test_draw_sw_line_endings(void)
+{
+    dsc.width = 10;
+    draw_line(20, 20, 50, 60);
+    uint32_t area_butt = get_area();
+    TEST_ASSERT_UINT32_WITHIN(8, 10 * 50, area_butt);
+
+    /*Half circles on both ends*/
+    dsc.round_start = 1;
+    dsc.round_end = 1;
+    draw_line(20, 20, 50, 60);
+    TEST_ASSERT_UINT32_WITHIN(8, 10 * 50 + 79, get_area());
+
+    /*Extended by half width on both ends*/
+    dsc.round_start = 0;
+    dsc.round_end = 0;
+    dsc.raw_end = 1;
+    draw_line(20, 20, 50, 60);
+    TEST_ASSERT_UINT32_WITHIN(12, 10 * 60, get_area());
+}
+
+void test_draw_sw_line_dash(void)
+{
+    dsc.width = 3;
+    draw_line(10, 10, 50, 40);
+    uint32_t area_solid = get_area();
+
+    dsc.dash_width = 5;
+    dsc.dash_gap = 5;
+    draw_line(10, 10, 50, 40);
+    TEST_ASSERT_UINT32_WITHIN(8, area_solid / 2, get_area());
+
+    /*There is a gap between 5 and 10 pixels from the start*/
+    TEST_ASSERT_EQUAL_UINT8(255, canvas_buf[(10 + 5) * CANVAS_W + (10 + 6)].red);
+    TEST_ASSERT_EQUAL_UINT8(0, canvas_buf[(10 + 2) * CANVAS_W + (10 + 2)].red);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_sw_line_area(void)
+{
+}
+
+void test_draw_sw_line_direction(void)
+{
+}
+
+void test_draw_sw_line_endings(void)
+{
+}
+
+void test_draw_sw_line_dash(void)
+{
+}
+
+#endif
+
+#endif
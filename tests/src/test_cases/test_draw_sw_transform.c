@@ -0,0 +1,257 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_SW && LV_COLOR_DEPTH == 32
+
+#define SRC_W   23
+#define SRC_H   17
+
+static uint8_t src_argb[SRC_W * SRC_H * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE];
+static lv_color_t src_rgb[SRC_W * SRC_H];
+static uint8_t src_a8[SRC_W * SRC_H];
+
+static lv_area_t dest_area;
+static lv_color_t cbuf_act[SRC_W * SRC_H * 9];
+static lv_color_t cbuf_ref[SRC_W * SRC_H * 9];
+static lv_opa_t abuf_act[SRC_W * SRC_H * 9];
+static lv_opa_t abuf_ref[SRC_W * SRC_H * 9];
+
+/*The per-pixel transformation as it was before the span based rewrite*/
+static void ref_transform(const void * src_buf, const lv_draw_img_dsc_t * dsc, lv_color_format_t cf)
+{
+    int32_t angle = -dsc->angle;
+    int32_t zoom = (256 * 256) / dsc->zoom;
+    int32_t angle_low = angle / 10;
+    int32_t angle_rem = angle - (angle_low * 10);
+    int32_t sinma = (lv_trigo_sin(angle_low) * (10 - angle_rem) + lv_trigo_sin(angle_low + 1) * angle_rem) / 10;
+    int32_t cosma = (lv_trigo_sin(angle_low + 90) * (10 - angle_rem) + lv_trigo_sin(angle_low + 91) * angle_rem) / 10;
+    sinma = sinma >> (LV_TRIGO_SHIFT - 10);
+    cosma = cosma >> (LV_TRIGO_SHIFT - 10);
+
+    lv_coord_t dest_w = lv_area_get_width(&dest_area);
+    lv_coord_t dest_h = lv_area_get_height(&dest_area);
+    lv_coord_t y;
+    for(y = 0; y < dest_h; y++) {
+        int32_t p_ups[2][2];
+        int32_t i;
+        for(i = 0; i < 2; i++) {
+            int32_t xin = (i == 0 ? dest_area.x1 : dest_area.x2);
+            int32_t yin = dest_area.y1 + y;
+            if(angle == 0 && zoom == LV_ZOOM_NONE) {
+                p_ups[i][0] = xin * 256;
+                p_ups[i][1] = yin * 256;
+                continue;
+            }
+            xin -= dsc->pivot.x;
+            yin -= dsc->pivot.y;
+            if(angle == 0) {
+                p_ups[i][0] = xin * zoom + dsc->pivot.x * 256;
+                p_ups[i][1] = yin * zoom + dsc->pivot.y * 256;
+            }
+            else if(zoom == LV_ZOOM_NONE) {
+                p_ups[i][0] = ((cosma * xin - sinma * yin) >> 2) + dsc->pivot.x * 256;
+                p_ups[i][1] = ((sinma * xin + cosma * yin) >> 2) + dsc->pivot.y * 256;
+            }
+            else {
+                p_ups[i][0] = (((cosma * xin - sinma * yin) * zoom) >> 10) + dsc->pivot.x * 256;
+                p_ups[i][1] = (((sinma * xin + cosma * yin) * zoom) >> 10) + dsc->pivot.y * 256;
+            }
+        }
+
+        int32_t xs_step = dest_w > 1 ? (256 * (p_ups[1][0] - p_ups[0][0])) / (dest_w - 1) : 0;
+        int32_t ys_step = dest_w > 1 ? (256 * (p_ups[1][1] - p_ups[0][1])) / (dest_w - 1) : 0;
+
+        lv_coord_t x;
+        for(x = 0; x < dest_w; x++) {
+            int32_t xs_ups = p_ups[0][0] + 0x80 + ((xs_step * x) >> 8);
+            int32_t ys_ups = p_ups[0][1] + 0x80 + ((ys_step * x) >> 8);
+            int32_t xs_int = xs_ups >> 8;
+            int32_t ys_int = ys_ups >> 8;
+            uint32_t i_out = y * dest_w + x;
+            if(xs_int < 0 || xs_int >= SRC_W || ys_int < 0 || ys_int >= SRC_H) {
+                abuf_ref[i_out] = 0;
+                continue;
+            }
+
+            int32_t px_size = cf == LV_COLOR_FORMAT_A8 ? 1 : cf == LV_COLOR_FORMAT_NATIVE ? (int32_t)sizeof(lv_color_t) :
+                               LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+            const uint8_t * px = (const uint8_t *)src_buf + (ys_int * SRC_W + xs_int) * px_size;
+
+            if(dsc->antialias == 0) {
+                cbuf_ref[i_out] = *((const lv_color_t *)px);
+                abuf_ref[i_out] = cf == LV_COLOR_FORMAT_NATIVE_ALPHA ? px[3] : 0xff;
+                continue;
+            }
+
+            int32_t xs_fract = xs_ups & 0xFF;
+            int32_t ys_fract = ys_ups & 0xFF;
+            int32_t x_next = xs_fract < 0x80 ? -1 : 1;
+            int32_t y_next = ys_fract < 0x80 ? -1 : 1;
+            xs_fract = xs_fract < 0x80 ? (0x7F - xs_fract) * 2 : (xs_fract - 0x80) * 2;
+            ys_fract = ys_fract < 0x80 ? (0x7F - ys_fract) * 2 : (ys_fract - 0x80) * 2;
+
+            if(xs_int + x_next >= 0 && xs_int + x_next <= SRC_W - 1 &&
+               ys_int + y_next >= 0 && ys_int + y_next <= SRC_H - 1) {
+                const uint8_t * px_hor = px + x_next * px_size;
+                const uint8_t * px_ver = px + y_next * SRC_W * px_size;
+                lv_opa_t a_base = 0xff;
+                lv_opa_t a_ver = 0xff;
+                lv_opa_t a_hor = 0xff;
+                if(cf == LV_COLOR_FORMAT_A8) {
+                    /*The A8 sampler takes the horizontal neighbor as "ver" and vice versa*/
+                    a_base = px[0];
+                    a_ver = px_hor[0];
+                    a_hor = px_ver[0];
+                }
+                else if(cf == LV_COLOR_FORMAT_NATIVE_ALPHA) {
+                    a_base = px[3];
+                    a_ver = px_ver[3];
+                    a_hor = px_hor[3];
+                }
+                if(a_ver != a_base) a_ver = ((a_ver * ys_fract) + (a_base * (0x100 - ys_fract))) >> 8;
+                if(a_hor != a_base) a_hor = ((a_hor * xs_fract) + (a_base * (0x100 - xs_fract))) >> 8;
+                abuf_ref[i_out] = (a_ver + a_hor) >> 1;
+                if(cf == LV_COLOR_FORMAT_A8 || abuf_ref[i_out] == 0) continue;
+
+                lv_color_t c_base = *((const lv_color_t *)px);
+                lv_color_t c_hor = *((const lv_color_t *)px_hor);
+                lv_color_t c_ver = *((const lv_color_t *)px_ver);
+                if(lv_color_eq(c_base, c_ver) && lv_color_eq(c_base, c_hor)) {
+                    cbuf_ref[i_out] = c_base;
+                }
+                else {
+                    c_ver = lv_color_mix(c_ver, c_base, ys_fract);
+                    c_hor = lv_color_mix(c_hor, c_base, xs_fract);
+                    cbuf_ref[i_out] = lv_color_mix(c_hor, c_ver, LV_OPA_50);
+                }
+            }
+            else {
+                lv_opa_t a = cf == LV_COLOR_FORMAT_NATIVE ? 0xff : px[cf == LV_COLOR_FORMAT_A8 ? 0 : 3];
+                if(cf != LV_COLOR_FORMAT_A8) cbuf_ref[i_out] = *((const lv_color_t *)px);
+                if((xs_int == 0 && x_next < 0) || (xs_int == SRC_W - 1 && x_next > 0)) {
+                    abuf_ref[i_out] = (a * (0xFF - xs_fract)) >> 8;
+                }
+                else if((ys_int == 0 && y_next < 0) || (ys_int == SRC_H - 1 && y_next > 0)) {
+                    abuf_ref[i_out] = (a * (0xFF - ys_fract)) >> 8;
+                }
+                else {
+                    abuf_ref[i_out] = 0x00;
+                }
+            }
+        }
+    }
+}
+
+static void compare(lv_color_format_t cf, int16_t angle, uint16_t zoom, bool aa)
+{
+    const void * src_buf;
+    if(cf == LV_COLOR_FORMAT_A8) src_buf = src_a8;
+    else if(cf == LV_COLOR_FORMAT_NATIVE) src_buf = src_rgb;
+    else src_buf = src_argb;
+
+    lv_draw_img_dsc_t dsc;
+    lv_draw_img_dsc_init(&dsc);
+    dsc.angle = angle;
+    dsc.zoom = zoom;
+    dsc.pivot.x = SRC_W / 3;
+    dsc.pivot.y = SRC_H / 2;
+    dsc.antialias = aa;
+
+    lv_draw_img_sup_t sup;
+    lv_memzero(&sup, sizeof(sup));
+
+    lv_memzero(cbuf_act, sizeof(cbuf_act));
+    lv_memzero(cbuf_ref, sizeof(cbuf_ref));
+    lv_memset(abuf_act, 0x55, sizeof(abuf_act));
+    lv_memset(abuf_ref, 0x55, sizeof(abuf_ref));
+
+    lv_draw_sw_transform(NULL, &dest_area, src_buf, SRC_W, SRC_H, SRC_W, &dsc, &sup, cf, cbuf_act, abuf_act);
+    ref_transform(src_buf, &dsc, cf);
+
+    uint32_t px_cnt = lv_area_get_size(&dest_area);
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        TEST_ASSERT_EQUAL_HEX8_MESSAGE(abuf_ref[i], abuf_act[i], "alpha mismatch");
+        if(cf != LV_COLOR_FORMAT_A8 && abuf_ref[i] != 0) {
+            TEST_ASSERT_EQUAL_HEX32_MESSAGE(lv_color_to_int(cbuf_ref[i]), lv_color_to_int(cbuf_act[i]), "color mismatch");
+        }
+    }
+}
+
+void setUp(void)
+{
+    uint32_t rnd = 0x12345678;
+    uint32_t i;
+    for(i = 0; i < SRC_W * SRC_H; i++) {
+        rnd = rnd * 1103515245 + 12345;
+        /*Make some neighbors equal to cover the "no mixing" shortcut too*/
+        uint32_t v = (i % 5 == 0) ? 0x80402010 : rnd;
+        lv_color_set_int(&src_rgb[i], v);
+        lv_memcpy(&src_argb[i * 4], &v, 4);
+        src_a8[i] = (uint8_t)(v >> 24);
+    }
+
+    dest_area.x1 = -SRC_W;
+    dest_area.y1 = -SRC_H;
+    dest_area.x2 = 2 * SRC_W - 1;
+    dest_area.y2 = 2 * SRC_H - 1;
+}
+
+void tearDown(void)
+{
+}
+
+void test_transform_matches_per_pixel_reference(void)
+{
+    static const int16_t angles[] = {0, 1, 15, 450, 900, 1234, 1800, 2700, 3599};
+    static const uint16_t zooms[] = {64, 128, 200, 256, 300, 512};
+    static const lv_color_format_t cfs[] = {LV_COLOR_FORMAT_NATIVE, LV_COLOR_FORMAT_NATIVE_ALPHA, LV_COLOR_FORMAT_A8};
+
+    uint32_t a, z, c;
+    for(c = 0; c < sizeof(cfs) / sizeof(cfs[0]); c++) {
+        for(a = 0; a < sizeof(angles) / sizeof(angles[0]); a++) {
+            for(z = 0; z < sizeof(zooms) / sizeof(zooms[0]); z++) {
+                compare(cfs[c], angles[a], zooms[z], true);
+                if(cfs[c] != LV_COLOR_FORMAT_A8) compare(cfs[c], angles[a], zooms[z], false);
+            }
+        }
+    }
+}
+
+void test_transform_single_column_destination(void)
+{
+    /*With 1 px wide destination area there is no stepping at all*/
+    dest_area.x1 = 5;
+    dest_area.x2 = 5;
+    compare(LV_COLOR_FORMAT_NATIVE_ALPHA, 300, 180, true);
+    compare(LV_COLOR_FORMAT_NATIVE, 300, 180, false);
+
+    dest_area.x1 = -3;
+    dest_area.x2 = -3;
+    compare(LV_COLOR_FORMAT_NATIVE_ALPHA, 0, 256, true);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_transform_matches_per_pixel_reference(void)
+{
+}
+
+void test_transform_single_column_destination(void)
+{
+}
+
+#endif
+
+#endif
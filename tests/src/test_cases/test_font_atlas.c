@@ -0,0 +1,151 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define BUF_SIZE    (800 * 480 * sizeof(lv_color_t))
+
+static const char * txt = "Quick brown fox jumps over\nthe lazy dog. AVAWATo 0123456789 {[(#&@)]} áéőű";
+
+static uint8_t buf_ref[BUF_SIZE];
+static lv_font_t * atlas;
+
+/*Counts how many glyphs are rendered by the base font*/
+static lv_font_t counter_font;
+static uint32_t render_cnt;
+
+static bool counter_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                                  uint32_t letter_next)
+{
+    const lv_font_t * base = font->dsc;
+    return base->get_glyph_dsc(base, dsc_out, letter, letter_next);
+}
+
+static const uint8_t * counter_get_glyph_bitmap(const lv_font_t * font, uint32_t letter)
+{
+    const lv_font_t * base = font->dsc;
+    render_cnt++;
+    return base->get_glyph_bitmap(base, letter);
+}
+
+static void counter_font_init(const lv_font_t * base)
+{
+    counter_font = *base;
+    counter_font.get_glyph_dsc = counter_get_glyph_dsc;
+    counter_font.get_glyph_bitmap = counter_get_glyph_bitmap;
+    counter_font.dsc = base;
+    counter_font.fallback = NULL;
+}
+
+static void label_create(const lv_font_t * font, const char * label_txt)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 780);
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_label_set_text(label, label_txt);
+    lv_obj_center(label);
+}
+
+static void refr_now(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Draw a text with the font and with the atlas of the font and compare them*/
+static void compare_with_atlas(const lv_font_t * font, const char * atlas_txt, const char * label_txt)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+
+    label_create(font, label_txt);
+    refr_now();
+    lv_memcpy(buf_ref, disp->draw_buf_act, BUF_SIZE);
+
+    atlas = lv_font_atlas_create(font, atlas_txt);
+    TEST_ASSERT_NOT_NULL(atlas);
+    label_create(atlas, label_txt);
+    refr_now();
+    TEST_ASSERT_EQUAL_MEMORY(buf_ref, disp->draw_buf_act, BUF_SIZE);
+
+    lv_obj_clean(lv_scr_act());
+    lv_font_atlas_destroy(atlas);
+    atlas = NULL;
+}
+
+void setUp(void)
+{
+    render_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    if(atlas) {
+        lv_font_atlas_destroy(atlas);
+        atlas = NULL;
+    }
+}
+
+void test_font_atlas_first_frame(void)
+{
+    /*Without the atlas the glyphs are rendered when the text is drawn*/
+    counter_font_init(&lv_font_montserrat_20);
+    label_create(&counter_font, txt);
+    refr_now();
+    TEST_ASSERT_GREATER_THAN(0, render_cnt);
+
+    /*With the atlas all of them are rendered in advance*/
+    render_cnt = 0;
+    atlas = lv_font_atlas_create(&counter_font, txt);
+    TEST_ASSERT_NOT_NULL(atlas);
+    uint32_t bitmap_size;
+    uint32_t glyph_cnt = lv_font_atlas_get_glyph_count(atlas, &bitmap_size);
+    TEST_ASSERT_GREATER_THAN(0, render_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(glyph_cnt, render_cnt);
+    TEST_ASSERT_GREATER_THAN(0, bitmap_size);
+
+    render_cnt = 0;
+    label_create(atlas, txt);
+    refr_now();
+    TEST_ASSERT_EQUAL(0, render_cnt);
+}
+
+void test_font_atlas_fallback(void)
+{
+    /*The letters not in the atlas are drawn by the base font*/
+    counter_font_init(&lv_font_montserrat_20);
+    atlas = lv_font_atlas_create(&counter_font, "abc");
+    TEST_ASSERT_EQUAL(3, lv_font_atlas_get_glyph_count(atlas, NULL));
+
+    render_cnt = 0;
+    label_create(atlas, "abcabcXYZ");
+    refr_now();
+    TEST_ASSERT_EQUAL(3, render_cnt);
+
+    lv_obj_clean(lv_scr_act());
+    lv_font_atlas_destroy(atlas);
+    atlas = NULL;
+
+    compare_with_atlas(&lv_font_montserrat_20, "abc", txt);
+}
+
+void test_font_atlas_fmt_txt(void)
+{
+    compare_with_atlas(&lv_font_montserrat_14, txt, txt);
+    compare_with_atlas(&lv_font_unscii_8, txt, txt);                    /*1 bpp*/
+    compare_with_atlas(&lv_font_montserrat_28_compressed, txt, txt);
+}
+
+void test_font_atlas_tiny_ttf(void)
+{
+#if LV_USE_TINY_TTF
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+    lv_font_t * font = lv_tiny_ttf_create_data(ubuntu_font, ubuntu_font_size, 30);
+    compare_with_atlas(font, txt, txt);
+    lv_tiny_ttf_destroy(font);
+#endif
+}
+
+#endif
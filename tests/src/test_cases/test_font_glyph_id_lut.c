@@ -0,0 +1,150 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "lv_test_helpers.h"
+
+#if LV_FONT_FMT_TXT_GLYPH_ID_LUT
+
+#define LETTER_MAX  0x20000
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+/*Compare the glyphs found via the lookup tables with the ones found by searching in the character maps*/
+static void compare_with_cmaps(const lv_font_t * font)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    TEST_ASSERT_NOT_NULL(fdsc->cache);
+
+    /*A copy of the font without cache searches in the character maps*/
+    lv_font_fmt_txt_dsc_t fdsc_ref = *fdsc;
+    fdsc_ref.cache = NULL;
+    lv_font_t font_ref = *font;
+    font_ref.dsc = &fdsc_ref;
+
+    uint32_t found_cnt = 0;
+    uint32_t letter;
+    for(letter = 0; letter < LETTER_MAX; letter++) {
+        lv_font_glyph_dsc_t g;
+        lv_font_glyph_dsc_t g_ref;
+        bool found = lv_font_get_glyph_dsc(font, &g, letter, 0);
+        bool found_ref = lv_font_get_glyph_dsc(&font_ref, &g_ref, letter, 0);
+        TEST_ASSERT_EQUAL(found_ref, found);
+        if(!found) continue;
+
+        found_cnt++;
+        TEST_ASSERT_EQUAL(g_ref.adv_w, g.adv_w);
+        TEST_ASSERT_EQUAL(g_ref.box_w, g.box_w);
+        TEST_ASSERT_EQUAL(g_ref.box_h, g.box_h);
+        TEST_ASSERT_EQUAL(g_ref.ofs_x, g.ofs_x);
+        TEST_ASSERT_EQUAL(g_ref.ofs_y, g.ofs_y);
+
+        /*The bitmaps of the compressed fonts are decompressed into the same buffer*/
+        if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN) {
+            TEST_ASSERT_EQUAL_PTR(lv_font_get_glyph_bitmap(&font_ref, letter), lv_font_get_glyph_bitmap(font, letter));
+        }
+    }
+
+    TEST_ASSERT_NOT_NULL(fdsc->cache->gid_lut);
+    TEST_ASSERT_GREATER_THAN(0, found_cnt);
+}
+
+void test_font_glyph_id_lut_montserrat(void)
+{
+    compare_with_cmaps(&lv_font_montserrat_14);
+    compare_with_cmaps(&lv_font_montserrat_28_compressed);
+    compare_with_cmaps(&lv_font_montserrat_12_subpx);
+}
+
+void test_font_glyph_id_lut_cjk(void)
+{
+    compare_with_cmaps(&lv_font_simsun_16_cjk);
+}
+
+void test_font_glyph_id_lut_persian_hebrew(void)
+{
+    compare_with_cmaps(&lv_font_dejavu_16_persian_hebrew);
+}
+
+void test_font_glyph_id_lut_rebuild(void)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = lv_font_unscii_8.dsc;
+
+    lv_font_build_glyph_id_lut_fmt_txt(&lv_font_unscii_8);
+    TEST_ASSERT_NOT_NULL(fdsc->cache->gid_lut);
+
+    lv_font_free_glyph_id_lut_fmt_txt(&lv_font_unscii_8);
+    TEST_ASSERT_NULL(fdsc->cache->gid_lut);
+
+    /*Built again on the next use*/
+    compare_with_cmaps(&lv_font_unscii_8);
+}
+
+void test_font_glyph_id_lut_release(void)
+{
+    /*Drop the cached text sizes and glyphs as `lv_font_free` does*/
+    lv_font_t * font = lv_font_load("A:src/test_assets/font_1.fnt");
+    TEST_ASSERT_NOT_NULL(font);
+    lv_font_free(font);
+
+    uint32_t mem_before = lv_test_get_free_mem();
+
+    /*The tables of the loaded fonts are built when the font is created and freed with the font*/
+    font = lv_font_load("A:src/test_assets/font_1.fnt");
+    TEST_ASSERT_NOT_NULL(font);
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    TEST_ASSERT_NOT_NULL(fdsc->cache->gid_lut);
+    compare_with_cmaps(font);
+    lv_font_free(font);
+    TEST_ASSERT_EQUAL(mem_before, lv_test_get_free_mem());
+
+    /*The tables of the built-in fonts are kept until they are freed explicitly or by `lv_deinit`*/
+    lv_font_free_glyph_id_lut_fmt_txt(&lv_font_unscii_8);
+    mem_before = lv_test_get_free_mem();
+    lv_font_build_glyph_id_lut_fmt_txt(&lv_font_unscii_8);
+    lv_font_free_glyph_id_lut_fmt_txt(&lv_font_unscii_8);
+    TEST_ASSERT_EQUAL(mem_before, lv_test_get_free_mem());
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_font_glyph_id_lut_montserrat(void)
+{
+}
+
+void test_font_glyph_id_lut_cjk(void)
+{
+}
+
+void test_font_glyph_id_lut_persian_hebrew(void)
+{
+}
+
+void test_font_glyph_id_lut_rebuild(void)
+{
+}
+
+void test_font_glyph_id_lut_release(void)
+{
+}
+
+#endif
+
+#endif
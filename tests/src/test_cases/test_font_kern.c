@@ -0,0 +1,147 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define LETTER_FIRST    0x20
+#define LETTER_LAST     0x7E
+#define PAIR_MAX        (256 * 256)
+
+static uint8_t pair_ids[PAIR_MAX * 2];
+static int8_t pair_values[PAIR_MAX];
+static lv_font_fmt_txt_kern_pair_t kern_pairs;
+static lv_font_fmt_txt_glyph_cache_t cache;
+static lv_font_fmt_txt_dsc_t fdsc;
+static lv_font_t font;
+
+static uint32_t glyph_cnt_get(const lv_font_fmt_txt_dsc_t * dsc)
+{
+    uint32_t cnt = 0;
+    uint32_t i;
+    for(i = 0; i < dsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &dsc->cmaps[i];
+        uint32_t n = cmap->unicode_list ? cmap->list_length : cmap->range_length;
+        cnt = LV_MAX(cnt, cmap->glyph_id_start + n);
+    }
+    return cnt;
+}
+
+/*Create a copy of a font with class based kerning where the kerning is stored as pairs*/
+static void pair_font_create(const lv_font_t * font_ref)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc_ref = font_ref->dsc;
+    const lv_font_fmt_txt_kern_classes_t * kern_classes = fdsc_ref->kern_dsc;
+    TEST_ASSERT_EQUAL(1, fdsc_ref->kern_classes);
+
+    uint32_t glyph_cnt = glyph_cnt_get(fdsc_ref);
+    TEST_ASSERT_LESS_OR_EQUAL(256, glyph_cnt);
+
+    uint32_t pair_cnt = 0;
+    uint32_t l;
+    for(l = 1; l < glyph_cnt; l++) {
+        uint32_t r;
+        for(r = 1; r < glyph_cnt; r++) {
+            uint8_t lc = kern_classes->left_class_mapping[l];
+            uint8_t rc = kern_classes->right_class_mapping[r];
+            if(lc == 0 || rc == 0) continue;
+            int8_t v = kern_classes->class_pair_values[(lc - 1) * kern_classes->right_class_cnt + (rc - 1)];
+            if(v == 0) continue;
+            pair_ids[pair_cnt * 2] = l;
+            pair_ids[pair_cnt * 2 + 1] = r;
+            pair_values[pair_cnt] = v;
+            pair_cnt++;
+        }
+    }
+    TEST_ASSERT_GREATER_THAN(0, pair_cnt);
+
+    kern_pairs.glyph_ids = pair_ids;
+    kern_pairs.values = pair_values;
+    kern_pairs.pair_cnt = pair_cnt;
+    kern_pairs.glyph_ids_size = 0;
+
+    lv_memzero(&cache, sizeof(cache));
+    fdsc = *fdsc_ref;
+    fdsc.kern_dsc = &kern_pairs;
+    fdsc.kern_classes = 0;
+    fdsc.cache = &cache;
+    font = *font_ref;
+    font.dsc = &fdsc;
+}
+
+static void compare_kerning(const lv_font_t * font_act, const lv_font_t * font_ref)
+{
+    uint32_t kerned_cnt = 0;
+    uint32_t round;
+    /*Run twice to read the cached values too*/
+    for(round = 0; round < 2; round++) {
+        uint32_t l;
+        for(l = LETTER_FIRST; l <= LETTER_LAST; l++) {
+            uint32_t r;
+            for(r = LETTER_FIRST; r <= LETTER_LAST; r++) {
+                lv_font_glyph_dsc_t g;
+                lv_font_glyph_dsc_t g_ref;
+                TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font_act, &g, l, r));
+                TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font_ref, &g_ref, l, r));
+                TEST_ASSERT_EQUAL(g_ref.adv_w, g.adv_w);
+
+                lv_font_get_glyph_dsc(font_ref, &g_ref, l, 0);
+                if(g.adv_w != g_ref.adv_w) kerned_cnt++;
+            }
+        }
+    }
+
+    TEST_ASSERT_GREATER_THAN(0, kerned_cnt);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+#if LV_FONT_FMT_TXT_GLYPH_ID_LUT
+    lv_font_free_glyph_id_lut_fmt_txt(&font);
+#endif
+}
+
+void test_font_kern_pairs(void)
+{
+    pair_font_create(&lv_font_montserrat_14);
+    compare_kerning(&font, &lv_font_montserrat_14);
+
+    /*Without cache too*/
+    fdsc.cache = NULL;
+    compare_kerning(&font, &lv_font_montserrat_14);
+    fdsc.cache = &cache;
+}
+
+void test_font_kern_pairs_to_classes(void)
+{
+    pair_font_create(&lv_font_montserrat_14);
+    uint32_t glyph_cnt = glyph_cnt_get(&fdsc);
+
+    /*Doesn't fit*/
+    TEST_ASSERT_NULL(lv_font_kern_pairs_to_classes_fmt_txt(&kern_pairs, glyph_cnt, 16));
+
+    lv_font_fmt_txt_kern_classes_t * kern_classes = lv_font_kern_pairs_to_classes_fmt_txt(&kern_pairs, glyph_cnt,
+                                                                                            UINT32_MAX);
+    TEST_ASSERT_NOT_NULL(kern_classes);
+
+    /*The glyphs with the same kerning share a class so there can't be more classes than in the original font*/
+    const lv_font_fmt_txt_kern_classes_t * kern_classes_ref = ((lv_font_fmt_txt_dsc_t *)
+                                                               lv_font_montserrat_14.dsc)->kern_dsc;
+    TEST_ASSERT_LESS_OR_EQUAL(kern_classes_ref->left_class_cnt, kern_classes->left_class_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(kern_classes_ref->right_class_cnt, kern_classes->right_class_cnt);
+
+    fdsc.kern_dsc = kern_classes;
+    fdsc.kern_classes = 1;
+    compare_kerning(&font, &lv_font_montserrat_14);
+
+    lv_free((void *)kern_classes->class_pair_values);
+    lv_free((void *)kern_classes->left_class_mapping);
+    lv_free((void *)kern_classes->right_class_mapping);
+    lv_free(kern_classes);
+}
+
+#endif
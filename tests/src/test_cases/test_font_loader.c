@@ -25,7 +25,9 @@
  **********************/
 
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2);
+static void compare_glyphs(const lv_font_t * f1, const lv_font_t * f2);
 void test_font_loader(void);
+void test_font_loader_lazy(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -72,6 +74,66 @@ void test_font_loader(void)
     lv_font_free(font_3_bin);
 }
 
+void test_font_loader_lazy(void)
+{
+    lv_font_t * fonts[] = {&font_1, &font_2, &font_3};
+    const char * paths[] = {"A:src/test_assets/font_1.fnt", "A:src/test_assets/font_2.fnt", "A:src/test_assets/font_3.fnt"};
+
+    for(uint32_t i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+        /*Large enough cache for all glyphs and a cache smaller than the glyphs*/
+        lv_font_t * font_bin = lv_font_load_lazy(paths[i], 64 * 1024);
+        TEST_ASSERT_NOT_NULL(font_bin);
+        compare_glyphs(fonts[i], font_bin);
+        compare_glyphs(fonts[i], font_bin);
+        lv_font_free(font_bin);
+
+        font_bin = lv_font_load_lazy(paths[i], 64);
+        TEST_ASSERT_NOT_NULL(font_bin);
+        compare_glyphs(fonts[i], font_bin);
+        lv_font_free(font_bin);
+    }
+
+    /*The bitmaps are not loaded up front*/
+    lv_font_t * font_bin = lv_font_load_lazy("A:src/test_assets/font_1.fnt", 1024);
+    TEST_ASSERT_NOT_NULL(font_bin);
+    TEST_ASSERT_NULL(((lv_font_fmt_txt_dsc_t *)font_bin->dsc)->glyph_bitmap);
+    lv_font_free(font_bin);
+
+    /*Not existing file*/
+    TEST_ASSERT_NULL(lv_font_load_lazy("A:src/test_assets/no_font.fnt", 1024));
+}
+
+static void compare_glyphs(const lv_font_t * f1, const lv_font_t * f2)
+{
+    static uint8_t bitmap1[64 * 64];
+    uint32_t glyph_cnt = 0;
+
+    for(uint32_t letter = 0; letter < 0x10000; letter++) {
+        lv_font_glyph_dsc_t g1;
+        lv_font_glyph_dsc_t g2;
+        bool found = lv_font_get_glyph_dsc(f1, &g1, letter, 0);
+        TEST_ASSERT_EQUAL(found, lv_font_get_glyph_dsc(f2, &g2, letter, 0));
+        if(!found || g1.box_w == 0 || g1.box_h == 0) continue;
+
+        TEST_ASSERT_EQUAL_INT(g1.box_w, g2.box_w);
+        TEST_ASSERT_EQUAL_INT(g1.box_h, g2.box_h);
+
+        /*The compressed bitmaps are decompressed into the same buffer so copy them first*/
+        uint32_t size = (g1.box_w * g1.box_h * g1.bpp + 7) / 8;
+        TEST_ASSERT_LESS_OR_EQUAL(sizeof(bitmap1), size);
+        const uint8_t * bmp1 = lv_font_get_glyph_bitmap(f1, letter);
+        TEST_ASSERT_NOT_NULL(bmp1);
+        lv_memcpy(bitmap1, bmp1, size);
+
+        const uint8_t * bmp2 = lv_font_get_glyph_bitmap(f2, letter);
+        TEST_ASSERT_NOT_NULL(bmp2);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(bitmap1, bmp2, size);
+        glyph_cnt++;
+    }
+
+    TEST_ASSERT_GREATER_THAN(0, glyph_cnt);
+}
+
 static int compare_fonts(lv_font_t * f1, lv_font_t * f2)
 {
     TEST_ASSERT_NOT_NULL_MESSAGE(f1, "font not null");
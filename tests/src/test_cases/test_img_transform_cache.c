@@ -0,0 +1,283 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define IMG_W   40
+#define IMG_H   30
+#define FB_SIZE (800 * 480)
+
+extern lv_color_t test_fb[];
+
+static uint8_t img_map[IMG_W * IMG_H * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE];
+static lv_img_dsc_t img_dsc;
+static lv_color_t fb_ref[FB_SIZE];
+static lv_obj_t * img;
+
+#if LV_USE_IMG_MIPMAP && LV_COLOR_DEPTH == 32
+#define CHECKER_W   64
+static lv_color_t checker_map[CHECKER_W * CHECKER_W];
+static lv_img_dsc_t checker_dsc;
+#endif
+
+static void render(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+#if LV_USE_IMG_MIPMAP && LV_COLOR_DEPTH == 32
+/*Get the bounding box of the pixels which are not white*/
+static void get_drawn_area(lv_area_t * area)
+{
+    lv_area_set(area, 800, 480, -1, -1);
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < 480; y++) {
+        for(x = 0; x < 800; x++) {
+            if(lv_color_to_int(test_fb[y * 800 + x]) == lv_color_to_int(lv_color_white())) continue;
+            area->x1 = LV_MIN(area->x1, x);
+            area->y1 = LV_MIN(area->y1, y);
+            area->x2 = LV_MAX(area->x2, x);
+            area->y2 = LV_MAX(area->y2, y);
+        }
+    }
+}
+#endif
+
+void setUp(void)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(img_map); i++) {
+        img_map[i] = (uint8_t)(i * 37 + (i >> 5));
+    }
+
+    img_dsc.header.cf = LV_COLOR_FORMAT_NATIVE_ALPHA;
+    img_dsc.header.w = IMG_W;
+    img_dsc.header.h = IMG_H;
+    img_dsc.data_size = sizeof(img_map);
+    img_dsc.data = img_map;
+
+    img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &img_dsc);
+    lv_obj_center(img);
+    lv_img_set_angle(img, 300);
+    lv_img_set_zoom(img, 400);
+}
+
+void tearDown(void)
+{
+    lv_img_transform_cache_set_size(0);
+    lv_img_transform_cache_invalidate_src(NULL);
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_img_transform_cache_same_result(void)
+{
+    lv_img_transform_cache_set_size(0);
+    render();
+    lv_memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_img_transform_cache_stats_t stats;
+    lv_img_transform_cache_set_size(64 * 1024);
+    render();
+    lv_img_transform_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+
+    /*Used twice in a row so it's cached now*/
+    render();
+    lv_img_transform_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.entry_cnt);
+    TEST_ASSERT_TRUE(stats.used_size > 0);
+    TEST_ASSERT_TRUE(stats.used_size <= stats.max_size);
+
+    uint32_t hit_prev = stats.hit_cnt;
+    render();
+    lv_img_transform_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(hit_prev + 1, stats.hit_cnt);
+
+    TEST_ASSERT_EQUAL_MEMORY(fb_ref, test_fb, sizeof(fb_ref));
+}
+
+void test_img_transform_cache_changing_transformation(void)
+{
+    lv_img_transform_cache_stats_t stats;
+    lv_img_transform_cache_get_stats(&stats);
+    uint32_t hit_prev = stats.hit_cnt;
+    lv_img_transform_cache_set_size(64 * 1024);
+
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_img_set_angle(img, i * 100);
+        render();
+    }
+
+    lv_img_transform_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(hit_prev, stats.hit_cnt);
+}
+
+void test_img_transform_cache_eviction(void)
+{
+    lv_img_transform_cache_stats_t stats;
+    lv_img_transform_cache_set_size(64 * 1024);
+    render();
+    render();
+    lv_img_transform_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.entry_cnt);
+
+    /*Allow only one entry*/
+    uint32_t entry_size = stats.used_size;
+    uint32_t evict_prev = stats.evict_cnt;
+    lv_img_transform_cache_set_size(entry_size + entry_size / 2);
+
+    lv_img_set_angle(img, 600);
+    render();
+    render();
+    lv_img_transform_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(evict_prev + 1, stats.evict_cnt);
+
+    /*Too large to be cached at all*/
+    lv_img_set_zoom(img, 1024);
+    render();
+    render();
+    lv_img_transform_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.entry_cnt);
+
+    lv_img_cache_invalidate_src(&img_dsc);
+    lv_img_transform_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.used_size);
+}
+
+#if LV_USE_IMG_MIPMAP && LV_COLOR_DEPTH == 32
+void test_img_transform_cache_mipmap(void)
+{
+    /*Red and blue checker board which should be purple when zoomed out*/
+    uint32_t x;
+    uint32_t y;
+    for(y = 0; y < CHECKER_W; y++) {
+        for(x = 0; x < CHECKER_W; x++) {
+            checker_map[y * CHECKER_W + x] = (x + y) & 1 ? lv_color_make(0xff, 0, 0) : lv_color_make(0, 0, 0xff);
+        }
+    }
+
+    checker_dsc.header.cf = LV_COLOR_FORMAT_NATIVE;
+    checker_dsc.header.w = CHECKER_W;
+    checker_dsc.header.h = CHECKER_W;
+    checker_dsc.data_size = sizeof(checker_map);
+    checker_dsc.data = (const uint8_t *)checker_map;
+
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+    lv_img_set_src(img, &checker_dsc);
+    lv_img_set_angle(img, 0);
+    lv_img_set_zoom(img, 64);
+
+    /*Without cache the full resolution image is sampled*/
+    lv_area_t area_ref;
+    render();
+    get_drawn_area(&area_ref);
+
+    lv_img_transform_cache_stats_t stats;
+    lv_img_transform_cache_set_size(64 * 1024);
+    render();
+    lv_img_transform_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.entry_cnt);   /*32x32 and 16x16 levels*/
+
+    lv_area_t area;
+    get_drawn_area(&area);
+    TEST_ASSERT_INT_WITHIN(1, area_ref.x1, area.x1);
+    TEST_ASSERT_INT_WITHIN(1, area_ref.y1, area.y1);
+    TEST_ASSERT_INT_WITHIN(1, area_ref.x2, area.x2);
+    TEST_ASSERT_INT_WITHIN(1, area_ref.y2, area.y2);
+
+    /*The inner pixels are the average of red and blue*/
+    int32_t x_fb;
+    int32_t y_fb;
+    for(y_fb = area.y1 + 2; y_fb <= area.y2 - 2; y_fb++) {
+        for(x_fb = area.x1 + 2; x_fb <= area.x2 - 2; x_fb++) {
+            lv_color_t c = test_fb[y_fb * 800 + x_fb];
+            TEST_ASSERT_INT_WITHIN(2, 0x7f, c.red);
+            TEST_ASSERT_INT_WITHIN(2, 0x7f, c.blue);
+            TEST_ASSERT_EQUAL_UINT8(0, c.green);
+        }
+    }
+
+    /*The levels are reused while zooming*/
+    uint32_t hit_prev = stats.hit_cnt;
+    lv_img_set_zoom(img, 50);
+    render();
+    lv_img_transform_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(hit_prev + 1, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.entry_cnt);
+
+    /*Levels for large zoom out*/
+    lv_img_set_zoom(img, 10);
+    render();
+    lv_img_transform_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.entry_cnt);
+
+    lv_img_cache_invalidate_src(&checker_dsc);
+    lv_img_transform_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+}
+
+void test_img_transform_cache_mipmap_premultiplied(void)
+{
+    /*Semi-transparent red and opaque blue checker board with premultiplied colors*/
+    uint32_t x;
+    uint32_t y;
+    for(y = 0; y < CHECKER_W; y++) {
+        for(x = 0; x < CHECKER_W; x++) {
+            lv_color_t c = (x + y) & 1 ? lv_color_make(0x80, 0, 0) : lv_color_make(0, 0, 0xff);
+            c.alpha = (x + y) & 1 ? 0x80 : 0xff;
+            checker_map[y * CHECKER_W + x] = c;
+        }
+    }
+
+    checker_dsc.header.cf = LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED;
+    checker_dsc.header.w = CHECKER_W;
+    checker_dsc.header.h = CHECKER_W;
+    checker_dsc.data_size = sizeof(checker_map);
+    checker_dsc.data = (const uint8_t *)checker_map;
+
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+    lv_img_set_src(img, &checker_dsc);
+    lv_img_set_angle(img, 0);
+    lv_img_set_zoom(img, 64);
+
+    lv_img_transform_cache_stats_t stats;
+    lv_img_transform_cache_set_size(64 * 1024);
+    render();
+    lv_img_transform_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.entry_cnt);
+
+    /*The premultiplied colors are averaged without weighting them by the alpha again:
+     *(0x40, 0, 0x7f) with 0xc0 alpha blended on white*/
+    lv_area_t area;
+    get_drawn_area(&area);
+    int32_t x_fb;
+    int32_t y_fb;
+    for(y_fb = area.y1 + 2; y_fb <= area.y2 - 2; y_fb++) {
+        for(x_fb = area.x1 + 2; x_fb <= area.x2 - 2; x_fb++) {
+            lv_color_t c = test_fb[y_fb * 800 + x_fb];
+            TEST_ASSERT_INT_WITHIN(3, 0x7f, c.red);
+            TEST_ASSERT_INT_WITHIN(3, 0x3f, c.green);
+            TEST_ASSERT_INT_WITHIN(3, 0xbe, c.blue);
+        }
+    }
+
+    lv_img_cache_invalidate_src(&checker_dsc);
+}
+#else
+void test_img_transform_cache_mipmap(void)
+{
+}
+
+void test_img_transform_cache_mipmap_premultiplied(void)
+{
+}
+#endif
+
+#endif
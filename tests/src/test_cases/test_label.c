@@ -577,4 +577,33 @@ void test_label_text_selection(void)
     TEST_ASSERT_EQUAL(selection_end, end);
 }
 
+void test_label_set_text_fmt(void)
+{
+    lv_label_set_text_fmt(label, "%d.%02d V", 12, 5);
+    TEST_ASSERT_EQUAL_STRING("12.05 V", lv_label_get_text(label));
+
+    /*Shorter and longer texts than the buffer of the previous one*/
+    lv_label_set_text_fmt(label, "%d", 7);
+    TEST_ASSERT_EQUAL_STRING("7", lv_label_get_text(label));
+    lv_label_set_text_fmt(label, "%s %s", long_text, long_text_multiline);
+    TEST_ASSERT_EQUAL_UINT32(strlen(long_text) + 1 + strlen(long_text_multiline), strlen(lv_label_get_text(label)));
+
+    /*A static text is not reused*/
+    lv_label_set_text_static(label, long_text);
+    lv_label_set_text_fmt(label, "0x%04X", 0xBEEF);
+    TEST_ASSERT_EQUAL_STRING("0xBEEF", lv_label_get_text(label));
+}
+
+void test_label_set_text_fmt_own_text(void)
+{
+    /*The label's own text can be an item of the format both for short and long texts*/
+    lv_label_set_text(label, "abc");
+    lv_label_set_text_fmt(label, "%s-%s", lv_label_get_text(label), lv_label_get_text(label));
+    TEST_ASSERT_EQUAL_STRING("abc-abc", lv_label_get_text(label));
+
+    lv_label_set_text_fmt(long_label, "%s|%s", lv_label_get_text(long_label), lv_label_get_text(long_label));
+    TEST_ASSERT_EQUAL_UINT32(2 * strlen(long_text) + 1, strlen(lv_label_get_text(long_label)));
+    TEST_ASSERT_EQUAL_MEMORY(long_text, lv_label_get_text(long_label), strlen(long_text));
+}
+
 #endif
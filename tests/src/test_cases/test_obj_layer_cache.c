@@ -0,0 +1,153 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define FB_SIZE (800 * 480)
+
+extern lv_color_t test_fb[];
+
+static lv_color_t fb_ref[FB_SIZE];
+static lv_obj_t * card;
+static lv_obj_t * label;
+static lv_obj_t * rect;
+
+static void render(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*The layer is blended with alpha so there can be small rounding differences*/
+static void assert_fb_eq_ref(void)
+{
+    uint32_t i;
+    for(i = 0; i < FB_SIZE; i++) {
+        TEST_ASSERT_UINT8_WITHIN(2, fb_ref[i].red, test_fb[i].red);
+        TEST_ASSERT_UINT8_WITHIN(2, fb_ref[i].green, test_fb[i].green);
+        TEST_ASSERT_UINT8_WITHIN(2, fb_ref[i].blue, test_fb[i].blue);
+    }
+}
+
+void setUp(void)
+{
+    lv_obj_layer_cache_set_size(1024 * 1024);
+
+    card = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(card, 300, 200);
+    lv_obj_set_pos(card, 20, 30);
+    lv_obj_set_flex_flow(card, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        label = lv_label_create(card);
+        lv_label_set_text_fmt(label, "Setting %"LV_PRIu32, i);
+    }
+
+    /*Not in the card, but drawn on it*/
+    rect = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(rect, 50, 50);
+    lv_obj_set_pos(rect, 100, 100);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_obj_layer_cache_set_size(LV_OBJ_LAYER_CACHE_SIZE);
+}
+
+void test_obj_layer_cache_same_result(void)
+{
+    render();
+    lv_memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_LAYER);
+    render();
+    assert_fb_eq_ref();
+    render();
+    assert_fb_eq_ref();
+
+    /*Also with opacity*/
+    lv_obj_clear_flag(card, LV_OBJ_FLAG_CACHE_LAYER);
+    lv_obj_set_style_opa(card, LV_OPA_50, 0);
+    render();
+    lv_memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_LAYER);
+    render();
+    assert_fb_eq_ref();
+}
+
+void test_obj_layer_cache_reuse(void)
+{
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_LAYER);
+
+    lv_obj_layer_cache_stats_t stats_start;
+    lv_obj_layer_cache_get_stats(&stats_start);
+    render();
+
+    lv_obj_layer_cache_stats_t stats;
+    lv_obj_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(stats_start.miss_cnt + 1, stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.entry_cnt);
+
+    /*Moving an other object on the card doesn't invalidate the cached layer*/
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        lv_obj_set_x(rect, 110 + i * 10);
+        lv_refr_now(NULL);
+    }
+    lv_obj_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(stats_start.miss_cnt + 1, stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stats_start.hit_cnt + 5, stats.hit_cnt);
+
+    /*Changing a child renders the card again*/
+    lv_label_set_text(label, "Changed");
+    lv_refr_now(NULL);
+    lv_obj_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(stats_start.miss_cnt + 2, stats.miss_cnt);
+    lv_memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    lv_obj_clear_flag(card, LV_OBJ_FLAG_CACHE_LAYER);
+    lv_obj_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.used_size);
+
+    render();
+    assert_fb_eq_ref();
+}
+
+void test_obj_layer_cache_limit(void)
+{
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_LAYER);
+    render();
+    lv_memcpy(fb_ref, test_fb, sizeof(fb_ref));
+
+    /*The card doesn't fit, it's drawn normally*/
+    lv_obj_layer_cache_set_size(10 * 1024);
+    lv_obj_layer_cache_stats_t stats;
+    lv_obj_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+
+    render();
+    assert_fb_eq_ref();
+    lv_obj_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.used_size);
+}
+
+void test_obj_layer_cache_delete(void)
+{
+    lv_obj_add_flag(card, LV_OBJ_FLAG_CACHE_LAYER);
+    render();
+
+    lv_obj_del(card);
+    lv_obj_layer_cache_stats_t stats;
+    lv_obj_layer_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.used_size);
+
+    render();
+}
+
+#endif
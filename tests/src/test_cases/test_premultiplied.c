@@ -0,0 +1,269 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+#define BUF_W   67
+#define BUF_H   41
+#define IMG_W   23
+#define IMG_H   17
+
+/*The error of a color channel in 8 bit due to the lower color depth*/
+#define CH_TOL  (LV_COLOR_DEPTH == 32 ? 1 : 16)
+
+static uint8_t buf_straight[BUF_W * BUF_H * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE];
+static uint8_t buf_premult[BUF_W * BUF_H * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE];
+
+/*Compare the channels in 8 bit so the tolerances are the same for all color depths*/
+static void assert_color_near(lv_color_t expected, lv_color_t actual, int32_t tolerance)
+{
+    lv_color32_t e = lv_color_to32(expected);
+    lv_color32_t a = lv_color_to32(actual);
+    TEST_ASSERT_INT_WITHIN(tolerance, e.red, a.red);
+    TEST_ASSERT_INT_WITHIN(tolerance, e.green, a.green);
+    TEST_ASSERT_INT_WITHIN(tolerance, e.blue, a.blue);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_premultiplied_convert(void)
+{
+    uint32_t px_size = LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE;
+    uint32_t a;
+    for(a = 0; a <= 255; a++) {
+        uint32_t i;
+        for(i = 0; i < 256; i++) {
+            lv_color_t c = lv_color_make(i, 255 - i, (i * 7) & 0xFF);
+            lv_memcpy(&buf_straight[i * px_size], &c, sizeof(lv_color_t));
+            buf_straight[i * px_size + LV_COLOR_FORMAT_NATIVE_ALPHA_OFS] = a;
+        }
+        lv_memcpy(buf_premult, buf_straight, 256 * px_size);
+
+        lv_color_premultiply(buf_premult, 256);
+        for(i = 0; i < 256; i++) {
+            lv_color_t c = lv_color_from_buf(&buf_straight[i * px_size]);
+            lv_color_t p = lv_color_from_buf(&buf_premult[i * px_size]);
+            TEST_ASSERT_EQUAL(a, buf_premult[i * px_size + LV_COLOR_FORMAT_NATIVE_ALPHA_OFS]);
+            assert_color_near(LV_COLOR_MIX(c, lv_color_black(), a), p, CH_TOL);
+        }
+
+        /*The lost precision depends on the alpha*/
+        lv_color_unpremultiply(buf_premult, 256);
+        int32_t tolerance = a ? (255 / a + 1) * CH_TOL : 255;
+        for(i = 0; i < 256; i++) {
+            lv_color_t c = lv_color_from_buf(&buf_straight[i * px_size]);
+            lv_color_t u = lv_color_from_buf(&buf_premult[i * px_size]);
+            if(a == LV_OPA_COVER) TEST_ASSERT_EQUAL_MEMORY(&buf_straight[i * px_size], &buf_premult[i * px_size], px_size);
+            else assert_color_near(c, u, tolerance);
+        }
+    }
+
+    /*The split version gives the same result*/
+    lv_color_t c_buf[256];
+    lv_opa_t a_buf[256];
+    uint32_t i;
+    for(i = 0; i < 256; i++) {
+        c_buf[i] = lv_color_make(i, i / 2, 255 - i);
+        a_buf[i] = i;
+        lv_memcpy(&buf_premult[i * px_size], &c_buf[i], sizeof(lv_color_t));
+        buf_premult[i * px_size + LV_COLOR_FORMAT_NATIVE_ALPHA_OFS] = a_buf[i];
+    }
+    lv_color_unpremultiply(buf_premult, 256);
+    lv_color_unpremultiply_split(c_buf, a_buf, 256);
+    for(i = 0; i < 256; i++) {
+        assert_color_near(lv_color_from_buf(&buf_premult[i * px_size]), c_buf[i], 0);
+    }
+}
+
+#if LV_USE_DRAW_SW && LV_COLOR_DEPTH == 32
+
+static lv_draw_sw_ctx_t sw_ctx;
+static lv_area_t buf_area = {0, 0, BUF_W - 1, BUF_H - 1};
+static uint8_t img_straight[IMG_W * IMG_H * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE];
+static uint8_t img_premult[IMG_W * IMG_H * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE];
+
+static lv_draw_ctx_t * draw_ctx_init(uint8_t * buf, lv_color_format_t cf)
+{
+    lv_draw_ctx_t * draw_ctx = (lv_draw_ctx_t *)&sw_ctx;
+    lv_draw_sw_init_ctx(NULL, draw_ctx);
+    draw_ctx->buf = buf;
+    draw_ctx->buf_area = &buf_area;
+    draw_ctx->clip_area = &buf_area;
+    draw_ctx->color_format = cf;
+    return draw_ctx;
+}
+
+/*Semi-transparent and masked shapes overlapping each other*/
+static void draw_scene(uint8_t * buf, lv_color_format_t cf)
+{
+    lv_memzero(buf, sizeof(buf_straight));
+    lv_draw_ctx_t * draw_ctx = draw_ctx_init(buf, cf);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_palette_main(LV_PALETTE_RED);
+    dsc.bg_opa = 160;
+    dsc.radius = 12;
+    dsc.border_width = 3;
+    dsc.border_color = lv_palette_main(LV_PALETTE_YELLOW);
+    dsc.border_opa = 200;
+    lv_area_t a1 = {3, 2, 40, 30};
+    lv_draw_rect(draw_ctx, &dsc, &a1);
+
+    dsc.bg_color = lv_palette_main(LV_PALETTE_BLUE);
+    dsc.bg_grad.dir = LV_GRAD_DIR_HOR;
+    dsc.bg_grad.stops_count = 2;
+    dsc.bg_grad.stops[0].color = lv_palette_main(LV_PALETTE_BLUE);
+    dsc.bg_grad.stops[0].frac = 0;
+    dsc.bg_grad.stops[1].color = lv_palette_main(LV_PALETTE_GREEN);
+    dsc.bg_grad.stops[1].frac = 255;
+    dsc.bg_opa = 100;
+    dsc.border_width = 0;
+    lv_area_t a2 = {20, 10, 60, 38};
+    lv_draw_rect(draw_ctx, &dsc, &a2);
+
+    lv_draw_sw_deinit_ctx(NULL, draw_ctx);
+}
+
+static void img_init(void)
+{
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < IMG_H; y++) {
+        for(x = 0; x < IMG_W; x++) {
+            uint8_t * px = &img_straight[(y * IMG_W + x) * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE];
+            lv_color_t c = lv_color_make(x * 11, y * 15, 255 - x * 11);
+            lv_memcpy(px, &c, sizeof(lv_color_t));
+            px[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS] = (x + y) * 255 / (IMG_W + IMG_H - 2);
+        }
+    }
+    lv_memcpy(img_premult, img_straight, sizeof(img_straight));
+    lv_color_premultiply(img_premult, IMG_W * IMG_H);
+}
+
+static void draw_img(uint8_t * buf, lv_color_format_t buf_cf, const uint8_t * img, lv_color_format_t img_cf,
+                     lv_opa_t opa, int16_t angle, uint16_t zoom)
+{
+    lv_draw_ctx_t * draw_ctx = draw_ctx_init(buf, buf_cf);
+
+    lv_draw_img_dsc_t dsc;
+    lv_draw_img_dsc_init(&dsc);
+    dsc.opa = opa;
+    dsc.angle = angle;
+    dsc.zoom = zoom;
+    dsc.pivot.x = IMG_W / 2;
+    dsc.pivot.y = IMG_H / 2;
+
+    lv_draw_img_sup_t sup;
+    lv_memzero(&sup, sizeof(sup));
+
+    /*Clip to the transformed image like `lv_draw_img` does*/
+    lv_area_t coords = {20, 10, 20 + IMG_W - 1, 10 + IMG_H - 1};
+    lv_area_t clip_area;
+    _lv_img_buf_get_transformed_area(&clip_area, IMG_W, IMG_H, angle, zoom, &dsc.pivot);
+    lv_area_move(&clip_area, coords.x1, coords.y1);
+    _lv_area_intersect(&clip_area, &clip_area, &buf_area);
+    draw_ctx->clip_area = &clip_area;
+    lv_draw_img_decoded(draw_ctx, &dsc, &coords, img, &sup, img_cf);
+
+    lv_draw_sw_deinit_ctx(NULL, draw_ctx);
+}
+
+static void assert_argb_near(const uint8_t * expected, const uint8_t * actual, int32_t tolerance)
+{
+    uint32_t i;
+    for(i = 0; i < BUF_W * BUF_H; i++) {
+        const uint8_t * e = &expected[i * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE];
+        const uint8_t * a = &actual[i * LV_COLOR_FORMAT_NATIVE_ALPHA_SIZE];
+        TEST_ASSERT_INT_WITHIN(tolerance, e[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS], a[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS]);
+        /*The premultiplied colors have less precision if the alpha is low*/
+        lv_opa_t opa = e[LV_COLOR_FORMAT_NATIVE_ALPHA_OFS];
+        if(opa > LV_OPA_MIN) {
+            assert_color_near(lv_color_from_buf(e), lv_color_from_buf(a), tolerance + 255 / opa);
+        }
+    }
+}
+
+void test_premultiplied_blend(void)
+{
+    draw_scene(buf_straight, LV_COLOR_FORMAT_NATIVE_ALPHA);
+    draw_scene(buf_premult, LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED);
+
+    lv_color_unpremultiply(buf_premult, BUF_W * BUF_H);
+    assert_argb_near(buf_straight, buf_premult, 4);
+}
+
+void test_premultiplied_img_on_native(void)
+{
+    img_init();
+
+    static const lv_opa_t opas[] = {LV_OPA_COVER, 150};
+    static const int16_t angles[] = {0, 0, 300};
+    static const uint16_t zooms[] = {LV_ZOOM_NONE, 300, 300};
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < sizeof(opas) / sizeof(opas[0]); i++) {
+        for(j = 0; j < sizeof(angles) / sizeof(angles[0]); j++) {
+            /*Draw onto an opaque background*/
+            lv_color_fill((lv_color_t *)buf_straight, lv_palette_main(LV_PALETTE_GREY), BUF_W * BUF_H);
+            lv_color_fill((lv_color_t *)buf_premult, lv_palette_main(LV_PALETTE_GREY), BUF_W * BUF_H);
+
+            draw_img(buf_straight, LV_COLOR_FORMAT_NATIVE, img_straight, LV_COLOR_FORMAT_NATIVE_ALPHA,
+                     opas[i], angles[j], zooms[j]);
+            draw_img(buf_premult, LV_COLOR_FORMAT_NATIVE, img_premult, LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED,
+                     opas[i], angles[j], zooms[j]);
+
+            uint32_t k;
+            for(k = 0; k < BUF_W * BUF_H; k++) {
+                assert_color_near(((lv_color_t *)buf_straight)[k], ((lv_color_t *)buf_premult)[k], 4);
+            }
+        }
+    }
+}
+
+void test_premultiplied_img_on_premultiplied(void)
+{
+    img_init();
+
+    static const lv_opa_t opas[] = {LV_OPA_COVER, 150};
+    uint32_t i;
+    for(i = 0; i < sizeof(opas) / sizeof(opas[0]); i++) {
+        draw_scene(buf_straight, LV_COLOR_FORMAT_NATIVE_ALPHA);
+        draw_scene(buf_premult, LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED);
+
+        draw_img(buf_straight, LV_COLOR_FORMAT_NATIVE_ALPHA, img_straight, LV_COLOR_FORMAT_NATIVE_ALPHA,
+                 opas[i], 0, LV_ZOOM_NONE);
+        draw_img(buf_premult, LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED, img_premult,
+                 LV_COLOR_FORMAT_NATIVE_ALPHA_PREMULTIPLIED, opas[i], 0, LV_ZOOM_NONE);
+
+        lv_color_unpremultiply(buf_premult, BUF_W * BUF_H);
+        assert_argb_near(buf_straight, buf_premult, 4);
+    }
+}
+
+#else
+
+void test_premultiplied_blend(void)
+{
+}
+
+void test_premultiplied_img_on_native(void)
+{
+}
+
+void test_premultiplied_img_on_premultiplied(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,96 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <limits.h>
+
+/*Compare the result of `lv_vsnprintf` with the C library's `vsnprintf`*/
+static void check_fmt(size_t size, const char * fmt, ...)
+{
+    char buf_ref[128];
+    char buf[128];
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(buf), size);
+
+    va_list args;
+    va_start(args, fmt);
+    int len_ref = vsnprintf(buf_ref, size, fmt, args);
+    va_end(args);
+
+    lv_memset(buf, 0xAA, sizeof(buf));
+    va_start(args, fmt);
+    int len = lv_vsnprintf(buf, size, fmt, args);
+    va_end(args);
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(len_ref, len, fmt);
+    if(size > 0) TEST_ASSERT_EQUAL_STRING_MESSAGE(buf_ref, buf, fmt);
+    if(size < sizeof(buf)) TEST_ASSERT_EQUAL_HEX8_MESSAGE(0xAA, buf[size], fmt);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_snprintf_int(void)
+{
+    static const int values[] = {0, 1, -1, 9, 10, 99, 100, -100, 1234, 98765, 100000, 2147483647, INT_MIN};
+    uint32_t i;
+    for(i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        int v = values[i];
+        check_fmt(128, "%d", v);
+        check_fmt(128, "%i|%5d|%-5d|%05d|%+d|% d", v, v, v, v, v, v);
+        check_fmt(128, "%.3d|%8.3d", v, v);
+        check_fmt(128, "%u|%x|%X|%o", (unsigned int)v, (unsigned int)v, (unsigned int)v, (unsigned int)v);
+        check_fmt(128, "%#x|%#X|%#o|%08x|%#010x", (unsigned int)v, (unsigned int)v, (unsigned int)v, (unsigned int)v,
+                  (unsigned int)v);
+        check_fmt(128, "%ld|%lu|%lx", (long)v, (unsigned long)v, (unsigned long)v);
+        check_fmt(128, "%lld|%llu|%llx", (long long)v * 1000003, (unsigned long long)v * 1000003,
+                  (unsigned long long)v * 1000003);
+        check_fmt(128, "%hd|%hhu", (short)v, (unsigned char)v);
+    }
+
+    check_fmt(128, "%.0d|%.0x", 0, 0);
+    check_fmt(128, "%llu|%llx|%lld", ULLONG_MAX, ULLONG_MAX, LLONG_MIN);
+    check_fmt(128, "%" LV_PRId32 " %" LV_PRIu32 " %" LV_PRIx32 " %" LV_PRIX32, (int32_t) -42, (uint32_t)42,
+              (uint32_t)0xbeef, (uint32_t)0xBEEF);
+}
+
+void test_snprintf_text(void)
+{
+    check_fmt(128, "");
+    check_fmt(128, "hello world");
+    check_fmt(128, "%%|%c|%5c|%-3c|", 'a', 'b', 'c');
+    check_fmt(128, "%s|%8s|%-8s|%.2s|", "abc", "abc", "abc", "abc");
+    check_fmt(128, "Value: %d %s, next: %d%%", 42, "Volts", -7);
+}
+
+void test_snprintf_truncate(void)
+{
+    size_t size;
+    for(size = 0; size < 24; size++) {
+        check_fmt(size, "Temperature: %d.%02d C", 23, 5);
+        check_fmt(size, "%x and more text after", 0xABCDEF);
+    }
+}
+
+void test_snprintf_float(void)
+{
+#if LV_USE_BUILTIN_SNPRINTF && LV_SPRINTF_USE_FLOAT
+    static const double values[] = {0.0, 0.5, 1.5, 2.5, -0.25, 3.14159265, -123.456, 99.995, 1234567.891, 0.001};
+    uint32_t i;
+    for(i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        double v = values[i];
+        check_fmt(128, "%.0f|%.1f|%.2f|%.3f|%.6f|%.9f", v, v, v, v, v, v);
+        check_fmt(128, "%8.2f|%-8.2f|%08.2f|%+.2f", v, v, v, v);
+    }
+#endif
+}
+
+#endif
@@ -44,4 +44,68 @@ void test_tiny_ttf_rendering_test(void)
 #endif
 }
 
+void test_tiny_ttf_cache(void)
+{
+#if LV_USE_TINY_TTF
+    extern const uint8_t ubuntu_font[];
+    extern size_t ubuntu_font_size;
+    lv_font_t * font = lv_tiny_ttf_create_data_ex(ubuntu_font, ubuntu_font_size, 30, 16 * 1024);
+    lv_font_t * font_small = lv_tiny_ttf_create_shared(font, 16);
+    TEST_ASSERT_NOT_NULL(font_small);
+
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 600);
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_label_set_text(label, "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor "
+                      "incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud "
+                      "exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat.");
+
+    lv_obj_t * label_small = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label_small, 600);
+    lv_obj_set_style_text_font(label_small, font_small, 0);
+    lv_label_set_text(label_small, lv_label_get_text(label));
+    lv_obj_align(label_small, LV_ALIGN_BOTTOM_MID, 0, -20);
+
+    /*Render the paragraph a few times*/
+    lv_tiny_ttf_cache_stat_t stat_first;
+    lv_tiny_ttf_cache_stat_t stat;
+    lv_refr_now(NULL);
+    lv_tiny_ttf_get_cache_stat(font, &stat_first);
+    TEST_ASSERT_GREATER_THAN(0, stat_first.miss_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(16 * 1024, stat_first.size);
+
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+
+    /*The cache is large enough for all glyphs of both sizes*/
+    lv_tiny_ttf_get_cache_stat(font_small, &stat);
+    TEST_ASSERT_EQUAL_UINT32(stat_first.miss_cnt, stat.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(stat_first.entry_cnt, stat.entry_cnt);
+    TEST_ASSERT_GREATER_THAN(stat_first.hit_cnt, stat.hit_cnt);
+
+    /*A small cache works too but misses more*/
+    lv_tiny_ttf_destroy(font_small);
+    lv_tiny_ttf_set_size(font, 20);
+    lv_obj_del(label_small);
+    lv_font_t * font_tiny_cache = lv_tiny_ttf_create_data_ex(ubuntu_font, ubuntu_font_size, 30, 512);
+    lv_obj_set_style_text_font(label, font_tiny_cache, 0);
+    for(i = 0; i < 3; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+    lv_tiny_ttf_get_cache_stat(font_tiny_cache, &stat);
+    TEST_ASSERT_GREATER_THAN(stat_first.miss_cnt, stat.miss_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(512 + 30 * 30, stat.size);
+
+    lv_obj_del(label);
+    lv_tiny_ttf_destroy(font);
+    lv_tiny_ttf_destroy(font_tiny_cache);
+#else
+    TEST_PASS();
+#endif
+}
+
 #endif
@@ -0,0 +1,211 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define ROW_CNT     1000
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_txt_size_cache_invalidate();
+}
+
+#if LV_TXT_SIZE_CACHE_CNT
+
+static lv_point_t size_get(const char * text, const lv_font_t * font, lv_coord_t letter_space, lv_coord_t max_width)
+{
+    lv_point_t size;
+    lv_txt_get_size(&size, text, font, letter_space, 0, max_width, LV_TEXT_FLAG_NONE);
+    return size;
+}
+
+void test_txt_size_cache_hit(void)
+{
+    const char * text = "Quick brown fox jumps";
+    lv_point_t ref = size_get(text, &lv_font_montserrat_14, 0, LV_COORD_MAX);
+    lv_point_t cached = size_get(text, &lv_font_montserrat_14, 0, LV_COORD_MAX);
+    TEST_ASSERT_EQUAL(ref.x, cached.x);
+    TEST_ASSERT_EQUAL(ref.y, cached.y);
+
+    /*Other parameters shouldn't get the same entry*/
+    lv_point_t wide_font = size_get(text, &lv_font_montserrat_28, 0, LV_COORD_MAX);
+    TEST_ASSERT_GREATER_THAN(ref.x, wide_font.x);
+    lv_point_t spaced = size_get(text, &lv_font_montserrat_14, 2, LV_COORD_MAX);
+    TEST_ASSERT_GREATER_THAN(ref.x, spaced.x);
+    lv_point_t wrapped = size_get(text, &lv_font_montserrat_14, 0, ref.x / 2);
+    TEST_ASSERT_GREATER_THAN(ref.y, wrapped.y);
+
+    cached = size_get(text, &lv_font_montserrat_14, 0, LV_COORD_MAX);
+    TEST_ASSERT_EQUAL(ref.x, cached.x);
+    TEST_ASSERT_EQUAL(ref.y, cached.y);
+}
+
+void test_txt_size_cache_text_changed(void)
+{
+    /*The texts are compared by content so modifying a buffer in place needs no invalidation*/
+    char text[32];
+    lv_snprintf(text, sizeof(text), "%s", "AAAA");
+    lv_point_t size_a = size_get(text, &lv_font_montserrat_14, 0, LV_COORD_MAX);
+    text[2] = '\n';
+    lv_point_t size_nl = size_get(text, &lv_font_montserrat_14, 0, LV_COORD_MAX);
+    TEST_ASSERT_GREATER_THAN(size_a.y, size_nl.y);
+    lv_snprintf(text, sizeof(text), "%s", "AAAA");
+    size_nl = size_get(text, &lv_font_montserrat_14, 0, LV_COORD_MAX);
+    TEST_ASSERT_EQUAL(size_a.x, size_nl.x);
+    TEST_ASSERT_EQUAL(size_a.y, size_nl.y);
+}
+
+void test_txt_size_cache_hash_collision(void)
+{
+    /*These texts have the same length and FNV-1a hash*/
+    lv_point_t ref_1 = size_get("upqaod", &lv_font_montserrat_14, 0, LV_COORD_MAX);
+    lv_txt_size_cache_invalidate();
+    lv_point_t ref_2 = size_get("ggkecs", &lv_font_montserrat_14, 0, LV_COORD_MAX);
+    TEST_ASSERT_NOT_EQUAL(ref_1.x, ref_2.x);
+
+    lv_point_t size_1 = size_get("upqaod", &lv_font_montserrat_14, 0, LV_COORD_MAX);
+    lv_point_t size_2 = size_get("ggkecs", &lv_font_montserrat_14, 0, LV_COORD_MAX);
+    TEST_ASSERT_EQUAL(ref_1.x, size_1.x);
+    TEST_ASSERT_EQUAL(ref_2.x, size_2.x);
+}
+
+void test_txt_size_cache_font_changed(void)
+{
+    /*Changing these properties of a font in place needs no invalidation*/
+    lv_font_t font = lv_font_montserrat_14;
+    lv_font_fmt_txt_dsc_t dsc = *(const lv_font_fmt_txt_dsc_t *)font.dsc;
+    font.dsc = &dsc;
+
+    lv_point_t cjk = size_get("\xE4\xB8\xAD", &font, 0, LV_COORD_MAX);
+    font.fallback = &lv_font_simsun_16_cjk;
+    lv_point_t cjk_fallback = size_get("\xE4\xB8\xAD", &font, 0, LV_COORD_MAX);
+    TEST_ASSERT_GREATER_THAN(cjk.x, cjk_fallback.x);
+
+    lv_point_t kerned = size_get("AVAVAV", &font, 0, LV_COORD_MAX);
+    dsc.kern_scale = 0;
+    lv_point_t not_kerned = size_get("AVAVAV", &font, 0, LV_COORD_MAX);
+    TEST_ASSERT_GREATER_THAN(kerned.x, not_kerned.x);
+
+    font.line_height += 10;
+    lv_point_t taller = size_get("AVAVAV", &font, 0, LV_COORD_MAX);
+    TEST_ASSERT_EQUAL(not_kerned.y + 10, taller.y);
+}
+
+void test_txt_size_cache_many_texts(void)
+{
+    /*More texts than cache entries*/
+    lv_point_t ref[LV_TXT_SIZE_CACHE_CNT * 3];
+    char buf[32];
+    uint32_t round;
+    for(round = 0; round < 2; round++) {
+        uint32_t i;
+        for(i = 0; i < sizeof(ref) / sizeof(ref[0]); i++) {
+            lv_snprintf(buf, sizeof(buf), "Item %" LV_PRIu32 "\n%" LV_PRIu32, i, i * 111);
+            lv_point_t size = size_get(buf, &lv_font_montserrat_14, 0, LV_COORD_MAX);
+            if(round == 0) ref[i] = size;
+            TEST_ASSERT_EQUAL(ref[i].x, size.x);
+            TEST_ASSERT_EQUAL(ref[i].y, size.y);
+        }
+    }
+}
+
+void test_txt_size_cache_table(void)
+{
+    /*A large table where the same texts are measured again on every refresh*/
+    lv_obj_t * table = lv_table_create(lv_scr_act());
+    lv_table_set_col_cnt(table, 2);
+    lv_table_set_row_cnt(table, ROW_CNT);
+    lv_obj_set_size(table, 400, 400);
+
+    uint32_t i;
+    for(i = 0; i < ROW_CNT; i++) {
+        lv_table_set_cell_value_fmt(table, i, 0, "Row %" LV_PRIu32, i);
+        lv_table_set_cell_value(table, i, 1, i % 7 ? "Value" : "Two\nlines");
+    }
+    lv_refr_now(NULL);
+
+    lv_coord_t h_cached = lv_obj_get_self_height(table);
+    lv_coord_t row_h_cached[2] = {((lv_table_t *)table)->row_h[6], ((lv_table_t *)table)->row_h[7]};
+
+    /*Measure all the rows again without the cache*/
+    lv_txt_size_cache_invalidate();
+    lv_obj_refresh_style(table, LV_PART_ANY, LV_STYLE_PROP_ANY);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL(h_cached, lv_obj_get_self_height(table));
+    TEST_ASSERT_EQUAL(row_h_cached[0], ((lv_table_t *)table)->row_h[6]);
+    TEST_ASSERT_EQUAL(row_h_cached[1], ((lv_table_t *)table)->row_h[7]);
+    TEST_ASSERT_GREATER_THAN(row_h_cached[0], row_h_cached[1]);
+}
+
+#else
+
+void test_txt_size_cache_hit(void)
+{
+}
+
+void test_txt_size_cache_text_changed(void)
+{
+}
+
+void test_txt_size_cache_hash_collision(void)
+{
+}
+
+void test_txt_size_cache_font_changed(void)
+{
+}
+
+void test_txt_size_cache_hash_collision(void)
+{
+    /*These texts have the same length and FNV-1a hash*/
+    lv_point_t ref_1 = size_get("upqaod", &lv_font_montserrat_14, 0, LV_COORD_MAX);
+    lv_txt_size_cache_invalidate();
+    lv_point_t ref_2 = size_get("ggkecs", &lv_font_montserrat_14, 0, LV_COORD_MAX);
+    TEST_ASSERT_NOT_EQUAL(ref_1.x, ref_2.x);
+
+    lv_point_t size_1 = size_get("upqaod", &lv_font_montserrat_14, 0, LV_COORD_MAX);
+    lv_point_t size_2 = size_get("ggkecs", &lv_font_montserrat_14, 0, LV_COORD_MAX);
+    TEST_ASSERT_EQUAL(ref_1.x, size_1.x);
+    TEST_ASSERT_EQUAL(ref_2.x, size_2.x);
+}
+
+void test_txt_size_cache_font_changed(void)
+{
+    /*Changing these properties of a font in place needs no invalidation*/
+    lv_font_t font = lv_font_montserrat_14;
+    lv_font_fmt_txt_dsc_t dsc = *(const lv_font_fmt_txt_dsc_t *)font.dsc;
+    font.dsc = &dsc;
+
+    lv_point_t cjk = size_get("\xE4\xB8\xAD", &font, 0, LV_COORD_MAX);
+    font.fallback = &lv_font_simsun_16_cjk;
+    lv_point_t cjk_fallback = size_get("\xE4\xB8\xAD", &font, 0, LV_COORD_MAX);
+    TEST_ASSERT_GREATER_THAN(cjk.x, cjk_fallback.x);
+
+    lv_point_t kerned = size_get("AVAVAV", &font, 0, LV_COORD_MAX);
+    dsc.kern_scale = 0;
+    lv_point_t not_kerned = size_get("AVAVAV", &font, 0, LV_COORD_MAX);
+    TEST_ASSERT_GREATER_THAN(kerned.x, not_kerned.x);
+
+    font.line_height += 10;
+    lv_point_t taller = size_get("AVAVAV", &font, 0, LV_COORD_MAX);
+    TEST_ASSERT_EQUAL(not_kerned.y + 10, taller.y);
+}
+
+void test_txt_size_cache_many_texts(void)
+{
+}
+
+void test_txt_size_cache_table(void)
+{
+}
+
+#endif
+
+#endif